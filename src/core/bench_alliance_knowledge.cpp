@@ -0,0 +1,146 @@
+// Alliance knowledge sharing benchmark
+// Eight allied players each observe part of a 1000-planet galaxy every turn, then every
+// member merges every other member's knowledge.  Compares the bitset merge
+// (KnowledgeGalaxy::merge_from) with a naive scan of every planet for every ally pair,
+// and checks that both leave identical knowledge.
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -Iinclude bench_alliance_knowledge.cpp _gate_build/libOpenHoCore.a -o bench_alliance_knowledge
+//   cd ../.. && src/core/bench_alliance_knowledge
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "include/knowledge_galaxy.h"
+
+typedef std::vector<std::unique_ptr<KnowledgeGalaxy>> Alliance;
+
+// Naive merge: every planet of every ally, field by field
+static uint32_t naive_merge(KnowledgeGalaxy& mine, const KnowledgeGalaxy& ally, const Galaxy& galaxy, const Player* observer) {
+    uint32_t merged = 0;
+    const KnowledgeGalaxy& self = mine;
+    for (uint32_t id = 1; id <= galaxy.planets.size(); ++id) {
+        const KnowledgePlanet* theirs = ally.get_planet(id);
+        const KnowledgePlanet* ours = self.get_planet(id);
+        if (theirs && (!ours || ours->observation_year < theirs->observation_year)) {
+            mine.observe_planet(id, galaxy.planets[id - 1], observer, theirs->observation_year);
+            merged++;
+        }
+    }
+    return merged;
+}
+
+int main() {
+    std::cout << "=== Alliance Knowledge Sharing Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 1000;
+    const uint32_t n_allies = 8;
+    const uint32_t n_turns = 200;
+    const uint32_t observed_per_turn = 150;    // Planets each ally sees per turn
+
+    try {
+        GalaxyGenerationParams params(n_planets, n_allies, 0.5, GALAXY_RANDOM, 12345);
+
+        std::vector<PlayerSetup> setups;
+        for (uint32_t i = 0; i < n_allies; ++i) {
+            PlayerSetup setup;
+            setup.name = "Ally " + std::to_string(i + 1);
+            setup.player_gender = GENDER_F;
+            setup.type = PLAYER_HUMAN;
+            setup.ai_iq = 0;
+            setup.starting_colony_quality = START_NORMAL;
+            setups.push_back(setup);
+        }
+
+        GameSetup game_setup(params, setups);
+        GameState game(game_setup);
+        const Galaxy& galaxy = game.get_galaxy();
+        const uint32_t planet_count = static_cast<uint32_t>(galaxy.planets.size());
+
+        // Two identical alliances: one merged with bitsets, one naively
+        Alliance fast, naive;
+        for (uint32_t i = 0; i < n_allies; ++i) {
+            PlayerID id = static_cast<PlayerID>(game.get_players()[i].id);
+            fast.push_back(std::make_unique<KnowledgeGalaxy>(galaxy, id));
+            naive.push_back(std::make_unique<KnowledgeGalaxy>(galaxy, id));
+        }
+
+        double fast_seconds = 0.0;
+        double naive_seconds = 0.0;
+        uint64_t fast_merged = 0;
+        uint64_t naive_merged = 0;
+        uint64_t lcg = 88172645463325252ULL;
+
+        for (uint32_t turn = 0; turn < n_turns; ++turn) {
+            int32_t year = 2000 + static_cast<int32_t>(turn) * 10;
+
+            // Each ally observes a pseudo-random patch of planets (not timed)
+            for (uint32_t a = 0; a < n_allies; ++a) {
+                const Player* observer = &game.get_players()[a];
+                fast[a]->begin_turn(turn);
+                naive[a]->begin_turn(turn);
+                lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+                uint32_t start = static_cast<uint32_t>(lcg >> 33) % planet_count;
+                for (uint32_t k = 0; k < observed_per_turn; ++k) {
+                    uint32_t id = 1 + (start + k * 7) % planet_count;
+                    fast[a]->observe_planet(id, galaxy.planets[id - 1], observer, year);
+                    naive[a]->observe_planet(id, galaxy.planets[id - 1], observer, year);
+                }
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t a = 0; a < n_allies; ++a) {
+                for (uint32_t b = 0; b < n_allies; ++b) {
+                    if (a != b) {
+                        fast_merged += fast[a]->merge_from(*fast[b], &game.get_players()[a]);
+                    }
+                }
+            }
+            auto mid = std::chrono::steady_clock::now();
+            for (uint32_t a = 0; a < n_allies; ++a) {
+                for (uint32_t b = 0; b < n_allies; ++b) {
+                    if (a != b) {
+                        naive_merged += naive_merge(*naive[a], *naive[b], galaxy, &game.get_players()[a]);
+                    }
+                }
+            }
+            auto end = std::chrono::steady_clock::now();
+            fast_seconds += std::chrono::duration<double>(mid - start).count();
+            naive_seconds += std::chrono::duration<double>(end - mid).count();
+        }
+
+        // Both strategies must leave every ally with the same knowledge
+        uint32_t mismatches = 0;
+        for (uint32_t a = 0; a < n_allies; ++a) {
+            for (uint32_t id = 1; id <= planet_count; ++id) {
+                KnowledgePlanet f = fast[a]->get_planet_or_unknown(id);
+                KnowledgePlanet n = naive[a]->get_planet_or_unknown(id);
+                if (std::memcmp(&f, &n, sizeof(KnowledgePlanet)) != 0) {
+                    mismatches++;
+                }
+            }
+        }
+
+        std::cout << "Planets:               " << planet_count << std::endl;
+        std::cout << "Allies:                " << n_allies << std::endl;
+        std::cout << "Turns:                 " << n_turns << std::endl;
+        std::cout << "Bitset merge:          " << fast_seconds * 1e6 / n_turns << " us/turn ("
+                  << fast_merged << " records merged)" << std::endl;
+        std::cout << "Naive merge:           " << naive_seconds * 1e6 / n_turns << " us/turn ("
+                  << naive_merged << " records merged)" << std::endl;
+        std::cout << "Speedup:               " << naive_seconds / fast_seconds << "x" << std::endl;
+        std::cout << "Mismatches:            " << mismatches << std::endl;
+
+        return mismatches == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,185 @@
+// Background autosave benchmark
+// Plays a 500-planet, 20-player game for 300 turns three times: without autosave, saving
+// to a file on the turn thread after every turn, and with an AutosaveService writing the
+// same file in the background.  Then checks that:
+//   - the autosave file holds the last turn and loads back into the same game
+//   - with a slow target the turn loop still only pays for the snapshot, the queue stays
+//     bounded and the overflow shows up as dropped snapshots, and the newest turn is saved
+//   - a target that fails its saves is counted, not retried, and never blocks the game
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -pthread -Iinclude bench_autosave.cpp _gate_build/libOpenHoCore.a -o bench_autosave
+//   cd ../.. && src/core/bench_autosave
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <algorithm>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/autosave.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "bench_common.h"
+
+// Keeps the bytes of the last save, taking a fixed time per save like a slow disk
+class SlowTarget : public AutosaveTarget {
+public:
+    explicit SlowTarget(std::chrono::milliseconds delay) : delay(delay) {}
+    ByteSink* begin_save(uint32_t) override {
+        sink.bytes.clear();
+        return &sink;
+    }
+    bool end_save(uint32_t turn, bool streamed) override {
+        std::this_thread::sleep_for(delay);
+        last_turn = turn;
+        last_bytes = sink.bytes;
+        return streamed;
+    }
+    struct Collect : ByteSink {
+        bool write(const uint8_t* data, size_t size) override {
+            bytes.insert(bytes.end(), data, data + size);
+            return true;
+        }
+        std::vector<uint8_t> bytes;
+    } sink;
+    std::chrono::milliseconds delay;
+    uint32_t last_turn = 0;
+    std::vector<uint8_t> last_bytes;
+};
+
+class FailingTarget : public AutosaveTarget {
+public:
+    ByteSink* begin_save(uint32_t) override { return nullptr; }
+    bool end_save(uint32_t, bool) override { return false; }
+};
+
+static std::vector<uint8_t> read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+struct TurnTimes {
+    double mean_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+// Plays n_turns; after_turn runs inside the timed region (a save on the turn thread)
+template <typename AfterTurn>
+static TurnTimes play(GameState& game, uint32_t n_turns, AfterTurn after_turn) {
+    TurnTimes times;
+    uint64_t lcg = 1;
+    for (uint32_t turn = 0; turn < n_turns; ++turn) {
+        issue_orders(game, lcg);
+        auto start = std::chrono::steady_clock::now();
+        game.process_turn();
+        after_turn(game);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        times.mean_ms += ms / n_turns;
+        times.max_ms = std::max(times.max_ms, ms);
+    }
+    return times;
+}
+
+int main() {
+    std::cout << "=== Background Autosave Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 20;
+    const uint32_t n_turns = 300;
+    const uint32_t slow_turns = 60;
+    const std::string path = "bench_autosave.ohsv";
+    bool ok = true;
+
+    try {
+        GameSetup setup = make_setup(n_planets, n_players);
+
+        // No autosave
+        GameState plain(setup);
+        TurnTimes plain_times = play(plain, n_turns, [](GameState&) {});
+
+        // Save on the turn thread
+        GameState blocking(setup);
+        TurnTimes blocking_times = play(blocking, n_turns, [&path](GameState& game) {
+            std::vector<uint8_t> bytes = game.serialize_state();
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        });
+
+        // Background autosave to the same file
+        GameState background(setup);
+        FileAutosaveTarget file_target(path);
+        AutosaveService service(file_target, 1, 2);
+        service.attach(background);
+        TurnTimes background_times = play(background, n_turns, [](GameState&) {});
+        background.set_autosave(nullptr);
+        service.wait_idle();
+        AutosaveMetrics metrics = service.get_metrics();
+
+        std::vector<uint8_t> saved = read_file(path);
+        GameState loaded(setup);
+        bool file_ok = saved == background.serialize_state()
+                    && loaded.deserialize_state(saved) && loaded.serialize_state() == saved
+                    && metrics.last_saved_turn == n_turns && metrics.snapshots == n_turns
+                    && metrics.saves + metrics.dropped + metrics.failed == metrics.snapshots;
+        std::remove(path.c_str());
+
+        // Slow target: 25 ms per save, far longer than a turn
+        GameState slow_game(setup);
+        SlowTarget slow_target(std::chrono::milliseconds(25));
+        AutosaveService slow_service(slow_target, 1, 2);
+        slow_service.attach(slow_game);
+        size_t deepest_queue = 0;
+        TurnTimes slow_times = play(slow_game, slow_turns, [&slow_service, &deepest_queue](GameState&) {
+            deepest_queue = std::max(deepest_queue, slow_service.get_metrics().queued);
+        });
+        slow_game.set_autosave(nullptr);
+        slow_service.wait_idle();
+        AutosaveMetrics slow_metrics = slow_service.get_metrics();
+        bool slow_ok = slow_metrics.dropped > 0 && deepest_queue <= 2 && slow_target.last_turn == slow_turns
+                    && slow_target.last_bytes == slow_game.serialize_state()
+                    && slow_metrics.saves + slow_metrics.dropped == slow_metrics.snapshots;
+
+        // Failing target
+        GameState failing_game(setup);
+        FailingTarget failing_target;
+        AutosaveService failing_service(failing_target, 5, 2);
+        failing_service.attach(failing_game);
+        (void)play(failing_game, 20, [](GameState&) {});
+        failing_game.set_autosave(nullptr);
+        failing_service.wait_idle();
+        AutosaveMetrics failing_metrics = failing_service.get_metrics();
+        bool failing_ok = failing_metrics.snapshots == 4 && failing_metrics.failed + failing_metrics.dropped == 4
+                       && failing_metrics.saves == 0;
+
+        std::cout << "Planets:                  " << n_planets << std::endl;
+        std::cout << "Players:                  " << n_players << std::endl;
+        std::cout << "Turns:                    " << n_turns << std::endl;
+        std::cout << "Save size:                " << metrics.last_save_bytes << " bytes" << std::endl;
+        std::cout << "Turn, no autosave:        " << plain_times.mean_ms << " ms (max " << plain_times.max_ms << ")" << std::endl;
+        std::cout << "Turn, save on turn:       " << blocking_times.mean_ms << " ms (max " << blocking_times.max_ms << ")" << std::endl;
+        std::cout << "Turn, background save:    " << background_times.mean_ms << " ms (max " << background_times.max_ms << ")" << std::endl;
+        std::cout << "Snapshot on turn thread:  " << metrics.max_capture_ms << " ms max" << std::endl;
+        std::cout << "Saves / dropped:          " << metrics.saves << " / " << metrics.dropped << std::endl;
+        std::cout << "Save lag:                 " << metrics.total_lag_ms / std::max<uint64_t>(metrics.saves, 1)
+                  << " ms mean, " << metrics.max_lag_ms << " ms max" << std::endl;
+        std::cout << "Slow target turn:         " << slow_times.mean_ms << " ms (max " << slow_times.max_ms << ")" << std::endl;
+        std::cout << "Slow target saves:        " << slow_metrics.saves << " kept, " << slow_metrics.dropped
+                  << " dropped, lag " << slow_metrics.max_lag_ms << " ms max" << std::endl;
+        std::cout << "Autosave file loads:      " << (file_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Slow target bounded:      " << (slow_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Failed saves counted:     " << (failing_ok ? "yes" : "NO") << " (" << failing_metrics.failed << ")" << std::endl;
+
+        ok = file_ok && slow_ok && failing_ok;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
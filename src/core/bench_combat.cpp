@@ -0,0 +1,112 @@
+// Combat engine benchmark
+// Resolves repeated 10,000-ship engagements between several owners and checks determinism,
+// and that allied owners never fire on each other.
+// Build from src/core (after building OpenHoCore):
+//   g++ -std=c++17 -O2 -Iinclude bench_combat.cpp _gate_build/libOpenHoCore.a -o bench_combat
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "include/combat.h"
+#include "include/rng.h"
+#include "include/game_constants.h"
+
+// Build a 10k-ship engagement: 4 owners x 250 fleets x 10 ships, spread over several tech levels
+static std::vector<CombatParticipant> make_engagement() {
+    std::vector<CombatParticipant> participants;
+    uint32_t fleet_id = 1;
+    for (int32_t owner = 1; owner <= 4; ++owner) {
+        for (uint32_t f = 0; f < 250; ++f) {
+            CombatParticipant p;
+            p.owner = owner;
+            p.fleet_id = fleet_id++;
+            p.tech_weapons = static_cast<int32_t>((f * 7 + owner) % 6);
+            p.tech_shields = static_cast<int32_t>((f * 3 + owner * 2) % 5);
+            p.ship_count = 10;
+            participants.push_back(p);
+        }
+    }
+    return participants;
+}
+
+int main() {
+    std::cout << "=== Combat Engine Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t iterations = 2000;
+
+    CombatEngine engine;
+    RNGStream rng = DeterministicRNG(12345, 54321).stream(1, RNG_PHASE_COMBAT, 1);
+    std::vector<CombatParticipant> base = make_engagement();
+
+    uint32_t ships_per_engagement = 0;
+    for (const CombatParticipant& p : base) {
+        ships_per_engagement += p.ship_count;
+    }
+
+    uint64_t total_destroyed = 0;
+    uint64_t total_rounds = 0;
+    std::vector<CombatParticipant> participants;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        participants = base;
+        CombatResult result = engine.resolve(participants, rng);
+        total_destroyed += result.ships_destroyed;
+        total_rounds += result.rounds_fought;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    // Determinism check: identical stream keys must give identical survivors
+    RNGStream rng_a(777, 1, RNG_PHASE_COMBAT, 42);
+    RNGStream rng_b(777, 1, RNG_PHASE_COMBAT, 42);
+    std::vector<CombatParticipant> run_a = base;
+    std::vector<CombatParticipant> run_b = base;
+    engine.resolve(run_a, rng_a);
+    engine.resolve(run_b, rng_b);
+    bool deterministic = true;
+    for (size_t i = 0; i < run_a.size(); ++i) {
+        if (run_a[i].ship_count != run_b[i].ship_count) {
+            deterministic = false;
+        }
+    }
+
+    // Allies: owners 1+2 against 3+4 end with one alliance holding the planet, and
+    // an engagement among allies fights no rounds and loses no ships
+    std::vector<CombatParticipant> sides = base;
+    for (CombatParticipant& p : sides) {
+        p.alliance = (p.owner <= 2) ? 1 : 2;
+    }
+    RNGStream rng_sides(777, 1, RNG_PHASE_COMBAT, 43);
+    CombatResult sides_result = engine.resolve(sides, rng_sides);
+    uint32_t alliances_left = 0;
+    for (uint32_t alliance = 1; alliance <= 2; ++alliance) {
+        for (const CombatParticipant& p : sides) {
+            if (p.alliance == alliance && p.ship_count > 0) {
+                alliances_left++;
+                break;
+            }
+        }
+    }
+    std::vector<CombatParticipant> friends = base;
+    for (CombatParticipant& p : friends) {
+        p.alliance = 1;
+    }
+    CombatResult friends_result = engine.resolve(friends, rng_sides);
+    bool allies_hold_fire = sides_result.rounds_fought > 0 && friends_result.rounds_fought == 0
+                         && friends_result.ships_destroyed == 0
+                         && (alliances_left <= 1 || sides_result.rounds_fought == GameConstants::Combat_Max_Rounds);
+
+    std::cout << "Ships per engagement:  " << ships_per_engagement << std::endl;
+    std::cout << "Fleets per engagement: " << base.size() << std::endl;
+    std::cout << "Engagements resolved:  " << iterations << std::endl;
+    std::cout << "Average rounds:        " << static_cast<double>(total_rounds) / iterations << std::endl;
+    std::cout << "Average destroyed:     " << static_cast<double>(total_destroyed) / iterations << std::endl;
+    std::cout << "Total time:            " << seconds * 1000.0 << " ms" << std::endl;
+    std::cout << "Per engagement:        " << seconds * 1e6 / iterations << " us" << std::endl;
+    std::cout << "Deterministic:         " << (deterministic ? "yes" : "NO") << std::endl;
+    std::cout << "Allies hold fire:      " << (allies_hold_fire ? "yes" : "NO") << " (2 v 2 over "
+              << sides_result.rounds_fought << " rounds)" << std::endl;
+
+    return deterministic && allies_hold_fire ? 0 : 1;
+}
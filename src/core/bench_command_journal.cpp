@@ -0,0 +1,230 @@
+// Command journal and replay benchmark
+// Plays a 500-planet, 20-player game for 400 turns with every order after setup given through
+// GameState::execute_command() and a CommandJournal attached (a keyframe every 25 turns),
+// then replays it in a second game and checks that:
+//   - seeking to sampled turns (in any order) rebuilds exactly the recorded state
+//   - a full replay from the first keyframe matches every keyframe it passes
+//   - the journal reads back from its bytes, and journals cut inside a keyframe are rejected
+//   - orders given through GameState's own setters (an alliance change, a money allocation)
+//     are journaled too, so the replay still matches
+// Times recording, full replay and a cold seek to the last turn.
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -Iinclude bench_command_journal.cpp _gate_build/libOpenHoCore.a -o bench_command_journal
+//   cd ../.. && src/core/bench_command_journal
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/command_journal.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "bench_common.h"
+
+// Starting design and fleets, given directly (early tech levels do not pass the design check)
+static void give_fleets(GameState& game, uint64_t& lcg) {
+    for (Player& player : game.get_players()) {
+        if (player.get_colonized_planets().empty()) {
+            continue;
+        }
+        uint32_t home = player.get_colonized_planets()[0].get_id();
+        uint32_t design_id = player.create_ship_design("Warship", SHIP_FIGHTER, 1, 1, 1, 1, 1);
+        for (uint32_t i = 0; i < 6; ++i) {
+            lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+            (void)player.create_fleet(design_id, 5 + static_cast<uint32_t>((lcg >> 33) % 20), home);
+        }
+    }
+}
+
+// Builds, moves, refuels, allocations, reseeding and the odd disbanded fleet, all as commands;
+// new designs are attempted too, and only orders that pass their checks are journaled
+static void issue_orders(GameState& game, uint64_t& lcg, size_t& issued) {
+    const Galaxy& galaxy = game.get_galaxy();
+    auto next = [&lcg]() {
+        lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+        return lcg >> 33;
+    };
+    auto execute = [&game, &issued](const GameCommand& command, uint32_t* out_id = nullptr) {
+        issued += game.execute_command(command, out_id) == ErrorCode::SUCCESS ? 1 : 0;
+    };
+
+    if (next() % 10 == 0) {
+        execute(GameCommand::set_ai_seed(next()));
+    }
+    for (const Player& player : game.get_players()) {
+        if (player.get_colonized_planets().empty()) {
+            continue;
+        }
+        const ColonizedPlanet& home = player.get_colonized_planets()[0];
+        const Player::TechnologyLevels& tech = player.get_tech_levels();
+        execute(GameCommand::create_ship_design(player.id, "Cruiser", SHIP_FIGHTER, tech.range, tech.speed,
+                                                tech.weapons, tech.shields, tech.mini));
+        if (player.get_fleets().size() < 8) {
+            execute(GameCommand::build_fleet(player.id, player.get_ship_designs()[0].id, 1 + static_cast<uint32_t>(next() % 5), home.get_id()));
+        }
+        if (next() % 8 == 0) {
+            double mining = static_cast<double>(next() % 101) / 100.0;
+            execute(GameCommand::set_planet_allocation(player.id, home.get_id(), mining, 1.0 - mining));
+            Player::MoneyAllocation allocation = player.get_spending_allocation();
+            allocation.savings_fraction = static_cast<double>(next() % 41) / 100.0;
+            allocation.research_fraction = 0.3;
+            allocation.planets_fraction = 0.7 - allocation.savings_fraction;
+            execute(GameCommand::set_money_allocation(player.id, allocation));
+        }
+        if (next() % 50 == 0 && !player.get_fleets().empty()) {
+            execute(GameCommand::delete_fleet(player.id, player.get_fleets()[0].id));
+        }
+
+        std::vector<uint32_t> fleet_ids;
+        for (const Fleet& fleet : player.get_fleets()) {
+            if (!fleet.is_in_transit()) {
+                fleet_ids.push_back(fleet.id);
+            }
+        }
+        for (uint32_t fleet_id : fleet_ids) {
+            PlanetNeighbourGraph::NeighbourRange neighbours = galaxy.neighbour_graph.get_neighbours(
+                game.get_fleet(player.id, fleet_id)->current_planet->id);
+            if (neighbours.count == 0) {
+                continue;
+            }
+            uint32_t destination = neighbours.ids[next() % std::min<uint32_t>(neighbours.count, 6)];
+            execute(GameCommand::move_fleet(player.id, fleet_id, destination));
+            execute(GameCommand::refuel_fleet(player.id, fleet_id));
+        }
+    }
+}
+
+int main() {
+    std::cout << "=== Command Journal Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 20;
+    const uint32_t n_turns = 400;
+    const uint32_t keyframe_interval = 25;
+    const std::vector<uint32_t> sample_turns = { 400, 0, 399, 123, 124, 250, 37, 375, 376, 1 };
+    bool ok = true;
+
+    try {
+        GameSetup setup = make_setup(n_planets, n_players);
+        GameState game(setup);
+        for (uint32_t i = 1; i <= n_players; ++i) {
+            (void)game.execute_command(GameCommand::set_alliance(i, i <= 4 ? 1 : (i <= 8 ? 2 : GameState::NO_ALLIANCE)));
+        }
+
+        uint64_t lcg = 1;
+        give_fleets(game, lcg);
+
+        CommandJournal journal(keyframe_interval);
+        journal.start(game);
+
+        // Record
+        std::map<uint32_t, std::vector<uint8_t>> recorded;
+        size_t issued = 0;
+        double play_ms = 0.0;
+        for (uint32_t turn = 0; turn <= n_turns; ++turn) {
+            if (std::find(sample_turns.begin(), sample_turns.end(), turn) != sample_turns.end()) {
+                recorded[turn] = game.serialize_state();
+            }
+            if (turn == n_turns) {
+                break;
+            }
+            auto start = std::chrono::steady_clock::now();
+            if (turn == n_turns / 2) {
+                // Setters are shorthands for commands: these must reach the journal
+                Player::MoneyAllocation allocation = game.get_money_allocation(9);
+                allocation.savings_fraction = 0.5;
+                allocation.research_fraction = 0.2;
+                allocation.planets_fraction = 0.3;
+                issued += game.set_player_alliance(9, 2) == ErrorCode::SUCCESS ? 1 : 0;
+                issued += game.set_money_allocation(9, allocation) == ErrorCode::SUCCESS ? 1 : 0;
+            }
+            issue_orders(game, lcg, issued);
+            game.process_turn();
+            play_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        game.set_command_journal(nullptr);
+        size_t journal_bytes = journal.get_data().size();
+        size_t keyframe_bytes = 0;
+        for (const CommandJournal::Keyframe& keyframe : journal.get_keyframes()) {
+            keyframe_bytes += keyframe.size;
+        }
+
+        // Seek to sampled turns
+        GameState replay_game(setup);
+        ReplayEngine replay(journal, replay_game);
+        bool seeks_match = true;
+        double worst_seek_ms = 0.0;
+        for (uint32_t turn : sample_turns) {
+            auto start = std::chrono::steady_clock::now();
+            bool sought = replay.seek(turn);
+            worst_seek_ms = std::max(worst_seek_ms, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            if (!sought || replay_game.serialize_state() != recorded[turn]) {
+                std::cout << "Seek to turn " << turn << " does not match" << std::endl;
+                seeks_match = false;
+            }
+        }
+
+        // Cold seek to the last turn
+        GameState cold_game(setup);
+        ReplayEngine cold(journal, cold_game);
+        auto start = std::chrono::steady_clock::now();
+        bool cold_ok = cold.seek(n_turns);
+        double cold_seek_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        cold_ok = cold_ok && cold_game.serialize_state() == recorded[n_turns];
+
+        // Full replay, checking every keyframe
+        ReplayEngine full(journal, cold_game);
+        full.set_check_keyframes(true);
+        start = std::chrono::steady_clock::now();
+        bool full_ok = full.seek(0);
+        uint32_t replayed = 0;
+        while (full_ok && full.get_turn() < n_turns) {
+            full_ok = full.step();
+            replayed++;
+        }
+        double replay_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        full_ok = full_ok && !full.step() && cold_game.serialize_state() == recorded[n_turns];
+
+        // Read back; journals cut inside a keyframe are rejected
+        CommandJournal reread;
+        bool file_ok = reread.read(journal.get_data().data(), journal.get_data().size())
+                    && reread.get_keyframes().size() == journal.get_keyframes().size()
+                    && reread.get_end_turn() == n_turns && reread.get_command_count() == journal.get_command_count();
+        ReplayEngine reread_replay(reread, replay_game);
+        file_ok = file_ok && reread_replay.seek(250) && replay_game.serialize_state() == recorded[250];
+        uint32_t rejected = 0;
+        for (const CommandJournal::Keyframe& keyframe : journal.get_keyframes()) {
+            CommandJournal cut;
+            rejected += cut.read(journal.get_data().data(), keyframe.offset + keyframe.size / 2) ? 0 : 1;
+        }
+
+        std::cout << "Planets:                  " << n_planets << std::endl;
+        std::cout << "Players:                  " << n_players << std::endl;
+        std::cout << "Turns:                    " << n_turns << std::endl;
+        std::cout << "Commands:                 " << journal.get_command_count() << " (" << issued << " accepted orders)" << std::endl;
+        std::cout << "Journal:                  " << journal_bytes << " bytes (" << journal.get_keyframes().size()
+                  << " keyframes, " << keyframe_bytes << " bytes)" << std::endl;
+        std::cout << "Commands and turns:       " << (journal_bytes - keyframe_bytes) / n_turns << " bytes/turn" << std::endl;
+        std::cout << "Play (with journal):      " << play_ms / n_turns << " ms/turn" << std::endl;
+        std::cout << "Replay:                   " << replay_ms / std::max<uint32_t>(replayed, 1) << " ms/turn" << std::endl;
+        std::cout << "Cold seek to turn " << n_turns << ":   " << cold_seek_ms << " ms" << std::endl;
+        std::cout << "Slowest sampled seek:     " << worst_seek_ms << " ms" << std::endl;
+        std::cout << "Seeks match recording:    " << (seeks_match && cold_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Full replay matches:      " << (full_ok ? "yes" : "NO") << " (" << replayed << " turns)" << std::endl;
+        std::cout << "Journal read back:        " << (file_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Cut journals rejected:    " << rejected << "/" << journal.get_keyframes().size() << std::endl;
+
+        ok = journal.get_command_count() == issued && seeks_match && cold_ok && full_ok && file_ok
+          && rejected == journal.get_keyframes().size();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+// Shared helpers for the game-level benchmarks (bench_*.cpp)
+// A reproducible game setup, and a deterministic stream of fleet orders that keeps
+// every player building fleets and moving them between nearby planets, so that
+// saves, journals and snapshots have realistic state to work on.
+// Header only: each benchmark is a single translation unit built by hand.
+
+#ifndef OPENHO_BENCH_COMMON_H
+#define OPENHO_BENCH_COMMON_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+
+// Human players only, alternating genders, normal starting colonies
+inline GameSetup make_setup(uint32_t n_planets, uint32_t n_players, GalaxyShape shape = GALAXY_RANDOM,
+                            uint64_t seed = 2024) {
+    GalaxyGenerationParams params(n_planets, n_players, 0.5, shape, seed);
+    std::vector<PlayerSetup> setups;
+    for (uint32_t i = 0; i < n_players; ++i) {
+        PlayerSetup setup;
+        setup.name = "Player " + std::to_string(i + 1);
+        setup.player_gender = (i % 2) ? GENDER_M : GENDER_F;
+        setup.type = PLAYER_HUMAN;
+        setup.ai_iq = 0;
+        setup.starting_colony_quality = START_NORMAL;
+        setups.push_back(setup);
+    }
+    return GameSetup(params, setups);
+}
+
+// Give every player a few fleets and keep them moving between nearby planets
+// (the same lcg state always gives the same orders)
+inline void issue_orders(GameState& game, uint64_t& lcg) {
+    const Galaxy& galaxy = game.get_galaxy();
+    for (Player& player : game.get_players()) {
+        if (player.get_colonized_planets().empty()) {
+            continue;
+        }
+        uint32_t home = player.get_colonized_planets()[0].get_id();
+        if (player.get_ship_designs().empty()) {
+            (void)player.create_ship_design("Warship", SHIP_FIGHTER, 1, 1, 1, 1, 1);
+        }
+        if (player.get_fleets().size() < 6 && !player.get_ship_designs().empty()) {
+            (void)player.create_fleet(player.get_ship_designs()[0].id, 5 + static_cast<uint32_t>(lcg % 20), home);
+        }
+
+        std::vector<uint32_t> fleet_ids;
+        for (const Fleet& fleet : player.get_fleets()) {
+            if (!fleet.is_in_transit()) {
+                fleet_ids.push_back(fleet.id);
+            }
+        }
+        for (uint32_t fleet_id : fleet_ids) {
+            lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+            PlanetNeighbourGraph::NeighbourRange neighbours = galaxy.neighbour_graph.get_neighbours(
+                player.get_fleet(fleet_id)->current_planet->id);
+            if (neighbours.count == 0) {
+                continue;
+            }
+            uint32_t destination = neighbours.ids[(lcg >> 33) % std::min<uint32_t>(neighbours.count, 6)];
+            (void)game.move_fleet(player.id, fleet_id, destination);
+            (void)game.refuel_fleet(player.id, fleet_id);
+        }
+    }
+}
+
+// Issue orders and process a number of turns
+inline void play(GameState& game, uint32_t turns, uint64_t& lcg) {
+    for (uint32_t turn = 0; turn < turns; ++turn) {
+        issue_orders(game, lcg);
+        game.process_turn();
+    }
+}
+
+#endif // OPENHO_BENCH_COMMON_H
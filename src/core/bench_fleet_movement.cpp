@@ -0,0 +1,114 @@
+// Fleet movement benchmark
+// Issues 100,000 move orders and measures the cost of order issue and arrival processing.
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -Iinclude bench_fleet_movement.cpp _gate_build/libOpenHoCore.a -o bench_fleet_movement
+//   cd ../.. && src/core/bench_fleet_movement
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+
+int main() {
+    std::cout << "=== Fleet Movement Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 4;
+    const uint32_t fleets_per_player = 250;
+    const uint32_t total_orders = 100000;
+
+    try {
+        GalaxyGenerationParams params(n_planets, n_players, 0.5, GALAXY_RANDOM, 12345);
+
+        std::vector<PlayerSetup> setups;
+        for (uint32_t i = 0; i < n_players; ++i) {
+            PlayerSetup setup;
+            setup.name = "Player " + std::to_string(i + 1);
+            setup.player_gender = GENDER_F;
+            setup.type = PLAYER_HUMAN;
+            setup.ai_iq = 0;
+            setup.starting_colony_quality = START_NORMAL;
+            setups.push_back(setup);
+        }
+
+        GameSetup game_setup(params, setups);
+        GameState game(game_setup);
+
+        // Build fleets at each player's home planet
+        std::vector<std::vector<uint32_t>> fleet_ids(n_players);
+        for (uint32_t p = 0; p < n_players; ++p) {
+            Player& player = game.get_players()[p];
+            uint32_t design_id = player.create_ship_design("Scout", SHIP_SCOUT, 1000, 1, 1, 1, 1);
+            uint32_t home_id = player.get_colonized_planets().front().get_id();
+            for (uint32_t f = 0; f < fleets_per_player; ++f) {
+                fleet_ids[p].push_back(player.create_fleet(design_id, 1, home_id));
+            }
+        }
+
+        const uint32_t planet_count = static_cast<uint32_t>(game.get_galaxy().planets.size());
+        uint32_t orders_issued = 0;
+        uint32_t turns_processed = 0;
+        double order_seconds = 0.0;
+        double arrival_seconds = 0.0;
+        uint32_t round = 0;
+
+        while (orders_issued < total_orders) {
+            // Top up fuel so every order is a legal single hop (not timed)
+            for (uint32_t p = 0; p < n_players; ++p) {
+                for (uint32_t f = 0; f < fleets_per_player; ++f) {
+                    (void)game.refuel_fleet(game.get_players()[p].id, fleet_ids[p][f]);
+                }
+            }
+
+            // Issue one move order per docked fleet
+            auto order_start = std::chrono::steady_clock::now();
+            for (uint32_t p = 0; p < n_players && orders_issued < total_orders; ++p) {
+                Player& player = game.get_players()[p];
+                for (uint32_t f = 0; f < fleets_per_player && orders_issued < total_orders; ++f) {
+                    uint32_t dest_id = 1 + (f * 7919 + round * 104729 + p * 31) % planet_count;
+                    player.move_fleet(fleet_ids[p][f], dest_id);
+                    orders_issued++;
+                }
+            }
+            auto order_end = std::chrono::steady_clock::now();
+            order_seconds += std::chrono::duration<double>(order_end - order_start).count();
+
+            // Advance turns until every fleet has arrived
+            auto arrival_start = std::chrono::steady_clock::now();
+            bool any_in_transit = true;
+            while (any_in_transit) {
+                game.process_turn();
+                turns_processed++;
+                any_in_transit = false;
+                for (const Player& player : game.get_players()) {
+                    if (!player.get_fleets_in_transit().empty()) {
+                        any_in_transit = true;
+                        break;
+                    }
+                }
+            }
+            auto arrival_end = std::chrono::steady_clock::now();
+            arrival_seconds += std::chrono::duration<double>(arrival_end - arrival_start).count();
+            round++;
+        }
+
+        std::cout << "Planets:            " << planet_count << std::endl;
+        std::cout << "Fleets:             " << n_players * fleets_per_player << std::endl;
+        std::cout << "Move orders issued: " << orders_issued << std::endl;
+        std::cout << "Turns processed:    " << turns_processed << std::endl;
+        std::cout << "Order issue time:   " << order_seconds * 1000.0 << " ms ("
+                  << order_seconds * 1e9 / orders_issued << " ns/order)" << std::endl;
+        std::cout << "Turn processing:    " << arrival_seconds * 1000.0 << " ms" << std::endl;
+        std::cout << "Stationed fleets:   " << game.get_fleet_occupancy().get_fleet_count() << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+// Archive mapping benchmark
+// Plays a 500-planet, 20-player game for 300 turns, writes it as a read-only archive,
+// then times opening the archive with MappedGameArchive against deserialize_state() of
+// a full save, and checks that:
+//   - planets, players, colonies, knowledge, visibility and history read through the
+//     views match the game
+//   - damaged archives (truncated, wrong magic, other byte order) are rejected
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -Iinclude bench_game_archive.cpp _gate_build/libOpenHoCore.a -o bench_game_archive
+//   cd ../.. && src/core/bench_game_archive
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/game_snapshot.h"
+#include "include/game_archive.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "bench_common.h"
+
+static bool write_file(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+// Everything read through the views matches the snapshot it was written from
+static bool matches(const GameArchiveView& view, const GameSnapshot& s) {
+    if (view.get_meta().current_turn != s.current_turn || view.get_planets().size() != s.planets.size()
+        || view.get_players().size() != s.players.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < s.planets.size(); ++i) {
+        const ArchivePlanet& planet = view.get_planets()[i];
+        if (planet.id != s.planets[i].id || planet.owner != s.planets[i].owner
+            || planet.population != s.planets[i].population || planet.x != s.planets[i].x
+            || view.get_string(planet.name) != s.planets[i].name) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < s.players.size(); ++i) {
+        const PlayerRecord& p = s.players[i];
+        const ArchivePlayer& player = view.get_players()[i];
+        if (player.id != p.id || view.get_string(player.name) != p.name || player.money_savings != p.money_savings
+            || view.get_colonies(i).size() != p.colonies.size() || view.get_known_planets(i).size() != p.known_planets.size()
+            || !std::equal(p.visible_planet_words.begin(), p.visible_planet_words.end(),
+                           view.get_visible_planet_words(i).begin(), view.get_visible_planet_words(i).end())) {
+            return false;
+        }
+        for (size_t k = 0; k < p.known_planets.size(); ++k) {
+            const ArchiveKnownPlanet& known = view.get_known_planets(i)[k];
+            if (known.id != p.known_planets[k].id || known.apparent_owner != p.known_planets[k].apparent_owner
+                || known.observation_year != p.known_planets[k].observation_year) {
+                return false;
+            }
+        }
+        for (size_t c = 0; c < p.colonies.size(); ++c) {
+            if (view.get_colonies(i)[c].planet_id != p.colonies[c].planet_id
+                || view.get_colonies(i)[c].population != p.colonies[c].population) {
+                return false;
+            }
+        }
+    }
+    const PlayerHistoryStore& history = s.history;
+    if (view.get_history_info().row_count != history.get_row_count()
+        || !std::equal(history.get_years().begin(), history.get_years().end(),
+                       view.get_history_years().begin(), view.get_history_years().end())) {
+        return false;
+    }
+    for (size_t player = 0; player < history.get_player_count(); ++player) {
+        for (uint32_t metric = 0; metric < METRIC_COUNT; ++metric) {
+            MetricSpan expected = history.get_metric(player, static_cast<PlayerMetric>(metric));
+            MetricSpan actual = view.get_metric(player, static_cast<PlayerMetric>(metric));
+            if (actual.first_turn != expected.first_turn
+                || !std::equal(expected.begin(), expected.end(), actual.begin(), actual.end())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Archive Mapping Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 20;
+    const uint32_t n_turns = 300;
+    const uint32_t open_repetitions = 1000;
+    const uint32_t load_repetitions = 20;
+    const std::string path = "bench_game_archive.ohar";
+    const std::string damaged_path = "bench_game_archive_damaged.ohar";
+    bool ok = true;
+
+    try {
+        GameSetup setup = make_setup(n_planets, n_players);
+        GameState game(setup);
+        for (uint32_t i = 1; i <= n_players; ++i) {
+            (void)game.set_player_alliance(i, i <= 4 ? 1 : (i <= 8 ? 2 : GameState::NO_ALLIANCE));
+        }
+        uint64_t lcg = 1;
+        for (uint32_t turn = 0; turn < n_turns; ++turn) {
+            issue_orders(game, lcg);
+            game.process_turn();
+        }
+
+        GameSnapshot snapshot;
+        game.capture_snapshot(snapshot);
+        if (!save_game_archive(game, path)) {
+            std::cout << "Could not write " << path << std::endl;
+            return 1;
+        }
+        std::vector<uint8_t> archive;
+        write_game_archive(snapshot, archive);
+
+        // Open (map + check) and run a small analysis: peak fleet power over the whole history
+        int64_t peak_power = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < open_repetitions; ++i) {
+            MappedGameArchive mapped;
+            if (!mapped.open(path)) {
+                std::cout << "Open failed" << std::endl;
+                return 1;
+            }
+            const GameArchiveView& view = mapped.get_view();
+            for (size_t player = 0; player < view.get_history_info().player_count; ++player) {
+                for (int64_t value : view.get_metric(player, METRIC_SHIP_POWER)) {
+                    peak_power = std::max(peak_power, value);
+                }
+            }
+        }
+        double open_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / open_repetitions;
+
+        // Open alone
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < open_repetitions; ++i) {
+            MappedGameArchive mapped;
+            (void)mapped.open(path);
+        }
+        double map_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / open_repetitions;
+
+        // Full load for comparison
+        std::vector<uint8_t> saved = game.serialize_state();
+        GameState loaded(setup);
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < load_repetitions; ++i) {
+            (void)loaded.deserialize_state(saved);
+        }
+        double load_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / load_repetitions;
+
+        MappedGameArchive mapped;
+        bool views_match = mapped.open(path) && matches(mapped.get_view(), snapshot);
+        mapped.close();
+
+        // Damaged archives
+        uint32_t rejected = 0;
+        uint32_t attempts = 0;
+        for (size_t cut = 1; cut < archive.size(); cut += archive.size() / 97 + 1) {
+            std::vector<uint8_t> truncated(archive.begin(), archive.begin() + cut);
+            attempts++;
+            rejected += write_file(damaged_path, truncated) && !mapped.open(damaged_path) ? 1 : 0;
+        }
+        std::vector<uint8_t> bad_magic = archive;
+        bad_magic[0] ^= 0xFF;
+        std::vector<uint8_t> other_order = archive;
+        std::reverse(other_order.begin() + offsetof(ArchiveHeader, byte_order),
+                     other_order.begin() + offsetof(ArchiveHeader, byte_order) + 4);
+        std::vector<uint8_t> bad_range = archive;
+        reinterpret_cast<ArchiveSection*>(bad_range.data() + sizeof(ArchiveHeader))[4].offset += 4;
+        for (const std::vector<uint8_t>* damaged : { &bad_magic, &other_order, &bad_range }) {
+            attempts++;
+            rejected += write_file(damaged_path, *damaged) && !mapped.open(damaged_path) ? 1 : 0;
+        }
+        std::remove(damaged_path.c_str());
+        std::remove(path.c_str());
+
+        std::cout << "Planets:                  " << n_planets << std::endl;
+        std::cout << "Players:                  " << n_players << std::endl;
+        std::cout << "Turn:                     " << n_turns << std::endl;
+        std::cout << "Archive size:             " << archive.size() << " bytes (full save " << saved.size() << ")" << std::endl;
+        std::cout << "Map and check:            " << map_us << " us" << std::endl;
+        std::cout << "Map and scan history:     " << open_us << " us (peak fleet power " << peak_power << ")" << std::endl;
+        std::cout << "Full load:                " << load_us << " us" << std::endl;
+        std::cout << "Views match the game:     " << (views_match ? "yes" : "NO") << std::endl;
+        std::cout << "Damaged archives rejected: " << rejected << "/" << attempts << std::endl;
+
+        ok = views_match && rejected == attempts;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
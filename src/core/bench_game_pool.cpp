@@ -0,0 +1,149 @@
+// Game pool hibernation benchmark
+// Hosts twelve 500-planet, 20-player games in a GamePool with a budget of about four
+// resident games, visits them in a skewed order, and checks that:
+//   - resident games stay within the memory budget, the least recently used hibernating
+//   - a hibernated game resumes to the same state, and plays on exactly like a copy that
+//     never hibernated
+//   - resuming (straight from the save, no galaxy generated) stays in the tens of milliseconds
+//   - games with a command journal or autosave attached are never hibernated
+//   - a leased game is never hibernated or removed until its lease is released
+// Reports the estimated footprint of a resident game against its hibernated save, and
+// the process's resident memory with every game resident and with all but one hibernated.
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -pthread -Iinclude bench_game_pool.cpp _gate_build/libOpenHoCore.a -o bench_game_pool
+//   cd ../.. && src/core/bench_game_pool
+//   (Linux only for the resident memory figures)
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <malloc.h>
+#include <unistd.h>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/game_pool.h"
+#include "include/command_journal.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "bench_common.h"
+
+static double resident_mb() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t resident = 0;
+    statm >> pages >> resident;
+    return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+int main() {
+    std::cout << "=== Game Pool Hibernation Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 20;
+    const uint32_t n_games = 12;
+    const uint32_t warmup_turns = 100;
+    const uint32_t visits = 120;
+    bool ok = true;
+
+    try {
+        GameSetup setup = make_setup(n_planets, n_players);
+        GamePool pool;
+        std::vector<GamePool::GameId> ids;
+        std::vector<uint64_t> lcgs(n_games, 1);
+        for (uint32_t i = 0; i < n_games; ++i) {
+            auto game = std::make_unique<GameState>(setup);
+            lcgs[i] = i + 1;
+            play(*game, warmup_turns, lcgs[i]);
+            ids.push_back(pool.add(std::move(game)));
+        }
+        GamePool::Stats all_resident = pool.get_stats();
+        double all_resident_mb = resident_mb();
+
+        // Twin of game 0 that never hibernates
+        std::vector<uint8_t> saved = pool.acquire(ids[0])->serialize_state();
+        GameState twin(setup);
+        bool twin_ok = twin.deserialize_state(saved);
+        uint64_t twin_lcg = lcgs[0];
+
+        // Compact everything but the game acquired last
+        pool.set_memory_budget(1);
+        malloc_trim(0);
+        GamePool::Stats compacted = pool.get_stats();
+        double compacted_mb = resident_mb();
+
+        // Skewed visits under a budget of about four games: game 0 often, the rest in turn
+        size_t per_game = all_resident.resident_bytes / n_games;
+        pool.set_memory_budget(4 * per_game + per_game / 2);
+        size_t worst_resident = 0;
+        bool state_kept = true;
+        for (uint32_t visit = 0; visit < visits; ++visit) {
+            uint32_t index = (visit % 3 == 0) ? 0 : 1 + (visit * 7) % (n_games - 1);
+            GamePool::Lease game = pool.acquire(ids[index]);
+            if (!game) {
+                state_kept = false;
+                break;
+            }
+            play(*game, 1, lcgs[index]);
+            if (index == 0) {
+                play(twin, 1, twin_lcg);
+                state_kept = game->serialize_state() == twin.serialize_state() && state_kept;
+            }
+            worst_resident = std::max(worst_resident, pool.get_stats().resident_bytes);
+        }
+        GamePool::Stats visited = pool.get_stats();
+        bool plays_on = twin_ok && state_kept && pool.acquire(ids[0])->serialize_state() == twin.serialize_state();
+        bool within_budget = visited.resident_bytes <= pool.get_memory_budget() + per_game && visited.hibernations > n_games;
+
+        // Attached games stay resident (once the lease is released, only the journal holds it)
+        CommandJournal journal;
+        GamePool::Lease lease = pool.acquire(ids[1]);
+        GameState* watched = lease.get();
+        journal.start(*watched);
+        lease.release();
+        (void)pool.acquire(ids[2]);
+        pool.set_memory_budget(1);
+        bool attached_kept = !pool.is_hibernated(ids[1]) && !pool.hibernate(ids[1]);
+        watched->set_command_journal(nullptr);
+        attached_kept = attached_kept && pool.hibernate(ids[1]);
+
+        // Leased games stay resident whatever the budget, and cannot be removed
+        GamePool::Lease held = pool.acquire(ids[3]);
+        GameState* held_game = held.get();
+        (void)pool.acquire(ids[4]);
+        bool leased_kept = pool.enforce_budget() == 0 && !pool.is_hibernated(ids[3]) && !pool.hibernate(ids[3])
+                        && !pool.remove(ids[3]) && held_game->serialize_state() == held->serialize_state();
+        GamePool::Lease moved = std::move(held);
+        leased_kept = leased_kept && !held && !pool.hibernate(ids[3]);
+        moved.release();
+        leased_kept = leased_kept && pool.hibernate(ids[3]);
+
+        std::cout << "Games:                    " << n_games << " (" << n_planets << " planets, " << n_players
+                  << " players, " << warmup_turns << " turns)" << std::endl;
+        std::cout << "Resident game (estimate): " << per_game / 1024 << " KiB" << std::endl;
+        std::cout << "Hibernated game (save):   " << compacted.hibernated_bytes / std::max<size_t>(compacted.hibernated_games, 1) / 1024
+                  << " KiB" << std::endl;
+        std::cout << "Process memory:           " << all_resident_mb << " MiB all resident, " << compacted_mb
+                  << " MiB with " << compacted.hibernated_games << " hibernated" << std::endl;
+        std::cout << "Visits:                   " << visits << " (" << visited.resumes << " resumes, "
+                  << visited.hibernations << " hibernations)" << std::endl;
+        std::cout << "Resume:                   " << visited.max_resume_ms << " ms max" << std::endl;
+        std::cout << "Peak resident (estimate): " << worst_resident / 1024 << " KiB (budget "
+                  << (4 * per_game + per_game / 2) / 1024 << " KiB)" << std::endl;
+        std::cout << "Resumed game plays on:    " << (plays_on ? "yes" : "NO") << std::endl;
+        std::cout << "Within budget:            " << (within_budget ? "yes" : "NO") << std::endl;
+        std::cout << "Attached games resident:  " << (attached_kept ? "yes" : "NO") << std::endl;
+        std::cout << "Leased games resident:    " << (leased_kept ? "yes" : "NO") << std::endl;
+
+        ok = plays_on && within_budget && attached_kept && leased_kept && visited.max_resume_ms < 100.0
+          && compacted.hibernated_games == n_games - 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+// RNG state benchmark
+// Compares the binary engine state (RNGStateFormat) with Boost's text form and checks that:
+//   - MersenneTwister64 produces the boost::random::mt19937_64 sequence for several seeds,
+//     raw and through the uniform and normal distributions
+//   - text states written by Boost (older saves) restore to the same sequence
+//   - binary states round trip at every position in the state, including mid-twist
+//   - damaged states are rejected and leave the engine unchanged
+//   - a saved game restores and plays on exactly like the original
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -Iinclude bench_rng_state.cpp _gate_build/libOpenHoCore.a -o bench_rng_state
+//   cd ../.. && src/core/bench_rng_state
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include "include/rng.h"
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "bench_common.h"
+
+// Same draws through both engines, raw and through every distribution DeterministicRNG uses
+static bool same_sequence(uint64_t seed, uint32_t draws) {
+    boost::random::mt19937_64 reference(seed);
+    MersenneTwister64 engine(seed);
+    boost::random::uniform_int_distribution<int32_t> ints(-1000, 1000);
+    boost::random::uniform_int_distribution<uint64_t> words(0, ~0ULL);
+    boost::random::uniform_real_distribution<double> reals(0.0, 1.0);
+    boost::random::normal_distribution<double> normals(50.0, 12.5);
+    for (uint32_t i = 0; i < draws; ++i) {
+        bool same = false;
+        switch (i % 5) {
+            case 0: same = reference() == engine(); break;
+            case 1: same = ints(reference) == ints(engine); break;
+            case 2: same = words(reference) == words(engine); break;
+            case 3: same = reals(reference) == reals(engine); break;
+            default: same = normals(reference) == normals(engine); break;
+        }
+        if (!same) {
+            std::cout << "Seed " << seed << " differs at draw " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool same_continuation(boost::random::mt19937_64& reference, MersenneTwister64& engine, uint32_t draws) {
+    for (uint32_t i = 0; i < draws; ++i) {
+        if (reference() != engine()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::vector<uint8_t> text_state(const boost::random::mt19937_64& engine) {
+    std::ostringstream oss;
+    oss << engine;
+    const std::string& str = oss.str();
+    return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+int main() {
+    std::cout << "=== RNG State Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t draws = 1000000;
+    const uint32_t repetitions = 20000;
+    bool ok = true;
+
+    try {
+        // Sequences
+        bool sequences = true;
+        for (uint64_t seed : { 0ULL, 1ULL, 5489ULL, 2024ULL, 0x8000000000000000ULL, ~0ULL }) {
+            sequences = same_sequence(seed, draws) && sequences;
+        }
+
+        // Text states from Boost, taken at several positions
+        bool text_ok = true;
+        for (uint32_t skip : { 0u, 1u, 311u, 312u, 313u, 1000u }) {
+            boost::random::mt19937_64 reference(77);
+            reference.discard(skip);
+            MersenneTwister64 engine;
+            std::vector<uint8_t> text = text_state(reference);
+            text_ok = text_ok && engine.read_state(text.data(), text.size()) && same_continuation(reference, engine, 5000);
+        }
+
+        // Binary round trip at every position in the state
+        bool binary_ok = true;
+        MersenneTwister64 source(99);
+        std::vector<uint8_t> binary(RNGStateFormat::SIZE);
+        for (uint32_t position = 0; position < 2 * RNGStateFormat::STATE_WORDS + 1 && binary_ok; ++position) {
+            source.write_state(binary.data());
+            MersenneTwister64 copy;
+            binary_ok = copy.read_state(binary.data(), binary.size()) && copy == source;
+            MersenneTwister64 ahead = source;
+            for (uint32_t i = 0; i < 1000 && binary_ok; ++i) {
+                binary_ok = ahead() == copy();
+            }
+            source();
+        }
+
+        // Damaged states
+        MersenneTwister64 engine(5);
+        engine.write_state(binary.data());
+        std::vector<uint8_t> short_binary(binary.begin(), binary.end() - 1);
+        std::vector<uint8_t> bad_version = binary;
+        bad_version[4] = 0xFF;
+        std::vector<uint8_t> bad_position = binary;
+        bad_position[9] = 0xFF;
+        std::vector<uint8_t> short_text = text_state(boost::random::mt19937_64(5));
+        short_text.resize(short_text.size() / 2);
+        std::vector<uint8_t> garbage(100, 'x');
+        std::vector<uint8_t> empty;
+        uint32_t rejected = 0;
+        uint32_t attempts = 0;
+        MersenneTwister64 target(6);
+        MersenneTwister64 target_before = target;
+        for (const std::vector<uint8_t>* damaged : { &short_binary, &bad_version, &bad_position, &short_text, &garbage, &empty }) {
+            attempts++;
+            rejected += !target.read_state(damaged->data(), damaged->size()) && target == target_before ? 1 : 0;
+        }
+
+        // Timing: Boost text form against the binary form
+        boost::random::mt19937_64 text_engine(42);
+        std::vector<uint8_t> text;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions / 20; ++i) {
+            text = text_state(text_engine);
+        }
+        double text_write_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / (repetitions / 20);
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions / 20; ++i) {
+            std::istringstream iss(std::string(text.begin(), text.end()));
+            iss >> text_engine;
+        }
+        double text_read_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / (repetitions / 20);
+
+        DeterministicRNG rng(42, 43);
+        std::vector<uint8_t> state;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions; ++i) {
+            state = rng.serialize_ai_rng_state();
+        }
+        double binary_write_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+        uint32_t restored = 0;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions; ++i) {
+            restored += rng.deserialize_ai_rng_state(state) ? 1 : 0;
+        }
+        double binary_read_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+        // Saved game plays on identically
+        GameSetup setup = make_setup(200, 8);
+        GameState game(setup);
+        for (uint32_t turn = 0; turn < 20; ++turn) {
+            game.process_turn();
+        }
+        std::vector<uint8_t> saved = game.serialize_state();
+        GameState loaded(setup);
+        bool game_ok = loaded.deserialize_state(saved);
+        for (uint32_t turn = 0; turn < 20 && game_ok; ++turn) {
+            game.process_turn();
+            loaded.process_turn();
+        }
+        game_ok = game_ok && game.serialize_state() == loaded.serialize_state();
+
+        std::cout << "State size:               " << state.size() << " bytes (exact size query "
+                  << DeterministicRNG::get_serialized_ai_rng_state_size() << ", text " << text.size() << ")" << std::endl;
+        std::cout << "Text write / read:        " << text_write_us << " / " << text_read_us << " us" << std::endl;
+        std::cout << "Binary write / read:      " << binary_write_us << " / " << binary_read_us << " us" << std::endl;
+        std::cout << "Save size:                " << saved.size() << " bytes" << std::endl;
+        std::cout << "Boost sequences match:    " << (sequences ? "yes" : "NO") << std::endl;
+        std::cout << "Boost text states load:   " << (text_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Binary states round trip: " << (binary_ok && restored == repetitions ? "yes" : "NO") << std::endl;
+        std::cout << "Damaged states rejected:  " << rejected << "/" << attempts << std::endl;
+        std::cout << "Loaded game plays on:     " << (game_ok ? "yes" : "NO") << std::endl;
+
+        ok = sequences && text_ok && binary_ok && restored == repetitions && rejected == attempts && game_ok
+            && state.size() == DeterministicRNG::get_serialized_ai_rng_state_size();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
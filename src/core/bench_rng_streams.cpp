@@ -0,0 +1,184 @@
+// Counter-based RNG stream benchmark
+// Compares RNGStream (Philox4x32-10) with mt19937_64 and checks that:
+//   - the Philox block matches the Random123 known-answer vectors
+//   - per-entity streams give the same numbers whatever the evaluation order or thread count
+//   - streams with different (turn, phase, entity) keys do not overlap, and another seed
+//     gives other streams
+//   - stream output is uniform (mean and bucket counts of nextDouble and nextUInt32Range)
+// Reports throughput of raw 64-bit draws and doubles for boost::random::mt19937_64,
+// MersenneTwister64, DeterministicRNG and RNGStream, and the cost of starting a fresh
+// stream per entity against seeding an mt19937_64 per entity.
+// Build from src/core (after building OpenHoCore):
+//   g++ -std=c++17 -O2 -pthread -Iinclude bench_rng_streams.cpp _gate_build/libOpenHoCore.a -o bench_rng_streams
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <boost/random/mersenne_twister.hpp>
+#include "include/rng.h"
+
+// Each entity draws a few numbers of its own, as a planet or fleet would in one phase
+static const uint32_t DRAWS_PER_ENTITY = 8;
+
+static void draw_entities(const DeterministicRNG& rng, uint32_t turn, uint32_t first, uint32_t end, uint32_t step,
+                          std::vector<uint64_t>& out) {
+    for (uint32_t entity = first; entity < end; entity += step) {
+        RNGStream stream = rng.stream(turn, RNG_PHASE_COMBAT, entity);
+        for (uint32_t i = 0; i < DRAWS_PER_ENTITY; ++i) {
+            out[static_cast<size_t>(entity) * DRAWS_PER_ENTITY + i] = stream();
+        }
+    }
+}
+
+// Fold every draw into a checksum so none can be optimised away
+static void fold(uint64_t& sink, uint64_t value) { sink ^= value; }
+static void fold(uint64_t& sink, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    sink ^= bits;
+}
+
+template <typename Draw>
+static double time_draws(uint64_t n, Draw draw, uint64_t& sink) {
+    double best = 1e9;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < n; ++i) {
+            fold(sink, draw());
+        }
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return static_cast<double>(n) / best / 1e6;
+}
+
+int main() {
+    std::cout << "=== Counter-based RNG Stream Benchmark ===" << std::endl << std::endl;
+
+    const uint64_t n_draws = 20000000;
+    const uint32_t n_entities = 200000;
+    bool ok = true;
+    uint64_t sink = 0;
+
+    // Random123 known-answer vectors for philox4x32, 10 rounds
+    const uint32_t kat_counters[3][4] = {
+        { 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+        { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF },
+        { 0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344 } };
+    const uint32_t kat_keys[3][2] = {
+        { 0x00000000, 0x00000000 },
+        { 0xFFFFFFFF, 0xFFFFFFFF },
+        { 0xA4093822, 0x299F31D0 } };
+    const uint32_t kat_outputs[3][4] = {
+        { 0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8 },
+        { 0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD },
+        { 0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1 } };
+    bool known_answers = true;
+    for (int v = 0; v < 3; ++v) {
+        uint32_t out[4];
+        RNGStream::philox_block(kat_counters[v], kat_keys[v], out);
+        known_answers = known_answers && std::equal(out, out + 4, kat_outputs[v]);
+    }
+
+    // Evaluation order and thread count
+    DeterministicRNG rng(2024, 2025);
+    std::vector<uint64_t> serial(static_cast<size_t>(n_entities) * DRAWS_PER_ENTITY);
+    draw_entities(rng, 7, 0, n_entities, 1, serial);
+
+    std::vector<uint64_t> reversed(serial.size());
+    for (uint32_t entity = n_entities; entity-- > 0; ) {
+        draw_entities(rng, 7, entity, entity + 1, 1, reversed);
+    }
+
+    // The shared engine moving on does not disturb the streams
+    for (int i = 0; i < 1000; ++i) {
+        (void)rng.nextUInt64();
+    }
+    bool order_free = serial == reversed;
+    for (uint32_t threads : { 2u, 4u, 8u }) {
+        std::vector<uint64_t> parallel(serial.size());
+        std::vector<std::thread> workers;
+        for (uint32_t t = 0; t < threads; ++t) {
+            workers.emplace_back(draw_entities, std::cref(rng), 7, t, n_entities, threads, std::ref(parallel));
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        order_free = order_free && parallel == serial;
+    }
+
+    // Distinct keys: first draws of many streams across turns, phases and entities
+    std::vector<uint64_t> firsts;
+    for (uint32_t turn = 0; turn < 20; ++turn) {
+        for (uint32_t phase = 0; phase < 5; ++phase) {
+            for (uint32_t entity = 0; entity < 1000; ++entity) {
+                firsts.push_back(rng.stream(turn, phase, entity)());
+            }
+        }
+    }
+    std::sort(firsts.begin(), firsts.end());
+    bool distinct = std::adjacent_find(firsts.begin(), firsts.end()) == firsts.end();
+    DeterministicRNG other_seed(2025, 2025);
+    distinct = distinct && other_seed.stream(7, RNG_PHASE_COMBAT, 0)() != serial[0];
+
+    // Uniformity
+    RNGStream uniform = rng.stream(1, RNG_PHASE_COMBAT, 1);
+    const uint32_t buckets = 16;
+    std::vector<uint64_t> counts(buckets, 0);
+    double sum = 0.0;
+    const uint64_t samples = 4000000;
+    for (uint64_t i = 0; i < samples; ++i) {
+        double value = uniform.nextDouble();
+        sum += value;
+        counts[uniform.nextUInt32Range(0, buckets - 1)]++;
+        ok = ok && value >= 0.0 && value < 1.0;
+    }
+    double mean = sum / static_cast<double>(samples);
+    double expected = static_cast<double>(samples) / buckets;
+    bool uniform_ok = ok && std::fabs(mean - 0.5) < 0.001;
+    for (uint64_t count : counts) {
+        uniform_ok = uniform_ok && std::fabs(static_cast<double>(count) - expected) < 0.01 * expected;
+    }
+
+    // Throughput (million draws per second)
+    boost::random::mt19937_64 boost_mt(2024);
+    MersenneTwister64 mt(2024);
+    DeterministicRNG det(2024, 2025);
+    RNGStream stream = det.stream(1, RNG_PHASE_COMBAT, 1);
+    double boost_u64 = time_draws(n_draws, [&boost_mt]() { return boost_mt(); }, sink);
+    double mt_u64 = time_draws(n_draws, [&mt]() { return mt(); }, sink);
+    double stream_u64 = time_draws(n_draws, [&stream]() { return stream(); }, sink);
+    double det_double = time_draws(n_draws, [&det]() { return det.nextDouble(); }, sink);
+    double stream_double = time_draws(n_draws, [&stream]() { return stream.nextDouble(); }, sink);
+
+    // A fresh stream per entity against a freshly seeded mt19937_64 per entity
+    const uint64_t n_fresh = 200000;
+    uint32_t entity = 0;
+    double fresh_stream = time_draws(n_fresh, [&det, &entity]() {
+        RNGStream s = det.stream(1, RNG_PHASE_COMBAT, entity++);
+        return s() ^ s() ^ s() ^ s();
+    }, sink);
+    double fresh_mt = time_draws(n_fresh, [&entity]() {
+        boost::random::mt19937_64 e(entity++);
+        return e() ^ e() ^ e() ^ e();
+    }, sink);
+
+    std::cout << "Draws timed:              " << n_draws << std::endl;
+    std::cout << "u64, boost mt19937_64:    " << boost_u64 << " M/s" << std::endl;
+    std::cout << "u64, MersenneTwister64:   " << mt_u64 << " M/s" << std::endl;
+    std::cout << "u64, RNGStream:           " << stream_u64 << " M/s" << std::endl;
+    std::cout << "double, DeterministicRNG: " << det_double << " M/s" << std::endl;
+    std::cout << "double, RNGStream:        " << stream_double << " M/s" << std::endl;
+    std::cout << "New stream + 4 draws:     " << fresh_stream << " M/s (seeded mt19937_64: " << fresh_mt << " M/s)" << std::endl;
+    std::cout << "Philox known answers:     " << (known_answers ? "yes" : "NO") << std::endl;
+    std::cout << "Order/thread independent: " << (order_free ? "yes" : "NO") << " (" << n_entities << " entities, 1-8 threads)" << std::endl;
+    std::cout << "Distinct streams:         " << (distinct ? "yes" : "NO") << std::endl;
+    std::cout << "Uniform:                  " << (uniform_ok ? "yes" : "NO") << " (mean " << mean << ")" << std::endl;
+    std::cout << "(checksum " << (sink & 0xFF) << ")" << std::endl;
+
+    ok = known_answers && order_free && distinct && uniform_ok;
+    return ok ? 0 : 1;
+}
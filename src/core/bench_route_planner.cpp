@@ -0,0 +1,247 @@
+// Route planner benchmark
+// Plans fleet routes on a 500-planet galaxy with 100 refuel planets and checks that:
+//   - every route found by RoutePlanner matches an exhaustive Dijkstra over (planet, fuel)
+//     states on the full distance matrix, in both turns and hops, for both route modes
+//   - a route is reported exactly when the exhaustive search finds one
+//   - the waypoints form a legal route: every hop within the fuel left, refuelling at
+//     refuel planets, and the reported turns, hops and fuel on arrival add up
+// Reports the time for 5000 queries at several ship ranges, from full-tank fleets at
+// refuel planets (the usual AI order) and from fleets part-way out with partial fuel:
+// the first batch includes building the planner's cached legs and route trees.
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -pthread -Iinclude bench_route_planner.cpp _gate_build/libOpenHoCore.a -o bench_route_planner
+//   cd ../.. && src/core/bench_route_planner
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <tuple>
+#include <chrono>
+#include <algorithm>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/galaxy.h"
+#include "include/knowledge_galaxy.h"
+#include "include/route_planner.h"
+#include "include/game_formulas.h"
+
+struct Cost {
+    uint32_t primary;
+    uint32_t secondary;
+    bool operator<(const Cost& other) const {
+        return std::tie(primary, secondary) < std::tie(other.primary, other.secondary);
+    }
+};
+
+// Lexicographic Dijkstra over (planet, fuel) states with every planet as a possible stop
+static bool exhaustive_search(const KnowledgeGalaxy& kg, const RouteQuery& query, const PlanetBitset& refuel,
+                              Cost& best) {
+    const uint32_t n = static_cast<uint32_t>(kg.get_planet_count());
+    const int32_t top = std::max(query.max_fuel, query.start_fuel);
+    const size_t fuels = static_cast<size_t>(top) + 1;
+    const bool by_turns = query.mode == ROUTE_FEWEST_TURNS;
+    std::vector<Cost> cost((static_cast<size_t>(n) + 1) * fuels, Cost{ UINT32_MAX, UINT32_MAX });
+    std::vector<uint8_t> done(cost.size(), 0);
+
+    typedef std::tuple<uint32_t, uint32_t, uint32_t, int32_t> Entry;  // primary, secondary, planet, fuel
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    int32_t start = query.start_fuel;
+    if (refuel.test(query.origin_planet_id)) {
+        start = std::max(start, query.max_fuel);
+    }
+    cost[query.origin_planet_id * fuels + start] = Cost{ 0, 0 };
+    open.emplace(0, 0, query.origin_planet_id, start);
+
+    while (!open.empty()) {
+        uint32_t primary, secondary, planet;
+        int32_t fuel;
+        std::tie(primary, secondary, planet, fuel) = open.top();
+        open.pop();
+        size_t state = planet * fuels + fuel;
+        if (done[state]) {
+            continue;
+        }
+        done[state] = 1;
+        if (planet == query.destination_planet_id) {
+            best = Cost{ primary, secondary };
+            return true;
+        }
+        for (uint32_t next = 1; next <= n; ++next) {
+            if (next == planet) {
+                continue;
+            }
+            double distance = kg.get_distance(planet, next);
+            int32_t fuel_cost = GameFormulas::calculate_fuel_cost(distance);
+            if (fuel_cost > fuel) {
+                continue;
+            }
+            uint32_t turns = GameFormulas::calculate_travel_turns(distance, query.ship_range);
+            int32_t left = fuel - fuel_cost;
+            if (refuel.test(next)) {
+                left = std::max(left, query.max_fuel);
+            }
+            Cost reached{ primary + (by_turns ? turns : 1), secondary + (by_turns ? 1 : turns) };
+            size_t next_state = next * fuels + left;
+            if (reached < cost[next_state]) {
+                cost[next_state] = reached;
+                open.emplace(reached.primary, reached.secondary, next, left);
+            }
+        }
+    }
+    return false;
+}
+
+// Walk the waypoints and check that the route is legal and its totals add up
+static bool route_is_legal(const KnowledgeGalaxy& kg, const RouteQuery& query, const PlanetBitset& refuel,
+                           const Route& route) {
+    if (route.waypoints.size() < 2 || route.waypoints.front() != query.origin_planet_id
+        || route.waypoints.back() != query.destination_planet_id) {
+        return false;
+    }
+    int32_t fuel = query.start_fuel;
+    if (refuel.test(query.origin_planet_id)) {
+        fuel = std::max(fuel, query.max_fuel);
+    }
+    uint32_t turns = 0;
+    for (size_t i = 1; i < route.waypoints.size(); ++i) {
+        double distance = kg.get_distance(route.waypoints[i - 1], route.waypoints[i]);
+        int32_t fuel_cost = GameFormulas::calculate_fuel_cost(distance);
+        if (fuel_cost > fuel) {
+            return false;
+        }
+        fuel -= fuel_cost;
+        if (refuel.test(route.waypoints[i])) {
+            fuel = std::max(fuel, query.max_fuel);
+        }
+        turns += GameFormulas::calculate_travel_turns(distance, query.ship_range);
+    }
+    return turns == route.total_turns && route.hops == route.waypoints.size() - 1 && fuel == route.fuel_on_arrival;
+}
+
+int main() {
+    std::cout << "=== Route Planner Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_refuel = 100;
+    const uint32_t n_checked = 150;
+    const uint32_t n_timed = 5000;
+    const int32_t ranges[] = { 10, 20, 40, 80 };
+    bool ok = true;
+
+    try {
+        GalaxyGenerationParams params(n_planets, 4, 0.5, GALAXY_RANDOM, 12345);
+        std::vector<PlayerSetup> setups(4);
+        for (uint32_t i = 0; i < setups.size(); ++i) {
+            setups[i].name = "Player " + std::to_string(i + 1);
+            setups[i].player_gender = GENDER_F;
+            setups[i].type = PLAYER_HUMAN;
+            setups[i].ai_iq = 0;
+            setups[i].starting_colony_quality = START_NORMAL;
+        }
+        GameState game(GameSetup(params, setups));
+        KnowledgeGalaxy kg(game.get_galaxy(), 1);
+        const uint32_t planet_count = static_cast<uint32_t>(kg.get_planet_count());
+
+        uint64_t lcg = 7;
+        auto next_random = [&lcg](uint32_t bound) {
+            lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<uint32_t>((lcg >> 33) % bound);
+        };
+
+        PlanetBitset refuel(planet_count + 1);
+        std::vector<uint32_t> refuel_ids;
+        while (refuel_ids.size() < n_refuel) {
+            uint32_t id = 1 + next_random(planet_count);
+            if (!refuel.test(id)) {
+                refuel.set(id);
+                refuel_ids.push_back(id);
+            }
+        }
+
+        RoutePlanner planner;
+        Route route;
+        uint32_t checked = 0;
+        uint32_t found = 0;
+        uint32_t mismatches = 0;
+        std::cout << "Planets:              " << planet_count << " (" << n_refuel << " refuel planets)" << std::endl;
+
+        for (int32_t range : ranges) {
+            // Cross-check against the exhaustive search, both modes, half from refuel planets
+            for (uint32_t i = 0; i < n_checked; ++i) {
+                RouteQuery query;
+                query.origin_planet_id = (i % 2) ? refuel_ids[next_random(n_refuel)] : 1 + next_random(planet_count);
+                query.destination_planet_id = 1 + next_random(planet_count);
+                query.max_fuel = range;
+                query.start_fuel = static_cast<int32_t>(next_random(static_cast<uint32_t>(range) + 1));
+                if (i % 8 == 7) {
+                    query.start_fuel = range + range / 2;    // More than a tank
+                }
+                query.ship_range = range;
+                query.mode = (i % 4 < 2) ? ROUTE_FEWEST_TURNS : ROUTE_FEWEST_HOPS;
+                if (query.origin_planet_id == query.destination_planet_id) {
+                    continue;
+                }
+                Cost best{ 0, 0 };
+                bool exists = exhaustive_search(kg, query, refuel, best);
+                bool planned = planner.plan(kg, query, refuel, route);
+                bool by_turns = query.mode == ROUTE_FEWEST_TURNS;
+                bool same = exists == planned;
+                if (same && planned) {
+                    same = route_is_legal(kg, query, refuel, route)
+                        && (by_turns ? route.total_turns : route.hops) == best.primary
+                        && (by_turns ? route.hops : route.total_turns) == best.secondary;
+                }
+                mismatches += same ? 0 : 1;
+                found += planned ? 1 : 0;
+                checked++;
+            }
+
+            // Timing: full tanks at refuel planets, then partial fuel anywhere
+            std::vector<RouteQuery> docked(n_timed);
+            std::vector<RouteQuery> partial(n_timed);
+            for (uint32_t i = 0; i < n_timed; ++i) {
+                RouteQuery query;
+                query.origin_planet_id = refuel_ids[next_random(n_refuel)];
+                query.destination_planet_id = 1 + next_random(planet_count);
+                query.max_fuel = range;
+                query.start_fuel = range;
+                query.ship_range = range;
+                query.mode = (i % 2) ? ROUTE_FEWEST_TURNS : ROUTE_FEWEST_HOPS;
+                docked[i] = query;
+                query.origin_planet_id = 1 + next_random(planet_count);
+                query.start_fuel = static_cast<int32_t>(next_random(static_cast<uint32_t>(range) + 1));
+                partial[i] = query;
+            }
+            // First batch builds the hub networks and route trees, the second reuses them
+            uint32_t routes = 0;
+            double ms[2][2];
+            planner.clear_cache();
+            for (int batch = 0; batch < 2; ++batch) {
+                for (int kind = 0; kind < 2; ++kind) {
+                    const std::vector<RouteQuery>& queries = kind ? partial : docked;
+                    auto start = std::chrono::steady_clock::now();
+                    for (const RouteQuery& query : queries) {
+                        routes += planner.plan(kg, query, refuel, route) ? 1 : 0;
+                    }
+                    ms[kind][batch] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                }
+            }
+            std::cout << "Range " << range << ":" << std::string(range < 100 ? 12 : 11, ' ') << "docked "
+                      << ms[0][0] << " ms first, " << ms[0][1] << " ms again; partial fuel " << ms[1][0]
+                      << " ms first, " << ms[1][1] << " ms again (" << routes / 2 << " of " << 2 * n_timed
+                      << " found)" << std::endl;
+        }
+
+        std::cout << "Cross-checked queries: " << checked << " (" << found << " with a route)" << std::endl;
+        std::cout << "Match exhaustive:      " << (mismatches == 0 ? "yes" : "NO") << " (" << mismatches
+                  << " mismatches)" << std::endl;
+        ok = mismatches == 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// Incremental save benchmark
+// Plays a 500-planet, 20-player game for 200 turns (fleets moving and fighting, two alliances),
+// checkpointing every turn into a SaveChain (a keyframe every 10 turns, deltas in between), and
+// compares entry sizes and times with a full save per turn.  Checks that:
+//   - every checkpointed turn rebuilds to exactly the full save of that turn
+//   - compaction keeps every later turn intact
+//   - a chain written to bytes reads back, continues with deltas, and loads into a game
+//   - truncated chains are rejected
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -Iinclude bench_save_chain.cpp _gate_build/libOpenHoCore.a -o bench_save_chain
+//   cd ../.. && src/core/bench_save_chain
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/game_snapshot.h"
+#include "include/save_chain.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "bench_common.h"
+
+static std::vector<uint8_t> encode(const GameSnapshot& snapshot) {
+    std::vector<uint8_t> bytes;
+    encode_game_snapshot(snapshot, bytes);
+    return bytes;
+}
+
+// Every turn from first_turn on rebuilds to its full save
+static bool check_turns(const SaveChain& chain, const std::vector<std::vector<uint8_t>>& full_saves, uint32_t first_turn) {
+    for (uint32_t turn = first_turn; turn < full_saves.size(); ++turn) {
+        GameSnapshot snapshot;
+        if (!chain.reconstruct(turn, snapshot) || encode(snapshot) != full_saves[turn]) {
+            std::cout << "Turn " << turn << " does not rebuild" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Incremental Save Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 20;
+    const uint32_t n_turns = 200;
+    const uint32_t keyframe_interval = 10;
+    const uint32_t compact_turn = 150;
+    bool ok = true;
+
+    try {
+        GameSetup setup = make_setup(n_planets, n_players);
+        GameState game(setup);
+        for (uint32_t i = 1; i <= n_players; ++i) {
+            (void)game.set_player_alliance(i, i <= 4 ? 1 : (i <= 8 ? 2 : GameState::NO_ALLIANCE));
+        }
+
+        SaveChain chain(keyframe_interval);
+        std::vector<std::vector<uint8_t>> full_saves;
+        double full_ms = 0.0;
+        double checkpoint_ms = 0.0;
+        size_t full_bytes = 0;
+        size_t delta_bytes = 0;
+        size_t keyframe_bytes = 0;
+        size_t deltas = 0;
+        size_t keyframes = 0;
+
+        uint64_t lcg = 1;
+        for (uint32_t turn = 0; turn < n_turns; ++turn) {
+            auto start = std::chrono::steady_clock::now();
+            full_saves.push_back(game.serialize_state());
+            full_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            full_bytes += full_saves.back().size();
+
+            start = std::chrono::steady_clock::now();
+            size_t entry_bytes = chain.checkpoint(game);
+            checkpoint_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (chain.get_entries().back().keyframe) {
+                keyframe_bytes += entry_bytes;
+                keyframes++;
+            } else {
+                delta_bytes += entry_bytes;
+                deltas++;
+            }
+
+            issue_orders(game, lcg);
+            game.process_turn();
+        }
+
+        // Rebuild every turn
+        auto start = std::chrono::steady_clock::now();
+        bool rebuilt = check_turns(chain, full_saves, 0);
+        double rebuild_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / n_turns;
+
+        // Compaction folds the start of the chain into one keyframe
+        size_t before_compaction = chain.get_total_bytes();
+        bool compacted = chain.compact(compact_turn) && chain.get_entries().front().turn == compact_turn
+                      && check_turns(chain, full_saves, compact_turn);
+        GameSnapshot dropped;
+        compacted = compacted && !chain.reconstruct(compact_turn - 1, dropped);
+
+        // Chain file: read back, continue with a delta, load into a game
+        std::vector<uint8_t> file;
+        chain.write(file);
+        SaveChain reread(keyframe_interval);
+        bool file_ok = reread.read(file.data(), file.size()) && check_turns(reread, full_saves, compact_turn);
+
+        full_saves.push_back(game.serialize_state());
+        (void)chain.checkpoint(game);
+        (void)reread.checkpoint(game);
+        std::vector<uint8_t> appended;
+        chain.write_entry(chain.get_entries().size() - 1, appended);
+        std::vector<uint8_t> appended_reread;
+        reread.write_entry(reread.get_entries().size() - 1, appended_reread);
+        file_ok = file_ok && appended == appended_reread && !reread.get_entries().back().keyframe;
+
+        GameState loaded(setup);
+        file_ok = file_ok && reread.load(n_turns, loaded) && loaded.serialize_state() == full_saves.back();
+
+        // Chains cut inside an entry are rejected and leave the chain as it was
+        // (a cut between entries is a valid shorter chain, as after an interrupted append)
+        std::vector<size_t> boundaries;
+        size_t offset = DeltaFormat::CHAIN_HEADER_SIZE;
+        for (const SaveChain::Entry& entry : chain.get_entries()) {
+            offset += DeltaFormat::ENTRY_HEADER_SIZE + entry.data.size();
+            boundaries.push_back(offset);
+        }
+        std::vector<uint8_t> before;
+        reread.write(before);
+        uint32_t rejected = 0;
+        uint32_t attempts = 0;
+        for (size_t cut = DeltaFormat::CHAIN_HEADER_SIZE + 1; cut < file.size(); cut += file.size() / 97 + 1) {
+            if (std::find(boundaries.begin(), boundaries.end(), cut) != boundaries.end()) {
+                continue;
+            }
+            std::vector<uint8_t> truncated(file.begin(), file.begin() + cut);
+            attempts++;
+            rejected += reread.read(truncated.data(), truncated.size()) ? 0 : 1;
+        }
+        std::vector<uint8_t> after;
+        reread.write(after);
+        bool untouched = before == after;
+
+        std::cout << "Planets:                 " << n_planets << std::endl;
+        std::cout << "Players:                 " << n_players << std::endl;
+        std::cout << "Turns:                   " << n_turns << std::endl;
+        std::cout << "Full save:               " << full_bytes / n_turns << " bytes/turn, "
+                  << full_ms / n_turns << " ms" << std::endl;
+        std::cout << "Keyframe:                " << keyframe_bytes / std::max<size_t>(keyframes, 1) << " bytes ("
+                  << keyframes << ")" << std::endl;
+        std::cout << "Delta:                   " << delta_bytes / std::max<size_t>(deltas, 1) << " bytes ("
+                  << deltas << ")" << std::endl;
+        std::cout << "Checkpoint:              " << (keyframe_bytes + delta_bytes) / n_turns << " bytes/turn, "
+                  << checkpoint_ms / n_turns << " ms" << std::endl;
+        std::cout << "Chain vs full saves:     " << (keyframe_bytes + delta_bytes) * 100 / full_bytes << "%" << std::endl;
+        std::cout << "Rebuild:                 " << rebuild_ms << " ms/turn" << std::endl;
+        std::cout << "Every turn rebuilds:     " << (rebuilt ? "yes" : "NO") << std::endl;
+        std::cout << "Compaction:              " << (compacted ? "yes" : "NO") << " (" << before_compaction
+                  << " -> " << chain.get_total_bytes() - chain.get_entries().back().data.size() << " bytes)" << std::endl;
+        std::cout << "Chain file round trip:   " << (file_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Cut chains rejected:     " << rejected << "/" << attempts << (untouched ? "" : " (CHAIN CHANGED)") << std::endl;
+
+        ok = rebuilt && compacted && file_ok && rejected == attempts && untouched;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// Seed-only map benchmark
+// Checks that galaxy generation is reproducible from GalaxyGenerationParams, then
+// compares full saves against seed-only map saves (params plus post-generation delta):
+//   - two games created from the same setup are identical, for every galaxy shape, and
+//     other seeds give other maps
+//   - a zero seed is replaced by a random one that recreates the same game
+//   - after play (mining, terraforming, colonisation), a seed-only map save loads into a
+//     game identical to one loaded from the full save
+//   - a map whose hash or generator version does not match is refused, game unchanged
+// Reports both save sizes and the cost of regenerating the galaxy on load.
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -pthread -Iinclude bench_seed_map.cpp _gate_build/libOpenHoCore.a -o bench_seed_map
+//   cd ../.. && src/core/bench_seed_map
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/serialization.h"
+#include "include/game_snapshot.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "bench_common.h"
+
+// Offset of a section's payload in a save (0 if absent)
+static size_t find_section(const std::vector<uint8_t>& save, uint32_t tag) {
+    ByteReader r(save.data(), save.size());
+    r.get_u32();
+    r.get_u16();
+    r.get_u16();
+    uint32_t count = r.get_u32();
+    size_t offset = SaveFormat::HEADER_SIZE;
+    for (uint32_t i = 0; i < count && r.ok(); ++i) {
+        uint32_t section_tag = r.get_u32();
+        uint32_t length = r.get_u32();
+        offset += SaveFormat::SECTION_HEADER_SIZE;
+        if (section_tag == tag) {
+            return offset;
+        }
+        r.get_bytes(length);
+        offset += length;
+    }
+    return 0;
+}
+
+int main() {
+    std::cout << "=== Seed-only Map Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 20;
+    const uint32_t n_turns = 100;
+    bool ok = true;
+
+    try {
+        // Every shape regenerates, and round-trips a seed-only map after some play
+        bool shapes_ok = true;
+        const GalaxyShape shapes[] = { GALAXY_RANDOM, GALAXY_SPIRAL, GALAXY_CIRCLE, GALAXY_RING, GALAXY_CLUSTER, GALAXY_GRID };
+        for (GalaxyShape shape : shapes) {
+            GameSetup shape_setup = make_setup(200, 8, shape, 77 + shape);
+            GameState first(shape_setup);
+            GameState second(shape_setup);
+            bool same = first.serialize_state() == second.serialize_state();
+            uint64_t lcg = 1;
+            play(first, 20, lcg);
+            std::vector<uint8_t> map_save = first.serialize_state_seed_map();
+            GameState loaded(shape_setup);
+            bool loads = find_section(map_save, SaveFormat::SECTION_MAP) != 0
+                      && loaded.deserialize_state(map_save) && loaded.serialize_state() == first.serialize_state();
+            if (!same || !loads) {
+                std::cout << "Shape " << shape << ":                  " << (same ? "" : "not reproducible ")
+                          << (loads ? "" : "map save does not load") << std::endl;
+            }
+            shapes_ok = shapes_ok && same && loads;
+        }
+
+        // Other seeds, other maps
+        GameSetup setup = make_setup(n_planets, n_players);
+        GameState game(setup);
+        GalaxyGenerationParams other_params = setup.get_galaxy_params();
+        other_params.seed += 1;
+        bool seeds_differ = hash_planets(game.generate_map(setup.get_galaxy_params())) != hash_planets(game.generate_map(other_params));
+
+        // Zero seed
+        GameState random_game(make_setup(n_planets, n_players, GALAXY_RANDOM, 0));
+        GameSetup recorded = random_game.get_setup();
+        GameState recreated(recorded);
+        bool zero_seed_ok = recorded.get_galaxy_params().seed != 0
+                         && recreated.serialize_state() == random_game.serialize_state();
+
+        // Full save against seed-only map after play
+        uint64_t lcg = 1;
+        play(game, n_turns, lcg);
+        std::vector<uint8_t> full = game.serialize_state();
+        std::vector<uint8_t> map_save = game.serialize_state_seed_map();
+
+        GameState from_full(setup);
+        GameState from_map(setup);
+        double full_load_ms = 1e9;
+        double map_load_ms = 1e9;
+        for (int i = 0; i < 5; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            bool full_ok = from_full.deserialize_state(full);
+            auto middle = std::chrono::steady_clock::now();
+            bool map_ok = from_map.deserialize_state(map_save);
+            auto end = std::chrono::steady_clock::now();
+            ok = ok && full_ok && map_ok;
+            full_load_ms = std::min(full_load_ms, std::chrono::duration<double, std::milli>(middle - start).count());
+            map_load_ms = std::min(map_load_ms, std::chrono::duration<double, std::milli>(end - middle).count());
+        }
+        bool round_trip = ok && from_map.serialize_state() == full && from_full.serialize_state() == full;
+
+        double generate_ms = 1e9;
+        for (int i = 0; i < 5; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<Planet> planets = game.generate_map(setup.get_galaxy_params());
+            generate_ms = std::min(generate_ms, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        // Tampered maps are refused and leave the game as it was
+        size_t map_offset = find_section(map_save, SaveFormat::SECTION_MAP);
+        std::vector<uint8_t> bad_hash = map_save;
+        bad_hash[map_offset + 1] ^= 0x01;
+        std::vector<uint8_t> bad_version = map_save;
+        bad_version[map_offset] = static_cast<uint8_t>(GALAXY_GENERATOR_VERSION + 1);
+        GameState target(setup);
+        std::vector<uint8_t> before = target.serialize_state();
+        bool refused = map_offset != 0 && !target.deserialize_state(bad_hash) && !target.deserialize_state(bad_version)
+                    && target.serialize_state() == before;
+
+        // Without a generator the map cannot be decoded
+        GameSnapshot snapshot;
+        refused = refused && !decode_game_snapshot(map_save.data(), map_save.size(), snapshot);
+
+        std::cout << "Planets:                  " << n_planets << std::endl;
+        std::cout << "Players:                  " << n_players << std::endl;
+        std::cout << "Turns:                    " << n_turns << std::endl;
+        std::cout << "Full save:                " << full.size() << " bytes" << std::endl;
+        std::cout << "Seed-only map save:       " << map_save.size() << " bytes ("
+                  << 100.0 * static_cast<double>(full.size() - map_save.size()) / static_cast<double>(full.size())
+                  << "% smaller)" << std::endl;
+        std::cout << "Load, full save:          " << full_load_ms << " ms" << std::endl;
+        std::cout << "Load, seed-only map:      " << map_load_ms << " ms" << std::endl;
+        std::cout << "Galaxy regeneration:      " << generate_ms << " ms" << std::endl;
+        std::cout << "Same setup, same game:    " << (shapes_ok ? "yes" : "NO") << " (all shapes)" << std::endl;
+        std::cout << "Other seed, other map:    " << (seeds_differ ? "yes" : "NO") << std::endl;
+        std::cout << "Zero seed recorded:       " << (zero_seed_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Map save matches full:    " << (round_trip ? "yes" : "NO") << std::endl;
+        std::cout << "Mismatched maps refused:  " << (refused ? "yes" : "NO") << std::endl;
+
+        ok = shapes_ok && seeds_differ && zero_seed_ok && round_trip && refused && map_save.size() < full.size();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// Save/load benchmark
+// Plays a 500-planet, 20-player game for 300 turns (fleets moving and fighting, two alliances),
+// then times serialize_state() and deserialize_state(), and checks that:
+//   - a loaded game saves back to the same bytes
+//   - the original and the loaded game stay byte-identical for further turns
+//   - truncated and corrupted saves are rejected without touching the game
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -Iinclude bench_serialization.cpp _gate_build/libOpenHoCore.a -o bench_serialization
+//   cd ../.. && src/core/bench_serialization
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "bench_common.h"
+
+int main() {
+    std::cout << "=== Save/Load Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 20;
+    const uint32_t n_turns = 300;
+    const uint32_t extra_turns = 20;
+    const uint32_t repetitions = 20;
+    bool ok = true;
+
+    try {
+        GameSetup setup = make_setup(n_planets, n_players);
+        GameState game(setup);
+        for (uint32_t i = 1; i <= n_players; ++i) {
+            (void)game.set_player_alliance(i, i <= 4 ? 1 : (i <= 8 ? 2 : GameState::NO_ALLIANCE));
+        }
+
+        uint64_t lcg = 1;
+        for (uint32_t turn = 0; turn < n_turns; ++turn) {
+            issue_orders(game, lcg);
+            game.process_turn();
+        }
+
+        // Save
+        std::vector<uint8_t> saved;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions; ++i) {
+            saved = game.serialize_state();
+        }
+        double save_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+        // Load (into a different game, so every piece of state has to come from the save)
+        GameState loaded(setup);
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions; ++i) {
+            if (!loaded.deserialize_state(saved)) {
+                std::cout << "Load failed" << std::endl;
+                return 1;
+            }
+        }
+        double load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+        bool round_trip = loaded.serialize_state() == saved;
+
+        // Both games must evolve identically
+        uint64_t lcg_a = lcg;
+        uint64_t lcg_b = lcg;
+        bool deterministic = true;
+        for (uint32_t turn = 0; turn < extra_turns; ++turn) {
+            issue_orders(game, lcg_a);
+            issue_orders(loaded, lcg_b);
+            game.process_turn();
+            loaded.process_turn();
+            if (game.serialize_state() != loaded.serialize_state()) {
+                deterministic = false;
+            }
+        }
+
+        // Damaged saves are rejected and leave the game as it was
+        std::vector<uint8_t> before = loaded.serialize_state();
+        uint32_t rejected = 0;
+        uint32_t attempts = 0;
+        for (size_t cut = 0; cut < saved.size(); cut += saved.size() / 97 + 1) {
+            std::vector<uint8_t> truncated(saved.begin(), saved.begin() + cut);
+            attempts++;
+            rejected += loaded.deserialize_state(truncated) ? 0 : 1;
+        }
+        std::vector<uint8_t> bad_magic = saved;
+        bad_magic[0] ^= 0xFF;
+        attempts++;
+        rejected += loaded.deserialize_state(bad_magic) ? 0 : 1;
+        std::vector<uint8_t> newer_version = saved;
+        newer_version[4] = 0xFF;
+        attempts++;
+        rejected += loaded.deserialize_state(newer_version) ? 0 : 1;
+        bool untouched = loaded.serialize_state() == before;
+
+        size_t fleets = 0;
+        for (const Player& player : game.get_players()) {
+            fleets += player.get_fleets().size();
+        }
+
+        std::cout << "Planets:               " << game.get_galaxy().planets.size() << std::endl;
+        std::cout << "Players:               " << n_players << std::endl;
+        std::cout << "Turn:                  " << n_turns << std::endl;
+        std::cout << "Fleets:                " << fleets << std::endl;
+        std::cout << "Save size:             " << saved.size() << " bytes" << std::endl;
+        std::cout << "Save time:             " << save_ms << " ms" << std::endl;
+        std::cout << "Load time:             " << load_ms << " ms" << std::endl;
+        std::cout << "Round trip identical:  " << (round_trip ? "yes" : "NO") << std::endl;
+        std::cout << "Replay identical:      " << (deterministic ? "yes" : "NO") << " (" << extra_turns << " turns)" << std::endl;
+        std::cout << "Damaged saves rejected: " << rejected << "/" << attempts << (untouched ? "" : " (GAME CHANGED)") << std::endl;
+
+        ok = round_trip && deterministic && rejected == attempts && untouched;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+// Streaming save benchmark
+// Plays a 500-planet, 20-player game for 300 turns and compares building the save in a
+// vector with streaming it through a ByteSink, and checks that:
+//   - the streamed bytes match serialize_state() at several points of the game
+//   - the size query is exact, through GameState and the C API
+//   - chunks handed to a sink overrun ByteWriter::CHUNK_SIZE by at most a record or so
+//   - game_serialize_state() fills an exact-size buffer and refuses a smaller one
+//   - the C callback stream matches, and a sink that stops the stream fails the save
+//   - a save streamed to a file loads back
+// Build from src/core (after building OpenHoCore) and run from the repository root
+// so that TextAssets/ can be found:
+//   g++ -std=c++17 -O2 -Iinclude bench_streaming_save.cpp _gate_build/libOpenHoCore.a -o bench_streaming_save
+//   cd ../.. && src/core/bench_streaming_save
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include "include/game.h"
+#include "include/game_setup.h"
+#include "include/openho_core.h"
+#include "include/serialization.h"
+#include "include/player.h"
+#include "include/galaxy.h"
+#include "bench_common.h"
+
+// Collects the stream and records the chunk sizes it arrived in
+class CollectSink : public ByteSink {
+public:
+    bool write(const uint8_t* data, size_t size) override {
+        bytes.insert(bytes.end(), data, data + size);
+        largest_chunk = std::max(largest_chunk, size);
+        chunks++;
+        return true;
+    }
+    std::vector<uint8_t> bytes;
+    size_t largest_chunk = 0;
+    size_t chunks = 0;
+};
+
+// Stands in for a compressor: folds every byte into a hash and keeps nothing
+class HashSink : public ByteSink {
+public:
+    bool write(const uint8_t* data, size_t size) override {
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 1099511628211ULL;
+        }
+        return true;
+    }
+    uint64_t hash = 14695981039346656037ULL;
+};
+
+class FileSink : public ByteSink {
+public:
+    explicit FileSink(std::FILE* file) : file(file) {}
+    bool write(const uint8_t* data, size_t size) override { return std::fwrite(data, 1, size, file) == size; }
+private:
+    std::FILE* file;
+};
+
+// Accepts a few chunks, then stops the stream
+class StoppingSink : public ByteSink {
+public:
+    bool write(const uint8_t*, size_t) override { return ++chunks < 3; }
+    size_t chunks = 0;
+};
+
+static int append_to_vector(void* context, const void* data, size_t size) {
+    std::vector<uint8_t>* bytes = static_cast<std::vector<uint8_t>*>(context);
+    const uint8_t* begin = static_cast<const uint8_t*>(data);
+    bytes->insert(bytes->end(), begin, begin + size);
+    return 1;
+}
+
+static uint64_t hash_bytes(const std::vector<uint8_t>& bytes) {
+    HashSink sink;
+    (void)sink.write(bytes.data(), bytes.size());
+    return sink.hash;
+}
+
+int main() {
+    std::cout << "=== Streaming Save Benchmark ===" << std::endl << std::endl;
+
+    const uint32_t n_planets = 500;
+    const uint32_t n_players = 20;
+    const uint32_t n_turns = 300;
+    const uint32_t check_every = 50;
+    const uint32_t repetitions = 50;
+    const std::string path = "bench_streaming_save.ohsv";
+    bool ok = true;
+
+    try {
+        GameSetup setup = make_setup(n_planets, n_players);
+        GameState game(setup);
+        for (uint32_t i = 1; i <= n_players; ++i) {
+            (void)game.set_player_alliance(i, i <= 4 ? 1 : (i <= 8 ? 2 : GameState::NO_ALLIANCE));
+        }
+
+        // Streamed bytes and size queries along the game
+        bool streams_match = true;
+        bool sizes_exact = true;
+        size_t largest_chunk = 0;
+        size_t chunks = 0;
+        uint64_t lcg = 1;
+        for (uint32_t turn = 0; turn <= n_turns; ++turn) {
+            if (turn % check_every == 0) {
+                std::vector<uint8_t> saved = game.serialize_state();
+                CollectSink sink;
+                streams_match = game.serialize_state(sink) && sink.bytes == saved && streams_match;
+                sizes_exact = game.get_serialized_size() == saved.size()
+                           && game_get_serialized_state_size(&game) == static_cast<int>(saved.size()) && sizes_exact;
+                largest_chunk = std::max(largest_chunk, sink.largest_chunk);
+                chunks = sink.chunks;
+            }
+            if (turn < n_turns) {
+                issue_orders(game, lcg);
+                game.process_turn();
+            }
+        }
+        std::vector<uint8_t> saved = game.serialize_state();
+
+        // C API: caller buffer and callback stream
+        std::vector<uint8_t> buffer(saved.size());
+        bool buffer_ok = game_serialize_state(&game, buffer.data(), static_cast<int>(buffer.size())) == static_cast<int>(saved.size())
+                      && buffer == saved
+                      && game_serialize_state(&game, buffer.data(), static_cast<int>(buffer.size()) - 1) == -1;
+        std::vector<uint8_t> streamed;
+        bool callback_ok = game_serialize_state_stream(&game, append_to_vector, &streamed) == static_cast<int64_t>(saved.size())
+                        && streamed == saved;
+        StoppingSink stopping;
+        bool stop_ok = !game.serialize_state(stopping) && stopping.chunks == 3;
+
+        // File
+        bool file_ok = false;
+        if (std::FILE* file = std::fopen(path.c_str(), "wb")) {
+            FileSink sink(file);
+            bool written = game.serialize_state(sink);
+            file_ok = std::fclose(file) == 0 && written;
+            std::ifstream in(path, std::ios::binary);
+            std::vector<uint8_t> loaded_bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            GameState loaded(setup);
+            file_ok = file_ok && loaded_bytes == saved && loaded.deserialize_state(loaded_bytes)
+                   && loaded.serialize_state() == saved;
+        }
+        std::remove(path.c_str());
+
+        // Timing
+        std::vector<uint8_t> bytes;
+        uint64_t vector_hash = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions; ++i) {
+            bytes = game.serialize_state();
+            vector_hash = hash_bytes(bytes);
+        }
+        double vector_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+        HashSink hash_sink;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions; ++i) {
+            hash_sink = HashSink();
+            (void)game.serialize_state(hash_sink);
+        }
+        double stream_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+        size_t old_size = 0;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions; ++i) {
+            old_size = game.serialize_state().size();
+        }
+        double old_size_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+        size_t size = 0;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repetitions; ++i) {
+            size = game.get_serialized_size();
+        }
+        double size_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+        bool hashes_match = hash_sink.hash == vector_hash && size == old_size;
+
+        std::cout << "Planets:                  " << n_planets << std::endl;
+        std::cout << "Players:                  " << n_players << std::endl;
+        std::cout << "Turn:                     " << n_turns << std::endl;
+        std::cout << "Save size:                " << saved.size() << " bytes (" << chunks << " chunks, largest "
+                  << largest_chunk << ")" << std::endl;
+        std::cout << "Vector save + hash:       " << vector_us << " us" << std::endl;
+        std::cout << "Streamed to hash sink:    " << stream_us << " us" << std::endl;
+        std::cout << "Size via full save:       " << old_size_us << " us" << std::endl;
+        std::cout << "Size query:               " << size_us << " us" << std::endl;
+        std::cout << "Streams match saves:      " << (streams_match && hashes_match ? "yes" : "NO") << std::endl;
+        std::cout << "Size queries exact:       " << (sizes_exact ? "yes" : "NO") << std::endl;
+        std::cout << "Caller buffer:            " << (buffer_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Callback stream:          " << (callback_ok ? "yes" : "NO") << std::endl;
+        std::cout << "Stopped stream fails:     " << (stop_ok ? "yes" : "NO") << std::endl;
+        std::cout << "File save loads back:     " << (file_ok ? "yes" : "NO") << std::endl;
+
+        ok = streams_match && hashes_match && sizes_exact && buffer_ok && callback_ok && stop_ok && file_ok
+          && largest_chunk <= ByteWriter::CHUNK_SIZE + 16 * 1024;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
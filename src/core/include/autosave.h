@@ -0,0 +1,150 @@
+#ifndef OPENHO_AUTOSAVE_H
+#define OPENHO_AUTOSAVE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "serialization.h"
+
+class GameState;
+struct GameSnapshot;
+
+// ============================================================================
+// AutosaveTarget Interface
+// ============================================================================
+
+/// Where autosaves go.  Called on the autosave thread, one save at a time.
+class AutosaveTarget
+{
+public:
+	virtual ~AutosaveTarget() = default;
+
+	/// Sink for the save of a turn (a compressing sink can wrap the output here)
+	/// Returns nullptr to fail this save
+	virtual ByteSink* begin_save(uint32_t turn) = 0;
+
+	/// The save begun last is finished; streamed is false if its sink stopped it
+	/// Returns whether the save was kept
+	virtual bool end_save(uint32_t turn, bool streamed) = 0;
+};
+
+/// Keeps the latest autosave in one file
+/// Each save is streamed to path + ".tmp" and renamed over path once complete,
+/// so a save interrupted part-way leaves the previous one in place.
+class FileAutosaveTarget : public AutosaveTarget
+{
+public:
+	explicit FileAutosaveTarget(const std::string& path);
+	~FileAutosaveTarget() override;
+
+	ByteSink* begin_save(uint32_t turn) override;
+	bool end_save(uint32_t turn, bool streamed) override;
+
+	const std::string& get_path() const { return path; }
+
+private:
+	class FileSink;
+
+	std::string path;
+	std::string temp_path;
+	std::unique_ptr<FileSink> sink;
+};
+
+// ============================================================================
+// AutosaveService Class
+// ============================================================================
+
+struct AutosaveMetrics
+{
+	uint64_t snapshots = 0;             // Taken on the turn thread
+	uint64_t saves = 0;                 // Written and kept by the target
+	uint64_t failed = 0;                // Refused by the target or stopped by its sink
+	uint64_t dropped = 0;               // Pushed out of a full queue by a newer snapshot
+	size_t queued = 0;                  // Waiting now (not counting the one being written)
+
+	uint32_t last_saved_turn = 0;       // Valid once saves > 0
+	size_t last_save_bytes = 0;
+
+	double last_capture_ms = 0.0;       // Turn-thread cost of a snapshot
+	double max_capture_ms = 0.0;
+	double last_lag_ms = 0.0;           // From snapshot to save kept
+	double max_lag_ms = 0.0;
+	double total_lag_ms = 0.0;          // Over all kept saves
+};
+
+/// Saves a game in the background
+/// On an autosaved turn, process_turn() takes a snapshot (a frozen copy of the
+/// game's mutable state, see game_snapshot.h; knowledge pages are shared, not
+/// copied) and queues it; a worker thread encodes queued snapshots, reading the
+/// pinned pages in place, and streams them to the target.  The turn thread
+/// never waits for encoding or disk: when the queue is full the oldest waiting
+/// snapshot is dropped for the new one, so the newest state is always saved next.
+class AutosaveService
+{
+public:
+	/// interval: processed turns between autosaves (at least 1)
+	/// queue_capacity: snapshots that may wait while one is being written (at least 1)
+	/// The target must outlive the service
+	explicit AutosaveService(AutosaveTarget& target, uint32_t interval = 1, size_t queue_capacity = 2);
+
+	/// Finishes the queued saves (see stop())
+	~AutosaveService();
+
+	AutosaveService(const AutosaveService&) = delete;
+	AutosaveService& operator=(const AutosaveService&) = delete;
+
+	/// Autosave the game after every interval-th turn (the service must outlive
+	/// the attachment; detach with GameState::set_autosave(nullptr))
+	void attach(GameState& game);
+
+	/// Called by GameState::process_turn(): snapshots the game if the turn is due
+	void on_turn_processed(const GameState& game);
+
+	/// Snapshot the game now and queue it, whatever the interval
+	void save_now(const GameState& game);
+
+	/// Block until every queued snapshot has been written (for shutdown and tests,
+	/// never needed by the turn loop)
+	void wait_idle();
+
+	/// Write what is queued, then stop the worker; later snapshots are dropped
+	void stop();
+
+	AutosaveMetrics get_metrics() const;
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Pending
+	{
+		std::unique_ptr<GameSnapshot> snapshot;
+		Clock::time_point captured;
+	};
+
+	void run();
+	void write(Pending& pending);
+
+	AutosaveTarget& target;
+	uint32_t interval;
+	size_t queue_capacity;
+
+	mutable std::mutex mutex;
+	std::condition_variable work_ready;
+	std::condition_variable idle;
+	std::deque<Pending> queue;
+	std::vector<std::unique_ptr<GameSnapshot>> spare;       // Written snapshots, reused to keep their buffers
+	bool writing = false;
+	bool stopping = false;
+	AutosaveMetrics metrics;
+
+	std::thread worker;
+};
+
+#endif // OPENHO_AUTOSAVE_H
@@ -115,7 +115,7 @@ public:
 	
 	// --- Setters for player-specific data ---
 	void set_funding_fraction(double p_val) { planet_funding_fraction = p_val; }
-	void set_population(int32_t p_val) { population = p_val; }
+	void set_population(int32_t p_val);  // Also updates the owner's victory points
 	void set_income(int32_t p_val) { income = p_val; }
 	void set_apparent_gravity(double p_val) { apparent_gravity = p_val; }
 	void set_apparent_temperature(double p_val) { apparent_temperature = p_val; }
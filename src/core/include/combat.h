@@ -0,0 +1,98 @@
+#ifndef OPENHO_COMBAT_H
+#define OPENHO_COMBAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// Forward Declarations
+// ============================================================================
+
+typedef int32_t PlayerID;
+
+class RNGStream;
+
+// ============================================================================
+// Combat Data Structures
+// ============================================================================
+
+/// One fleet taking part in an engagement
+/// ship_count is updated in place with the number of survivors
+struct CombatParticipant
+{
+	PlayerID owner;          // Which player owns this fleet
+	uint32_t fleet_id;       // Fleet identifier (used for deterministic loss ordering)
+	int32_t tech_weapons;    // Weapons tech of the fleet's ship design
+	int32_t tech_shields;    // Shields tech of the fleet's ship design
+	uint32_t ship_count;     // Ships before combat; survivors after resolve()
+	uint32_t alliance = 0;   // Owners sharing a non-zero alliance do not fire on each other
+};
+
+/// Summary of a resolved engagement
+struct CombatResult
+{
+	uint32_t rounds_fought = 0;        // Exchange rounds actually fought
+	uint32_t ships_destroyed = 0;      // Total ships lost by all sides
+	uint32_t surviving_owners = 0;     // Owners with at least one ship left
+	PlayerID victor = 0;               // Sole surviving owner, or NOT_OWNED if none/several
+};
+
+// ============================================================================
+// CombatEngine Class
+// ============================================================================
+
+/// Resolves engagements between fleets of several owners at one planet.
+///
+/// Fleets are aggregated into groups keyed by (owner, weapons, shields), so the
+/// cost of a round depends on the number of distinct groups rather than ships.
+/// Each round, every owner's total firepower is spread over all enemy ships in
+/// proportion to their numbers (Lanchester square law); a group's expected
+/// losses are its incoming damage divided by per-ship defense.  Allied owners
+/// form one side: they never fire on each other, and the engagement ends when
+/// only one side has ships left.  The per-group
+/// arithmetic runs over flat arrays (structure of arrays) so the compiler can
+/// vectorize it.  Fractional losses are rounded stochastically with the
+/// engagement's own RNG stream, visiting groups in sorted order, so results are
+/// identical on every client and independent of the order engagements run in.
+///
+/// The engine keeps its scratch buffers between calls; reuse one instance to
+/// avoid per-engagement allocation.
+class CombatEngine
+{
+public:
+	/// Resolve one engagement, updating each participant's ship_count to its survivors
+	/// Losses within a group are taken from the highest fleet_id first
+	CombatResult resolve(std::vector<CombatParticipant>& participants, RNGStream& rng);
+
+private:
+	// Participant indices sorted by (owner, weapons, shields, fleet_id)
+	std::vector<uint32_t> order;
+
+	// Group data (structure of arrays, one entry per group)
+	std::vector<uint32_t> group_owner_slot;   // Index into owner arrays
+	std::vector<uint32_t> group_first;        // First position in order
+	std::vector<uint32_t> group_last;         // One past last position in order
+	std::vector<double> group_ships;          // Current ship count
+	std::vector<double> group_attack;         // Damage per ship per round
+	std::vector<double> group_inv_defense;    // 1 / damage absorbed per ship
+	std::vector<double> group_incoming;       // Scratch: damage pressure on this group
+	std::vector<double> group_losses;         // Scratch: expected losses this round
+
+	// Owner data (one entry per distinct owner in the engagement)
+	std::vector<PlayerID> owner_ids;
+	std::vector<uint32_t> owner_alliance;     // Alliance of each owner (0 if none)
+	std::vector<double> owner_firepower;      // Sum of ships * attack
+	std::vector<double> owner_ships;          // Sum of ships
+	std::vector<double> owner_side_ships;     // Ships of the owner and its allies
+	std::vector<double> owner_pressure;       // Damage per enemy ship aimed at this owner
+
+	void build_groups(const std::vector<CombatParticipant>& participants);
+	uint32_t count_surviving_owners();
+	uint32_t count_surviving_sides();
+	bool same_side(size_t a, size_t b) const;
+	void fight_round(RNGStream& rng);
+	void distribute_losses(std::vector<CombatParticipant>& participants);
+};
+
+#endif // OPENHO_COMBAT_H
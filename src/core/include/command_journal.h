@@ -0,0 +1,203 @@
+#ifndef OPENHO_COMMAND_JOURNAL_H
+#define OPENHO_COMMAND_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "enums.h"
+#include "player.h"
+#include "serialization.h"
+
+class GameState;
+
+// ============================================================================
+// Journal Format
+// ============================================================================
+//
+// Append-only record of a game: the orders players gave and the turns that
+// were processed, with a full save every few turns to seek from.
+//   header  : magic "OHCJ" (u32), format version (u16), flags (u16)
+//   records : kind (u8) followed by
+//     KEYFRAME  turn (u32), length (u32), full save (serialization.h) of the
+//               game at the start of that turn
+//     COMMAND   type (u8), player ID (varint), the fields used by the type
+//     TURN      turn (u32): process_turn() ran with the commands since the
+//               previous TURN or KEYFRAME
+// The first record is a keyframe.  Seeds are part of each keyframe; reseeding
+// between turns is journaled as a command, so replaying the records from any
+// keyframe reproduces the game exactly.
+
+namespace JournalFormat
+{
+	constexpr uint32_t MAGIC = SaveFormat::make_tag('O', 'H', 'C', 'J');
+	constexpr uint16_t VERSION = 1;
+	constexpr size_t HEADER_SIZE = 8;
+
+	constexpr uint8_t RECORD_KEYFRAME = 1;
+	constexpr uint8_t RECORD_COMMAND = 2;
+	constexpr uint8_t RECORD_TURN = 3;
+}
+
+// ============================================================================
+// GameCommand Struct
+// ============================================================================
+
+enum CommandType : uint8_t
+{
+	COMMAND_NONE = 0,
+	COMMAND_SET_MONEY_ALLOCATION = 1,
+	COMMAND_SET_PLANET_ALLOCATION = 2,
+	COMMAND_CREATE_SHIP_DESIGN = 3,
+	COMMAND_DELETE_SHIP_DESIGN = 4,
+	COMMAND_BUILD_FLEET = 5,
+	COMMAND_DELETE_FLEET = 6,
+	COMMAND_MOVE_FLEET = 7,
+	COMMAND_REFUEL_FLEET = 8,
+	COMMAND_SET_ALLIANCE = 9,
+	COMMAND_SET_AI_SEED = 10,
+	COMMAND_SET_DETERMINISTIC_SEED = 11,
+	COMMAND_TYPE_COUNT = 12
+};
+
+/// One order given between turns, carried out by GameState::execute_command()
+/// Only the fields used by the type are meaningful (and journaled)
+struct GameCommand
+{
+	CommandType type = COMMAND_NONE;
+	uint32_t player_id = 0;
+
+	uint32_t fleet_id = 0;                  // DELETE_FLEET, MOVE_FLEET, REFUEL_FLEET
+	uint32_t design_id = 0;                 // DELETE_SHIP_DESIGN, BUILD_FLEET
+	uint32_t planet_id = 0;                 // SET_PLANET_ALLOCATION, BUILD_FLEET, MOVE_FLEET (destination)
+	uint32_t value = 0;                     // BUILD_FLEET ship count, SET_ALLIANCE alliance ID
+	uint64_t seed = 0;                      // SET_AI_SEED, SET_DETERMINISTIC_SEED
+
+	Player::MoneyAllocation money{};        // SET_MONEY_ALLOCATION
+	double mining_fraction = 0.0;           // SET_PLANET_ALLOCATION
+	double terraforming_fraction = 0.0;
+
+	std::string name;                       // CREATE_SHIP_DESIGN
+	ShipType ship_type = SHIP_SCOUT;
+	int32_t tech_range = 0;
+	int32_t tech_speed = 0;
+	int32_t tech_weapons = 0;
+	int32_t tech_shields = 0;
+	int32_t tech_mini = 0;
+
+	static GameCommand set_money_allocation(uint32_t player_id, const Player::MoneyAllocation& allocation);
+	static GameCommand set_planet_allocation(uint32_t player_id, uint32_t planet_id, double mining_fraction, double terraforming_fraction);
+	static GameCommand create_ship_design(uint32_t player_id, const std::string& name, ShipType type, int32_t tech_range,
+	                                      int32_t tech_speed, int32_t tech_weapons, int32_t tech_shields, int32_t tech_mini);
+	static GameCommand delete_ship_design(uint32_t player_id, uint32_t design_id);
+	static GameCommand build_fleet(uint32_t player_id, uint32_t design_id, uint32_t ship_count, uint32_t planet_id);
+	static GameCommand delete_fleet(uint32_t player_id, uint32_t fleet_id);
+	static GameCommand move_fleet(uint32_t player_id, uint32_t fleet_id, uint32_t destination_planet_id);
+	static GameCommand refuel_fleet(uint32_t player_id, uint32_t fleet_id);
+	static GameCommand set_alliance(uint32_t player_id, uint32_t alliance_id);
+	static GameCommand set_ai_seed(uint64_t seed);
+	static GameCommand set_deterministic_seed(uint64_t seed);
+};
+
+namespace SaveRecords
+{
+	void write_command(ByteWriter& w, const GameCommand& command);
+	[[nodiscard]] bool read_command(ByteReader& r, GameCommand& command);
+}
+
+// ============================================================================
+// CommandJournal Class
+// ============================================================================
+
+/// Records a game as it is played: attach it with start(), and every command
+/// carried out through GameState::execute_command() and every processed turn
+/// is appended.  The bytes only ever grow, so a host can persist the journal
+/// by writing get_data() from where it stopped last time.
+class CommandJournal
+{
+public:
+	struct Keyframe
+	{
+		uint32_t turn;
+		size_t offset;              // Of the full save in get_data()
+		size_t size;
+	};
+
+	/// keyframe_interval: processed turns between keyframes (at least 1)
+	explicit CommandJournal(uint32_t keyframe_interval = 25);
+
+	/// Start a new journal from the game's current state and attach it to the game
+	void start(GameState& game);
+
+	/// Append a command (called by GameState::execute_command())
+	void record_command(const GameCommand& command);
+
+	/// Append a processed turn, and a keyframe when one is due (called by GameState::process_turn())
+	void record_turn(const GameState& game, uint32_t turn);
+
+	void clear();
+
+	const std::vector<uint8_t>& get_data() const { return data; }
+	const std::vector<Keyframe>& get_keyframes() const { return keyframes; }
+	bool empty() const { return keyframes.empty(); }
+	size_t get_command_count() const { return command_count; }
+
+	/// Turns a replay can reach: the first keyframe's turn up to the turn after the last processed one
+	uint32_t get_first_turn() const { return keyframes.empty() ? 0 : keyframes.front().turn; }
+	uint32_t get_end_turn() const { return end_turn; }
+
+	/// Offset just past the last TURN or KEYFRAME record (commands after it belong to a turn not yet processed)
+	size_t get_complete_size() const { return complete_size; }
+
+	/// Replace the journal with one read back from bytes
+	/// Returns false, leaving the journal unchanged, if the bytes are damaged
+	[[nodiscard]] bool read(const uint8_t* bytes, size_t size);
+
+private:
+	void append_keyframe(const GameState& game);
+
+	uint32_t keyframe_interval;
+	std::vector<uint8_t> data;
+	std::vector<Keyframe> keyframes;
+	size_t command_count = 0;
+	size_t complete_size = 0;
+	uint32_t end_turn = 0;
+};
+
+// ============================================================================
+// ReplayEngine Class
+// ============================================================================
+
+/// Re-simulates a journaled game in a GameState of the same setup
+/// seek() restores the nearest keyframe at or before the turn and replays the
+/// turns after it, so a jump costs at most keyframe_interval turns of play.
+class ReplayEngine
+{
+public:
+	/// The journal must outlive the engine and not change while replaying
+	/// The game is overwritten by seek() and detached from any journal
+	ReplayEngine(const CommandJournal& journal, GameState& game);
+
+	/// Put the game at the start of a turn (before that turn's commands)
+	/// Returns false if the turn is not in the journal or the replay diverges
+	[[nodiscard]] bool seek(uint32_t turn);
+
+	/// Replay the current turn's commands and process it
+	/// Returns false at the end of the journal or if the replay diverges
+	[[nodiscard]] bool step();
+
+	/// Compare the game with every keyframe step() passes (one full save per keyframe)
+	void set_check_keyframes(bool enabled) { check_keyframes = enabled; }
+
+	bool is_positioned() const { return positioned; }
+	uint32_t get_turn() const;
+
+private:
+	const CommandJournal& journal;
+	GameState& game;
+	size_t cursor = 0;              // Next record in the journal
+	bool positioned = false;
+	bool check_keyframes = false;
+};
+
+#endif // OPENHO_COMMAND_JOURNAL_H
@@ -120,6 +120,43 @@ enum GalaxyShape
 	GALAXY_GRID = 5
 };
 
+// Route planning objectives
+enum RouteMode
+{
+	ROUTE_FEWEST_TURNS = 0,
+	ROUTE_FEWEST_HOPS = 1
+};
+
+// Observable KnowledgePlanet fields (bit flags, combined into knowledge delta masks)
+enum KnowledgeField
+{
+	KNOWLEDGE_TEMPERATURE = 1 << 0,
+	KNOWLEDGE_GRAVITY = 1 << 1,
+	KNOWLEDGE_METAL = 1 << 2,
+	KNOWLEDGE_OWNER = 1 << 3,
+	KNOWLEDGE_POPULATION = 1 << 4,
+	KNOWLEDGE_OBSERVATION_YEAR = 1 << 5,
+	KNOWLEDGE_PROFITABILITY = 1 << 6,
+	KNOWLEDGE_PERCEIVED_VALUE = 1 << 7
+};
+
+// Per-turn public player metrics (columns of the PlayerHistoryStore)
+enum PlayerMetric
+{
+	METRIC_TECH_RANGE = 0,
+	METRIC_TECH_SPEED = 1,
+	METRIC_TECH_WEAPONS = 2,
+	METRIC_TECH_SHIELDS = 3,
+	METRIC_TECH_MINI = 4,
+	METRIC_MONEY_INCOME = 5,
+	METRIC_MONEY_SAVINGS = 6,
+	METRIC_METAL_SAVINGS = 7,
+	METRIC_PLANETS_OWNED = 8,
+	METRIC_SHIP_POWER = 9,
+	METRIC_VICTORY_POINTS = 10,
+	METRIC_COUNT = 11
+};
+
 // ============================================================================
 // Sentinel Values for Unknown/Unowned States
 // ============================================================================
@@ -34,6 +34,7 @@ enum class ErrorCode : uint32_t
 	INVALID_FLEET_SIZE = 31,
 	FLEET_LIMIT_REACHED = 32,
 	FLEET_IN_TRANSIT = 33,  // Can't perform action on fleet in transit
+	DESTINATION_OUT_OF_RANGE = 34,  // Not enough fuel to reach destination in one hop
 	
 	// Planet errors
 	PLANET_NOT_OWNED = 40,
@@ -92,6 +93,8 @@ inline const char* error_code_to_string(ErrorCode code)
 			return "Fleet limit reached";
 		case ErrorCode::FLEET_IN_TRANSIT:
 			return "Fleet is in transit";
+		case ErrorCode::DESTINATION_OUT_OF_RANGE:
+			return "Destination is out of fuel range";
 		case ErrorCode::PLANET_NOT_OWNED:
 			return "Planet not owned by player";
 		case ErrorCode::PLANET_NOT_FOUND:
@@ -3,7 +3,7 @@
 
 #include <cstdint>
 #include <string>
-#include <memory>
+#include <optional>
 
 // Forward declarations
 struct Planet;
@@ -19,6 +19,7 @@ class Player;
 // ============================================================================
 
 // Encapsulates all transit state for a fleet in motion
+// Stored inline in Fleet (std::optional), so issuing a move order allocates nothing
 struct FleetTransit
 {
 	uint32_t origin_planet_id;          // ID of origin planet
@@ -57,29 +58,26 @@ public:
 	uint32_t ship_count;            // Number of identical ships in fleet (max 1000)
 	
 	int32_t fuel;                   // Current fuel level (all ships have same amount)
-	bool in_transit;                // Is fleet currently traveling?
 	
 	std::string descriptor;
 	
 	// Position tracking
-	Planet* current_planet;         // Planet fleet is currently at (nullptr if in transit)
-	Planet* origin_planet;          // Planet fleet departed from
-	Planet* destination_planet;     // Planet fleet is heading to
+	Planet* current_planet;         // Planet fleet is currently at (space planet while in transit)
 	
-	// Movement tracking
-	double distance_to_destination; // Remaining distance in light-years
-	uint32_t turns_to_destination;  // Estimated turns until arrival
+	// Transit state - the single authoritative record of an in-progress move
+	std::optional<FleetTransit> transit;  // Empty if docked, engaged if in transit
 	
-	// Transit state (new architecture)
-	std::unique_ptr<FleetTransit> transit;  // nullptr if docked, not-null if in transit
+	/// Is fleet currently traveling?
+	bool is_in_transit() const { return transit.has_value(); }
 	
-	// Move semantics (required by unique_ptr)
-	Fleet(Fleet&&) = default;
-	Fleet& operator=(Fleet&&) = default;
+	/// Does this fleet consume fuel when moving? (biological ships do not)
+	bool uses_fuel() const;
 	
-	// Delete copy semantics (unique_ptr is not copyable)
-	Fleet(const Fleet&) = delete;
-	Fleet& operator=(const Fleet&) = delete;
+	/// Fuel available for route planning (effectively unlimited if the fleet uses no fuel)
+	int32_t get_available_fuel() const;
+	
+	/// Can the fleet reach a planet at this distance with its current fuel?
+	bool can_reach(double distance) const;
 	
 	// Member functions (implemented in fleet.cpp)
 	
@@ -91,6 +89,7 @@ public:
 	
 	/// Move fleet to destination planet
 	/// Sets up fleet movement with distance and turns calculated from distance matrix
+	/// and consumes the hop's fuel; does nothing if the destination is out of fuel range
 	void move_to(Planet* destination, KnowledgeGalaxy* knowledge_galaxy, uint32_t current_turn);
 };
 
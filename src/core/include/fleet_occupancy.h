@@ -0,0 +1,97 @@
+#ifndef OPENHO_FLEET_OCCUPANCY_H
+#define OPENHO_FLEET_OCCUPANCY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// Forward Declarations
+// ============================================================================
+
+typedef int32_t PlayerID;
+
+// ============================================================================
+// FleetHandle Struct
+// ============================================================================
+
+/// Compact reference to a fleet stationed at a planet
+/// Fleets live in Player::fleets (a vector that may reallocate), so the index
+/// stores (owner, fleet_id) pairs rather than Fleet pointers
+struct FleetHandle
+{
+	PlayerID owner;       // Which player owns this fleet
+	uint32_t fleet_id;    // Globally unique fleet identifier
+};
+
+/// Contiguous run of handles belonging to a single owner at one planet
+struct FleetHandleRange
+{
+	const FleetHandle* first;
+	const FleetHandle* last;
+
+	const FleetHandle* begin() const { return first; }
+	const FleetHandle* end() const { return last; }
+	size_t size() const { return static_cast<size_t>(last - first); }
+	bool empty() const { return first == last; }
+};
+
+// ============================================================================
+// FleetOccupancyIndex Class
+// ============================================================================
+
+/// Galaxy-wide index answering "which fleets from which players are at planet P?"
+/// Each planet keeps a compact list of fleet handles sorted (grouped) by owner,
+/// plus a count of distinct owners so contested planets are known in O(1).
+/// Updated incrementally whenever fleets are built, depart, arrive or are deleted.
+/// Fleets in transit are not stationed anywhere and do not appear in the index.
+class FleetOccupancyIndex
+{
+public:
+	/// Clear the index and size it for planet IDs in [0, max_planet_id]
+	void reset(uint32_t max_planet_id);
+
+	/// Record a fleet as stationed at a planet
+	void add_fleet(uint32_t planet_id, PlayerID owner, uint32_t fleet_id);
+
+	/// Remove a fleet from a planet
+	/// Returns false if the fleet was not recorded at that planet
+	bool remove_fleet(uint32_t planet_id, PlayerID owner, uint32_t fleet_id);
+
+	/// All fleets stationed at a planet, grouped by owner (ascending PlayerID)
+	[[nodiscard]] const std::vector<FleetHandle>& get_fleets_at(uint32_t planet_id) const;
+
+	/// Fleets belonging to one owner at a planet (empty range if none)
+	[[nodiscard]] FleetHandleRange get_owner_fleets_at(uint32_t planet_id, PlayerID owner) const;
+
+	/// Number of distinct owners with fleets at a planet
+	[[nodiscard]] uint32_t get_owner_count_at(uint32_t planet_id) const;
+
+	/// True if fleets from two or more owners are stationed at a planet
+	[[nodiscard]] bool is_contested(uint32_t planet_id) const { return get_owner_count_at(planet_id) > 1; }
+
+	/// IDs of all currently contested planets (unordered)
+	[[nodiscard]] const std::vector<uint32_t>& get_contested_planets() const { return contested_planets; }
+
+	/// Total number of fleets recorded in the index
+	[[nodiscard]] size_t get_fleet_count() const { return fleet_count; }
+
+private:
+	static constexpr uint32_t NOT_CONTESTED = UINT32_MAX;
+
+	struct PlanetSlot
+	{
+		std::vector<FleetHandle> fleets;               // Sorted by owner
+		uint32_t owner_count = 0;                      // Distinct owners present
+		uint32_t contested_position = NOT_CONTESTED;   // Index into contested_planets
+	};
+
+	std::vector<PlanetSlot> slots;              // Indexed by planet_id
+	std::vector<uint32_t> contested_planets;    // Planets with owner_count > 1
+	size_t fleet_count = 0;
+
+	void mark_contested(uint32_t planet_id);
+	void unmark_contested(uint32_t planet_id);
+};
+
+#endif // OPENHO_FLEET_OCCUPANCY_H
@@ -2,6 +2,8 @@
 #define OPENHO_GALAXY_H
 
 #include "planet.h"
+#include "planet_identity.h"
+#include "route_planner.h"
 #include "player.h"
 #include "enums.h"
 #include <cstdint>
@@ -20,7 +22,7 @@ struct GalaxyGenerationParams
 	uint32_t n_players;  // Number of players (determines home planet count)
 	double density;      // Planet distribution density (0.0-1.0, TBD)
 	GalaxyShape shape;   // Distribution pattern (random, spiral, circle, ring, cluster, grid)
-	uint64_t seed;       // Random seed for generation
+	uint64_t seed;       // Random seed for generation (0 = GameState picks one and stores it here)
 	double cluster_angular_offset;  // Angular offset for cluster galaxies (set by generate_coordinates_cluster)
 	
 	// Default constructor for testing
@@ -48,6 +50,12 @@ struct GalaxyGenerationParams
 	}
 };
 
+// Version of galaxy generation: within a version, the same parameters (seed
+// included) always generate the same planets.  Bump it with any change that
+// moves, renames or re-rolls generated planets, so that seed-only maps
+// (serialization.h, SECTION_MAP) written by another version are refused.
+constexpr uint32_t GALAXY_GENERATOR_VERSION = 1;
+
 // Coordinate pair for planet positions
 using PlanetCoord = std::pair<double, double>;  // (x, y)
 
@@ -59,6 +67,12 @@ struct Galaxy
 	// Immutable planet list
 	std::vector<Planet> planets;
 	
+	// Planet ID, name and coordinates, shared by every player's KnowledgeGalaxy
+	PlanetIdentityTable planet_identities;
+	
+	// Distance-sorted neighbour lists, shared by every player (route planning, reachability)
+	PlanetNeighbourGraph neighbour_graph;
+	
 	// Home planet indices (indices into planets vector)
 	std::vector<size_t> home_planet_indices;
 	
@@ -68,9 +82,15 @@ struct Galaxy
 	std::vector<std::vector<double>> distance_matrix;
 	
 	// Constructor to initialize galaxy boundaries and planets
-	// Takes GameState reference for access to RNG and TextAssets
-	// Implementation in game.cpp
-	Galaxy(const GalaxyGenerationParams& params, class GameState* game_state);
+	// Every random draw comes from rng and planet names from text_assets, so the same
+	// params and RNG state always give the same galaxy, whoever owns the RNG
+	Galaxy(const GalaxyGenerationParams& params, class DeterministicRNG& rng, const class TextAssets& text_assets);
+	
+	// Constructor for a saved galaxy: takes the planets as stored and rebuilds the derived data
+	Galaxy(std::vector<Planet> saved_planets, GalaxyCoord size, std::vector<size_t> home_indices);
+	
+	// Build everything derived from the planet list (distance matrix, identity table, neighbour graph)
+	void build_derived_data();
 	
 	// Compute distance matrix after all planets are created
 	// Called from constructor after generate_planet_parameters()
@@ -83,19 +103,20 @@ struct Galaxy
 	
 	// // Generate randomized planet names (helper method)
 	// // Generates n_planets unique names in random order from available_names
-	static std::vector<std::string> generate_planet_names(uint32_t n_planets, class GameState* game_state);
+	static std::vector<std::string> generate_planet_names(uint32_t n_planets, class DeterministicRNG& rng,
+		const class TextAssets& text_assets);
 	
 	// Staged galaxy generation methods
 	// Phase 1: Generate all planet coordinates according to galaxy shape
 	std::vector<PlanetCoord> generate_planet_coordinates(
 		const GalaxyGenerationParams& params,
-		class GameState* game_state);
+		class DeterministicRNG& rng);
 	
 	// Phase 2: Select home planet coordinates from all coordinates (random selection)
 	std::vector<PlanetCoord> select_home_planets_random(
 		const std::vector<PlanetCoord>& all_coords,
 		uint32_t n_home_planets,
-		class GameState* game_state);
+		class DeterministicRNG& rng);
 	
 	// Phase 2b: Select home planet coordinates for spiral galaxies
 	std::vector<PlanetCoord> select_home_planets_spiral(
@@ -103,7 +124,7 @@ struct Galaxy
 		uint32_t n_home_planets,
 		double a,
 		double delta_theta,
-		class GameState* game_state);
+		class DeterministicRNG& rng);
 	
 	// Phase 2c: Select home planet coordinates for cluster galaxies
 	// Divides galaxy into N equal wedges starting from angular_offset in params
@@ -111,42 +132,17 @@ struct Galaxy
 	std::vector<PlanetCoord> select_home_planets_cluster(
 		const std::vector<PlanetCoord>& all_coords,
 		const GalaxyGenerationParams& params,
-		class GameState* game_state);
+		class DeterministicRNG& rng);
 	
 	// Phase 3: Generate planet parameters for all coordinates
 	void generate_planet_parameters(
 		const std::vector<PlanetCoord>& all_coords,
 		const std::vector<PlanetCoord>& home_coords,
 		const std::vector<std::string>& planet_names,
-		class GameState* game_state);
+		class DeterministicRNG& rng);
 	
 	// Shape-specific coordinate generation methods
 	// Each method generates planet coordinates according to its shape pattern
-	static std::vector<PlanetCoord> generate_coordinates_random(
-		const GalaxyGenerationParams& params,
-		class GameState* game_state);
-	
-	static std::vector<PlanetCoord> generate_coordinates_spiral(
-		const GalaxyGenerationParams& params,
-		class GameState* game_state);
-	
-	static std::vector<PlanetCoord> generate_coordinates_circle(
-		const GalaxyGenerationParams& params,
-		class GameState* game_state);
-	
-	static std::vector<PlanetCoord> generate_coordinates_ring(
-		const GalaxyGenerationParams& params,
-		class GameState* game_state);
-	
-	static std::vector<PlanetCoord> generate_coordinates_cluster(
-		const GalaxyGenerationParams& params,
-		class GameState* game_state);
-	
-	static std::vector<PlanetCoord> generate_coordinates_grid(
-		const GalaxyGenerationParams& params,
-		class GameState* game_state);
-	
-	// Overloaded versions that take RNG directly (for Python wrapper)
 	static std::vector<PlanetCoord> generate_coordinates_random(
 		const GalaxyGenerationParams& params,
 		class DeterministicRNG& rng);
@@ -175,12 +171,13 @@ struct Galaxy
 	void initialize_planets_random(
 		const GalaxyGenerationParams& params,
 		const std::vector<std::string>& planet_names,
-		class GameState* game_state);
+		class DeterministicRNG& rng,
+		const class TextAssets& text_assets);
 	
 	void initialize_planets_grid(
 		const GalaxyGenerationParams& params,
 		const std::vector<std::string>& planet_names,
-		class GameState* game_state);
+		class DeterministicRNG& rng);
 };
 
 // ============================================================================
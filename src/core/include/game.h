@@ -7,6 +7,9 @@
 #include "game_formulas.h"
 #include "game_setup.h"
 #include "error_codes.h"
+#include "fleet_occupancy.h"
+#include "combat.h"
+#include "visibility.h"
 #include <memory>
 #include <unordered_map>
 
@@ -36,6 +39,25 @@ public:
 	const Galaxy& get_galaxy() const
 		{ return *galaxy; }
 
+	// Fleet occupancy index access (which fleets from which players are at each planet)
+	FleetOccupancyIndex& get_fleet_occupancy()
+		{ return fleet_occupancy; }
+	const FleetOccupancyIndex& get_fleet_occupancy() const
+		{ return fleet_occupancy; }
+
+	// Alliances (players sharing an alliance ID pool their observations every turn)
+	/// Put a player in an alliance (NO_ALLIANCE to leave); journaled via execute_command()
+	[[nodiscard]] ErrorCode set_player_alliance(uint32_t player_id, uint32_t alliance_id);
+	/// Alliance ID of a player (NO_ALLIANCE if none or invalid player)
+	[[nodiscard]] uint32_t get_player_alliance(uint32_t player_id) const;
+	/// Are two distinct players in the same alliance?
+	[[nodiscard]] bool are_allied(uint32_t player_a, uint32_t player_b) const;
+	
+	static constexpr uint32_t NO_ALLIANCE = 0;
+
+	/// Planets a player could see at the end of the last turn (bit N set = planet ID N)
+	[[nodiscard]] const PlanetBitset& get_visible_planets(uint32_t player_id) const;
+
 	// RNG access
 	DeterministicRNG& get_rng()
 		{ return *rng; }
@@ -81,7 +103,7 @@ public:
 	void increment_turn()
 		{ current_turn++; }
 	void increment_year()
-		{ current_year += 10; }
+		{ current_year += GameConstants::Years_Per_Turn; }
 	
 	
 	// Player property accessors (for C API and internal use)
@@ -96,8 +118,16 @@ public:
 	/// Capture current player info and distribute to all players
 	void capture_and_distribute_player_public_info();
 	
-	/// Get full player info history (for resync after disconnection)
-	[[nodiscard]] const std::vector<PlayerPublicInfo>& get_full_player_info_history(uint32_t player_id) const;
+	/// Check every player's incremental fleet power and victory points against a full recompute
+	/// (run on every capture when built with OPENHO_VERIFY_METRICS)
+	[[nodiscard]] bool verify_player_metrics();
+	
+	/// Public per-turn metrics of every player (shared, read-only; also used for resync after disconnection)
+	const PlayerHistoryStore& get_player_history() const
+		{ return player_history; }
+	
+	/// Reassemble one player's public info for a turn; false if the player or turn is not stored
+	[[nodiscard]] bool get_player_public_info(uint32_t player_id, uint32_t turn, PlayerPublicInfo& out) const;
 	
 	// Ship design management - use Player methods directly
 	// Player::create_ship_design(), Player::get_ship_design(), Player::get_ship_designs(), Player::delete_ship_design()
@@ -106,15 +136,16 @@ public:
 	[[nodiscard]] Fleet* get_fleet(uint32_t player_id, uint32_t fleet_id);
 	[[nodiscard]] const Fleet* get_fleet(uint32_t player_id, uint32_t fleet_id) const;
 	[[nodiscard]] const std::vector<Fleet>& get_player_fleets(uint32_t player_id) const;
-	[[nodiscard]] bool delete_fleet(uint32_t player_id, uint32_t fleet_id);
-	void move_fleet(uint32_t player_id, uint32_t fleet_id, uint32_t destination_planet_id);
-	void refuel_fleet(uint32_t player_id, uint32_t fleet_id);
+	// Fleet orders (carried out and journaled by execute_command())
+	[[nodiscard]] ErrorCode delete_fleet(uint32_t player_id, uint32_t fleet_id);
+	[[nodiscard]] ErrorCode move_fleet(uint32_t player_id, uint32_t fleet_id, uint32_t destination_planet_id);
+	[[nodiscard]] ErrorCode refuel_fleet(uint32_t player_id, uint32_t fleet_id);
 	
 	// Turn processing
 	void process_turn();
 	
-	// Money allocation
-	void set_money_allocation(uint32_t player_id, const Player::MoneyAllocation& alloc);
+	// Money allocation (setting it is journaled via execute_command())
+	[[nodiscard]] ErrorCode set_money_allocation(uint32_t player_id, const Player::MoneyAllocation& alloc);
 	const Player::MoneyAllocation& get_money_allocation(uint32_t player_id) const;
 	
 	// ========================================================================
@@ -136,20 +167,67 @@ public:
 	/// Check if a player can set planet allocation
 	[[nodiscard]] ErrorCode check_player_set_planet_allocation(uint32_t player_id, uint32_t planet_id, double mining_frac, double terraforming_frac) const;
 	
-	// RNG seed accessors (delegates to RNG)
+	// RNG seed accessors (delegates to RNG; reseeding is journaled via execute_command())
 	uint64_t get_det_seed() const
 		{ return rng->getDeterministicSeed(); }
-	void set_det_seed(uint64_t seed)
-		{ rng->setDeterministicSeed(seed); }
+	[[nodiscard]] ErrorCode set_det_seed(uint64_t seed);
 	uint64_t get_ai_seed() const
 		{ return rng->getAISeed(); }
-	void set_ai_seed(uint64_t seed)
-		{ rng->setAISeed(seed); }
+	[[nodiscard]] ErrorCode set_ai_seed(uint64_t seed);
 	
 	
-	// Serialization
+	// Serialization (save format in serialization.h; implemented in serialization.cpp)
 	[[nodiscard]] std::vector<uint8_t> serialize_state() const;
+	/// Stream the same bytes to a sink without building them in memory; false if the sink stopped it
+	[[nodiscard]] bool serialize_state(class ByteSink& sink) const;
+	/// Exact size of serialize_state(), measured without producing it
+	[[nodiscard]] size_t get_serialized_size() const;
+	/// Replace this game with a saved one; returns false (game unchanged) if the data is invalid
+	/// Seed-only map saves are accepted too: their galaxy is regenerated and hash-checked.
 	[[nodiscard]] bool deserialize_state(const std::vector<uint8_t>& data);
+	/// A new game built straight from a save (nullptr if the data is invalid)
+	/// Unlike constructing from a setup and then loading, no galaxy is generated
+	/// only to be replaced, so this is the cheap way to bring a save back.
+	[[nodiscard]] static std::unique_ptr<GameState> from_save(const std::vector<uint8_t>& data);
+	/// Save with the planets as a seed-only map (galaxy parameters plus what changed
+	/// since generation) for peers that regenerate the galaxy; usually far smaller
+	[[nodiscard]] std::vector<uint8_t> serialize_state_seed_map() const;
+	/// Planets the galaxy parameters generate (GALAXY_GENERATOR_VERSION), before any
+	/// player is placed; only this game's text assets are read
+	[[nodiscard]] std::vector<Planet> generate_map(const GalaxyGenerationParams& params) const;
+	
+	/// Copy everything needed to rebuild this game into a snapshot (game_snapshot.cpp)
+	void capture_snapshot(struct GameSnapshot& snapshot) const;
+	/// Same, but knowledge is only pinned (PlayerRecord::frozen_knowledge), sharing
+	/// the committed pages; the save encoders read it as it is, and
+	/// expand_frozen_knowledge() finishes it on any thread for everything else
+	void capture_frozen_snapshot(struct GameSnapshot& snapshot) const;
+	/// Rebuild this game from a snapshot, recomputing derived data
+	/// Returns false (game unchanged) if the snapshot is inconsistent
+	[[nodiscard]] bool restore_snapshot(const struct GameSnapshot& snapshot);
+	
+	// Commands (command_journal.h; implemented in command_journal.cpp)
+	/// Validate and carry out a player order (see the check_* methods); on success
+	/// it is appended to the attached journal and out_id receives the new design or fleet ID
+	/// Every public setter above that changes game state goes through here.
+	[[nodiscard]] ErrorCode execute_command(const struct GameCommand& command, uint32_t* out_id = nullptr);
+	/// Journal recording this game's commands and turns (not owned; nullptr to stop recording)
+	void set_command_journal(class CommandJournal* journal)
+		{ command_journal = journal; }
+	class CommandJournal* get_command_journal() const
+		{ return command_journal; }
+	
+	// Autosave (autosave.h): snapshots the game at the end of due turns for a background writer
+	void set_autosave(class AutosaveService* service)
+		{ autosave = service; }
+	class AutosaveService* get_autosave() const
+		{ return autosave; }
+	
+	// Hibernation support (game_pool.h; implemented in game_pool.cpp)
+	/// Setup this game was created from (what a resumed copy is constructed with)
+	class GameSetup get_setup() const;
+	/// Approximate heap bytes held by the game, derived caches included
+	[[nodiscard]] size_t estimate_memory_usage() const;
 	
 private:
 	// Current game turn
@@ -170,9 +248,6 @@ private:
 	GalaxyGenerationParams galaxy_params;  // Galaxy generation parameters used to create this game
 	std::vector<PlayerSetup> player_setups;  // Player configurations used to create this game
 	
-	// Friend class for Galaxy to access GameState members
-	friend class Galaxy;
-	
 	// ========== IMMUTABLE MAPPINGS (built once, never change) ==========
 	// Entity ID to index mappings - fixed after initialization
 	std::unordered_map<uint32_t, size_t> planet_id_to_index;      // planet ID -> index in galaxy.planets
@@ -181,16 +256,30 @@ private:
 	std::unordered_map<std::string, size_t> player_name_to_index;  // player name -> index in players
 	
 	// ========== MUTABLE MAPPINGS (updated frequently) ==========
-	// Fleet ownership mapping: (player_id, fleet_id) -> fleet index (O(1) lookup)
-	std::unordered_map<uint64_t, size_t> fleet_id_to_index;
+	// Galaxy-wide fleet occupancy: planet_id -> fleet handles grouped by owner
+	// Updated incrementally by Player::build_fleet/delete_fleet/move_fleet and process_ships
+	FleetOccupancyIndex fleet_occupancy;
 	
-	// Per-player fleet mapping: player_id -> vector of fleet indices (updated when fleets change)
-	std::unordered_map<uint32_t, std::vector<size_t>> player_fleets;
+	// Combat resolution engine (keeps scratch buffers between engagements)
+	CombatEngine combat_engine;
+	
+	// Sensor visibility: spatial index plus each player's visible set (indexed like players)
+	VisibilitySystem visibility;
+	std::vector<PlanetBitset> visible_planets;
+	
+	// Alliance ID per player (indexed like players)
+	std::vector<uint32_t> player_alliances;
+	
+	// Journal recording commands and processed turns (not owned)
+	class CommandJournal* command_journal = nullptr;
+	
+	// Background autosave notified after each processed turn (not owned)
+	class AutosaveService* autosave = nullptr;
 	
 	// Note: player_planets mapping removed - use players' colonized_planets instead
 	
-	// Player public information history: player_id -> vector of PlayerPublicInfo (one per turn)
-	std::unordered_map<uint32_t, std::vector<PlayerPublicInfo>> player_info_history;
+	// Player public information history: one column per (player, metric), rows indexed by turn
+	PlayerHistoryStore player_history;
 	
 	// Research advancement cost caches (indexed by tech level)
 	std::vector<int64_t> research_cost_range;
@@ -201,12 +290,17 @@ private:
 	std::vector<int64_t> research_cost_radical;
 	
 	
+	// Empty game for from_save(): text assets only, the rest comes from the save
+	GameState();
+	
 	// Private helper methods
 	void initialize_research_cost_caches();
 	void ensure_research_costs_available(int32_t max_tech_level);
 	
 	std::vector<Player> initialize_players(const std::vector<PlayerSetup>& player_setups);
 	std::unique_ptr<Galaxy> initialize_galaxy(const GalaxyGenerationParams& params);
+	// Generate a galaxy from its own RNG stream seeded by params.seed (see GALAXY_GENERATOR_VERSION)
+	std::unique_ptr<Galaxy> generate_galaxy(const GalaxyGenerationParams& params) const;
 	void initialize_player_knowledge();
 	void build_entity_maps();
 	
@@ -229,6 +323,9 @@ private:
 	void process_planet_mining(Player& player, Planet* planet, int64_t mining_budget);
 	
 	void process_ships();
+	void process_combat();
+	void process_visibility();
+	void share_alliance_knowledge();
 	void process_novae();
 	
 };
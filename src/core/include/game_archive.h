@@ -0,0 +1,322 @@
+#ifndef OPENHO_GAME_ARCHIVE_H
+#define OPENHO_GAME_ARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "enums.h"
+#include "player_history.h"
+#include "serialization.h"
+
+typedef int32_t PlayerID;
+
+struct GameSnapshot;
+class GameState;
+
+// ============================================================================
+// Archive Format
+// ============================================================================
+//
+// Read-only layout for archived games, meant to be memory-mapped and read in
+// place: every table is an array of fixed-size records at an 8-byte aligned
+// offset, so opening an archive checks the header and table bounds and never
+// parses or copies records.
+//   header   : ArchiveHeader
+//   sections : ArchiveSection[section_count]
+//   payloads : one table each, padded to ALIGNMENT
+//
+// Records are stored in the writer's byte order; the header carries a marker
+// so a host with the other byte order rejects the file instead of misreading
+// it.  Record layouts have no implicit padding; changing one bumps the version.
+// Strings live in one blob and are referenced by offset and length.
+//
+// The archive holds what spectator and analysis tools read: the galaxy,
+// planets, players with their colonies and knowledge, and the public history.
+// Resuming a game still needs the full save format (serialization.h).
+
+namespace ArchiveFormat
+{
+	using SaveFormat::make_tag;
+
+	constexpr uint32_t MAGIC = make_tag('O', 'H', 'A', 'R');
+	constexpr uint16_t VERSION = 1;
+	constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+	constexpr size_t ALIGNMENT = 8;
+
+	constexpr uint32_t SECTION_META = make_tag('M', 'E', 'T', 'A');           // ArchiveMeta
+	constexpr uint32_t SECTION_STRINGS = make_tag('S', 'T', 'R', 'S');        // char blob
+	constexpr uint32_t SECTION_HOMES = make_tag('H', 'O', 'M', 'E');          // uint32_t planet index per home planet
+	constexpr uint32_t SECTION_PLANETS = make_tag('P', 'L', 'N', 'T');        // ArchivePlanet
+	constexpr uint32_t SECTION_PLAYERS = make_tag('P', 'L', 'Y', 'R');        // ArchivePlayer
+	constexpr uint32_t SECTION_COLONIES = make_tag('C', 'O', 'L', 'N');       // ArchiveColony, grouped by player
+	constexpr uint32_t SECTION_KNOWLEDGE = make_tag('K', 'N', 'O', 'W');      // ArchiveKnownPlanet, grouped by player
+	constexpr uint32_t SECTION_VISIBILITY = make_tag('V', 'I', 'S', 'B');     // uint64_t visible planet words, grouped by player
+	constexpr uint32_t SECTION_HISTORY = make_tag('H', 'I', 'S', 'T');        // ArchiveHistoryInfo
+	constexpr uint32_t SECTION_HISTORY_IDS = make_tag('H', 'S', 'I', 'D');    // uint32_t player ID per history player
+	constexpr uint32_t SECTION_HISTORY_YEARS = make_tag('H', 'S', 'Y', 'R');  // uint32_t year per row
+	constexpr uint32_t SECTION_HISTORY_COLUMNS = make_tag('H', 'S', 'C', 'L'); // int64_t [player * METRIC_COUNT + metric][row]
+}
+
+// ============================================================================
+// Archive Records
+// ============================================================================
+
+struct ArchiveHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t flags;
+	uint32_t byte_order;            // BYTE_ORDER_MARK as written by the writer
+	uint32_t section_count;
+	uint64_t file_size;
+};
+
+struct ArchiveSection
+{
+	uint32_t tag;
+	uint32_t reserved;
+	uint64_t offset;                // From the start of the archive, multiple of ALIGNMENT
+	uint64_t size;                  // In bytes
+};
+
+/// Reference into the string blob
+struct ArchiveString
+{
+	uint32_t offset;
+	uint32_t length;
+};
+
+/// Range of a per-player group in a grouped table
+struct ArchiveRange
+{
+	uint32_t first;
+	uint32_t count;
+};
+
+struct ArchiveMeta
+{
+	uint32_t current_turn;
+	uint32_t current_year;
+	uint32_t next_fleet_id;
+	uint32_t n_planets;             // Generation parameters
+	uint32_t n_players;
+	uint32_t shape;                 // GalaxyShape
+	uint64_t seed;
+	double density;
+	double cluster_angular_offset;
+	double galaxy_size;
+};
+
+struct ArchivePlanet
+{
+	uint32_t id;
+	PlayerID owner;
+	double x;
+	double y;
+	double true_gravity;
+	double true_temperature;
+	int32_t metal;
+	int32_t population;
+	ArchiveString name;
+	uint32_t nova_state;            // PlanetNovaState
+	uint32_t reserved;
+};
+
+struct ArchivePlayer
+{
+	uint32_t id;
+	uint32_t alliance_id;
+	ArchiveString name;
+	uint32_t gender;                // Gender
+	uint32_t type;                  // PlayerType
+	int32_t iq;
+	uint32_t starting_colony_quality;
+
+	int64_t money_savings;
+	int64_t metal_reserve;
+	int64_t money_income;
+	int64_t metal_income;
+	double ideal_temperature;
+	double ideal_gravity;
+
+	int32_t tech_range;
+	int32_t tech_speed;
+	int32_t tech_weapons;
+	int32_t tech_shields;
+	int32_t tech_mini;
+	int32_t tech_radical;
+
+	ArchiveRange colonies;          // In SECTION_COLONIES
+	ArchiveRange known_planets;     // In SECTION_KNOWLEDGE
+	ArchiveRange visible_words;     // In SECTION_VISIBILITY
+	uint32_t fleet_count;
+	uint32_t ship_count;
+};
+
+struct ArchiveColony
+{
+	uint32_t planet_id;
+	int32_t population;
+	int32_t income;
+	int32_t desirability;
+	double funding_fraction;
+	double mining_fraction;
+	double terraforming_fraction;
+	double apparent_gravity;
+	double apparent_temperature;
+};
+
+/// One player's knowledge of a planet (KnowledgePlanet)
+struct ArchiveKnownPlanet
+{
+	uint32_t id;
+	int32_t metal;
+	double apparent_temperature;
+	double apparent_gravity;
+	PlayerID apparent_owner;
+	int32_t apparent_population;
+	int32_t observation_year;
+	int32_t can_be_profitable;
+	int32_t perceived_value;
+	uint32_t nova_state;            // PlanetNovaState
+};
+
+struct ArchiveHistoryInfo
+{
+	uint32_t player_count;
+	uint32_t metric_count;          // METRIC_COUNT when written
+	uint32_t row_count;
+	uint32_t first_turn;
+	uint64_t retained_turns;
+};
+
+static_assert(sizeof(ArchiveHeader) == 24, "ArchiveHeader layout");
+static_assert(sizeof(ArchiveSection) == 24, "ArchiveSection layout");
+static_assert(sizeof(ArchiveMeta) == 56, "ArchiveMeta layout");
+static_assert(sizeof(ArchivePlanet) == 64, "ArchivePlanet layout");
+static_assert(sizeof(ArchivePlayer) == 136, "ArchivePlayer layout");
+static_assert(sizeof(ArchiveColony) == 56, "ArchiveColony layout");
+static_assert(sizeof(ArchiveKnownPlanet) == 48, "ArchiveKnownPlanet layout");
+static_assert(sizeof(ArchiveHistoryInfo) == 24, "ArchiveHistoryInfo layout");
+
+// ============================================================================
+// ArchiveSpan Template
+// ============================================================================
+
+/// Read-only view of consecutive archive records
+template <typename T>
+struct ArchiveSpan
+{
+	const T* first = nullptr;
+	size_t count = 0;
+
+	const T* begin() const { return first; }
+	const T* end() const { return first + count; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	const T& operator[](size_t i) const { return first[i]; }
+};
+
+// ============================================================================
+// Archive Writing
+// ============================================================================
+
+/// Lay out a snapshot as an archive (replaces the contents of out)
+void write_game_archive(const GameSnapshot& snapshot, std::vector<uint8_t>& out);
+
+/// Write a game's current state to an archive file
+[[nodiscard]] bool save_game_archive(const GameState& game, const std::string& path);
+
+// ============================================================================
+// GameArchiveView Class
+// ============================================================================
+
+/// Typed views over archive bytes owned by someone else (a mapping or a buffer)
+/// open() checks the header, section bounds and alignment, and the per-player
+/// ranges - O(players), independent of the number of planets or turns.
+/// Every accessor returns views straight into the bytes.
+class GameArchiveView
+{
+public:
+	/// Point the view at an archive; data must be 8-byte aligned and outlive the view
+	/// Returns false (and leaves the view closed) if the archive is damaged or foreign
+	[[nodiscard]] bool open(const uint8_t* data, size_t size);
+	void close() { *this = GameArchiveView(); }
+	bool is_open() const { return meta != nullptr; }
+
+	const ArchiveMeta& get_meta() const { return *meta; }
+	ArchiveSpan<uint32_t> get_home_planet_indices() const { return homes; }
+	ArchiveSpan<ArchivePlanet> get_planets() const { return planets; }
+	ArchiveSpan<ArchivePlayer> get_players() const { return players; }
+
+	/// Player data by player index (caller keeps index < get_players().size())
+	ArchiveSpan<ArchiveColony> get_colonies(size_t player_index) const
+		{ return slice(colonies, players[player_index].colonies); }
+	ArchiveSpan<ArchiveKnownPlanet> get_known_planets(size_t player_index) const
+		{ return slice(known_planets, players[player_index].known_planets); }
+	ArchiveSpan<uint64_t> get_visible_planet_words(size_t player_index) const
+		{ return slice(visible_words, players[player_index].visible_words); }
+
+	/// Text of a string reference (empty if it points outside the blob)
+	std::string_view get_string(ArchiveString reference) const;
+
+	// Public history, laid out as in PlayerHistoryStore
+	const ArchiveHistoryInfo& get_history_info() const { return *history; }
+	ArchiveSpan<uint32_t> get_history_player_ids() const { return history_ids; }
+	ArchiveSpan<uint32_t> get_history_years() const { return history_years; }
+	MetricSpan get_metric(size_t player_index, PlayerMetric metric) const
+	{
+		return MetricSpan{ history_columns.first + (player_index * METRIC_COUNT + metric) * history->row_count,
+		                   history->row_count, history->first_turn };
+	}
+
+private:
+	template <typename T>
+	static ArchiveSpan<T> slice(ArchiveSpan<T> table, ArchiveRange range)
+		{ return ArchiveSpan<T>{ table.first + range.first, range.count }; }
+
+	const ArchiveMeta* meta = nullptr;
+	ArchiveSpan<char> strings;
+	ArchiveSpan<uint32_t> homes;
+	ArchiveSpan<ArchivePlanet> planets;
+	ArchiveSpan<ArchivePlayer> players;
+	ArchiveSpan<ArchiveColony> colonies;
+	ArchiveSpan<ArchiveKnownPlanet> known_planets;
+	ArchiveSpan<uint64_t> visible_words;
+	const ArchiveHistoryInfo* history = nullptr;
+	ArchiveSpan<uint32_t> history_ids;
+	ArchiveSpan<uint32_t> history_years;
+	ArchiveSpan<int64_t> history_columns;
+};
+
+// ============================================================================
+// MappedGameArchive Class
+// ============================================================================
+
+/// Archive file mapped read-only into memory
+/// Pages are loaded on first touch and shared with every other process mapping
+/// the same file; nothing is read up front beyond the header and section table.
+class MappedGameArchive
+{
+public:
+	MappedGameArchive() = default;
+	~MappedGameArchive() { close(); }
+	MappedGameArchive(const MappedGameArchive&) = delete;
+	MappedGameArchive& operator=(const MappedGameArchive&) = delete;
+
+	/// Map an archive file; returns false if it cannot be mapped or is not a valid archive
+	[[nodiscard]] bool open(const std::string& path);
+	void close();
+	bool is_open() const { return view.is_open(); }
+
+	const GameArchiveView& get_view() const { return view; }
+
+private:
+	const uint8_t* mapping = nullptr;
+	size_t mapping_size = 0;
+	GameArchiveView view;
+};
+
+#endif // OPENHO_GAME_ARCHIVE_H
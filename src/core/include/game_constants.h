@@ -135,6 +135,58 @@ namespace GameConstants
 		60000        // START_ABUNDANT
 	};
 	
+	// ========================================================================
+	// Combat
+	// ========================================================================
+	
+	/// Maximum number of exchange rounds fought at a contested planet per turn.
+	/// Combat stops earlier once only one owner has ships left.
+	constexpr uint32_t Combat_Max_Rounds = 8;
+	
+	/// Damage dealt per round by one ship at weapons tech 0, and the increase per weapons level.
+	constexpr double Combat_Base_Attack = 1.0;
+	constexpr double Combat_Attack_Per_Weapons_Level = 0.15;
+	
+	/// Damage one ship absorbs before being destroyed at shields tech 0, and the increase per shields level.
+	constexpr double Combat_Base_Defense = 2.0;
+	constexpr double Combat_Defense_Per_Shields_Level = 0.3;
+	
+	// ========================================================================
+	// Sensors
+	// ========================================================================
+	
+	/// Distance within which a colony observes planets and the fleets stationed at them.
+	/// At the default density a colony sees its 3-4 nearest neighbours.
+	constexpr double Sensor_Range_Colony = 12.0;
+	
+	/// Distance within which a stationed fleet observes planets and fleets.
+	constexpr double Sensor_Range_Fleet = 8.0;
+	
+	// ========================================================================
+	// Knowledge
+	// ========================================================================
+	
+	/// Game years that pass each turn.
+	constexpr int32_t Years_Per_Turn = 10;
+	
+	/// Number of most recent turns of knowledge deltas kept in each player's change log.
+	constexpr uint32_t Knowledge_Change_Log_Turns = 16;
+	
+	/// Number of most recent turns of knowledge snapshots kept for each player
+	/// (KnowledgeGalaxy::get_planet(id, turn) answers nothing older).
+	constexpr uint32_t Knowledge_History_Turns = 32;
+	
+	// ========================================================================
+	// Player Metrics
+	// ========================================================================
+	
+	/// Fleet power of one ship = round(attack strength * defense strength * Fleet_Power_Scale).
+	constexpr double Fleet_Power_Scale = 10.0;
+	
+	/// Victory points for holding a colony, plus one point per Population_Per_Victory_Point inhabitants.
+	constexpr int32_t Victory_Points_Per_Colony = 10;
+	constexpr int32_t Population_Per_Victory_Point = 100000;
+	
 	// ========================================================================
 	// Future Balance Parameters
 	// ========================================================================
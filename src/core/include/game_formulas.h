@@ -60,13 +60,63 @@ namespace GameFormulas
 	                                          int32_t tech_weapons, int32_t tech_shields, 
 	                                          int32_t tech_mini);
 	
+	// ========================================================================
+	// Fleet Movement Calculations
+	// ========================================================================
+	
+	/// Calculate the number of turns a fleet needs to cover a distance.
+	/// 
+	/// @param distance Distance in light-years (from the distance matrix)
+	/// @param ship_range Range of the fleet's ship design
+	/// @return Travel time in turns (at least 1)
+	uint32_t calculate_travel_turns(double distance, int32_t ship_range);
+	
+	/// Calculate the fuel consumed by a single hop.
+	/// 
+	/// @param distance Distance in light-years (from the distance matrix)
+	/// @return Fuel units consumed
+	int32_t calculate_fuel_cost(double distance);
+	
+	// ========================================================================
+	// Combat Calculations
+	// ========================================================================
+	
+	/// Calculate the damage a single ship deals per combat round.
+	/// 
+	/// @param tech_weapons The weapons technology level of the ship's design
+	/// @return Damage dealt per round
+	double calculate_ship_attack_strength(int32_t tech_weapons);
+	
+	/// Calculate the damage a single ship absorbs before it is destroyed.
+	/// 
+	/// @param tech_shields The shields technology level of the ship's design
+	/// @return Damage absorbed (always positive)
+	double calculate_ship_defense_strength(int32_t tech_shields);
+	
 	// ========================================================================
 	// Player Metrics Calculations
 	// ========================================================================
 	
+	/// Calculate the fleet power contributed by one ship of a design.
+	/// A fleet contributes ship_count times this value.
+	/// 
+	/// @param tech_weapons The weapons technology level of the ship's design
+	/// @param tech_shields The shields technology level of the ship's design
+	/// @return Fleet power per ship
+	int64_t calculate_ship_power(int32_t tech_weapons, int32_t tech_shields);
+	
+	/// Calculate the victory points contributed by one colony.
+	/// A player's victory points are the sum over their colonies.
+	/// 
+	/// @param population The colony's population
+	/// @return Victory points for the colony
+	int32_t calculate_colony_victory_points(int32_t population);
+	
 	/// Calculate the fleet power for a player based on their ships.
 	/// Fleet power represents the combat strength of all a player's ships.
 	/// This is a public metric visible to all players.
+	/// Full recompute over every fleet - Player keeps the same total incrementally
+	/// (Player::get_fleet_power()); this is the reference it is checked against.
 	/// 
 	/// @param playerID The player to calculate fleet power for
 	/// @param gameState Reference to the game state (for accessing ships)
@@ -76,6 +126,8 @@ namespace GameFormulas
 	/// Calculate the victory points for a player based on various factors.
 	/// Victory points represent a player's overall progress and strength.
 	/// This is a public metric visible to all players.
+	/// Full recompute over every colony - Player keeps the same total incrementally
+	/// (Player::get_victory_points()); this is the reference it is checked against.
 	/// 
 	/// @param playerID The player to calculate victory points for
 	/// @param gameState Reference to the game state (for accessing planets, ships, etc.)
@@ -0,0 +1,137 @@
+#ifndef OPENHO_GAME_POOL_H
+#define OPENHO_GAME_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class GameState;
+
+// ============================================================================
+// GamePool Class
+// ============================================================================
+
+/// The live games of a multi-game host, hibernating idle ones to fit a memory budget
+///
+/// A hibernated game is only its save (serialization.h) and setup: the galaxy,
+/// distance matrix, neighbour graph, knowledge, indices and caches are freed,
+/// and resuming rebuilds them from the save.  Resuming is a load, so the game
+/// comes back as a save keeps it; per-turn knowledge history and change logs
+/// restart from the resume turn.
+///
+/// Whenever the estimated footprint of the resident games exceeds the budget,
+/// the least recently used ones are hibernated.  Games with a command journal
+/// or autosave attached are never hibernated, since those point into the game,
+/// and neither is a game while a Lease on it is held.
+class GamePool
+{
+public:
+	typedef uint64_t GameId;
+
+	/// An acquired game, kept resident for as long as the lease is held
+	/// While any lease on a game exists, the budget skips it and hibernate() and
+	/// remove() refuse it, so the game pointer cannot dangle.  Move-only; a lease
+	/// must not outlive its pool.
+	class Lease
+	{
+	public:
+		Lease() = default;
+		~Lease() { release(); }
+
+		Lease(Lease&& other) noexcept;
+		Lease& operator=(Lease&& other) noexcept;
+		Lease(const Lease&) = delete;
+		Lease& operator=(const Lease&) = delete;
+
+		GameState* get() const { return game; }
+		GameState* operator->() const { return game; }
+		GameState& operator*() const { return *game; }
+		explicit operator bool() const { return game != nullptr; }
+
+		/// Give the game back early; the lease is empty afterwards
+		void release();
+
+	private:
+		friend class GamePool;
+		Lease(GamePool& pool, GameId id, GameState* game) : pool(&pool), id(id), game(game) {}
+
+		GamePool* pool = nullptr;
+		GameId id = 0;
+		GameState* game = nullptr;
+	};
+
+	struct Stats
+	{
+		size_t resident_games = 0;
+		size_t hibernated_games = 0;
+		size_t resident_bytes = 0;          // Estimated (GameState::estimate_memory_usage())
+		size_t hibernated_bytes = 0;        // Saves held for hibernated games
+		uint64_t hibernations = 0;
+		uint64_t resumes = 0;
+		double last_resume_ms = 0.0;
+		double max_resume_ms = 0.0;
+	};
+
+	/// memory_budget: estimated bytes the resident games may use (0 = no limit)
+	explicit GamePool(size_t memory_budget = 0);
+	~GamePool();
+
+	GamePool(const GamePool&) = delete;
+	GamePool& operator=(const GamePool&) = delete;
+
+	/// Take ownership of a game, as the most recently used; returns its ID
+	GameId add(std::unique_ptr<GameState> game);
+
+	/// Lease the game, resumed if needed, as the most recently used
+	/// The lease is empty if the ID is unknown or the game could not be resumed.
+	/// Besides leased games, the game acquired last is never hibernated by the budget.
+	[[nodiscard]] Lease acquire(GameId id);
+
+	/// Compact a resident game into its save; false if unknown, already
+	/// hibernated, leased, or attached to a journal or autosave
+	bool hibernate(GameId id);
+
+	/// Rebuild a hibernated game straight from its save (GameState::from_save()),
+	/// without changing its place in the LRU order
+	/// Returns false (the game stays hibernated) if its save does not load
+	bool resume(GameId id);
+
+	/// Destroy a game, resident or hibernated; false if unknown or leased
+	bool remove(GameId id);
+
+	bool contains(GameId id) const { return games.count(id) != 0; }
+	bool is_hibernated(GameId id) const;
+
+	/// Change the budget, hibernating at once if it is exceeded
+	void set_memory_budget(size_t bytes);
+	size_t get_memory_budget() const { return memory_budget; }
+
+	/// Hibernate the least recently used games until the resident estimate fits
+	/// the budget (games grow as turns are played); returns the number hibernated
+	size_t enforce_budget();
+
+	/// Counts and sizes now, plus totals since the pool was created
+	Stats get_stats() const;
+
+private:
+	struct Entry
+	{
+		std::unique_ptr<GameState> game;        // Null while hibernated
+		std::vector<uint8_t> save;              // Set while hibernated
+		std::list<GameId>::iterator lru;        // Position in lru (front = most recent)
+		uint32_t leases = 0;                    // Leases held on the game
+	};
+
+	void touch(Entry& entry);
+
+	size_t memory_budget;
+	GameId next_id = 1;
+	std::unordered_map<GameId, Entry> games;
+	std::list<GameId> lru;
+	Stats totals;                               // hibernations, resumes and resume times
+};
+
+#endif // OPENHO_GAME_POOL_H
@@ -33,6 +33,10 @@ class GameSetup
 {
 public:
 	GameSetup();
+	
+	/// Construct a setup from parameters collected elsewhere (no user interaction)
+	/// Used by tools, tests and benchmarks that create games programmatically
+	GameSetup(const GalaxyGenerationParams& params, const std::vector<PlayerSetup>& players);
 	~GameSetup();
 	
 	/// Start a new game setup flow
@@ -0,0 +1,137 @@
+#ifndef OPENHO_GAME_SNAPSHOT_H
+#define OPENHO_GAME_SNAPSHOT_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "enums.h"
+#include "planet.h"
+#include "galaxy.h"
+#include "ship_design.h"
+#include "fleet.h"
+#include "knowledge_planet.h"
+#include "player.h"
+#include "player_history.h"
+
+// ============================================================================
+// GameSnapshot Records
+// ============================================================================
+// Plain copies of everything needed to rebuild a GameState.  Derived data
+// (distance matrix, neighbour graph, spatial index, reachability, metric
+// totals, research cost caches) is not stored: it is rebuilt on restore.
+// Pointers in the live state become IDs here.
+
+/// A player's colony (or their knowledge of one)
+struct ColonyRecord
+{
+	uint32_t planet_id;
+	double funding_fraction;
+	int32_t population;
+	int32_t income;
+	double mining_fraction;
+	double terraforming_fraction;
+	double apparent_gravity;
+	double apparent_temperature;
+	int32_t desirability;
+
+	static ColonyRecord from(const ColonizedPlanet& colony);
+};
+
+/// A fleet, with its design and position as IDs
+struct FleetRecord
+{
+	uint32_t id;
+	uint32_t design_id;
+	uint32_t ship_count;
+	int32_t fuel;
+	std::string descriptor;
+	uint32_t planet_id;                   // Planet the fleet is stationed at (0 while in transit)
+	std::optional<FleetTransit> transit;
+};
+
+/// An enemy fleet a player can see, and where
+struct EnemyFleetRecord
+{
+	uint32_t planet_id;
+	FleetVisibleInfo info;
+};
+
+/// One stationed fleet in FleetOccupancyIndex order (order decides combat draws)
+struct OccupancyRecord
+{
+	uint32_t planet_id;
+	PlayerID owner;
+	uint32_t fleet_id;
+};
+
+/// Everything stored for one player
+struct PlayerRecord
+{
+	uint32_t id = 0;
+	std::string name;
+	Gender gender = GENDER_OTHER;
+	PlayerType type = PLAYER_HUMAN;
+	int32_t iq = 0;
+	StartingColonyQuality starting_colony_quality = START_NORMAL;
+
+	int64_t money_savings = 0;
+	int64_t metal_reserve = 0;
+	int64_t money_income = 0;
+	int64_t metal_income = 0;
+	double ideal_temperature = 0.0;
+	double ideal_gravity = 0.0;
+
+	Player::TechnologyLevels tech{};
+	Player::IncomeBreakdown income{};
+	Player::MoneyAllocation allocation{};
+	Player::PartialResearchProgress research{};
+
+	uint32_t next_ship_design_id = 1;
+	uint32_t alliance_id = 0;
+
+	std::vector<ColonyRecord> colonies;
+	std::vector<ShipDesign> designs;
+	std::vector<FleetRecord> fleets;
+
+	// Knowledge (records in order of first observation)
+	std::vector<KnowledgePlanet> known_planets;
+	KnowledgeGalaxy::FrozenKnowledge frozen_knowledge;  // Pinned instead, until expanded
+	std::vector<ColonyRecord> known_colonizations;
+	std::vector<EnemyFleetRecord> enemy_fleets;
+	std::vector<uint64_t> visible_planet_words;
+};
+
+// ============================================================================
+// GameSnapshot Struct
+// ============================================================================
+
+/// Complete, self-contained copy of a game between turns
+/// Produced by GameState::capture_snapshot() and consumed by restore_snapshot();
+/// serialization.h turns it into bytes and back.
+struct GameSnapshot
+{
+	uint32_t current_turn = 0;
+	uint32_t current_year = 0;
+	uint32_t next_fleet_id = 1;
+
+	GalaxyGenerationParams galaxy_params;
+	GalaxyCoord galaxy_size = 0.0;
+	std::vector<size_t> home_planet_indices;
+	std::vector<Planet> planets;
+
+	std::vector<PlayerRecord> players;
+	std::vector<OccupancyRecord> occupancy;
+	PlayerHistoryStore history;
+
+	uint64_t deterministic_seed = 0;
+	uint64_t ai_seed = 0;
+	std::vector<uint8_t> deterministic_rng_state;     // RNGStateFormat (Boost text in older saves)
+	std::vector<uint8_t> ai_rng_state;
+};
+
+/// Turn the pinned knowledge of a GameState::capture_frozen_snapshot() into
+/// known_planets, releasing the pages (needs no GameState, so any thread can do it)
+void expand_frozen_knowledge(GameSnapshot& snapshot);
+
+#endif // OPENHO_GAME_SNAPSHOT_H
@@ -183,6 +183,26 @@ ErrorCode game_player_move_fleet(
 	uint32_t destination_planet_id
 );
 
+/**
+ * Disband a player's fleet (with validation)
+ * Returns: error code
+ */
+ErrorCode game_player_delete_fleet(
+	GameState* game_state,
+	uint32_t player_id,
+	uint32_t fleet_id
+);
+
+/**
+ * Refuel a player's fleet at its current planet (with validation)
+ * Returns: error code
+ */
+ErrorCode game_player_refuel_fleet(
+	GameState* game_state,
+	uint32_t player_id,
+	uint32_t fleet_id
+);
+
 // ============================================================================
 // Planet Allocation Validation & Actions
 // ============================================================================
@@ -215,6 +235,84 @@ ErrorCode game_player_set_planet_allocation(
 	double terraforming_fraction
 );
 
+// ============================================================================
+// Player History Export
+// ============================================================================
+
+/**
+ * Zero-copy view of one public metric of one player over consecutive turns
+ * Value i (turn first_turn + i) is at (const char*)values + i * stride.
+ * Plain C layout with fixed-width fields only; safe to mirror in Swift or ctypes.
+ * The pointer stays valid until the next game turn is processed.
+ */
+typedef struct PlayerHistoryView
+{
+	const int64_t* values;      // First value, or NULL if count == 0
+	uint32_t count;             // Number of values
+	uint32_t stride;            // Bytes between consecutive values
+	uint32_t first_turn;        // Turn of the first value
+	uint32_t reserved;          // Always 0
+} PlayerHistoryView;
+
+/**
+ * Get the number of public metrics per player per turn (PlayerMetric values 0 .. count-1)
+ */
+uint32_t game_get_player_metric_count(void);
+
+/**
+ * Get the range of turns held in the public history
+ * Returns: error code (INVALID_PARAMETER if the history is empty)
+ */
+ErrorCode game_get_player_history_turns(
+	const GameState* game_state,
+	uint32_t* out_first_turn,
+	uint32_t* out_last_turn
+);
+
+/**
+ * Get a zero-copy view of one metric for one player over turns [first_turn, last_turn]
+ * The range is clipped to the turns held; an empty view is not an error.
+ * Returns: error code
+ */
+ErrorCode game_get_player_metric_view(
+	const GameState* game_state,
+	uint32_t player_id,
+	uint32_t metric,
+	uint32_t first_turn,
+	uint32_t last_turn,
+	PlayerHistoryView* out
+);
+
+/**
+ * Get a zero-copy view of one metric for one player from since_turn (inclusive) to the latest turn
+ * Clients that keep their own copy pass (last turn they hold + 1) to fetch only new rows.
+ * Returns: error code
+ */
+ErrorCode game_get_player_metric_since(
+	const GameState* game_state,
+	uint32_t player_id,
+	uint32_t metric,
+	uint32_t since_turn,
+	PlayerHistoryView* out
+);
+
+/**
+ * Copy every metric of one player from since_turn (inclusive), oldest first, up to max_rows turns
+ * out_values must hold game_get_player_metric_count() * max_rows values and is filled
+ * metric-major: value of metric m at row r is out_values[m * (*out_rows) + r]
+ * (one memcpy per metric).  Row r is turn (*out_first_turn + r).
+ * Returns: error code
+ */
+ErrorCode game_copy_player_history(
+	const GameState* game_state,
+	uint32_t player_id,
+	uint32_t since_turn,
+	int64_t* out_values,
+	uint32_t max_rows,
+	uint32_t* out_rows,
+	uint32_t* out_first_turn
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,111 @@
+#ifndef OPENHO_KNOWLEDGE_DELTA_H
+#define OPENHO_KNOWLEDGE_DELTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "enums.h"
+
+// ============================================================================
+// Forward Declarations
+// ============================================================================
+
+typedef int32_t PlayerID;
+
+struct KnowledgePlanet;
+class ByteWriter;
+class ByteReader;
+
+// ============================================================================
+// KnowledgeDelta Struct
+// ============================================================================
+
+/// What a player learned about one planet in one observation.
+/// changed_fields is a mask of KnowledgeField bits; only the matching values
+/// are meaningful (the others hold the values the player already knew).
+/// Encoded, a delta carries only the masked values: varint planet ID, mask
+/// byte, then each set field in bit order (doubles raw, integers as zigzag varints).
+struct KnowledgeDelta
+{
+	uint32_t planet_id;
+	uint32_t changed_fields;        // KnowledgeField bits
+
+	double apparent_temperature;
+	double apparent_gravity;
+	int32_t metal;
+	PlayerID apparent_owner;
+	int32_t apparent_population;
+	int32_t observation_year;
+	int32_t can_be_profitable;
+	int32_t perceived_value;
+
+	/// Capture the current observable values of a planet with a change mask
+	static KnowledgeDelta capture(const KnowledgePlanet& planet, uint32_t changed_fields);
+
+	/// Apply the changed fields to another copy of the planet's knowledge (e.g. a client mirror)
+	void apply_to(KnowledgePlanet& planet) const;
+
+	/// Append the variable-length encoding (planet ID, mask, masked fields only)
+	void encode(ByteWriter& w) const;
+
+	/// Read one encoded delta; fields outside the mask are zeroed
+	/// Returns false on truncated or malformed input.
+	bool decode(ByteReader& r);
+};
+
+// ============================================================================
+// KnowledgeChangeLog Class
+// ============================================================================
+
+/// Per-player log of knowledge deltas, segmented by turn.
+/// Deltas are stored encoded and contiguously; each turn is a byte range of the
+/// log, so a client or AI can read exactly what changed in a turn without a full
+/// dump, and the range can be sent as-is.  Every observation that changes the
+/// record is logged, including a refresh of only the observation year, so a
+/// mirror replaying the log keeps the same observation years as the player.
+/// Only the most recent GameConstants::Knowledge_Change_Log_Turns turns are kept.
+class KnowledgeChangeLog
+{
+public:
+	/// Start recording deltas for a turn (no-op if that turn is already current)
+	void begin_turn(uint32_t turn);
+
+	/// Record a delta for the current turn (turn 0 if no turn has begun)
+	void append(const KnowledgeDelta& delta);
+
+	/// Decode the deltas recorded during a turn into out (cleared first)
+	/// Returns the number of entries (0 if the turn is not retained)
+	size_t get_turn_deltas(uint32_t turn, std::vector<KnowledgeDelta>& out) const;
+
+	/// Encoded deltas recorded during a turn, for sending on without decoding
+	/// Writes the first byte to first and returns the byte count (0 if the turn is not retained)
+	size_t get_turn_bytes(uint32_t turn, const uint8_t*& first) const;
+
+	/// Decode a byte range from get_turn_bytes() into out (cleared first)
+	/// Returns false on truncated or malformed input.
+	static bool decode_deltas(const uint8_t* data, size_t size, std::vector<KnowledgeDelta>& out);
+
+	/// Oldest and newest turns still in the log (equal when only one turn is held)
+	uint32_t get_oldest_turn() const { return turns.empty() ? 0 : turns.front().turn; }
+	uint32_t get_current_turn() const { return turns.empty() ? 0 : turns.back().turn; }
+
+	/// Total deltas retained, and the bytes holding them
+	size_t get_delta_count() const { return delta_count; }
+	size_t get_byte_count() const { return bytes.size(); }
+
+private:
+	struct TurnSegment
+	{
+		uint32_t turn;
+		size_t first;       // Offset of the turn's first encoded delta
+		size_t count;       // Deltas in the turn
+	};
+
+	std::vector<uint8_t> bytes;         // Encoded deltas, turn after turn
+	std::vector<TurnSegment> turns;     // Ascending by turn
+	size_t delta_count = 0;
+
+	void discard_oldest_turn();
+};
+
+#endif // OPENHO_KNOWLEDGE_DELTA_H
@@ -2,8 +2,16 @@
 #define OPENHO_KNOWLEDGE_GALAXY_H
 
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "knowledge_planet.h"
+#include "knowledge_delta.h"
+#include "observation_index.h"
+#include "colonized_planet.h"
+#include "planet_identity.h"
+#include "route_planner.h"
 
 // ============================================================================
 // Forward Declarations
@@ -20,14 +28,93 @@ class Player;
 // ============================================================================
 
 // Player's knowledge of the galaxy
-// Contains KnowledgePlanets representing the player's view of each planet
-// Primarily self-sufficient for validation; can reference real galaxy if needed
+// Sparse: only planets the player has observed (or colonized) have a KnowledgePlanet record.
+// Planets without a record are unknown apart from their identity, which comes from the
+// galaxy's shared PlanetIdentityTable.  Distances and neighbour lists are likewise shared,
+// so creating a view costs O(1) and memory grows with what the player has actually seen.
+//
+// History: records live in fixed-size pages.  commit_snapshot() freezes a shared,
+// immutable copy of each page whose records changed since the previous commit, so a
+// turn costs in proportion to what the player learned.  Re-observing a planet that is
+// unchanged only advances its observation year, which is written in place and does not
+// count as a change: a frozen version keeps the observation years it was frozen with.
+// Each page keeps its own version list, so get_planet(id, turn) is a hash lookup plus a
+// binary search; versions older than GameConstants::Knowledge_History_Turns are dropped
+// by the game each turn.
 class KnowledgeGalaxy
 {
+public:
+	/// Fixed-capacity block of records
+	struct KnowledgePage
+	{
+		static constexpr uint32_t CAPACITY = 32;
+		std::vector<KnowledgePlanet> records;  // Reserved to CAPACITY
+	};
+	
+	/// Every known record as shared read-only pages, for another thread to read
+	/// Observation years are held apart: a year-only refresh does not freeze a new
+	/// version, so a pinned version can carry older years than the live record.
+	struct FrozenKnowledge
+	{
+		std::vector<std::shared_ptr<const KnowledgePage>> pages;
+		std::vector<int32_t> observation_years;  // Per record, in slot order
+		
+		size_t size() const { return observation_years.size(); }
+		void clear() { pages.clear(); observation_years.clear(); }
+		
+		/// Append the records, with their current observation years, in order of first observation
+		void expand(std::vector<KnowledgePlanet>& out) const;
+		
+		/// Call fn(const KnowledgePlanet&, int32_t observation_year) for every record, in the same order
+		template<typename Fn>
+		void for_each_record(Fn&& fn) const
+		{
+			size_t slot = 0;
+			for (const auto& page : pages)
+			{
+				for (const KnowledgePlanet& record : page->records)
+					{ fn(record, observation_years[slot++]); }
+			}
+		}
+	};
+	
 private:
-	const Galaxy* real_galaxy;  // Reference to the real galaxy (for edge cases)
-	std::vector<KnowledgePlanet> knowledge_planets;  // Player's knowledge of each planet (indexed by planet_id)
-	std::vector<std::vector<double>> distance_matrix;  // Local copy of distance matrix for O(1) access
+	/// A page as it stood at the end of a turn
+	struct PageVersion
+	{
+		uint32_t turn;
+		std::shared_ptr<const KnowledgePage> page;
+	};
+	
+	const Galaxy* real_galaxy;  // Reference to the real galaxy (identity, distances, neighbours)
+	
+	// Known planets, in order of first observation (slot = page * CAPACITY + index)
+	std::vector<std::unique_ptr<KnowledgePage>> pages;
+	std::unordered_map<uint32_t, uint32_t> record_slots;  // planet_id -> slot
+	
+	// Snapshot history: per page, versions in ascending turn order
+	std::vector<std::vector<PageVersion>> page_history;
+	std::vector<uint32_t> dirty_pages;  // Pages whose records changed since the last commit
+	std::vector<uint8_t> page_dirty;    // Per page: listed in dirty_pages
+	
+	// Record the page as changed (it is frozen again at the next commit)
+	KnowledgePage& get_writable_page(uint32_t page_index);
+	KnowledgePlanet& get_record(uint32_t slot)
+		{ return pages[slot / KnowledgePage::CAPACITY]->records[slot % KnowledgePage::CAPACITY]; }
+	
+	// Side tables for the few planets with variable-size knowledge
+	std::unordered_map<uint32_t, ColonizedPlanet> colonizations;  // planet_id -> this player's colony data
+	std::vector<uint32_t> enemy_fleet_planet_ids;  // Sorted; parallel to enemy_fleets
+	std::vector<FleetVisibleInfo> enemy_fleets;    // Enemy fleets visible this turn, grouped by planet
+	
+	KnowledgeChangeLog change_log;  // What this player learned, turn by turn
+	
+	// Planets whose record changed during the current turn (freshness itself is observation_year)
+	PlanetBitset changed_this_turn;
+	
+	// Staleness indexes, maintained by observe_planet()
+	ObservationAgeIndex observation_age;   // Every observed planet, by last observation year
+	ObservationAgeIndex enemy_colony_age;  // Planets last seen owned by another player
 	PlayerID player_id;
 	
 	// Space planets for holding in-transit fleets
@@ -35,29 +122,155 @@ private:
 	KnowledgePlanet* space_knowledge_planet;  // Player's knowledge view of the space planet
 
 public:
-	// Constructor - initializes with partial info for all planets
+	// Constructor - starts with no planet records (everything unknown)
 	KnowledgeGalaxy(const Galaxy& galaxy, PlayerID player_id);
 	
 	// Destructor - cleans up space_real_planet
 	~KnowledgeGalaxy();
 	
 	// Accessors
+	// Record for a planet, or nullptr if the player has never observed it
+	// The non-const overload counts as a write (the record is included in the next snapshot)
 	KnowledgePlanet* get_planet(uint32_t planet_id);
 	const KnowledgePlanet* get_planet(uint32_t planet_id) const;
 	
-	size_t get_planet_count() const { return knowledge_planets.size(); }
+	// Record for a planet, creating an all-unknown record if there is none
+	// Returns nullptr if the planet ID is not in the galaxy
+	KnowledgePlanet* get_or_create_planet(uint32_t planet_id);
+	
+	// Copy of the player's knowledge of a planet (all fields unknown if never observed)
+	KnowledgePlanet get_planet_or_unknown(uint32_t planet_id) const;
+	
+	// Is there a record for this planet?
+	bool is_planet_known(uint32_t planet_id) const { return record_slots.count(planet_id) != 0; }
+	
+	// Number of planets in the galaxy, and number this player has records for
+	size_t get_planet_count() const;
+	size_t get_known_planet_count() const { return record_slots.size(); }
+	
+	// Approximate heap bytes held, including snapshot history and the change log
+	size_t estimate_memory_usage() const;
+	
+	// ========================================================================
+	// Staleness Queries (output-sensitive)
+	// ========================================================================
+	
+	// Append planets last observed before a year, oldest first, up to max_count
+	// (planets never observed at all are not included)
+	void get_planets_observed_before(int32_t year, size_t max_count, std::vector<uint32_t>& out) const
+		{ observation_age.collect_observed_before(year, max_count, out); }
+	
+	// Append planets last seen owned by another player, oldest observation first, up to max_count
+	void get_oldest_enemy_colonies(size_t max_count, std::vector<uint32_t>& out) const
+		{ enemy_colony_age.collect_observed_before(INT32_MAX, max_count, out); }
+	
+	const ObservationAgeIndex& get_observation_age_index() const { return observation_age; }
+	
+	// ========================================================================
+	// Knowledge History (copy-on-write snapshots)
+	// ========================================================================
+	
+	// Freeze the current knowledge as the state at the end of a turn
+	// Cost is proportional to the pages whose records changed since the previous commit
+	void commit_snapshot(uint32_t turn);
+	
+	// What the player knew about a planet at the end of a turn
+	// Returns nullptr if the planet was unknown then (or the turn predates the retained history)
+	// The observation year is that of the last change committed by then, not of the last sighting
+	const KnowledgePlanet* get_planet(uint32_t planet_id, uint32_t turn) const;
+	
+	// Drop page versions that are no longer needed to answer queries for turns >= turn
+	void discard_snapshots_before(uint32_t turn);
+	
+	// Pin the current knowledge for a reader on another thread (see FrozenKnowledge)
+	// Pages unchanged since the last commit share that commit's version; only
+	// pages changed since are copied, so a player who learned nothing copies no records.
+	void freeze(FrozenKnowledge& out) const;
+	
+	// Call fn(const KnowledgePlanet&) for every known planet, in order of first observation
+	template<typename Fn>
+	void for_each_known_planet(Fn&& fn) const
+	{
+		for (const auto& page : pages)
+		{
+			for (const KnowledgePlanet& record : page->records)
+				{ fn(record); }
+		}
+	}
+	
+	// Call fn(planet_id, const ColonizedPlanet&) for every entry of the colonization side table
+	template<typename Fn>
+	void for_each_colonization(Fn&& fn) const
+	{
+		for (const auto& entry : colonizations)
+			{ fn(entry.first, entry.second); }
+	}
+	
+	// Call fn(planet_id, const FleetVisibleInfo&) for every visible enemy fleet, by ascending planet ID
+	template<typename Fn>
+	void for_each_enemy_fleet(Fn&& fn) const
+	{
+		for (size_t i = 0; i < enemy_fleets.size(); ++i)
+			{ fn(enemy_fleet_planet_ids[i], enemy_fleets[i]); }
+	}
+	
+	// Re-create a record exactly as saved (loading a game)
+	// Updates the staleness indexes but not the change log; returns false for an unknown planet ID
+	bool restore_planet(const KnowledgePlanet& record);
+	
+	// Which player this knowledge belongs to
+	PlayerID get_player_id() const { return player_id; }
+	
+	// Immutable identity shared by all players (name, coordinates)
+	const PlanetIdentity* get_planet_identity(uint32_t planet_id) const;
+	const std::string& get_planet_name(uint32_t planet_id) const;
+	
+	// Colonization side table (planets this player has colonized)
+	ColonizedPlanet* get_colonization(uint32_t planet_id);
+	const ColonizedPlanet* get_colonization(uint32_t planet_id) const;
+	void set_colonization(uint32_t planet_id, const ColonizedPlanet& colonization);
+	void clear_colonization(uint32_t planet_id);
+	
+	// Visible enemy fleets side table (rebuilt every turn by the visibility phase)
+	// Stationed friendly fleets are found through GameState's FleetOccupancyIndex
+	FleetVisibleRange get_enemy_fleets(uint32_t planet_id) const;
+	void clear_enemy_fleets();
+	void add_visible_enemy_fleet(uint32_t planet_id, const FleetVisibleInfo& fleet_info);
+	size_t get_enemy_fleet_count() const { return enemy_fleets.size(); }
 	
 	// Update player's knowledge of a planet
-	void observe_planet(uint32_t planet_id, const Planet& real_planet, const Player* observer, int32_t current_year);
+	// Appends a delta to the change log, and marks the record for the next snapshot, only if
+	// a field other than the observation year changed
+	// Returns the KnowledgeField mask of changed fields
+	uint32_t observe_planet(uint32_t planet_id, const Planet& real_planet, const Player* observer, int32_t current_year);
+	
+	// Start a new turn: opens the change log segment and clears changed_this_turn
+	void begin_turn(uint32_t turn);
+	
+	// Planets whose record changed this turn (bit N set = planet ID N)
+	const PlanetBitset& get_changed_this_turn() const { return changed_this_turn; }
+	
+	// Alliance sharing: adopt every observation the ally made this turn that is newer
+	// than ours.  Walks the ally's changed_this_turn bitset word by word, skipping planets
+	// we already observed this turn, and re-derives apparent values for observer.
+	// Returns the number of planets updated
+	uint32_t merge_from(const KnowledgeGalaxy& ally, const Player* observer);
+	
+	// Per-turn log of knowledge deltas
+	KnowledgeChangeLog& get_change_log() { return change_log; }
+	const KnowledgeChangeLog& get_change_log() const { return change_log; }
 	
 	// Access to real galaxy (for edge cases)
 	const Planet* get_real_planet(uint32_t planet_id) const;
 	
-	// Get distance between two planets (O(1) local lookup, no network latency)
+	// Get distance between two planets (O(1) lookup in the galaxy's shared matrix)
 	// Returns Euclidean distance rounded to nearest integer
 	// Throws std::out_of_range if planet IDs are invalid
 	double get_distance(uint32_t from_id, uint32_t to_id) const;
 	
+	// Neighbour lists sorted by distance (serves every range via prefixes)
+	const PlanetNeighbourGraph& get_neighbour_graph() const;
+	
 	// Access to space planet (for in-transit fleets)
 	Planet* get_space_real_planet() { return space_real_planet; }
 	const Planet* get_space_real_planet() const { return space_real_planet; }
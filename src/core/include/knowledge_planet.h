@@ -1,10 +1,9 @@
 #ifndef OPENHO_KNOWLEDGE_PLANET_H
 #define OPENHO_KNOWLEDGE_PLANET_H
 
+#include <cstddef>
 #include <cstdint>
-#include <memory>
-#include <string>
-#include <vector>
+#include <type_traits>
 #include "enums.h"
 #include "planet.h"
 
@@ -17,7 +16,6 @@ typedef int32_t PlayerID;
 typedef double GalaxyCoord;
 
 class Player;
-struct Fleet;
 
 // ============================================================================
 // FleetVisibleInfo Struct
@@ -32,55 +30,55 @@ struct FleetVisibleInfo
 	// TODO: Add more observable properties as needed (design type, fuel level, etc.)
 };
 
+/// Contiguous run of visible fleets at one planet
+struct FleetVisibleRange
+{
+	const FleetVisibleInfo* first;
+	size_t count;
+
+	const FleetVisibleInfo* begin() const { return first; }
+	const FleetVisibleInfo* end() const { return first + count; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+};
+
 // ============================================================================
-// KnowledgePlanet Class
+// KnowledgePlanet Struct
 // ============================================================================
 
 // Planet information snapshot (what a player knows about a planet)
-class KnowledgePlanet
+// Plain data so that a player's whole knowledge can be copied with memcpy for snapshots.
+// Immutable identity (name, coordinates) lives in the galaxy's PlanetIdentityTable
+// (entry id - 1); colonization and visible enemy fleets live in KnowledgeGalaxy side tables.
+struct KnowledgePlanet
 {
-public:
-	// Core planet identity - set at construction, should not be modified
-	uint32_t id;
-	std::string name;
-	GalaxyCoord x;
-	GalaxyCoord y;
-	PlayerID as_seen_by;  // Which player created this snapshot
-
 	// Observable fields - updated via observe_planet()
 	double apparent_temperature;
 	double apparent_gravity;
+
+	// Core planet identity - key into the shared identity table
+	uint32_t id;
+
 	int32_t metal;
 	PlayerID apparent_owner;
 	int32_t apparent_population;  // POPULATION_UNKNOWN if unknown, otherwise estimated population
 	int32_t observation_year;  // When this information was collected
-	
+
 	int32_t can_be_profitable;
 	int32_t perceived_value;
-	
+
 	// Nova state - can be updated independently, not by observe_planet()
 	PlanetNovaState nova_state;
-	
-	// Colonization info - if this player has colonized this planet
-	// nullptr if not colonized, otherwise contains colonization-specific data
-	std::unique_ptr<class ColonizedPlanet> colonization;
-	
-	// Fleet visibility - fleets at this planet
-	std::vector<Fleet*> my_fleets;                 // Player's own fleets stationed here
-	std::vector<FleetVisibleInfo> enemy_fleets;    // Enemy fleets visible at this planet
-	
-	// Default constructor - initializes with partial info (id, name, coordinates only)
-	KnowledgePlanet(const Planet& planet, PlayerID player_id);
-	
+
+	// Constructor - initializes a record with every observable field unknown
+	explicit KnowledgePlanet(uint32_t planet_id);
+
 	// Update snapshot with current observation of the planet
-	void observe_planet(const Planet& planet, const Player* observer, int32_t current_year);
-	
-	// Fleet management methods
-	void add_my_fleet(Fleet* fleet);
-	void remove_my_fleet(uint32_t fleet_id);
-	void add_visible_enemy_fleet(const FleetVisibleInfo& fleet_info);
-	void remove_visible_enemy_fleet(uint32_t fleet_id);
-	void clear_enemy_fleets();
+	// Only fields whose value differs are written; returns the KnowledgeField mask of changed fields
+	uint32_t observe_planet(const Planet& planet, const Player* observer, int32_t current_year);
 };
 
+static_assert(std::is_trivially_copyable<KnowledgePlanet>::value,
+              "KnowledgePlanet must stay trivially copyable for knowledge snapshots");
+
 #endif // OPENHO_KNOWLEDGE_PLANET_H
@@ -0,0 +1,49 @@
+#ifndef OPENHO_OBSERVATION_INDEX_H
+#define OPENHO_OBSERVATION_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// ObservationAgeIndex Class
+// ============================================================================
+
+/// Planets bucketed by the year they were last observed.
+/// Buckets are ordered by year, and each planet remembers its position in its
+/// bucket, so re-observing a planet is an O(1) swap-remove plus an append.
+/// Staleness queries walk the oldest buckets only and stop as soon as they
+/// reach the cutoff year or the requested count, so their cost follows the
+/// size of the answer rather than the number of known planets.
+class ObservationAgeIndex
+{
+public:
+	/// Record (or move) a planet as last observed in a year
+	void update(uint32_t planet_id, int32_t observation_year);
+
+	/// Remove a planet from the index (no-op if absent)
+	void remove(uint32_t planet_id);
+
+	bool contains(uint32_t planet_id) const { return entries.count(planet_id) != 0; }
+	size_t size() const { return entries.size(); }
+
+	/// Append planets last observed before a year, oldest first, up to max_count
+	void collect_observed_before(int32_t year, size_t max_count, std::vector<uint32_t>& out) const;
+
+	/// Year of the oldest observation in the index (OBSERVATION_YEAR_UNKNOWN if empty)
+	int32_t get_oldest_year() const;
+
+private:
+	struct Entry
+	{
+		int32_t year;
+		uint32_t position;      // Index within buckets[year]
+	};
+
+	std::map<int32_t, std::vector<uint32_t>> buckets;   // year -> planet IDs
+	std::unordered_map<uint32_t, Entry> entries;        // planet_id -> bucket slot
+};
+
+#endif // OPENHO_OBSERVATION_INDEX_H
@@ -1,6 +1,7 @@
 #ifndef OPENHO_CORE_H
 #define OPENHO_CORE_H
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -63,7 +64,7 @@ void game_destroy(void* game);
 [[nodiscard]] uint32_t game_get_num_fleets(void* game);
 
 // Player public information queries
-void game_get_full_player_info_history(void* game, uint32_t player_id, const std::vector<PlayerPublicInfo>** out);
+[[nodiscard]] ErrorCode game_get_player_public_info(void* game, uint32_t player_id, uint32_t turn, PlayerPublicInfo* out);
 [[nodiscard]] uint32_t game_get_player_info_history_size(void* game, uint32_t player_id);
 
 // Ship design queries and management
@@ -80,16 +81,25 @@ void game_get_player_ship_designs(void* game, uint32_t player_id, ShipDesign* ou
 
 	// AI RNG seed management
 	[[nodiscard]] uint64_t game_get_ai_seed(void* game);
-	void game_set_ai_seed(void* game, uint64_t seed);
+	[[nodiscard]] ErrorCode game_set_ai_seed(void* game, uint64_t seed);
 
 // Turn processing
 [[nodiscard]] ErrorCode game_process_turn(void* game);
 
 // Serialization
+// game_serialize_state() writes straight into the buffer (-1 if it is too small);
+// game_get_serialized_state_size() measures the save without producing it
 [[nodiscard]] int game_serialize_state(void* game, void* buffer, int buffer_size);
 [[nodiscard]] int game_deserialize_state(void* game, const void* buffer, int buffer_size);
 [[nodiscard]] int game_get_serialized_state_size(void* game);
 
+// Streaming serialization: the save is passed to write in order, in chunks of about 64 KiB
+// (valid only during the call), so it can go to a file, a socket or a compressor without a
+// full-size copy.  write returns nonzero to continue, 0 to stop.
+// Returns the bytes written, or -1 if the game is invalid or write stopped the stream.
+typedef int (*SaveWriteFn)(void* context, const void* data, size_t size);
+[[nodiscard]] int64_t game_serialize_state_stream(void* game, SaveWriteFn write, void* context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,152 @@
+#ifndef OPENHO_PLANET_BITSET_H
+#define OPENHO_PLANET_BITSET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// ============================================================================
+// Bit Helpers
+// ============================================================================
+
+namespace PlanetBits
+{
+	inline uint32_t popcount(uint64_t word)
+	{
+#ifdef _MSC_VER
+		return static_cast<uint32_t>(__popcnt64(word));
+#else
+		return static_cast<uint32_t>(__builtin_popcountll(word));
+#endif
+	}
+
+	/// Index of the lowest set bit (word must be non-zero)
+	inline uint32_t lowest_bit(uint64_t word)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(__builtin_ctzll(word));
+#endif
+	}
+}
+
+// ============================================================================
+// PlanetBitset Class
+// ============================================================================
+
+/// Dense set of planet IDs stored as 64-bit words (bit N = planet ID N)
+/// Word storage is contiguous so it can be exposed directly through the C API
+/// and combined word-wise (union, intersection, difference) without per-bit loops.
+class PlanetBitset
+{
+public:
+	PlanetBitset() = default;
+	explicit PlanetBitset(uint32_t bit_count) { resize(bit_count); }
+
+	/// Resize to hold IDs in [0, bit_count); new bits are cleared
+	void resize(uint32_t bit_count)
+	{
+		n_bits = bit_count;
+		word_storage.resize((static_cast<size_t>(bit_count) + 63) / 64, 0);
+		clear_tail();
+	}
+
+	/// Clear every bit (keeps capacity)
+	void clear()
+		{ std::fill(word_storage.begin(), word_storage.end(), 0); }
+
+	void set(uint32_t id)
+		{ if (id < n_bits) { word_storage[id >> 6] |= (uint64_t(1) << (id & 63)); } }
+	void reset(uint32_t id)
+		{ if (id < n_bits) { word_storage[id >> 6] &= ~(uint64_t(1) << (id & 63)); } }
+	bool test(uint32_t id) const
+		{ return id < n_bits && (word_storage[id >> 6] >> (id & 63)) & 1; }
+
+	/// Number of bits set
+	uint32_t count() const
+	{
+		uint32_t total = 0;
+		for (uint64_t word : word_storage)
+			{ total += PlanetBits::popcount(word); }
+		return total;
+	}
+
+	bool any() const
+	{
+		for (uint64_t word : word_storage)
+		{
+			if (word)
+				{ return true; }
+		}
+		return false;
+	}
+
+	/// Word-wise set operations (operands must have the same size)
+	PlanetBitset& operator|=(const PlanetBitset& other)
+	{
+		for (size_t i = 0; i < word_storage.size() && i < other.word_storage.size(); ++i)
+			{ word_storage[i] |= other.word_storage[i]; }
+		return *this;
+	}
+	PlanetBitset& operator&=(const PlanetBitset& other)
+	{
+		for (size_t i = 0; i < word_storage.size() && i < other.word_storage.size(); ++i)
+			{ word_storage[i] &= other.word_storage[i]; }
+		return *this;
+	}
+	/// Remove every bit that is set in other
+	PlanetBitset& subtract(const PlanetBitset& other)
+	{
+		for (size_t i = 0; i < word_storage.size() && i < other.word_storage.size(); ++i)
+			{ word_storage[i] &= ~other.word_storage[i]; }
+		return *this;
+	}
+
+	bool operator==(const PlanetBitset& other) const
+		{ return n_bits == other.n_bits && word_storage == other.word_storage; }
+	bool operator!=(const PlanetBitset& other) const
+		{ return !(*this == other); }
+
+	/// Call fn(id) for every set bit, in ascending ID order
+	template<typename Fn>
+	void for_each_set(Fn&& fn) const
+	{
+		for (size_t w = 0; w < word_storage.size(); ++w)
+		{
+			uint64_t word = word_storage[w];
+			while (word)
+			{
+				uint32_t bit = PlanetBits::lowest_bit(word);
+				fn(static_cast<uint32_t>(w * 64 + bit));
+				word &= word - 1;
+			}
+		}
+	}
+
+	/// Raw word access (bit N of the set is bit (N % 64) of word N / 64)
+	const uint64_t* words() const { return word_storage.data(); }
+	uint64_t* words() { return word_storage.data(); }
+	size_t word_count() const { return word_storage.size(); }
+	uint32_t size() const { return n_bits; }
+
+private:
+	std::vector<uint64_t> word_storage;
+	uint32_t n_bits = 0;
+
+	// Keep bits past n_bits zero so count() and comparisons stay exact
+	void clear_tail()
+	{
+		if (n_bits % 64 && !word_storage.empty())
+			{ word_storage.back() &= (uint64_t(1) << (n_bits % 64)) - 1; }
+	}
+};
+
+#endif // OPENHO_PLANET_BITSET_H
@@ -0,0 +1,50 @@
+#ifndef OPENHO_PLANET_IDENTITY_H
+#define OPENHO_PLANET_IDENTITY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "planet.h"
+
+// ============================================================================
+// PlanetIdentity Struct
+// ============================================================================
+
+/// Immutable facts about a planet that every player knows from the start
+struct PlanetIdentity
+{
+	uint32_t id;
+	GalaxyCoord x;
+	GalaxyCoord y;
+};
+
+// ============================================================================
+// PlanetIdentityTable Class
+// ============================================================================
+
+/// Galaxy-level table of planet identities (ID, name, coordinates), shared by
+/// every player's KnowledgeGalaxy instead of being copied into each knowledge
+/// record.  Planet IDs are sequential from 1, so entry index = planet_id - 1.
+class PlanetIdentityTable
+{
+public:
+	/// Build from the galaxy's planet list (called once after generation)
+	void build(const std::vector<Planet>& planets);
+
+	/// Identity of a planet, or nullptr if the ID is out of range
+	const PlanetIdentity* get(uint32_t planet_id) const
+	{
+		return (planet_id >= 1 && planet_id <= entries.size()) ? &entries[planet_id - 1] : nullptr;
+	}
+
+	/// Name of a planet (empty string if the ID is out of range)
+	const std::string& get_name(uint32_t planet_id) const;
+
+	size_t size() const { return entries.size(); }
+
+private:
+	std::vector<PlanetIdentity> entries;
+	std::vector<std::string> names;     // Parallel to entries
+};
+
+#endif // OPENHO_PLANET_IDENTITY_H
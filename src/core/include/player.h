@@ -7,6 +7,9 @@
 #include "knowledge_galaxy.h"
 #include "ship_design.h"
 #include "fleet.h"
+#include "route_planner.h"
+#include "planet_bitset.h"
+#include "player_history.h"
 #include <cstdint>
 #include <unordered_map>
 #include <vector>
@@ -22,33 +25,6 @@ typedef int32_t PlayerID;
 // Data Structures
 // ============================================================================
 
-// Public information about a player (visible to all other players)
-struct PlayerPublicInfo
-{
-	uint32_t player_id;
-	uint32_t year;      // Game year (same as turn number)
-	uint32_t turn;      // Turn number (same as year, for convenience)
-	
-	// Technology levels (subset - no Radical)
-	int32_t tech_range;
-	int32_t tech_speed;
-	int32_t tech_weapons;
-	int32_t tech_shields;
-	int32_t tech_mini;
-	
-	// Resources
-	int64_t money_income;
-	int64_t money_savings;
-	int64_t metal_savings;
-		
-	// Territory
-	uint32_t planets_owned;
-	
-	// Calculated metrics
-	int64_t ship_power;
-	int32_t victory_points;
-};
-
 // Player structure
 // IMPORTANT: Player IDs must never be 0!
 // NOT_OWNED (0) is reserved to mean unowned for planets.
@@ -56,6 +32,7 @@ struct PlayerPublicInfo
 class Player
 {
 friend class GameState;  // GameState has access to all private members
+friend class ColonizedPlanet;  // Colonies report population changes (on_colony_population_changed)
 // Note: C API functions in c_api.cpp access Player through GameState, which is a friend
 
 public:
@@ -68,11 +45,11 @@ public:
 	// Constructor
 	Player(class GameState* game_state_ref) : game_state(game_state_ref) {}
 	
-	// Move semantics (required by Fleet's unique_ptr)
+	// Move semantics
 	Player(Player&&) = default;
 	Player& operator=(Player&&) = default;
 	
-	// Delete copy semantics (Fleet is not copyable)
+	// Delete copy semantics (Player owns its KnowledgeGalaxy)
 	Player(const Player&) = delete;
 	Player& operator=(const Player&) = delete;
 	
@@ -88,6 +65,11 @@ public:
 	/// Get all fleets owned by this player
 	const std::vector<Fleet>& get_fleets() const { return fleets; }
 	
+	/// Total fleet power of this player's ships (maintained incrementally)
+	int64_t get_fleet_power() const { return fleet_power; }
+	/// Victory points from this player's colonies (maintained incrementally)
+	int32_t get_victory_points() const { return victory_points; }
+	
 	// ========================================================================
 	// Type Definitions (used by accessors below)
 	// ========================================================================
@@ -198,6 +180,50 @@ public:
 	/// Get all fleets currently in transit (const version)
 	[[nodiscard]] const std::vector<const Fleet*> get_fleets_in_transit() const;
 	
+	// ========================================================================
+	// Route Planning
+	// ========================================================================
+	
+	/// Plan a multi-hop route for a docked fleet under its fuel constraint,
+	/// refuelling at this player's planets. Issue the legs with move_fleet().
+	/// Returns route.found
+	[[nodiscard]] bool plan_fleet_route(uint32_t fleet_id, uint32_t destination_planet_id, RouteMode mode, Route& route);
+	
+	/// Plan a route for an arbitrary query (e.g. AI planning for ships not yet built)
+	/// Returns route.found
+	[[nodiscard]] bool plan_route(const RouteQuery& query, Route& route);
+	
+	// ========================================================================
+	// Knowledge Staleness
+	// ========================================================================
+	
+	/// Append planets this player has not observed for at least min_turns_unseen turns
+	/// (oldest first, up to max_count) - e.g. targets for re-scouting
+	void get_stale_planets(uint32_t min_turns_unseen, size_t max_count, std::vector<uint32_t>& out) const;
+	
+	/// Append planets last seen owned by another player, oldest observation first, up to max_count
+	void get_oldest_enemy_colonies(size_t max_count, std::vector<uint32_t>& out) const;
+	
+	// ========================================================================
+	// Reachability
+	// ========================================================================
+	
+	/// Planets reachable in one hop from any of this player's colonies at the current range tech
+	/// (bit N set = planet ID N reachable; colonies themselves are included)
+	const PlanetBitset& get_reachable_planets() const { return reachable_planets; }
+	
+	/// Number of this player's colonies within range of a planet
+	uint32_t get_reach_coverage(uint32_t planet_id) const
+		{ return planet_id < reach_coverage.size() ? reach_coverage[planet_id] : 0; }
+	
+	// ========================================================================
+	// Public Player History
+	// ========================================================================
+	
+	/// Read-only view of every player's public per-turn metrics
+	/// (one shared store owned by GameState - players do not keep copies)
+	[[nodiscard]] const PlayerHistoryStore& get_public_history() const;
+	
 	// ========================================================================
 	// Ship Design Management
 	// ========================================================================
@@ -219,54 +245,71 @@ private:
 	class GameState* game_state;
 	
 	// Resources
-	int64_t money_savings;  // Savings account
-	int64_t metal_reserve;
+	int64_t money_savings = 0;  // Savings account
+	int64_t metal_reserve = 0;
 		
 	// Ideal planetary conditions (hidden from player)
-	double ideal_temperature;
-	double ideal_gravity;
+	double ideal_temperature = 0.0;
+	double ideal_gravity = 0.0;
 	
 	// Calculated properties
-	int64_t money_income;  // Per turn
-	int64_t metal_income;  // Per turn
+	int64_t money_income = 0;  // Per turn
+	int64_t metal_income = 0;  // Per turn
 	
 	// Technology levels
-	TechnologyLevels tech;
+	TechnologyLevels tech{};
 	// Income breakdown for current turn
-	IncomeBreakdown current_turn_income;
+	IncomeBreakdown current_turn_income{};
 	// Current money allocation
-	MoneyAllocation allocation;
+	MoneyAllocation allocation{};
 	// Research progress (accumulated points per research stream)
-	PartialResearchProgress partial_research;
+	PartialResearchProgress partial_research{};
 	// Colonized planets (owned by this player with allocation information)
 	std::vector<ColonizedPlanet> colonized_planets;
 	// Player's knowledge of the galaxy
-	KnowledgeGalaxy* knowledge_galaxy;  // Owned by Player, initialized during game setup
+	KnowledgeGalaxy* knowledge_galaxy = nullptr;  // Owned by Player, initialized during game setup
 	
 	// Ship designs
 	std::vector<ShipDesign> ship_designs;      // All designs, ordered by creation (max 100)
-	uint32_t next_ship_design_id;                // Counter for unique design IDs (never resets)
+	uint32_t next_ship_design_id = 1;            // Counter for unique design IDs (never resets)
 	
 	
 	// Fleets (groups of identical ships)
 	std::vector<Fleet> fleets;                 // All fleets owned by this player
+	std::unordered_map<uint32_t, size_t> fleet_index;  // fleet ID -> index in fleets (kept by build_fleet/delete_fleet)
+	
+	// Public metrics, kept equal to GameFormulas::calculate_player_fleet_power() /
+	// calculate_player_victory_points() by the fleet and colony hooks below
+	int64_t fleet_power = 0;
+	int32_t victory_points = 0;
+	
+	/// Change a fleet's ship count (combat losses), keeping fleet_power in step
+	void set_fleet_ship_count(Fleet& fleet, uint32_t ship_count);
+	/// Fleet power contributed by a fleet
+	static int64_t get_fleet_power_of(const Fleet& fleet);
+	/// Called by ColonizedPlanet::set_population for colonies in colonized_planets
+	void on_colony_population_changed(int32_t old_population, int32_t new_population);
+	
+	// Route planning state (search scratch is reused between queries)
+	RoutePlanner route_planner;
+	PlanetBitset refuel_planets;               // Planets where this player's fleets refuel (own colonies)
+	
+	// Reachability: planets within tech.range of any colony (maintained incrementally)
+	PlanetBitset reachable_planets;
+	std::vector<uint32_t> reach_coverage;      // Per planet ID: number of colonies within reach_range
+	int32_t reach_range = 0;                   // Range the coverage counts were built for
+	
+	/// Rebuild refuel and reachability sets from scratch (after knowledge galaxy is created)
+	void rebuild_reachability();
+	/// Incremental updates (called by GameState when colonies or range tech change)
+	/// on_colony_gained is called after the colony is added to colonized_planets,
+	/// on_colony_lost before it is removed; both also update victory_points
+	void on_colony_gained(uint32_t planet_id);
+	void on_colony_lost(uint32_t planet_id);
+	void on_range_advanced(int32_t new_range);
+	/// Add delta to coverage of planets whose distance from planet_id is in (min_exclusive, max_inclusive]
+	void adjust_reach_coverage(uint32_t planet_id, double min_exclusive, double max_inclusive, int32_t delta);
 	
-	// Player public information history: player_id -> vector of PlayerPublicInfo (one per turn)
-	std::unordered_map<uint32_t, std::vector<PlayerPublicInfo>> player_info_history;
-	
-	// Player info history management
-	/// Receive a new player public info snapshot (called by GameState each turn)
-	void receive_player_public_info(uint32_t source_player_id, const PlayerPublicInfo& info);
-	
-	/// Get full player info history for a specific player (for validation/resync)
-	[[nodiscard]] const std::vector<PlayerPublicInfo>* get_player_info_history(uint32_t player_id) const;
-	
-	/// Validate consistency of player info history
-	[[nodiscard]] bool validate_player_info_history(uint32_t player_id) const;
-	
-	/// Request full resync of player info history from GameState
-	void request_full_player_info_resync(uint32_t player_id);
-
 	// ========================================================================
 	// Money Allocation Calculation Helpers
 	// ========================================================================
@@ -14,6 +14,9 @@ typedef struct ShipDesign ShipDesign;
 typedef struct Fleet Fleet;
 typedef struct ColonizedPlanet ColonizedPlanet;
 
+// Read-only: allocations, designs and fleet orders are given through GameState
+// (gamestate_c_api_extensions.h) so that they are validated and journaled
+
 // ============================================================================
 // Player Accessors (Read-Only)
 // ============================================================================
@@ -59,22 +62,6 @@ ErrorCode player_get_spending_allocation(
 	double* out_planets_fraction
 );
 
-// ============================================================================
-// Player Spending Allocation
-// ============================================================================
-
-/**
- * Set player's spending allocation
- * Fractions should sum to approximately 1.0
- * Returns: 0 on success, error code otherwise
- */
-ErrorCode player_set_spending_allocation(
-	Player* player,
-	double savings_fraction,
-	double research_fraction,
-	double planets_fraction
-);
-
 // ============================================================================
 // Ship Design Management
 // ============================================================================
@@ -97,27 +84,6 @@ const ShipDesign* player_get_ship_design(const Player* player, uint32_t design_i
  */
 const ShipDesign* const* player_get_all_ship_designs(const Player* player);
 
-/**
- * Create a new ship design
- * Returns: design_id on success, 0 on error
- */
-uint32_t player_design_ship(
-	Player* player,
-	const char* name,
-	uint32_t ship_type,  // ShipType enum value
-	int32_t tech_range,
-	int32_t tech_speed,
-	int32_t tech_weapons,
-	int32_t tech_shields,
-	int32_t tech_miniaturization
-);
-
-/**
- * Delete a ship design
- * Returns: error code
- */
-ErrorCode player_delete_ship_design(Player* player, uint32_t design_id);
-
 // ============================================================================
 // Fleet Management
 // ============================================================================
@@ -140,35 +106,6 @@ const Fleet* player_get_fleet(const Player* player, uint32_t fleet_id);
  */
 const Fleet* const* player_get_all_fleets(const Player* player);
 
-/**
- * Create a new fleet (validation should be done via GameState first)
- * Returns: fleet_id on success, 0 on error
- */
-uint32_t player_build_fleet(
-	Player* player,
-	uint32_t design_id,
-	uint32_t ship_count,
-	uint32_t planet_id
-);
-
-/**
- * Delete a fleet
- * Returns: error code
- */
-ErrorCode player_delete_fleet(Player* player, uint32_t fleet_id);
-
-/**
- * Move a fleet to destination planet
- * Returns: error code
- */
-ErrorCode player_move_fleet(Player* player, uint32_t fleet_id, uint32_t destination_planet_id);
-
-/**
- * Refuel a fleet (at current planet)
- * Returns: error code
- */
-ErrorCode player_refuel_fleet(Player* player, uint32_t fleet_id);
-
 // ============================================================================
 // Colonized Planet Management
 // ============================================================================
@@ -191,17 +128,6 @@ const ColonizedPlanet* player_get_colonized_planet(const Player* player, uint32_
  */
 const ColonizedPlanet* const* player_get_all_colonized_planets(const Player* player);
 
-/**
- * Set planet's allocation (mining vs terraforming)
- * Returns: error code
- */
-ErrorCode player_set_planet_allocation(
-	Player* player,
-	uint32_t planet_id,
-	double mining_fraction,
-	double terraforming_fraction
-);
-
 // ============================================================================
 // Technology & Research (Read-Only)
 // ============================================================================
@@ -220,6 +146,30 @@ int32_t player_get_tech_level(const Player* player, uint32_t tech_type);
  */
 double player_get_research_allocation(const Player* player, uint32_t tech_type);
 
+// ============================================================================
+// Reachability (Read-Only)
+// ============================================================================
+
+/**
+ * Get planets reachable in one hop from the player's colonies at current range tech
+ * Bit N of the set is bit (N % 64) of words[N / 64] (bit N = planet ID N)
+ * word_count: receives number of 64-bit words
+ * Returns: pointer to internal word array (zero-copy; valid until the next game turn), or NULL
+ */
+const uint64_t* player_get_reachable_planet_words(const Player* player, uint32_t* word_count);
+
+/**
+ * Get number of planets reachable from the player's colonies
+ * Returns: count of set bits in the reachable set
+ */
+uint32_t player_get_reachable_planet_count(const Player* player);
+
+/**
+ * Check whether a planet is reachable from the player's colonies
+ * Returns: 1 if reachable, 0 otherwise
+ */
+int player_is_planet_reachable(const Player* player, uint32_t planet_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,135 @@
+#ifndef OPENHO_PLAYER_HISTORY_H
+#define OPENHO_PLAYER_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "enums.h"
+
+// ============================================================================
+// PlayerPublicInfo Struct
+// ============================================================================
+
+// Public information about a player (visible to all other players)
+// One row of the PlayerHistoryStore, reassembled on demand from its columns
+struct PlayerPublicInfo
+{
+	uint32_t player_id;
+	uint32_t year;      // Game year
+	uint32_t turn;      // Turn number
+
+	// Technology levels (subset - no Radical)
+	int32_t tech_range;
+	int32_t tech_speed;
+	int32_t tech_weapons;
+	int32_t tech_shields;
+	int32_t tech_mini;
+
+	// Resources
+	int64_t money_income;
+	int64_t money_savings;
+	int64_t metal_savings;
+
+	// Territory
+	uint32_t planets_owned;
+
+	// Calculated metrics
+	int64_t ship_power;
+	int32_t victory_points;
+};
+
+// ============================================================================
+// History Spans
+// ============================================================================
+
+/// Read-only view of consecutive turns of one metric for one player
+/// Points straight into the store; invalidated by the next begin_turn()
+struct MetricSpan
+{
+	const int64_t* first;
+	size_t count;
+	uint32_t first_turn;        // Turn of first[0]
+
+	const int64_t* begin() const { return first; }
+	const int64_t* end() const { return first + count; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	int64_t operator[](size_t i) const { return first[i]; }
+};
+
+// ============================================================================
+// PlayerHistoryStore Class
+// ============================================================================
+
+/// Per-turn public metrics of every player, stored column-wise: one
+/// contiguous array per (player, metric), plus shared turn and year columns.
+/// A single store is owned by GameState and every player reads the same one,
+/// so memory grows as players x metrics x turns instead of a copy per viewer.
+///
+/// Rows are consecutive turns.  With a retention limit the store keeps at
+/// least the last retained_turns rows; old rows are dropped in blocks of
+/// retained_turns, so trimming costs O(1) amortized per turn and every column
+/// stays contiguous (spans never wrap).
+class PlayerHistoryStore
+{
+public:
+	/// Clear and size the store for a set of players (IDs in player index order)
+	/// retained_turns = 0 keeps the whole game
+	void reset(const std::vector<uint32_t>& player_ids, size_t retained_turns = 0);
+
+	/// Start the row for a turn.  Capturing the last turn again overwrites it;
+	/// an earlier turn drops the rows from that turn on and starts it afresh.
+	/// Returns false (store unchanged, set() must not be called) for a turn that
+	/// would leave a gap after the last row.
+	[[nodiscard]] bool begin_turn(uint32_t turn, uint32_t year);
+
+	/// Write one metric of the current row
+	void set(size_t player_index, PlayerMetric metric, int64_t value)
+		{ columns[player_index * METRIC_COUNT + metric].back() = value; }
+
+	// Shape
+	size_t get_player_count() const { return player_ids.size(); }
+	const std::vector<uint32_t>& get_player_ids() const { return player_ids; }
+	size_t get_retained_turns() const { return retained_turns; }
+	size_t get_row_count() const { return turns.size(); }
+	bool empty() const { return turns.empty(); }
+	uint32_t get_first_turn() const { return turns.empty() ? 0 : turns.front(); }
+	uint32_t get_last_turn() const { return turns.empty() ? 0 : turns.back(); }
+	bool contains_turn(uint32_t turn) const
+		{ return !turns.empty() && turn >= turns.front() && turn <= turns.back(); }
+
+	/// Player index of a player ID (SIZE_MAX if not in the store)
+	size_t find_player(uint32_t player_id) const;
+
+	/// Every retained turn of one metric for one player
+	MetricSpan get_metric(size_t player_index, PlayerMetric metric) const;
+
+	/// One metric for one player over turns [first_turn, last_turn], clipped to the retained range
+	MetricSpan get_metric_range(size_t player_index, PlayerMetric metric, uint32_t first_turn, uint32_t last_turn) const;
+
+	/// Turn and year columns (shared by all players, same row order as metric spans)
+	const std::vector<uint32_t>& get_turns() const { return turns; }
+	const std::vector<uint32_t>& get_years() const { return years; }
+
+	/// Reassemble one row; returns false if the player or turn is not stored
+	bool get_row(size_t player_index, uint32_t turn, PlayerPublicInfo& out) const;
+
+	/// Check that rows are consecutive turns and every column has one value per row
+	[[nodiscard]] bool validate() const;
+
+private:
+	/// Row index of a retained turn (caller checks contains_turn)
+	size_t row_of(uint32_t turn) const { return turn - turns.front(); }
+
+	/// Drop the oldest rows once the retention window has doubled
+	void trim();
+
+	std::vector<uint32_t> player_ids;
+	size_t retained_turns = 0;
+
+	std::vector<uint32_t> turns;
+	std::vector<uint32_t> years;
+	std::vector<std::vector<int64_t>> columns;     // [player_index * METRIC_COUNT + metric][row]
+};
+
+#endif // OPENHO_PLAYER_HISTORY_H
@@ -1,14 +1,140 @@
 #ifndef OPENHO_RNG_H
 #define OPENHO_RNG_H
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
-#include <sstream>
-#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
 #include <boost/random/normal_distribution.hpp>
 
+// ============================================================================
+// RNG State Format
+// ============================================================================
+//
+// Binary engine state, fixed size and little-endian:
+//   header : magic "OHRS" (u32), format version (u16), flags (u16),
+//            position in the state (u32), reserved (u32)
+//   words  : the 312 state words (u64)
+// Restoring it copies the words back; nothing is parsed.  Saves made before
+// this format hold Boost's text form (312 decimal words) and are still read.
+
+namespace RNGStateFormat
+{
+	constexpr uint32_t MAGIC = 0x5352484F;          // "OHRS"
+	constexpr uint16_t VERSION = 1;
+	constexpr size_t HEADER_SIZE = 16;
+	constexpr size_t STATE_WORDS = 312;
+	constexpr size_t SIZE = HEADER_SIZE + STATE_WORDS * 8;
+}
+
+// ============================================================================
+// MersenneTwister64 Class
+// ============================================================================
+
+/// MT19937-64 generating exactly the sequence of boost::random::mt19937_64 for
+/// the same seed, with its state reachable for binary serialization (Boost only
+/// streams its state as text).  Usable with the Boost.Random distributions.
+class MersenneTwister64
+{
+public:
+	typedef uint64_t result_type;
+
+	explicit MersenneTwister64(uint64_t value = 5489) { seed(value); }
+
+	void seed(uint64_t value);
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+	result_type operator()()
+	{
+		if (index == RNGStateFormat::STATE_WORDS)
+			{ twist(); }
+		uint64_t z = state[index++];
+		z ^= (z >> 29) & 0x5555555555555555ULL;
+		z ^= (z << 17) & 0x71D67FFFEDA60000ULL;
+		z ^= (z << 37) & 0xFFF7EEE000000000ULL;
+		z ^= z >> 43;
+		return z;
+	}
+
+	/// Write the state in RNGStateFormat (exactly RNGStateFormat::SIZE bytes)
+	void write_state(uint8_t* out) const;
+
+	/// Restore a state written by write_state(), or Boost's text form
+	/// Returns false, leaving the engine unchanged, if the data is neither
+	[[nodiscard]] bool read_state(const uint8_t* data, size_t size);
+
+	bool operator==(const MersenneTwister64& other) const;
+	bool operator!=(const MersenneTwister64& other) const { return !(*this == other); }
+
+private:
+	void twist();
+	bool read_text_state(const uint8_t* data, size_t size);
+
+	uint64_t state[RNGStateFormat::STATE_WORDS];
+	uint32_t index;                 // Next word to temper (STATE_WORDS: twist first)
+};
+
+// ============================================================================
+// RNGStream Class
+// ============================================================================
+
+/// Turn phases that draw from substreams (the phase part of an RNGStream key)
+enum RNGPhase : uint32_t
+{
+	RNG_PHASE_COMBAT = 1        // Entity: contested planet ID
+};
+
+/// Reproducible numbers for one (turn, phase, entity) key, from DeterministicRNG::stream()
+/// Counter-based (Philox4x32-10, Salmon et al. 2011): block n of a stream is a keyed
+/// bijection of the counter (n, entity, phase, turn), computed directly rather than
+/// stepped from earlier draws.  Streams share no state, so they can be drawn in any
+/// order and on any thread with the same results.  Usable with the Boost.Random
+/// distributions; a stream is cheap to create and to copy (40 bytes).
+class RNGStream
+{
+public:
+	typedef uint64_t result_type;
+
+	RNGStream(uint64_t seed, uint32_t turn, uint32_t phase, uint32_t entity)
+		: key{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) },
+		  counter{ 0, entity, phase, turn }
+	{ }
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+	result_type operator()()
+	{
+		if (used == 2)
+			{ refill(); }
+		return buffer[used++];
+	}
+
+	uint32_t nextUInt32() { return static_cast<uint32_t>((*this)() >> 32); }
+	uint64_t nextUInt64() { return (*this)(); }
+	double nextDouble();  // Range [0.0, 1.0)
+
+	// Bounded random numbers
+	int32_t nextInt32Range(int32_t min, int32_t max);  // [min, max]
+	uint32_t nextUInt32Range(uint32_t min, uint32_t max);  // [min, max]
+	double nextDoubleRange(double min, double max);  // [min, max]
+	double nextNormal(double mean, double sigma);
+
+	/// One Philox4x32-10 block: the four output words for a counter under a key
+	static void philox_block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+
+private:
+	void refill();
+
+	uint32_t key[2];
+	uint32_t counter[4];        // Block index, entity, phase, turn
+	uint64_t buffer[2];
+	uint32_t used = 2;          // Words of buffer consumed (2: refill first)
+};
+
 // ============================================================================
 // DeterministicRNG Class
 // ============================================================================
@@ -19,6 +145,7 @@
  * The class maintains two separate RNG engines:
  * 1. deterministicRNG: For shared game mechanics (deterministic across all players)
  * 2. aiRNG: For AI decisions (seeded each turn by the host)
+ * Per-entity work that may run in any order draws from stream() substreams instead.
  * 
  * This ensures:
  * - Multiplayer games are deterministic (same sequence of events on all clients)
@@ -59,6 +186,12 @@ public:
 	uint32_t nextUInt32Range(uint32_t min, uint32_t max);  // [min, max]
 	double nextDoubleRange(double min, double max);  // [min, max]
 	
+	// Substreams of the deterministic seed (see RNGStream)
+	/// Numbers for one entity in one phase of one turn; the same key always gives the
+	/// same numbers, whatever has been drawn from this RNG or any other stream
+	[[nodiscard]] RNGStream stream(uint32_t turn, uint32_t phase, uint32_t entity) const
+		{ return RNGStream(det_seed_value, turn, phase, entity); }
+	
 	// AI bounded random numbers
 	int32_t nextAIInt32Range(int32_t min, int32_t max);  // [min, max]
 	uint32_t nextAIUInt32Range(uint32_t min, uint32_t max);  // [min, max]
@@ -80,28 +213,32 @@ public:
 	/// @return A random value from N(mean, sigma) truncated to [min, max]
 	double nextNormalTruncated(double mean, double sigma, double min, double max);
 	
-	// RNG state serialization for multiplayer host migration
+	// RNG state serialization for multiplayer host migration (RNGStateFormat)
 	/// Serialize the AI RNG state to a byte vector for network transmission
 	[[nodiscard]] std::vector<uint8_t> serialize_ai_rng_state() const;
 	
 	/// Deserialize the AI RNG state from a byte vector received from network
-	void deserialize_ai_rng_state(const std::vector<uint8_t>& data);
+	/// Returns false, leaving the engine unchanged, if the data is not an engine state
+	[[nodiscard]] bool deserialize_ai_rng_state(const std::vector<uint8_t>& data);
+	[[nodiscard]] bool deserialize_ai_rng_state(const uint8_t* data, size_t size);
 	
-	/// Get the size of serialized AI RNG state (for network planning)
-	[[nodiscard]] static size_t get_serialized_ai_rng_state_size();
+	/// Exact size of a serialized RNG state (either engine)
+	[[nodiscard]] static constexpr size_t get_serialized_ai_rng_state_size() { return RNGStateFormat::SIZE; }
 	
 	/// Serialize the deterministic RNG state to a byte vector
 	[[nodiscard]] std::vector<uint8_t> serialize_deterministic_rng_state() const;
 	
 	/// Deserialize the deterministic RNG state from a byte vector
-	void deserialize_deterministic_rng_state(const std::vector<uint8_t>& data);
+	/// Returns false, leaving the engine unchanged, if the data is not an engine state
+	[[nodiscard]] bool deserialize_deterministic_rng_state(const std::vector<uint8_t>& data);
+	[[nodiscard]] bool deserialize_deterministic_rng_state(const uint8_t* data, size_t size);
 	
 private:
-	// Boost.Random engines (Mersenne Twister)
-	boost::random::mt19937_64 deterministicEngine;
-	boost::random::mt19937_64 aiEngine;
+	// Mersenne Twister engines (sequence-compatible with boost::random::mt19937_64)
+	MersenneTwister64 deterministicEngine;
+	MersenneTwister64 aiEngine;
 	
-	// Stored seed values for retrieval (Boost engines don't provide seed getters)
+	// Stored seed values for retrieval (the engines don't keep their seed)
 	uint64_t det_seed_value;
 	uint64_t ai_seed_value;
 	
@@ -0,0 +1,205 @@
+#ifndef OPENHO_ROUTE_PLANNER_H
+#define OPENHO_ROUTE_PLANNER_H
+
+#include <cstdint>
+#include <vector>
+#include "enums.h"
+#include "planet_bitset.h"
+
+// ============================================================================
+// Forward Declarations
+// ============================================================================
+
+class KnowledgeGalaxy;
+class Galaxy;
+
+// ============================================================================
+// PlanetNeighbourGraph Class
+// ============================================================================
+
+/// Adjacency lists over the distance matrix in compressed sparse row form.
+/// Each planet's neighbours are sorted by ascending distance, so the neighbour
+/// graph for any range R is simply the prefix of every list with distance <= R.
+/// One build therefore serves every range tech level without recomputation.
+class PlanetNeighbourGraph
+{
+public:
+	/// Contiguous run of neighbours of one planet, nearest first
+	struct NeighbourRange
+	{
+		const uint32_t* ids;        // Neighbour planet IDs
+		const double* distances;    // Matching distances
+		uint32_t count;
+	};
+
+	/// Build from the galaxy's distance matrix (planet IDs 1..N)
+	void build(const Galaxy& galaxy);
+
+	/// Highest planet ID in the graph (IDs are 1..get_max_planet_id())
+	uint32_t get_max_planet_id() const { return max_planet_id; }
+
+	/// All neighbours of a planet, nearest first
+	NeighbourRange get_neighbours(uint32_t planet_id) const;
+
+	/// Neighbours of a planet within range (prefix of get_neighbours)
+	NeighbourRange get_neighbours_within(uint32_t planet_id, double range) const;
+
+	/// Directed edges stored (for memory accounting)
+	size_t get_edge_count() const { return neighbour_ids.size(); }
+
+private:
+	uint32_t max_planet_id = 0;
+	std::vector<uint32_t> offsets;            // offsets[id - 1] .. offsets[id] index the arrays below
+	std::vector<uint32_t> neighbour_ids;
+	std::vector<double> neighbour_distances;
+};
+
+// ============================================================================
+// Route Structures
+// ============================================================================
+
+/// Parameters for a single route query
+struct RouteQuery
+{
+	uint32_t origin_planet_id;
+	uint32_t destination_planet_id;
+	int32_t start_fuel;         // Fuel on departure (INT32_MAX: no fuel limit)
+	int32_t max_fuel;           // Fuel after refuelling (tank capacity)
+	int32_t ship_range;         // Design range, used for travel time
+	RouteMode mode;             // What to minimise
+};
+
+/// Result of a route query (reuse one instance to avoid reallocating waypoints)
+struct Route
+{
+	bool found = false;
+	std::vector<uint32_t> waypoints;    // Planet IDs, origin first and destination last
+	uint32_t total_turns = 0;           // Sum of per-hop travel turns
+	uint32_t hops = 0;                  // Number of legs
+	int32_t fuel_on_arrival = 0;        // Fuel left at the destination (full if it is a refuel planet)
+};
+
+// ============================================================================
+// RoutePlanner Class
+// ============================================================================
+
+/// Fuel-aware shortest path search over a player's view of the galaxy.
+/// Routes minimise the mode's primary cost, then the other; arriving at a refuel
+/// planet fills the tank.  Legs and route trees are cached per tank capacity,
+/// ship range and mode until the refuel set changes.  Keep one planner per caller.
+class RoutePlanner
+{
+public:
+	/// Find the best route for a query, writing it into route
+	/// Returns route.found
+	bool plan(const KnowledgeGalaxy& knowledge_galaxy, const RouteQuery& query,
+	          const PlanetBitset& refuel_planets, Route& route);
+
+	/// Drop every cached hub network (they are also dropped when the refuel set changes)
+	void clear_cache();
+
+private:
+	static constexpr uint32_t NO_LABEL = UINT32_MAX;
+
+	/// A settled search label: the cheapest way found to reach a planet with this much fuel
+	struct Label
+	{
+		uint32_t planet_id;
+		uint32_t parent;        // Label of the previous stop (NO_LABEL at the start)
+		int32_t fuel;           // Fuel left on arrival (not refilled on a leg)
+		uint32_t primary;
+		uint32_t secondary;
+	};
+
+	struct QueueEntry
+	{
+		uint32_t estimate;      // primary + lower bound on remaining primary cost (A*)
+		uint32_t secondary;
+		uint32_t primary;
+		uint32_t planet_id;
+		int32_t fuel;
+		uint32_t parent;
+	};
+
+	/// Every planet reachable on one tank from a planet, without refuelling on the way
+	struct Leg
+	{
+		std::vector<Label> labels;          // Settled labels; labels[0] is the leg's own planet
+		std::vector<uint32_t> best_label;   // Indexed by planet ID: cheapest label (NO_LABEL if out of reach)
+		std::vector<uint32_t> next_label;   // Indexed by label: next label at the same planet (NO_LABEL if last)
+		std::vector<uint32_t> refuel_labels;  // Labels ending at a refuel planet, cheapest first
+	};
+
+	/// Best cost to a planet, and the refuel planet whose leg ends there
+	struct Reach
+	{
+		uint32_t primary;
+		uint32_t secondary;
+		uint32_t via;           // Start of the last leg (NO_LABEL at the tree's own planet or if unreachable)
+	};
+
+	struct HubEntry
+	{
+		uint32_t primary;
+		uint32_t secondary;
+		uint32_t planet_id;
+	};
+
+	/// Legs and route trees for one tank capacity, ship range and mode
+	struct HubNetwork
+	{
+		int32_t max_fuel;
+		int32_t ship_range;
+		RouteMode mode;
+		std::vector<Leg> legs;                  // Indexed by planet ID (empty until first used)
+		std::vector<std::vector<Reach>> trees;  // Indexed by refuel planet ID (empty until first used)
+	};
+
+	// Cached hub networks, valid for cached_refuel_planets (oldest first)
+	std::vector<HubNetwork> hub_networks;
+	PlanetBitset cached_refuel_planets;
+
+	// Per-planet label search state (valid when planet_generation[id] == generation)
+	std::vector<int32_t> settled_fuel;      // Most fuel of any settled label (-1 if none)
+	std::vector<uint32_t> pending_primary;  // Cheapest label queued so far, to skip dominated ones
+	std::vector<uint32_t> pending_secondary;
+	std::vector<int32_t> pending_fuel;
+	std::vector<uint32_t> planet_generation;
+	uint32_t generation = 0;
+	std::vector<QueueEntry> queue;      // Binary heap
+
+	// Scratch for a single query
+	std::vector<Label> query_labels;
+	std::vector<uint8_t> hub_settled;
+	std::vector<HubEntry> hub_queue;    // Binary heap
+
+	void prepare(uint32_t max_planet_id);
+	void touch(uint32_t planet_id);
+
+	/// Label-setting search from origin_planet_id with start_fuel, appending settled labels to out.
+	/// With a destination, A* that stops there and returns its label (NO_LABEL if unreachable);
+	/// with destination_planet_id 0, a leg: every planet in reach, not refuelling at or expanding refuel planets
+	uint32_t search(const KnowledgeGalaxy& knowledge_galaxy, const RouteQuery& query,
+	                const PlanetBitset& refuel_planets, uint32_t origin_planet_id, int32_t start_fuel,
+	                uint32_t destination_planet_id, std::vector<Label>& out);
+	HubNetwork& get_hub_network(const KnowledgeGalaxy& knowledge_galaxy, const RouteQuery& query);
+	const Leg& get_leg(HubNetwork& network, const KnowledgeGalaxy& knowledge_galaxy, const RouteQuery& query,
+	                   const PlanetBitset& refuel_planets, uint32_t planet_id);
+	const std::vector<Reach>& get_route_tree(HubNetwork& network, const KnowledgeGalaxy& knowledge_galaxy,
+	                                         const RouteQuery& query, const PlanetBitset& refuel_planets,
+	                                         uint32_t planet_id);
+
+	static uint32_t remaining_hops_bound(double distance_to_destination, int32_t max_fuel);
+	static void set_route_totals(uint32_t primary, uint32_t secondary, RouteMode mode, Route& route);
+
+	/// Append the waypoints of a search's labels back from label_index, latest first, excluding the origin
+	static void append_label_path(const std::vector<Label>& labels, uint32_t label_index,
+	                              std::vector<uint32_t>& reversed_waypoints);
+
+	/// Append a route tree's waypoints to a planet, destination first, excluding the tree's
+	/// own planet.  Returns the fuel left on arrival, before any refuelling
+	static int32_t append_tree_path(const HubNetwork& network, uint32_t tree_planet_id,
+	                                uint32_t destination_planet_id, std::vector<uint32_t>& reversed_waypoints);
+};
+
+#endif // OPENHO_ROUTE_PLANNER_H
@@ -0,0 +1,129 @@
+#ifndef OPENHO_SAVE_CHAIN_H
+#define OPENHO_SAVE_CHAIN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "serialization.h"
+#include "game_snapshot.h"
+
+class GameState;
+
+// ============================================================================
+// Delta Format
+// ============================================================================
+//
+// A delta turns the snapshot of one checkpoint (the base) into the next one.
+//   header   : magic "OHDL" (u32), format version (u16), flags (u16),
+//              base turn (u32), turn (u32), section count (u32)
+//   sections : same framing and tags as a full save (serialization.h)
+//
+// Only what changed is written: planets and players by index, per-player lists
+// as "unchanged", "full" or "patch" (removed IDs plus changed and new records),
+// visibility as changed words, history as the rows appended since the base.
+// Sections with nothing to say are left out.  Galaxy layout and the set of
+// players never change between checkpoints of one game; when they do, no delta
+// can be made and the chain starts a new keyframe.
+//
+// A chain file is a header ("OHCH" u32, version u16, flags u16) followed by
+// entries (kind u8, turn u32, payload length u32, payload), so the newest
+// entry can be appended to an existing file without rewriting it.
+
+namespace DeltaFormat
+{
+	constexpr uint32_t MAGIC = SaveFormat::make_tag('O', 'H', 'D', 'L');
+	constexpr uint16_t VERSION = 1;
+	constexpr size_t HEADER_SIZE = 20;
+
+	constexpr uint32_t CHAIN_MAGIC = SaveFormat::make_tag('O', 'H', 'C', 'H');
+	constexpr uint16_t CHAIN_VERSION = 1;
+	constexpr size_t CHAIN_HEADER_SIZE = 8;
+	constexpr size_t ENTRY_HEADER_SIZE = 9;
+
+	constexpr uint8_t ENTRY_KEYFRAME = 1;       // Payload is a full save
+	constexpr uint8_t ENTRY_DELTA = 2;          // Payload is a delta against the previous entry
+}
+
+/// Encode the changes from base to next (appends to out)
+/// Returns false, writing nothing, if next cannot be expressed as a delta of base
+[[nodiscard]] bool encode_game_delta(const GameSnapshot& base, const GameSnapshot& next, std::vector<uint8_t>& out);
+
+/// Apply a delta to the snapshot it was made against
+/// Returns false, leaving snapshot unchanged, if the data is malformed or was made against another turn
+[[nodiscard]] bool apply_game_delta(const uint8_t* data, size_t size, GameSnapshot& snapshot);
+
+// ============================================================================
+// SaveChain Class
+// ============================================================================
+
+/// Checkpoint history of one game: periodic full keyframes with per-turn
+/// deltas in between.  An autosave only has to write the newest entry, whose
+/// size follows what changed during the turn rather than the size of the game.
+/// Any checkpointed turn can be rebuilt from the nearest keyframe before it.
+class SaveChain
+{
+public:
+	struct Entry
+	{
+		uint32_t turn;
+		bool keyframe;
+		std::vector<uint8_t> data;
+	};
+
+	/// keyframe_interval: deltas allowed between keyframes (0 = every checkpoint is a keyframe)
+	explicit SaveChain(uint32_t keyframe_interval = 10);
+
+	/// Record the game's current state; returns the size of the new entry in bytes
+	/// Checkpointing a turn at or before the newest one discards the entries from that turn on
+	size_t checkpoint(const GameState& game);
+
+	/// Rebuild the snapshot of a checkpointed turn (false if the turn is not in the chain)
+	[[nodiscard]] bool reconstruct(uint32_t turn, GameSnapshot& snapshot) const;
+
+	/// Restore a game to a checkpointed turn
+	[[nodiscard]] bool load(uint32_t turn, GameState& game) const;
+
+	/// Fold every entry up to and including turn into a single keyframe
+	/// Later entries stay valid; returns false if the turn is not in the chain
+	[[nodiscard]] bool compact(uint32_t turn);
+
+	void clear();
+
+	const std::vector<Entry>& get_entries() const { return entries; }
+	bool empty() const { return entries.empty(); }
+	uint32_t get_last_turn() const { return entries.empty() ? 0 : entries.back().turn; }
+	size_t get_total_bytes() const;
+
+	/// Whole chain in the chain file format (appends to out)
+	void write(std::vector<uint8_t>& out) const;
+
+	/// Chain file header only, for starting a file that entries are appended to
+	static void write_header(std::vector<uint8_t>& out);
+
+	/// One entry in the chain file format (appends to out)
+	void write_entry(size_t index, std::vector<uint8_t>& out) const;
+
+	/// Replace the chain with one read from a chain file; the newest entry is
+	/// rebuilt to check the chain, so checkpoint() can continue it
+	/// Returns false, leaving the chain unchanged, if the file is damaged
+	[[nodiscard]] bool read(const uint8_t* data, size_t size);
+
+private:
+	/// Index of the entry for a turn (SIZE_MAX if absent)
+	size_t find_entry(uint32_t turn) const;
+
+	/// Rebuild the snapshot of chain[index] from the nearest keyframe before it
+	static bool reconstruct_entry(const std::vector<Entry>& chain, size_t index, GameSnapshot& snapshot);
+
+	/// Deltas after the last keyframe
+	static uint32_t count_trailing_deltas(const std::vector<Entry>& chain);
+
+	uint32_t keyframe_interval;
+	uint32_t deltas_since_keyframe = 0;
+	std::vector<Entry> entries;
+
+	GameSnapshot last;          // State of the newest entry (base of the next delta)
+	bool has_last = false;
+};
+
+#endif // OPENHO_SAVE_CHAIN_H
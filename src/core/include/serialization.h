@@ -0,0 +1,541 @@
+#ifndef OPENHO_SERIALIZATION_H
+#define OPENHO_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Planet;
+class PlayerHistoryStore;
+struct GalaxyGenerationParams;
+struct ShipDesign;
+struct KnowledgePlanet;
+struct GameSnapshot;
+struct PlayerRecord;
+struct ColonyRecord;
+struct FleetRecord;
+struct EnemyFleetRecord;
+struct OccupancyRecord;
+
+// ============================================================================
+// Save Format
+// ============================================================================
+//
+// Layout (all fixed-width fields little-endian):
+//   header   : magic "OHSV" (u32), format version (u16), flags (u16), section count (u32)
+//   sections : tag (u32 FourCC), payload length in bytes (u32), payload
+//
+// Payloads use LEB128 varints for unsigned integers, zigzag varints for signed
+// ones, raw little-endian IEEE-754 for doubles, and indices into the STRS string
+// table for names.  Entity IDs are written as deltas from the previous ID in the
+// same list.  Readers skip sections with unknown tags, so new sections can be
+// added without bumping the version; changing an existing payload does bump it.
+
+namespace SaveFormat
+{
+	constexpr uint32_t make_tag(char a, char b, char c, char d)
+	{
+		return static_cast<uint32_t>(static_cast<uint8_t>(a))
+		     | static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8
+		     | static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16
+		     | static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24;
+	}
+
+	constexpr uint32_t MAGIC = make_tag('O', 'H', 'S', 'V');
+	constexpr uint16_t VERSION = 1;
+	constexpr size_t HEADER_SIZE = 12;
+	constexpr size_t SECTION_HEADER_SIZE = 8;
+
+	constexpr uint32_t SECTION_META = make_tag('M', 'E', 'T', 'A');         // Turn, year, galaxy parameters
+	constexpr uint32_t SECTION_STRINGS = make_tag('S', 'T', 'R', 'S');      // String table
+	constexpr uint32_t SECTION_PLANETS = make_tag('P', 'L', 'N', 'T');      // Real planets
+	constexpr uint32_t SECTION_PLAYERS = make_tag('P', 'L', 'Y', 'R');      // Player economy and tech
+	constexpr uint32_t SECTION_COLONIES = make_tag('C', 'O', 'L', 'N');     // Colonies per player
+	constexpr uint32_t SECTION_DESIGNS = make_tag('D', 'S', 'G', 'N');      // Ship designs per player
+	constexpr uint32_t SECTION_FLEETS = make_tag('F', 'L', 'E', 'T');       // Fleets per player
+	constexpr uint32_t SECTION_OCCUPANCY = make_tag('O', 'C', 'C', 'U');    // Stationed fleet order per planet
+	constexpr uint32_t SECTION_KNOWLEDGE = make_tag('K', 'N', 'O', 'W');    // Knowledge per player
+	constexpr uint32_t SECTION_HISTORY = make_tag('H', 'I', 'S', 'T');      // Public player history
+	constexpr uint32_t SECTION_RNG = make_tag('R', 'N', 'G', 'S');          // RNG seeds and engine state
+	constexpr uint32_t SECTION_MAP = make_tag('M', 'A', 'P', 'D');          // Planets as a seed-only map (replaces PLNT)
+}
+
+// ============================================================================
+// Seed-only Maps
+// ============================================================================
+//
+// A seed-only map save has no PLNT section.  Its planets are regenerated from
+// the galaxy parameters in META, and MAPD holds only what changed since
+// generation (terraforming, mining, population, ownership, novae):
+//   generator version (varuint), hash of the generated planets (u64),
+//   planet count (varuint), changed planet count (varuint), then per changed
+//   planet: index delta (varuint), field mask (u8), the fields in the mask
+// Loading refuses a map from another GALAXY_GENERATOR_VERSION, or whose
+// regenerated planets hash differently (other text assets, other platform maths).
+
+namespace MapDelta
+{
+	constexpr uint8_t FIELD_GRAVITY = 1 << 0;
+	constexpr uint8_t FIELD_TEMPERATURE = 1 << 1;
+	constexpr uint8_t FIELD_METAL = 1 << 2;
+	constexpr uint8_t FIELD_POPULATION = 1 << 3;
+	constexpr uint8_t FIELD_OWNER = 1 << 4;
+	constexpr uint8_t FIELD_NOVA = 1 << 5;
+}
+
+/// Regenerates the planets of a seed-only map (GameState::generate_map())
+class MapGenerator
+{
+public:
+	virtual ~MapGenerator() = default;
+
+	/// The planets params generate, before any player is placed; false if it cannot
+	[[nodiscard]] virtual bool generate_planets(const GalaxyGenerationParams& params, std::vector<Planet>& planets) = 0;
+};
+
+/// FNV-1a hash of everything about a planet list (IDs, names, positions, state)
+[[nodiscard]] uint64_t hash_planets(const std::vector<Planet>& planets);
+
+// ============================================================================
+// ByteSink Interface
+// ============================================================================
+
+/// Destination for a streamed save (a file, a socket buffer, a compressor ...)
+/// Receives the bytes in order, a chunk at a time; a chunk is only valid during the call.
+class ByteSink
+{
+public:
+	virtual ~ByteSink() = default;
+
+	/// Returns false to stop the stream (the encoder then reports failure)
+	[[nodiscard]] virtual bool write(const uint8_t* data, size_t size) = 0;
+};
+
+/// Writes into fixed caller memory; refuses any chunk that does not fit
+class BufferSink : public ByteSink
+{
+public:
+	BufferSink(void* buffer, size_t capacity) : buffer(static_cast<uint8_t*>(buffer)), capacity(capacity) {}
+
+	bool write(const uint8_t* data, size_t size) override
+	{
+		if (size > capacity - used)
+			{ return false; }
+		std::memcpy(buffer + used, data, size);
+		used += size;
+		return true;
+	}
+
+	size_t size() const { return used; }
+
+private:
+	uint8_t* buffer;
+	size_t capacity;
+	size_t used = 0;
+};
+
+// ============================================================================
+// ByteWriter Class
+// ============================================================================
+
+/// Appends little-endian fixed-width values and varints to a byte vector
+/// A streaming writer uses the vector as a chunk buffer instead: encoders call
+/// flush_point() between records, which hands the buffer to a sink once it
+/// holds CHUNK_SIZE bytes, so memory stays bounded by a chunk plus one record.
+/// A counting writer stores nothing and only advances size(), for exact size
+/// queries that need no output.
+class ByteWriter
+{
+public:
+	/// Buffered bytes at which a streaming writer passes them to its sink
+	static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+	/// Tag for the counting form
+	struct CountOnly {};
+
+	explicit ByteWriter(std::vector<uint8_t>& output) : out(output) {}
+
+	/// Stream to a sink, with buffer (cleared) as the chunk buffer; call flush() at the end
+	ByteWriter(std::vector<uint8_t>& buffer, ByteSink& sink) : out(buffer), sink(&sink), flush_at(CHUNK_SIZE)
+		{ out.clear(); }
+
+	/// Count the bytes that would be written, without writing them
+	explicit ByteWriter(CountOnly) : out(unused), counting(true) {}
+
+	void put_u8(uint8_t value)
+	{
+		if (counting)
+			{ flushed += 1; }
+		else
+			{ out.push_back(value); }
+	}
+	void put_u16(uint16_t value) { put_fixed(value, 2); }
+	void put_u32(uint32_t value) { put_fixed(value, 4); }
+	void put_u64(uint64_t value) { put_fixed(value, 8); }
+	void put_f64(double value)
+	{
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		put_fixed(bits, 8);
+	}
+
+	/// Unsigned LEB128
+	void put_varuint(uint64_t value)
+	{
+		if (counting)
+		{
+			do
+			{
+				flushed += 1;
+				value >>= 7;
+			} while (value);
+			return;
+		}
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<uint8_t>(value));
+	}
+
+	/// Zigzag-mapped signed LEB128 (small magnitudes of either sign stay short)
+	void put_varint(int64_t value)
+		{ put_varuint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)); }
+
+	void put_bytes(const void* data, size_t size)
+	{
+		if (counting)
+		{
+			flushed += size;
+			return;
+		}
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		out.insert(out.end(), bytes, bytes + size);
+	}
+
+	/// Bytes written so far (including any already passed to the sink)
+	size_t size() const { return flushed + out.size(); }
+
+	/// Start a section; returns the position to pass to end_section()
+	/// The length is patched in place, so a streaming writer cannot use this
+	/// (it writes the tag and a length measured by a counting pass itself).
+	size_t begin_section(uint32_t tag)
+	{
+		put_u32(tag);
+		put_u32(0);
+		return size();
+	}
+
+	/// Patch the length of a section started with begin_section()
+	void end_section(size_t payload_start)
+	{
+		if (counting)
+			{ return; }
+		uint32_t length = static_cast<uint32_t>(out.size() - payload_start);
+		for (size_t i = 0; i < 4; ++i)
+			{ out[payload_start - 4 + i] = static_cast<uint8_t>(length >> (8 * i)); }
+	}
+
+	/// Between records: pass a full chunk to the sink (never for the vector form)
+	void flush_point()
+	{
+		if (out.size() >= flush_at)
+			{ flush(); }
+	}
+
+	/// Pass buffered bytes to the sink; returns false once the sink has stopped the stream
+	/// (later bytes are then dropped).  Does nothing for the vector form.
+	bool flush()
+	{
+		if (sink && !out.empty())
+		{
+			failed = failed || !sink->write(out.data(), out.size());
+			flushed += out.size();
+			out.clear();
+		}
+		return !failed;
+	}
+
+private:
+	std::vector<uint8_t> unused;    // Stands in for the output of a counting writer
+	std::vector<uint8_t>& out;
+	ByteSink* sink = nullptr;
+	size_t flush_at = SIZE_MAX;
+	size_t flushed = 0;
+	bool counting = false;
+	bool failed = false;
+
+	void put_fixed(uint64_t value, size_t bytes)
+	{
+		if (counting)
+		{
+			flushed += bytes;
+			return;
+		}
+		for (size_t i = 0; i < bytes; ++i)
+			{ out.push_back(static_cast<uint8_t>(value >> (8 * i))); }
+	}
+};
+
+// ============================================================================
+// ByteReader Class
+// ============================================================================
+
+/// Bounds-checked reader over a byte range
+/// Any read past the end (or malformed varint) sets a sticky failure flag and
+/// returns zero, so decoders can read a whole record and check ok() once.
+class ByteReader
+{
+public:
+	ByteReader(const uint8_t* data, size_t size) : cursor(data), end(data + size) {}
+
+	bool ok() const { return !failed; }
+	bool at_end() const { return cursor == end; }
+	size_t remaining() const { return static_cast<size_t>(end - cursor); }
+
+	uint8_t get_u8() { return static_cast<uint8_t>(get_fixed(1)); }
+	uint16_t get_u16() { return static_cast<uint16_t>(get_fixed(2)); }
+	uint32_t get_u32() { return static_cast<uint32_t>(get_fixed(4)); }
+	uint64_t get_u64() { return get_fixed(8); }
+	double get_f64()
+	{
+		uint64_t bits = get_fixed(8);
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	uint64_t get_varuint()
+	{
+		uint64_t value = 0;
+		for (uint32_t shift = 0; shift < 64; shift += 7)
+		{
+			if (cursor == end)
+				{ return fail(); }
+			uint8_t byte = *cursor++;
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+				{ return value; }
+		}
+		return fail();
+	}
+
+	int64_t get_varint()
+	{
+		uint64_t zigzag = get_varuint();
+		return static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+	}
+
+	/// Varint that must fit in 32 bits (fails otherwise)
+	uint32_t get_varuint32()
+	{
+		uint64_t value = get_varuint();
+		if (value > UINT32_MAX)
+			{ return static_cast<uint32_t>(fail()); }
+		return static_cast<uint32_t>(value);
+	}
+	int32_t get_varint32()
+	{
+		int64_t value = get_varint();
+		if (value < INT32_MIN || value > INT32_MAX)
+			{ return static_cast<int32_t>(fail()); }
+		return static_cast<int32_t>(value);
+	}
+
+	/// Element count that cannot exceed the bytes left (each element takes at least one byte)
+	uint32_t get_count()
+	{
+		uint32_t count = get_varuint32();
+		if (count > remaining())
+			{ return static_cast<uint32_t>(fail()); }
+		return count;
+	}
+
+	/// Borrow size bytes from the input (nullptr on failure)
+	const uint8_t* get_bytes(size_t size)
+	{
+		if (size > remaining())
+		{
+			fail();
+			return nullptr;
+		}
+		const uint8_t* start = cursor;
+		cursor += size;
+		return start;
+	}
+
+private:
+	const uint8_t* cursor;
+	const uint8_t* end;
+	bool failed = false;
+
+	uint64_t fail()
+	{
+		failed = true;
+		cursor = end;
+		return 0;
+	}
+
+	uint64_t get_fixed(size_t bytes)
+	{
+		if (remaining() < bytes)
+			{ return fail(); }
+		uint64_t value = 0;
+		for (size_t i = 0; i < bytes; ++i)
+			{ value |= static_cast<uint64_t>(cursor[i]) << (8 * i); }
+		cursor += bytes;
+		return value;
+	}
+};
+
+// ============================================================================
+// StringTable Class
+// ============================================================================
+
+/// Deduplicated strings referenced by index from the other sections
+class StringTable
+{
+public:
+	/// Index of a string, adding it if new
+	uint32_t intern(const std::string& value)
+	{
+		auto it = indices.find(value);
+		if (it != indices.end())
+			{ return it->second; }
+		uint32_t index = static_cast<uint32_t>(strings.size());
+		strings.push_back(value);
+		indices.emplace(value, index);
+		return index;
+	}
+
+	const std::vector<std::string>& get_strings() const { return strings; }
+
+private:
+	std::vector<std::string> strings;
+	std::unordered_map<std::string, uint32_t> indices;
+};
+
+// ============================================================================
+// SectionIndex Class
+// ============================================================================
+
+/// Sections of a container (save or delta), indexed by tag; unknown tags are kept but never looked up
+class SectionIndex
+{
+public:
+	/// Read section_count sections from reader; false if any is truncated
+	[[nodiscard]] bool parse(ByteReader& reader, uint32_t section_count);
+
+	/// Point reader at the payload of the first section with this tag
+	bool find(uint32_t tag, ByteReader& reader) const;
+
+private:
+	struct Section
+	{
+		uint32_t tag;
+		const uint8_t* payload;
+		uint32_t length;
+	};
+	std::vector<Section> sections;
+};
+
+// ============================================================================
+// Record Codecs
+// ============================================================================
+// Payload encoding of individual records, shared by full saves and per-turn
+// deltas (save_chain.h).  Readers return false on truncated or malformed input;
+// names go through the string table of the enclosing container.
+
+namespace SaveRecords
+{
+	void write_strings(ByteWriter& w, const StringTable& strings);
+	[[nodiscard]] bool read_strings(ByteReader& r, std::vector<std::string>& strings);
+
+	/// Mutable planet fields (identity, name and position are written once per full save)
+	void write_planet_state(ByteWriter& w, const Planet& planet);
+	[[nodiscard]] bool read_planet_state(ByteReader& r, Planet& planet);
+
+	/// Player settings, economy and tech (everything but the ID and the per-player lists)
+	void write_player(ByteWriter& w, const PlayerRecord& player, StringTable& strings);
+	[[nodiscard]] bool read_player(ByteReader& r, const std::vector<std::string>& strings, PlayerRecord& player);
+
+	// IDs in lists are deltas from previous_id, which the caller starts at 0
+	void write_colony(ByteWriter& w, const ColonyRecord& colony, uint32_t& previous_id);
+	ColonyRecord read_colony(ByteReader& r, uint32_t& previous_id);
+	void write_colonies(ByteWriter& w, const std::vector<ColonyRecord>& colonies);
+	[[nodiscard]] bool read_colonies(ByteReader& r, std::vector<ColonyRecord>& colonies);
+
+	void write_designs(ByteWriter& w, const std::vector<ShipDesign>& designs, StringTable& strings);
+	[[nodiscard]] bool read_designs(ByteReader& r, const std::vector<std::string>& strings, std::vector<ShipDesign>& designs);
+
+	void write_fleet(ByteWriter& w, const FleetRecord& fleet, uint32_t& previous_id, StringTable& strings);
+	[[nodiscard]] bool read_fleet(ByteReader& r, const std::vector<std::string>& strings, uint32_t& previous_id, FleetRecord& fleet);
+	void write_fleets(ByteWriter& w, const std::vector<FleetRecord>& fleets, StringTable& strings);
+	[[nodiscard]] bool read_fleets(ByteReader& r, const std::vector<std::string>& strings, std::vector<FleetRecord>& fleets);
+
+	void write_known_planet(ByteWriter& w, const KnowledgePlanet& known, uint32_t& previous_id);
+	KnowledgePlanet read_known_planet(ByteReader& r, uint32_t& previous_id);
+
+	void write_enemy_fleets(ByteWriter& w, const std::vector<EnemyFleetRecord>& enemy_fleets);
+	[[nodiscard]] bool read_enemy_fleets(ByteReader& r, std::vector<EnemyFleetRecord>& enemy_fleets);
+
+	void write_occupancy(ByteWriter& w, const std::vector<OccupancyRecord>& occupancy);
+	[[nodiscard]] bool read_occupancy(ByteReader& r, std::vector<OccupancyRecord>& occupancy);
+
+	/// Whole history store: player IDs, retention, then every row
+	void write_history(ByteWriter& w, const PlayerHistoryStore& history);
+	[[nodiscard]] bool read_history(ByteReader& r, PlayerHistoryStore& history);
+
+	/// Rows [first_row, end) of a history store; reading replays them into a store
+	/// that already has the same players (begin_turn rules apply)
+	void write_history_rows(ByteWriter& w, const PlayerHistoryStore& history, size_t first_row);
+	[[nodiscard]] bool read_history_rows(ByteReader& r, PlayerHistoryStore& history);
+
+	/// Seeds and engine states
+	void write_rng(ByteWriter& w, const GameSnapshot& snapshot);
+	[[nodiscard]] bool read_rng(ByteReader& r, GameSnapshot& snapshot);
+
+	/// Planets as the changes from generated (MAPD payload); generated must match
+	/// planets by ID, name and position (map_matches_planets())
+	void write_map(ByteWriter& w, const std::vector<Planet>& generated, const std::vector<Planet>& planets);
+	[[nodiscard]] bool map_matches_planets(const std::vector<Planet>& generated, const std::vector<Planet>& planets);
+	/// Read the version and hash, then rebuild planets from generated and the changes
+	[[nodiscard]] bool read_map(ByteReader& r, const std::vector<Planet>& generated, std::vector<Planet>& planets);
+}
+
+// ============================================================================
+// Snapshot Encoding
+// ============================================================================
+
+/// Encode a snapshot in the save format (appends to out)
+void encode_game_snapshot(const GameSnapshot& snapshot, std::vector<uint8_t>& out);
+
+/// Encode a snapshot as a seed-only map save (MAPD instead of PLNT); generated
+/// holds the planets snapshot.galaxy_params generate.  Falls back to a full save
+/// if those do not match the snapshot's planets by ID, name and position.
+void encode_game_snapshot(const GameSnapshot& snapshot, const std::vector<Planet>& generated, std::vector<uint8_t>& out);
+
+/// Exact size encode_game_snapshot() would produce, without producing it
+/// (walks the snapshot with a counting writer: no bytes are stored)
+/// The snapshot may hold its knowledge expanded or frozen (capture_frozen_snapshot()),
+/// as may every encoder here; frozen pages are read in place.
+[[nodiscard]] size_t measure_game_snapshot(const GameSnapshot& snapshot);
+
+/// Encode a snapshot straight to a sink, in chunks of about ByteWriter::CHUNK_SIZE
+/// The bytes match encode_game_snapshot().  A counting pass measures the section
+/// lengths first, then each section streams after its tag and length, so memory
+/// stays bounded by a chunk plus one record.  Returns false if the sink stopped the stream.
+[[nodiscard]] bool stream_game_snapshot(const GameSnapshot& snapshot, ByteSink& sink);
+
+/// Decode a save; returns false (leaving snapshot unspecified) if the data is
+/// truncated, malformed, or written by a newer format version
+/// Seed-only map saves need a generator, and fail the hash and version checks
+/// described under Seed-only Maps.
+[[nodiscard]] bool decode_game_snapshot(const uint8_t* data, size_t size, GameSnapshot& snapshot,
+	MapGenerator* maps = nullptr);
+
+#endif // OPENHO_SERIALIZATION_H
@@ -0,0 +1,111 @@
+#ifndef OPENHO_VISIBILITY_H
+#define OPENHO_VISIBILITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "planet_bitset.h"
+
+// ============================================================================
+// Forward Declarations
+// ============================================================================
+
+class Galaxy;
+class Player;
+
+// ============================================================================
+// PlanetGrid Class
+// ============================================================================
+
+/// Uniform grid over planet coordinates for radius queries.
+/// Planets never move, so the grid is built once per galaxy.  Each cell lists
+/// its planet IDs in compressed sparse row form; a radius query only visits
+/// the cells overlapping the query square.
+class PlanetGrid
+{
+public:
+	/// Build the grid (cell_size should be close to the typical query radius)
+	void build(const Galaxy& galaxy, double cell_size);
+
+	/// Call fn(planet_id) for every planet within radius of (x, y)
+	template<typename Fn>
+	void for_each_within(double x, double y, double radius, Fn&& fn) const
+	{
+		if (cell_offsets.empty())
+			{ return; }
+
+		uint32_t cx0 = cell_x(x - radius);
+		uint32_t cx1 = cell_x(x + radius);
+		uint32_t cy0 = cell_y(y - radius);
+		uint32_t cy1 = cell_y(y + radius);
+		double radius_sq = radius * radius;
+
+		for (uint32_t cy = cy0; cy <= cy1; ++cy)
+		{
+			for (uint32_t cx = cx0; cx <= cx1; ++cx)
+			{
+				size_t cell = static_cast<size_t>(cy) * columns + cx;
+				for (uint32_t k = cell_offsets[cell]; k < cell_offsets[cell + 1]; ++k)
+				{
+					double dx = cell_planet_x[k] - x;
+					double dy = cell_planet_y[k] - y;
+					if (dx * dx + dy * dy <= radius_sq)
+						{ fn(cell_planet_ids[k]); }
+				}
+			}
+		}
+	}
+
+private:
+	double min_x = 0.0;
+	double min_y = 0.0;
+	double inv_cell_size = 1.0;
+	uint32_t columns = 0;
+	uint32_t rows = 0;
+
+	std::vector<uint32_t> cell_offsets;       // cell_offsets[c] .. cell_offsets[c + 1] index the arrays below
+	std::vector<uint32_t> cell_planet_ids;
+	std::vector<double> cell_planet_x;        // Coordinates stored alongside IDs for the distance test
+	std::vector<double> cell_planet_y;
+
+	uint32_t clamp_cell(double offset, uint32_t count) const;
+	uint32_t cell_x(double x) const { return clamp_cell((x - min_x) * inv_cell_size, columns); }
+	uint32_t cell_y(double y) const { return clamp_cell((y - min_y) * inv_cell_size, rows); }
+};
+
+// ============================================================================
+// VisibilitySystem Class
+// ============================================================================
+
+/// Computes which planets each player can see this turn.
+///
+/// Every colony and every stationed fleet is a sensor centred on its planet;
+/// sensors sharing a planet are merged and keep the larger range.  Each sensor
+/// queries the planet grid, so the cost of a player's update is proportional
+/// to its sensors and the planets they see, not to the size of the galaxy.
+/// Fleets in transit have no position between planets and do not act as sensors.
+/// The fleets seen at each visible planet come from the game's FleetOccupancyIndex.
+class VisibilitySystem
+{
+public:
+	/// Build the spatial index for a galaxy (planet IDs 1..N)
+	void build(const Galaxy& galaxy);
+
+	/// Planets within sensor range of a player's colonies and stationed fleets
+	/// (bit N set = planet ID N visible)
+	void compute_visible_planets(const Player& player, PlanetBitset& visible);
+
+private:
+	PlanetGrid grid;
+	std::vector<double> planet_x;       // Indexed by planet ID
+	std::vector<double> planet_y;
+	uint32_t max_planet_id = 0;
+
+	// Per-player scratch: sensor planets and their merged ranges
+	PlanetBitset sensor_planets;
+	std::vector<double> sensor_range;   // Indexed by planet ID, valid where sensor_planets is set
+
+	void add_sensor(uint32_t planet_id, double range);
+};
+
+#endif // OPENHO_VISIBILITY_H
@@ -0,0 +1,244 @@
+#include "autosave.h"
+#include "game.h"
+#include "game_snapshot.h"
+#include <algorithm>
+#include <cstdio>
+
+// ============================================================================
+// FileAutosaveTarget Class
+// ============================================================================
+
+class FileAutosaveTarget::FileSink : public ByteSink
+{
+public:
+	explicit FileSink(std::FILE* file) : file(file) {}
+	~FileSink() override { close(); }
+
+	bool write(const uint8_t* data, size_t size) override
+		{ return std::fwrite(data, 1, size, file) == size; }
+
+	bool close()
+	{
+		if (!file)
+			{ return true; }
+		bool closed = std::fclose(file) == 0;
+		file = nullptr;
+		return closed;
+	}
+
+private:
+	std::FILE* file;
+};
+
+FileAutosaveTarget::FileAutosaveTarget(const std::string& path)
+	: path(path), temp_path(path + ".tmp")
+{
+}
+
+FileAutosaveTarget::~FileAutosaveTarget()
+{
+	if (sink)
+	{
+		sink->close();
+		std::remove(temp_path.c_str());
+	}
+}
+
+ByteSink* FileAutosaveTarget::begin_save(uint32_t)
+{
+	std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+	if (!file)
+		{ return nullptr; }
+	sink = std::make_unique<FileSink>(file);
+	return sink.get();
+}
+
+bool FileAutosaveTarget::end_save(uint32_t, bool streamed)
+{
+	if (!sink)
+		{ return false; }
+	bool kept = sink->close() && streamed;
+	sink.reset();
+	if (kept && std::rename(temp_path.c_str(), path.c_str()) != 0)
+	{
+		// Some platforms will not rename over an existing file
+		std::remove(path.c_str());
+		kept = std::rename(temp_path.c_str(), path.c_str()) == 0;
+	}
+	if (!kept)
+		{ std::remove(temp_path.c_str()); }
+	return kept;
+}
+
+// ============================================================================
+// AutosaveService Class
+// ============================================================================
+
+namespace
+{
+	/// Passes a save through to the target's sink, counting its bytes
+	class CountingSink : public ByteSink
+	{
+	public:
+		explicit CountingSink(ByteSink& next) : next(next) {}
+
+		bool write(const uint8_t* data, size_t size) override
+		{
+			bytes += size;
+			return next.write(data, size);
+		}
+
+		size_t bytes = 0;
+
+	private:
+		ByteSink& next;
+	};
+
+	double elapsed_ms(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+		{ return std::chrono::duration<double, std::milli>(end - start).count(); }
+}
+
+AutosaveService::AutosaveService(AutosaveTarget& target, uint32_t interval, size_t queue_capacity)
+	: target(target),
+	  interval(std::max<uint32_t>(interval, 1)),
+	  queue_capacity(std::max<size_t>(queue_capacity, 1))
+{
+	worker = std::thread(&AutosaveService::run, this);
+}
+
+AutosaveService::~AutosaveService()
+{
+	stop();
+}
+
+void AutosaveService::attach(GameState& game)
+{
+	game.set_autosave(this);
+}
+
+void AutosaveService::on_turn_processed(const GameState& game)
+{
+	if (game.get_current_turn() % interval == 0)
+		{ save_now(game); }
+}
+
+void AutosaveService::save_now(const GameState& game)
+{
+	Pending pending;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopping)
+		{
+			metrics.dropped++;
+			return;
+		}
+		if (!spare.empty())
+		{
+			pending.snapshot = std::move(spare.back());
+			spare.pop_back();
+		}
+	}
+	if (!pending.snapshot)
+		{ pending.snapshot = std::make_unique<GameSnapshot>(); }
+
+	// The only work on the turn thread: copy the mutable state (knowledge pages are pinned, not copied)
+	Clock::time_point start = Clock::now();
+	game.capture_frozen_snapshot(*pending.snapshot);
+	pending.captured = Clock::now();
+	double capture_ms = elapsed_ms(start, pending.captured);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		metrics.snapshots++;
+		metrics.last_capture_ms = capture_ms;
+		metrics.max_capture_ms = std::max(metrics.max_capture_ms, capture_ms);
+		if (queue.size() >= queue_capacity)
+		{
+			spare.push_back(std::move(queue.front().snapshot));
+			queue.pop_front();
+			metrics.dropped++;
+		}
+		queue.push_back(std::move(pending));
+		metrics.queued = queue.size();
+	}
+	work_ready.notify_one();
+}
+
+void AutosaveService::wait_idle()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	idle.wait(lock, [this]() { return queue.empty() && !writing; });
+}
+
+void AutosaveService::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	work_ready.notify_one();
+	if (worker.joinable())
+		{ worker.join(); }
+}
+
+AutosaveMetrics AutosaveService::get_metrics() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return metrics;
+}
+
+void AutosaveService::run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;)
+	{
+		work_ready.wait(lock, [this]() { return stopping || !queue.empty(); });
+		if (queue.empty())
+			{ break; }
+
+		Pending pending = std::move(queue.front());
+		queue.pop_front();
+		metrics.queued = queue.size();
+		writing = true;
+
+		lock.unlock();
+		write(pending);
+		lock.lock();
+
+		// Keep enough spares for a full queue plus the one being captured
+		if (spare.size() <= queue_capacity)
+			{ spare.push_back(std::move(pending.snapshot)); }
+		writing = false;
+		if (queue.empty())
+			{ idle.notify_all(); }
+	}
+	idle.notify_all();
+}
+
+void AutosaveService::write(Pending& pending)
+{
+	const uint32_t turn = pending.snapshot->current_turn;
+	bool streamed = false;
+	size_t bytes = 0;
+	if (ByteSink* sink = target.begin_save(turn))
+	{
+		CountingSink counted(*sink);
+		streamed = stream_game_snapshot(*pending.snapshot, counted);
+		bytes = counted.bytes;
+	}
+	bool kept = target.end_save(turn, streamed);
+	double lag_ms = elapsed_ms(pending.captured, Clock::now());
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!kept)
+	{
+		metrics.failed++;
+		return;
+	}
+	metrics.saves++;
+	metrics.last_saved_turn = turn;
+	metrics.last_save_bytes = bytes;
+	metrics.last_lag_ms = lag_ms;
+	metrics.max_lag_ms = std::max(metrics.max_lag_ms, lag_ms);
+	metrics.total_lag_ms += lag_ms;
+}
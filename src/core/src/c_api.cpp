@@ -1,6 +1,8 @@
 #include "game.h"
 #include "openho_core.h"
 #include "game_setup.h"
+#include "command_journal.h"
+#include "serialization.h"
 #include <cstring>
 #include <unordered_set>
 
@@ -176,23 +178,28 @@ ErrorCode game_get_planet_perceived_values(void* game, uint32_t planetID, uint32
 // ============================================================================
 // Player Public Information Queries
 // ============================================================================
-void game_get_full_player_info_history(void* game, uint32_t player_id, const std::vector<PlayerPublicInfo>** out)
-	{
-		if (!game || !out)
-			{ return; }
-		
-		GameState* gameState = static_cast<GameState*>(game);
-		*out = &gameState->get_full_player_info_history(player_id);
+ErrorCode game_get_player_public_info(void* game, uint32_t player_id, uint32_t turn, PlayerPublicInfo* out)
+{
+	if (!game || !out)
+		{ return ErrorCode::INVALID_PARAMETER; }
+	
+	GameState* gameState = static_cast<GameState*>(game);
+	if (!gameState->get_player(player_id))
+		{ return ErrorCode::INVALID_PLAYER_ID; }
+	if (!gameState->get_player_public_info(player_id, turn, *out))
+		{ return ErrorCode::INVALID_PARAMETER; }
+	return ErrorCode::SUCCESS;
 }
 
-	uint32_t game_get_player_info_history_size(void* game, uint32_t player_id)
-	{
-		if (!game)
-			{ return 0; }
-		
-		GameState* gameState = static_cast<GameState*>(game);
-		const auto& history = gameState->get_full_player_info_history(player_id);
-		return static_cast<uint32_t>(history.size());
+uint32_t game_get_player_info_history_size(void* game, uint32_t player_id)
+{
+	if (!game)
+		{ return 0; }
+	
+	GameState* gameState = static_cast<GameState*>(game);
+	if (!gameState->get_player(player_id))
+		{ return 0; }
+	return static_cast<uint32_t>(gameState->get_player_history().get_row_count());
 }
 
 // ============================================================================
@@ -204,17 +211,7 @@ ErrorCode game_set_money_allocation(void* game, uint32_t player_id, const Player
 		return ErrorCode::INVALID_PARAMETER;
 	
 	GameState* gameState = static_cast<GameState*>(game);
-	
-	try
-	{
-		gameState->set_money_allocation(player_id, *money_alloc);
-		return ErrorCode::SUCCESS;
-	}
-	catch (const std::exception& e)
-	{
-		// In production, log the error
-		return ErrorCode::INVALID_ALLOCATION;
-	}
+	return gameState->execute_command(GameCommand::set_money_allocation(player_id, *money_alloc));
 }
 
 ErrorCode game_get_money_allocation(void* game, uint32_t player_id, Player::MoneyAllocation* out)
@@ -249,13 +246,13 @@ uint64_t game_get_ai_seed(void* game)
 	return gameState->get_ai_seed();
 }
 
-void game_set_ai_seed(void* game, uint64_t seed)
+ErrorCode game_set_ai_seed(void* game, uint64_t seed)
 {
 	if (!game)
-		{ return; }
+		{ return ErrorCode::INVALID_PARAMETER; }
 	
 	GameState* gameState = static_cast<GameState*>(game);
-	gameState->set_ai_seed(seed);
+	return gameState->set_ai_seed(seed);
 }
 
 // ============================================================================
@@ -283,15 +280,13 @@ int game_serialize_state(void* game, void* buffer, int bufferSize)
 	
 	try
 	{
-		std::vector<uint8_t> serialized = gameState->serialize_state();
-		
-		if (static_cast<int>(serialized.size()) > bufferSize)
+		// Streamed straight into the caller's buffer; the sink refuses to overrun it
+		BufferSink sink(buffer, static_cast<size_t>(bufferSize));
+		if (!gameState->serialize_state(sink))
 		{
 			return -1; // Buffer too small
 		}
-		
-		std::memcpy(buffer, serialized.data(), serialized.size());
-		return static_cast<int>(serialized.size());
+		return static_cast<int>(sink.size());
 	}
 	catch (const std::exception& e)
 	{
@@ -333,8 +328,52 @@ int game_get_serialized_state_size(void* game)
 	
 	try
 	{
-		std::vector<uint8_t> serialized = gameState->serialize_state();
-		return static_cast<int>(serialized.size());
+		return static_cast<int>(gameState->get_serialized_size());
+	}
+	catch (const std::exception& e)
+	{
+		// In production, log the error
+		return -1;
+	}
+}
+
+namespace
+{
+	/// Adapts a C write callback to a ByteSink
+	class CallbackSink : public ByteSink
+	{
+	public:
+		CallbackSink(SaveWriteFn write_fn, void* context) : write_fn(write_fn), context(context) {}
+		
+		bool write(const uint8_t* data, size_t size) override
+		{
+			if (write_fn(context, data, size) == 0)
+				{ return false; }
+			written += static_cast<int64_t>(size);
+			return true;
+		}
+		
+		int64_t written = 0;
+		
+	private:
+		SaveWriteFn write_fn;
+		void* context;
+	};
+}
+
+int64_t game_serialize_state_stream(void* game, SaveWriteFn write, void* context)
+{
+	if (!game || !write)
+		{ return -1; }
+	
+	GameState* gameState = static_cast<GameState*>(game);
+	
+	try
+	{
+		CallbackSink sink(write, context);
+		if (!gameState->serialize_state(sink))
+			{ return -1; }
+		return sink.written;
 	}
 	catch (const std::exception& e)
 	{
@@ -354,12 +393,10 @@ uint32_t game_create_ship_design(void* game, uint32_t player_id, const char* nam
 		{ return 0; }
 	
 	GameState* gameState = static_cast<GameState*>(game);
-	Player* player = gameState->get_player(player_id);
-	if (!player)
-		{ return 0; }
-	
-	return player->create_ship_design(std::string(name), type, tech_range, tech_speed, 
-	                                    tech_weapons, tech_shields, tech_miniaturization);
+	uint32_t design_id = 0;
+	(void)gameState->execute_command(GameCommand::create_ship_design(player_id, std::string(name), type, tech_range, tech_speed,
+	                                                                tech_weapons, tech_shields, tech_miniaturization), &design_id);
+	return design_id;
 }
 
 ErrorCode game_get_ship_design(void* game, uint32_t player_id, uint32_t design_id, ShipDesign* out)
@@ -421,12 +458,10 @@ ErrorCode game_delete_ship_design(void* game, uint32_t player_id, uint32_t desig
 		return ErrorCode::INVALID_PARAMETER;
 	
 	GameState* gameState = static_cast<GameState*>(game);
-	Player* player = gameState->get_player(player_id);
-	if (!player)
+	if (!gameState->get_player(player_id))
 		return ErrorCode::INVALID_PARAMETER;
 	
-	bool success = player->delete_ship_design(design_id);
-	return success ? ErrorCode::SUCCESS : ErrorCode::SHIP_DESIGN_NOT_FOUND;
+	return gameState->execute_command(GameCommand::delete_ship_design(player_id, design_id));
 }
 
 ErrorCode game_build_ship_from_design(void* game, uint32_t player_id, uint32_t design_id)
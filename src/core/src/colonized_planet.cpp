@@ -36,3 +36,11 @@ void ColonizedPlanet::update_desirability()
 	// Placeholder: All planets are maximally desirable (3)
 	desirability = 3;
 }
+
+void ColonizedPlanet::set_population(int32_t p_val)
+{
+	// Keep the owner's incrementally maintained victory points in step
+	if (owner_player && p_val != population)
+		{ owner_player->on_colony_population_changed(population, p_val); }
+	population = p_val;
+}
@@ -0,0 +1,242 @@
+#include "combat.h"
+#include "enums.h"
+#include "game_constants.h"
+#include "game_formulas.h"
+#include "rng.h"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// CombatEngine Implementation
+// ============================================================================
+
+CombatResult CombatEngine::resolve(std::vector<CombatParticipant>& participants, RNGStream& rng)
+{
+	CombatResult result;
+	result.victor = NOT_OWNED;
+
+	if (participants.empty())
+		{ return result; }
+
+	build_groups(participants);
+
+	double ships_before = 0.0;
+	for (double ships : group_ships)
+		{ ships_before += ships; }
+
+	// Fight until one side remains or the round limit is reached
+	while (count_surviving_sides() > 1 && result.rounds_fought < GameConstants::Combat_Max_Rounds)
+	{
+		fight_round(rng);
+		result.rounds_fought++;
+	}
+	uint32_t surviving = count_surviving_owners();
+
+	double ships_after = 0.0;
+	for (double ships : group_ships)
+		{ ships_after += ships; }
+
+	distribute_losses(participants);
+
+	result.ships_destroyed = static_cast<uint32_t>(ships_before - ships_after);
+	result.surviving_owners = surviving;
+	if (surviving == 1)
+	{
+		for (size_t slot = 0; slot < owner_ids.size(); ++slot)
+		{
+			if (owner_ships[slot] > 0.0)
+				{ result.victor = owner_ids[slot]; }
+		}
+	}
+	return result;
+}
+
+void CombatEngine::build_groups(const std::vector<CombatParticipant>& participants)
+{
+	// Sort participants so that fleets sharing (owner, weapons, shields) are adjacent
+	order.resize(participants.size());
+	for (uint32_t i = 0; i < order.size(); ++i)
+		{ order[i] = i; }
+
+	std::sort(order.begin(), order.end(), [&participants](uint32_t a, uint32_t b)
+	{
+		const CombatParticipant& pa = participants[a];
+		const CombatParticipant& pb = participants[b];
+		if (pa.owner != pb.owner)
+			{ return pa.owner < pb.owner; }
+		if (pa.tech_weapons != pb.tech_weapons)
+			{ return pa.tech_weapons < pb.tech_weapons; }
+		if (pa.tech_shields != pb.tech_shields)
+			{ return pa.tech_shields < pb.tech_shields; }
+		return pa.fleet_id < pb.fleet_id;
+	});
+
+	group_owner_slot.clear();
+	group_first.clear();
+	group_last.clear();
+	group_ships.clear();
+	group_attack.clear();
+	group_inv_defense.clear();
+	owner_ids.clear();
+	owner_alliance.clear();
+
+	for (uint32_t pos = 0; pos < order.size(); ++pos)
+	{
+		const CombatParticipant& p = participants[order[pos]];
+
+		bool new_owner = owner_ids.empty() || owner_ids.back() != p.owner;
+		bool new_group = new_owner ||
+			participants[order[pos - 1]].tech_weapons != p.tech_weapons ||
+			participants[order[pos - 1]].tech_shields != p.tech_shields;
+
+		if (new_owner)
+		{
+			owner_ids.push_back(p.owner);
+			owner_alliance.push_back(p.alliance);
+		}
+
+		if (new_group)
+		{
+			group_owner_slot.push_back(static_cast<uint32_t>(owner_ids.size() - 1));
+			group_first.push_back(pos);
+			group_last.push_back(pos);
+			group_ships.push_back(0.0);
+			group_attack.push_back(GameFormulas::calculate_ship_attack_strength(p.tech_weapons));
+			group_inv_defense.push_back(1.0 / GameFormulas::calculate_ship_defense_strength(p.tech_shields));
+		}
+
+		group_last.back() = pos + 1;
+		group_ships.back() += static_cast<double>(p.ship_count);
+	}
+
+	size_t n_groups = group_ships.size();
+	group_incoming.assign(n_groups, 0.0);
+	group_losses.assign(n_groups, 0.0);
+
+	size_t n_owners = owner_ids.size();
+	owner_firepower.assign(n_owners, 0.0);
+	owner_ships.assign(n_owners, 0.0);
+	owner_side_ships.assign(n_owners, 0.0);
+	owner_pressure.assign(n_owners, 0.0);
+
+	for (size_t g = 0; g < n_groups; ++g)
+		{ owner_ships[group_owner_slot[g]] += group_ships[g]; }
+}
+
+bool CombatEngine::same_side(size_t a, size_t b) const
+{
+	return a == b || (owner_alliance[a] != 0 && owner_alliance[a] == owner_alliance[b]);
+}
+
+uint32_t CombatEngine::count_surviving_sides()
+{
+	// A surviving owner starts a new side unless an earlier survivor is its ally
+	uint32_t count = 0;
+	for (size_t o = 0; o < owner_ids.size(); ++o)
+	{
+		if (owner_ships[o] <= 0.0)
+			{ continue; }
+		bool counted = false;
+		for (size_t a = 0; a < o && !counted; ++a)
+			{ counted = owner_ships[a] > 0.0 && same_side(a, o); }
+		if (!counted)
+			{ count++; }
+	}
+	return count;
+}
+
+uint32_t CombatEngine::count_surviving_owners()
+{
+	uint32_t count = 0;
+	for (double ships : owner_ships)
+	{
+		if (ships > 0.0)
+			{ count++; }
+	}
+	return count;
+}
+
+void CombatEngine::fight_round(RNGStream& rng)
+{
+	const size_t n_groups = group_ships.size();
+	const size_t n_owners = owner_ids.size();
+
+	// Owner totals at the start of the round (fire is simultaneous)
+	std::fill(owner_firepower.begin(), owner_firepower.end(), 0.0);
+	std::fill(owner_ships.begin(), owner_ships.end(), 0.0);
+	for (size_t g = 0; g < n_groups; ++g)
+	{
+		owner_firepower[group_owner_slot[g]] += group_ships[g] * group_attack[g];
+		owner_ships[group_owner_slot[g]] += group_ships[g];
+	}
+
+	double total_ships = 0.0;
+	for (size_t o = 0; o < n_owners; ++o)
+	{
+		total_ships += owner_ships[o];
+		owner_side_ships[o] = 0.0;
+		for (size_t a = 0; a < n_owners; ++a)
+		{
+			if (same_side(a, o))
+				{ owner_side_ships[o] += owner_ships[a]; }
+		}
+	}
+
+	// Each owner spreads its firepower evenly over every enemy ship, so the damage
+	// one ship of owner o receives is sum over enemies a of F[a] / (ships not on a's side)
+	for (size_t o = 0; o < n_owners; ++o)
+	{
+		double pressure = 0.0;
+		for (size_t a = 0; a < n_owners; ++a)
+		{
+			double targets = total_ships - owner_side_ships[a];
+			if (!same_side(a, o) && targets > 0.0)
+				{ pressure += owner_firepower[a] / targets; }
+		}
+		owner_pressure[o] = pressure;
+	}
+
+	// Expected losses per group (flat loops over contiguous arrays)
+	const uint32_t* slot = group_owner_slot.data();
+	const double* ships = group_ships.data();
+	const double* inv_defense = group_inv_defense.data();
+	double* incoming = group_incoming.data();
+	double* losses = group_losses.data();
+
+	for (size_t g = 0; g < n_groups; ++g)
+		{ incoming[g] = owner_pressure[slot[g]]; }
+	for (size_t g = 0; g < n_groups; ++g)
+		{ losses[g] = ships[g] * incoming[g] * inv_defense[g]; }
+
+	// Stochastic rounding in group order keeps the stream's draws deterministic
+	for (size_t g = 0; g < n_groups; ++g)
+	{
+		double expected = std::min(group_losses[g], group_ships[g]);
+		double whole = std::floor(expected);
+		double fraction = expected - whole;
+		if (fraction > 0.0 && rng.nextDouble() < fraction)
+			{ whole += 1.0; }
+		group_ships[g] -= std::min(whole, group_ships[g]);
+	}
+
+	// Refresh owner ship totals for the survival check
+	std::fill(owner_ships.begin(), owner_ships.end(), 0.0);
+	for (size_t g = 0; g < n_groups; ++g)
+		{ owner_ships[group_owner_slot[g]] += group_ships[g]; }
+}
+
+void CombatEngine::distribute_losses(std::vector<CombatParticipant>& participants)
+{
+	// Survivors fill fleets in ascending fleet_id order, so the newest fleets lose ships first
+	for (size_t g = 0; g < group_ships.size(); ++g)
+	{
+		uint32_t remaining = static_cast<uint32_t>(group_ships[g]);
+		for (uint32_t pos = group_first[g]; pos < group_last[g]; ++pos)
+		{
+			CombatParticipant& p = participants[order[pos]];
+			uint32_t keep = std::min(p.ship_count, remaining);
+			remaining -= keep;
+			p.ship_count = keep;
+		}
+	}
+}
@@ -0,0 +1,628 @@
+#include "command_journal.h"
+#include "game.h"
+#include "game_snapshot.h"
+#include <algorithm>
+
+// ============================================================================
+// GameCommand Factories
+// ============================================================================
+
+GameCommand GameCommand::set_money_allocation(uint32_t player_id, const Player::MoneyAllocation& allocation)
+{
+	GameCommand command;
+	command.type = COMMAND_SET_MONEY_ALLOCATION;
+	command.player_id = player_id;
+	command.money = allocation;
+	return command;
+}
+
+GameCommand GameCommand::set_planet_allocation(uint32_t player_id, uint32_t planet_id, double mining_fraction, double terraforming_fraction)
+{
+	GameCommand command;
+	command.type = COMMAND_SET_PLANET_ALLOCATION;
+	command.player_id = player_id;
+	command.planet_id = planet_id;
+	command.mining_fraction = mining_fraction;
+	command.terraforming_fraction = terraforming_fraction;
+	return command;
+}
+
+GameCommand GameCommand::create_ship_design(uint32_t player_id, const std::string& name, ShipType type, int32_t tech_range,
+                                            int32_t tech_speed, int32_t tech_weapons, int32_t tech_shields, int32_t tech_mini)
+{
+	GameCommand command;
+	command.type = COMMAND_CREATE_SHIP_DESIGN;
+	command.player_id = player_id;
+	command.name = name;
+	command.ship_type = type;
+	command.tech_range = tech_range;
+	command.tech_speed = tech_speed;
+	command.tech_weapons = tech_weapons;
+	command.tech_shields = tech_shields;
+	command.tech_mini = tech_mini;
+	return command;
+}
+
+GameCommand GameCommand::delete_ship_design(uint32_t player_id, uint32_t design_id)
+{
+	GameCommand command;
+	command.type = COMMAND_DELETE_SHIP_DESIGN;
+	command.player_id = player_id;
+	command.design_id = design_id;
+	return command;
+}
+
+GameCommand GameCommand::build_fleet(uint32_t player_id, uint32_t design_id, uint32_t ship_count, uint32_t planet_id)
+{
+	GameCommand command;
+	command.type = COMMAND_BUILD_FLEET;
+	command.player_id = player_id;
+	command.design_id = design_id;
+	command.value = ship_count;
+	command.planet_id = planet_id;
+	return command;
+}
+
+GameCommand GameCommand::delete_fleet(uint32_t player_id, uint32_t fleet_id)
+{
+	GameCommand command;
+	command.type = COMMAND_DELETE_FLEET;
+	command.player_id = player_id;
+	command.fleet_id = fleet_id;
+	return command;
+}
+
+GameCommand GameCommand::move_fleet(uint32_t player_id, uint32_t fleet_id, uint32_t destination_planet_id)
+{
+	GameCommand command;
+	command.type = COMMAND_MOVE_FLEET;
+	command.player_id = player_id;
+	command.fleet_id = fleet_id;
+	command.planet_id = destination_planet_id;
+	return command;
+}
+
+GameCommand GameCommand::refuel_fleet(uint32_t player_id, uint32_t fleet_id)
+{
+	GameCommand command;
+	command.type = COMMAND_REFUEL_FLEET;
+	command.player_id = player_id;
+	command.fleet_id = fleet_id;
+	return command;
+}
+
+GameCommand GameCommand::set_alliance(uint32_t player_id, uint32_t alliance_id)
+{
+	GameCommand command;
+	command.type = COMMAND_SET_ALLIANCE;
+	command.player_id = player_id;
+	command.value = alliance_id;
+	return command;
+}
+
+GameCommand GameCommand::set_ai_seed(uint64_t seed)
+{
+	GameCommand command;
+	command.type = COMMAND_SET_AI_SEED;
+	command.seed = seed;
+	return command;
+}
+
+GameCommand GameCommand::set_deterministic_seed(uint64_t seed)
+{
+	GameCommand command;
+	command.type = COMMAND_SET_DETERMINISTIC_SEED;
+	command.seed = seed;
+	return command;
+}
+
+// ============================================================================
+// Command Records
+// ============================================================================
+
+namespace SaveRecords
+{
+	void write_command(ByteWriter& w, const GameCommand& c)
+	{
+		w.put_u8(c.type);
+		w.put_varuint(c.player_id);
+		switch (c.type)
+		{
+			case COMMAND_SET_MONEY_ALLOCATION:
+				w.put_f64(c.money.savings_fraction);
+				w.put_f64(c.money.research_fraction);
+				w.put_f64(c.money.planets_fraction);
+				w.put_f64(c.money.research.research_range_fraction);
+				w.put_f64(c.money.research.research_speed_fraction);
+				w.put_f64(c.money.research.research_weapons_fraction);
+				w.put_f64(c.money.research.research_shields_fraction);
+				w.put_f64(c.money.research.research_mini_fraction);
+				w.put_f64(c.money.research.research_radical_fraction);
+				break;
+			case COMMAND_SET_PLANET_ALLOCATION:
+				w.put_varuint(c.planet_id);
+				w.put_f64(c.mining_fraction);
+				w.put_f64(c.terraforming_fraction);
+				break;
+			case COMMAND_CREATE_SHIP_DESIGN:
+				w.put_varuint(c.name.size());
+				w.put_bytes(c.name.data(), c.name.size());
+				w.put_u8(static_cast<uint8_t>(c.ship_type));
+				w.put_varint(c.tech_range);
+				w.put_varint(c.tech_speed);
+				w.put_varint(c.tech_weapons);
+				w.put_varint(c.tech_shields);
+				w.put_varint(c.tech_mini);
+				break;
+			case COMMAND_DELETE_SHIP_DESIGN:
+				w.put_varuint(c.design_id);
+				break;
+			case COMMAND_BUILD_FLEET:
+				w.put_varuint(c.design_id);
+				w.put_varuint(c.value);
+				w.put_varuint(c.planet_id);
+				break;
+			case COMMAND_DELETE_FLEET:
+			case COMMAND_REFUEL_FLEET:
+				w.put_varuint(c.fleet_id);
+				break;
+			case COMMAND_MOVE_FLEET:
+				w.put_varuint(c.fleet_id);
+				w.put_varuint(c.planet_id);
+				break;
+			case COMMAND_SET_ALLIANCE:
+				w.put_varuint(c.value);
+				break;
+			case COMMAND_SET_AI_SEED:
+			case COMMAND_SET_DETERMINISTIC_SEED:
+				w.put_u64(c.seed);
+				break;
+			default:
+				break;
+		}
+	}
+
+	bool read_command(ByteReader& r, GameCommand& c)
+	{
+		c = GameCommand();
+		uint8_t type = r.get_u8();
+		if (type == COMMAND_NONE || type >= COMMAND_TYPE_COUNT)
+			{ return false; }
+		c.type = static_cast<CommandType>(type);
+		c.player_id = r.get_varuint32();
+		switch (c.type)
+		{
+			case COMMAND_SET_MONEY_ALLOCATION:
+				c.money.savings_fraction = r.get_f64();
+				c.money.research_fraction = r.get_f64();
+				c.money.planets_fraction = r.get_f64();
+				c.money.research.research_range_fraction = r.get_f64();
+				c.money.research.research_speed_fraction = r.get_f64();
+				c.money.research.research_weapons_fraction = r.get_f64();
+				c.money.research.research_shields_fraction = r.get_f64();
+				c.money.research.research_mini_fraction = r.get_f64();
+				c.money.research.research_radical_fraction = r.get_f64();
+				break;
+			case COMMAND_SET_PLANET_ALLOCATION:
+				c.planet_id = r.get_varuint32();
+				c.mining_fraction = r.get_f64();
+				c.terraforming_fraction = r.get_f64();
+				break;
+			case COMMAND_CREATE_SHIP_DESIGN:
+			{
+				uint32_t length = r.get_count();
+				const uint8_t* name = r.get_bytes(length);
+				if (name)
+					{ c.name.assign(reinterpret_cast<const char*>(name), length); }
+				uint8_t ship_type = r.get_u8();
+				if (ship_type > SHIP_BIOLOGICAL)
+					{ return false; }
+				c.ship_type = static_cast<ShipType>(ship_type);
+				c.tech_range = r.get_varint32();
+				c.tech_speed = r.get_varint32();
+				c.tech_weapons = r.get_varint32();
+				c.tech_shields = r.get_varint32();
+				c.tech_mini = r.get_varint32();
+				break;
+			}
+			case COMMAND_DELETE_SHIP_DESIGN:
+				c.design_id = r.get_varuint32();
+				break;
+			case COMMAND_BUILD_FLEET:
+				c.design_id = r.get_varuint32();
+				c.value = r.get_varuint32();
+				c.planet_id = r.get_varuint32();
+				break;
+			case COMMAND_DELETE_FLEET:
+			case COMMAND_REFUEL_FLEET:
+				c.fleet_id = r.get_varuint32();
+				break;
+			case COMMAND_MOVE_FLEET:
+				c.fleet_id = r.get_varuint32();
+				c.planet_id = r.get_varuint32();
+				break;
+			case COMMAND_SET_ALLIANCE:
+				c.value = r.get_varuint32();
+				break;
+			case COMMAND_SET_AI_SEED:
+			case COMMAND_SET_DETERMINISTIC_SEED:
+				c.seed = r.get_u64();
+				break;
+			default:
+				break;
+		}
+		return r.ok();
+	}
+}
+
+using namespace SaveRecords;
+
+// ============================================================================
+// GameState Command Execution
+// ============================================================================
+
+ErrorCode GameState::execute_command(const GameCommand& command, uint32_t* out_id)
+{
+	ErrorCode result = ErrorCode::SUCCESS;
+	uint32_t created_id = 0;
+	Player* player = get_player(command.player_id);
+
+	switch (command.type)
+	{
+		case COMMAND_SET_MONEY_ALLOCATION:
+			result = check_player_set_spending_allocation(command.player_id, command.money.savings_fraction,
+			                                              command.money.research_fraction, command.money.planets_fraction);
+			if (result == ErrorCode::SUCCESS)
+				{ player->allocation = command.money; }
+			break;
+
+		case COMMAND_SET_PLANET_ALLOCATION:
+			result = check_player_set_planet_allocation(command.player_id, command.planet_id,
+			                                            command.mining_fraction, command.terraforming_fraction);
+			if (result != ErrorCode::SUCCESS)
+				{ break; }
+			for (ColonizedPlanet& colony : player->colonized_planets)
+			{
+				if (colony.get_id() == command.planet_id)
+					{ colony.set_budget_split(command.mining_fraction, command.terraforming_fraction); }
+			}
+			break;
+
+		case COMMAND_CREATE_SHIP_DESIGN:
+			result = check_player_design_ship(command.player_id, command.name, command.ship_type, command.tech_range,
+			                                  command.tech_speed, command.tech_weapons, command.tech_shields, command.tech_mini);
+			if (result == ErrorCode::SUCCESS)
+			{
+				created_id = player->create_ship_design(command.name, command.ship_type, command.tech_range,
+				                                        command.tech_speed, command.tech_weapons, command.tech_shields, command.tech_mini);
+			}
+			break;
+
+		case COMMAND_DELETE_SHIP_DESIGN:
+			if (!player)
+				{ result = ErrorCode::INVALID_PLAYER_ID; }
+			else if (!player->delete_ship_design(command.design_id))
+				{ result = ErrorCode::SHIP_DESIGN_NOT_FOUND; }
+			break;
+
+		case COMMAND_BUILD_FLEET:
+			result = check_player_build_fleet(command.player_id, command.design_id, command.value, command.planet_id);
+			if (result != ErrorCode::SUCCESS)
+				{ break; }
+			created_id = player->create_fleet(command.design_id, command.value, command.planet_id);
+			if (created_id == 0)
+				{ result = ErrorCode::VALIDATION_FAILED; }
+			break;
+
+		case COMMAND_DELETE_FLEET:
+			if (!player)
+				{ result = ErrorCode::INVALID_PLAYER_ID; }
+			else if (!player->delete_fleet(command.fleet_id))
+				{ result = ErrorCode::FLEET_NOT_FOUND; }
+			break;
+
+		case COMMAND_MOVE_FLEET:
+			result = check_player_move_fleet(command.player_id, command.fleet_id, command.planet_id);
+			if (result == ErrorCode::SUCCESS)
+				{ player->move_fleet(command.fleet_id, command.planet_id); }
+			break;
+
+		case COMMAND_REFUEL_FLEET:
+			if (!player)
+				{ result = ErrorCode::INVALID_PLAYER_ID; }
+			else if (Fleet* fleet = player->get_fleet(command.fleet_id))
+				{ fleet->refuel(); }
+			else
+				{ result = ErrorCode::FLEET_NOT_FOUND; }
+			break;
+
+		case COMMAND_SET_ALLIANCE:
+		{
+			auto it = player_id_to_index.find(command.player_id);
+			if (it == player_id_to_index.end())
+				{ result = ErrorCode::INVALID_PLAYER_ID; }
+			else
+				{ player_alliances[it->second] = command.value; }
+			break;
+		}
+
+		case COMMAND_SET_AI_SEED:
+			rng->setAISeed(command.seed);
+			break;
+
+		case COMMAND_SET_DETERMINISTIC_SEED:
+			rng->setDeterministicSeed(command.seed);
+			break;
+
+		default:
+			result = ErrorCode::INVALID_PARAMETER;
+			break;
+	}
+
+	if (result != ErrorCode::SUCCESS)
+		{ return result; }
+
+	if (out_id)
+		{ *out_id = created_id; }
+	if (command_journal)
+		{ command_journal->record_command(command); }
+	return ErrorCode::SUCCESS;
+}
+
+// Public setters are shorthands for their commands, so nothing bypasses the journal
+
+ErrorCode GameState::set_money_allocation(uint32_t player_id, const Player::MoneyAllocation& alloc)
+{
+	return execute_command(GameCommand::set_money_allocation(player_id, alloc));
+}
+
+ErrorCode GameState::delete_fleet(uint32_t player_id, uint32_t fleet_id)
+{
+	return execute_command(GameCommand::delete_fleet(player_id, fleet_id));
+}
+
+ErrorCode GameState::move_fleet(uint32_t player_id, uint32_t fleet_id, uint32_t destination_planet_id)
+{
+	return execute_command(GameCommand::move_fleet(player_id, fleet_id, destination_planet_id));
+}
+
+ErrorCode GameState::refuel_fleet(uint32_t player_id, uint32_t fleet_id)
+{
+	return execute_command(GameCommand::refuel_fleet(player_id, fleet_id));
+}
+
+ErrorCode GameState::set_player_alliance(uint32_t player_id, uint32_t alliance_id)
+{
+	return execute_command(GameCommand::set_alliance(player_id, alliance_id));
+}
+
+ErrorCode GameState::set_det_seed(uint64_t seed)
+{
+	return execute_command(GameCommand::set_deterministic_seed(seed));
+}
+
+ErrorCode GameState::set_ai_seed(uint64_t seed)
+{
+	return execute_command(GameCommand::set_ai_seed(seed));
+}
+
+// ============================================================================
+// CommandJournal Implementation
+// ============================================================================
+
+CommandJournal::CommandJournal(uint32_t keyframe_interval)
+	: keyframe_interval(std::max<uint32_t>(keyframe_interval, 1))
+{
+}
+
+void CommandJournal::start(GameState& game)
+{
+	clear();
+	ByteWriter w(data);
+	w.put_u32(JournalFormat::MAGIC);
+	w.put_u16(JournalFormat::VERSION);
+	w.put_u16(0);
+	append_keyframe(game);
+	game.set_command_journal(this);
+}
+
+void CommandJournal::record_command(const GameCommand& command)
+{
+	ByteWriter w(data);
+	w.put_u8(JournalFormat::RECORD_COMMAND);
+	write_command(w, command);
+	command_count++;
+}
+
+void CommandJournal::record_turn(const GameState& game, uint32_t turn)
+{
+	ByteWriter w(data);
+	w.put_u8(JournalFormat::RECORD_TURN);
+	w.put_u32(turn);
+	complete_size = data.size();
+	end_turn = turn + 1;
+
+	if (!keyframes.empty() && end_turn - keyframes.back().turn >= keyframe_interval)
+		{ append_keyframe(game); }
+}
+
+void CommandJournal::append_keyframe(const GameState& game)
+{
+	GameSnapshot snapshot;
+	game.capture_snapshot(snapshot);
+
+	ByteWriter w(data);
+	w.put_u8(JournalFormat::RECORD_KEYFRAME);
+	w.put_u32(snapshot.current_turn);
+	w.put_u32(0);
+	size_t payload_start = data.size();
+	encode_game_snapshot(snapshot, data);
+
+	size_t length = data.size() - payload_start;
+	for (size_t i = 0; i < 4; ++i)
+		{ data[payload_start - 4 + i] = static_cast<uint8_t>(length >> (8 * i)); }
+
+	keyframes.push_back(Keyframe{ snapshot.current_turn, payload_start, length });
+	complete_size = data.size();
+	end_turn = snapshot.current_turn;
+}
+
+void CommandJournal::clear()
+{
+	data.clear();
+	keyframes.clear();
+	command_count = 0;
+	complete_size = 0;
+	end_turn = 0;
+}
+
+bool CommandJournal::read(const uint8_t* bytes, size_t size)
+{
+	ByteReader r(bytes, size);
+	if (r.get_u32() != JournalFormat::MAGIC || r.get_u16() != JournalFormat::VERSION)
+		{ return false; }
+	(void)r.get_u16();
+
+	// Records are checked for framing and turn order; keyframes are decoded when seeked to
+	std::vector<Keyframe> read_keyframes;
+	size_t read_commands = 0;
+	size_t read_complete_size = 0;
+	uint32_t turn = 0;
+	GameCommand command;
+	while (r.ok() && !r.at_end())
+	{
+		uint8_t kind = r.get_u8();
+		if (kind == JournalFormat::RECORD_KEYFRAME)
+		{
+			uint32_t keyframe_turn = r.get_u32();
+			uint32_t length = r.get_u32();
+			size_t offset = size - r.remaining();
+			if (!r.get_bytes(length) || (!read_keyframes.empty() && keyframe_turn != turn))
+				{ return false; }
+			read_keyframes.push_back(Keyframe{ keyframe_turn, offset, length });
+			turn = keyframe_turn;
+		}
+		else if (kind == JournalFormat::RECORD_COMMAND && !read_keyframes.empty())
+		{
+			if (!read_command(r, command))
+				{ return false; }
+			read_commands++;
+			continue;
+		}
+		else if (kind == JournalFormat::RECORD_TURN && !read_keyframes.empty())
+		{
+			if (r.get_u32() != turn)
+				{ return false; }
+			turn++;
+		}
+		else
+			{ return false; }
+
+		read_complete_size = size - r.remaining();
+	}
+	if (!r.ok() || read_keyframes.empty())
+		{ return false; }
+
+	data.assign(bytes, bytes + size);
+	keyframes = std::move(read_keyframes);
+	command_count = read_commands;
+	complete_size = read_complete_size;
+	end_turn = turn;
+	return true;
+}
+
+// ============================================================================
+// ReplayEngine Implementation
+// ============================================================================
+
+ReplayEngine::ReplayEngine(const CommandJournal& journal, GameState& game)
+	: journal(journal), game(game)
+{
+	game.set_command_journal(nullptr);
+}
+
+uint32_t ReplayEngine::get_turn() const
+{
+	return game.get_current_turn();
+}
+
+bool ReplayEngine::seek(uint32_t turn)
+{
+	if (journal.empty() || turn < journal.get_first_turn() || turn > journal.get_end_turn())
+		{ return false; }
+
+	// Nearest keyframe at or before the turn
+	const std::vector<CommandJournal::Keyframe>& keyframes = journal.get_keyframes();
+	auto next = std::upper_bound(keyframes.begin(), keyframes.end(), turn,
+	                             [](uint32_t t, const CommandJournal::Keyframe& keyframe) { return t < keyframe.turn; });
+	const CommandJournal::Keyframe& keyframe = *(next - 1);
+
+	// Playing on is cheaper than restoring when the game is already between that keyframe and the turn
+	bool play_on = positioned && get_turn() >= keyframe.turn && get_turn() <= turn;
+	if (!play_on)
+	{
+		GameSnapshot snapshot;
+		positioned = decode_game_snapshot(journal.get_data().data() + keyframe.offset, keyframe.size, snapshot)
+		          && game.restore_snapshot(snapshot);
+		if (!positioned)
+			{ return false; }
+		cursor = keyframe.offset + keyframe.size;
+	}
+
+	while (get_turn() < turn)
+	{
+		if (!step())
+			{ return false; }
+	}
+	return true;
+}
+
+bool ReplayEngine::step()
+{
+	// Commands after the last TURN record belong to a turn that was never processed
+	const size_t end = journal.get_complete_size();
+	if (!positioned || cursor >= end)
+		{ return false; }
+
+	const std::vector<uint8_t>& data = journal.get_data();
+	ByteReader r(data.data() + cursor, end - cursor);
+	GameCommand command;
+	bool processed = false;
+	while (r.ok() && !r.at_end())
+	{
+		// A keyframe follows the turn it was taken after
+		if (processed && data[end - r.remaining()] != JournalFormat::RECORD_KEYFRAME)
+			{ break; }
+
+		uint8_t kind = r.get_u8();
+		if (kind == JournalFormat::RECORD_COMMAND)
+		{
+			if (!read_command(r, command) || game.execute_command(command) != ErrorCode::SUCCESS)
+				{ break; }
+		}
+		else if (kind == JournalFormat::RECORD_TURN)
+		{
+			if (r.get_u32() != get_turn())
+				{ break; }
+			game.process_turn();
+			processed = true;
+		}
+		else if (kind == JournalFormat::RECORD_KEYFRAME)
+		{
+			uint32_t keyframe_turn = r.get_u32();
+			uint32_t length = r.get_u32();
+			const uint8_t* saved = r.get_bytes(length);
+			if (check_keyframes && (!saved || keyframe_turn != get_turn()
+			    || game.serialize_state() != std::vector<uint8_t>(saved, saved + length)))
+				{ processed = false; }
+			break;
+		}
+		else
+			{ break; }
+	}
+
+	cursor = end - r.remaining();
+	if (!processed || !r.ok())
+		{ positioned = false; }
+	return positioned;
+}
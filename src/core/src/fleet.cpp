@@ -2,8 +2,8 @@
 #include "ship_design.h"
 #include "planet.h"
 #include "knowledge_galaxy.h"
+#include "game_formulas.h"
 #include <cmath>
-#include <memory>
 
 // ============================================================================
 // Fleet Constructor
@@ -16,13 +16,8 @@ Fleet::Fleet(uint32_t fleet_id, PlayerID player_id, const ShipDesign* design,
 	  ship_design(design),
 	  ship_count(ship_count),
 	  fuel(design ? design->get_range() : 0),
-	  in_transit(false),
 	  current_planet(planet),
-	  origin_planet(planet),
-	  destination_planet(nullptr),
-	  distance_to_destination(0),
-	  turns_to_destination(0),
-	  transit(nullptr)
+	  transit(std::nullopt)
 {
 	if(ship_design && ship_design->type == SHIP_BIOLOGICAL)
 	{
@@ -51,6 +46,21 @@ void Fleet::partial_refuel(int32_t amount)
 	}
 }
 
+bool Fleet::uses_fuel() const
+{
+	return ship_design && ship_design->type != SHIP_BIOLOGICAL;
+}
+
+int32_t Fleet::get_available_fuel() const
+{
+	return uses_fuel() ? fuel : INT32_MAX;
+}
+
+bool Fleet::can_reach(double distance) const
+{
+	return GameFormulas::calculate_fuel_cost(distance) <= get_available_fuel();
+}
+
 void Fleet::move_to(Planet* destination, KnowledgeGalaxy* knowledge_galaxy, uint32_t current_turn)
 {
 	// Validate inputs
@@ -68,19 +78,17 @@ void Fleet::move_to(Planet* destination, KnowledgeGalaxy* knowledge_galaxy, uint
 	// Get distance from knowledge galaxy's distance matrix
 	double distance = knowledge_galaxy->get_distance(origin_id, dest_id);
 	
+	// Fleets cannot leave with less fuel than the hop requires
+	if (!can_reach(distance))
+		{ return; }
+	
 	// Calculate turns to destination based on fleet's range (speed)
-	uint32_t turns = 0;
-	if (ship_design && ship_design->get_range() > 0)
-	{
-		turns = static_cast<uint32_t>(std::ceil(distance / ship_design->get_range()));
-	}
-	if (turns == 0)
-		{ turns = 1; }  // At least 1 turn to travel
+	uint32_t turns = GameFormulas::calculate_travel_turns(distance, ship_design ? ship_design->get_range() : 0);
 	
 	uint32_t arrival_turn = current_turn + turns;
 	
-	// Create FleetTransit to hold transit state
-	transit = std::make_unique<FleetTransit>(
+	// Record transit state inline (no allocation)
+	transit.emplace(
 		origin_id,
 		dest_id,
 		current_turn,
@@ -88,24 +96,14 @@ void Fleet::move_to(Planet* destination, KnowledgeGalaxy* knowledge_galaxy, uint
 		distance,
 		turns );
 	
-	// Update fleet state
-	in_transit = true;
-	origin_planet = current_planet;
-	destination_planet = destination;
-	distance_to_destination = distance;
-	turns_to_destination = turns;
+	// Burn fuel for the hop
+	if (uses_fuel())
+		{ fuel -= GameFormulas::calculate_fuel_cost(distance); }
 	
 	// Move fleet to space planet (both real and knowledge)
 	Planet* space_planet = knowledge_galaxy->get_space_real_planet();
 	if (space_planet)
 	{
 		current_planet = space_planet;
-		
-		// Add fleet to space knowledge planet's fleet list
-		KnowledgePlanet* space_knowledge = knowledge_galaxy->get_space_knowledge_planet();
-		if (space_knowledge)
-		{
-			space_knowledge->add_my_fleet(this);
-		}
 	}
 }
@@ -0,0 +1,126 @@
+#include "fleet_occupancy.h"
+#include <algorithm>
+
+// ============================================================================
+// FleetOccupancyIndex Implementation
+// ============================================================================
+
+namespace
+{
+	// Ordering used to keep each planet's handles grouped by owner
+	bool owner_less(const FleetHandle& handle, PlayerID owner) { return handle.owner < owner; }
+	bool less_owner(PlayerID owner, const FleetHandle& handle) { return owner < handle.owner; }
+
+	const std::vector<FleetHandle> empty_fleet_list;
+}
+
+void FleetOccupancyIndex::reset(uint32_t max_planet_id)
+{
+	slots.clear();
+	slots.resize(static_cast<size_t>(max_planet_id) + 1);
+	contested_planets.clear();
+	fleet_count = 0;
+}
+
+void FleetOccupancyIndex::add_fleet(uint32_t planet_id, PlayerID owner, uint32_t fleet_id)
+{
+	if (planet_id >= slots.size())
+		{ return; }
+
+	PlanetSlot& slot = slots[planet_id];
+
+	// Insert after the last handle of the same owner so the group stays contiguous
+	auto group_begin = std::lower_bound(slot.fleets.begin(), slot.fleets.end(), owner, owner_less);
+	auto group_end = std::upper_bound(group_begin, slot.fleets.end(), owner, less_owner);
+	bool new_owner = (group_begin == group_end);
+
+	slot.fleets.insert(group_end, FleetHandle{ owner, fleet_id });
+	++fleet_count;
+
+	if (new_owner)
+	{
+		slot.owner_count++;
+		if (slot.owner_count == 2)
+			{ mark_contested(planet_id); }
+	}
+}
+
+bool FleetOccupancyIndex::remove_fleet(uint32_t planet_id, PlayerID owner, uint32_t fleet_id)
+{
+	if (planet_id >= slots.size())
+		{ return false; }
+
+	PlanetSlot& slot = slots[planet_id];
+
+	auto group_begin = std::lower_bound(slot.fleets.begin(), slot.fleets.end(), owner, owner_less);
+	auto group_end = std::upper_bound(group_begin, slot.fleets.end(), owner, less_owner);
+	auto it = std::find_if(group_begin, group_end,
+		[fleet_id](const FleetHandle& handle) { return handle.fleet_id == fleet_id; });
+
+	if (it == group_end)
+		{ return false; }
+
+	bool last_of_owner = (group_end - group_begin == 1);
+	slot.fleets.erase(it);
+	--fleet_count;
+
+	if (last_of_owner)
+	{
+		slot.owner_count--;
+		if (slot.owner_count == 1)
+			{ unmark_contested(planet_id); }
+	}
+	return true;
+}
+
+const std::vector<FleetHandle>& FleetOccupancyIndex::get_fleets_at(uint32_t planet_id) const
+{
+	if (planet_id >= slots.size())
+		{ return empty_fleet_list; }
+	return slots[planet_id].fleets;
+}
+
+FleetHandleRange FleetOccupancyIndex::get_owner_fleets_at(uint32_t planet_id, PlayerID owner) const
+{
+	if (planet_id >= slots.size())
+		{ return FleetHandleRange{ nullptr, nullptr }; }
+
+	const std::vector<FleetHandle>& fleets = slots[planet_id].fleets;
+	auto group_begin = std::lower_bound(fleets.begin(), fleets.end(), owner, owner_less);
+	auto group_end = std::upper_bound(group_begin, fleets.end(), owner, less_owner);
+
+	const FleetHandle* base = fleets.data();
+	return FleetHandleRange{ base + (group_begin - fleets.begin()), base + (group_end - fleets.begin()) };
+}
+
+uint32_t FleetOccupancyIndex::get_owner_count_at(uint32_t planet_id) const
+{
+	if (planet_id >= slots.size())
+		{ return 0; }
+	return slots[planet_id].owner_count;
+}
+
+void FleetOccupancyIndex::mark_contested(uint32_t planet_id)
+{
+	PlanetSlot& slot = slots[planet_id];
+	if (slot.contested_position != NOT_CONTESTED)
+		{ return; }
+
+	slot.contested_position = static_cast<uint32_t>(contested_planets.size());
+	contested_planets.push_back(planet_id);
+}
+
+void FleetOccupancyIndex::unmark_contested(uint32_t planet_id)
+{
+	PlanetSlot& slot = slots[planet_id];
+	if (slot.contested_position == NOT_CONTESTED)
+		{ return; }
+
+	// Swap-remove to keep the contested list dense
+	uint32_t position = slot.contested_position;
+	uint32_t moved_planet = contested_planets.back();
+	contested_planets[position] = moved_planet;
+	slots[moved_planet].contested_position = position;
+	contested_planets.pop_back();
+	slot.contested_position = NOT_CONTESTED;
+}
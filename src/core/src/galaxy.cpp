@@ -1,5 +1,5 @@
 #include "galaxy.h"
-#include "game.h"
+#include "rng.h"
 #include "text_assets.h"
 #include "utility.h"
 #include "game_constants.h"
@@ -9,39 +9,39 @@
 #include <set>
 #include <limits>
 
-Galaxy::Galaxy(const GalaxyGenerationParams& params, GameState* game_state)
+Galaxy::Galaxy(const GalaxyGenerationParams& params, DeterministicRNG& rng, const TextAssets& text_assets)
 {
 	// Staged galaxy generation:
 	// Phase 1: Generate all planet coordinates
-	std::vector<PlanetCoord> all_coords = generate_planet_coordinates(params, game_state);
+	std::vector<PlanetCoord> all_coords = generate_planet_coordinates(params, rng);
 	
 	// Phase 2: Select home planet coordinates based on galaxy shape
 	std::vector<PlanetCoord> home_coords;
 	if (params.shape == GALAXY_CLUSTER)
 	{
 		// For cluster galaxies, angular offset is stored in params
-		home_coords = select_home_planets_cluster(all_coords, params, game_state);
+		home_coords = select_home_planets_cluster(all_coords, params, rng);
 	}
 	else if (params.shape == GALAXY_SPIRAL)
 	{
 		// For spiral galaxies, we need the spiral parameters
 		// We'll need to pass them through - for now, use a workaround
 		// TODO: Refactor to pass spiral parameters through params struct
-		home_coords = select_home_planets_random(all_coords, params.n_players, game_state);
+		home_coords = select_home_planets_random(all_coords, params.n_players, rng);
 	}
 	else
 	{
-		home_coords = select_home_planets_random(all_coords, params.n_players, game_state);
+		home_coords = select_home_planets_random(all_coords, params.n_players, rng);
 	}
 	
 	// Phase 3: Generate planet names
-	const std::vector<std::string> planet_names = generate_planet_names(all_coords.size(), game_state);
+	const std::vector<std::string> planet_names = generate_planet_names(all_coords.size(), rng, text_assets);
 	
 	// Phase 4: Generate planet parameters
-	generate_planet_parameters(all_coords, home_coords, planet_names, game_state);
+	generate_planet_parameters(all_coords, home_coords, planet_names, rng);
 	
-	// Phase 5: Compute distance matrix
-	compute_distance_matrix();
+	// Phases 5-7: Distance matrix, identity table and neighbour graph
+	build_derived_data();
 	
 	// Calculate galaxy size from coordinates
 	if (!all_coords.empty())
@@ -60,13 +60,32 @@ Galaxy::Galaxy(const GalaxyGenerationParams& params, GameState* game_state)
 	}
 }
 
+Galaxy::Galaxy(std::vector<Planet> saved_planets, GalaxyCoord size, std::vector<size_t> home_indices)
+	: gal_size(size),
+	  planets(std::move(saved_planets)),
+	  home_planet_indices(std::move(home_indices))
+{
+	build_derived_data();
+}
+
+void Galaxy::build_derived_data()
+{
+	// Phase 5: Compute distance matrix
+	compute_distance_matrix();
+	
+	// Phase 6: Build the shared identity table (planets never move or get renamed)
+	planet_identities.build(planets);
+	
+	// Phase 7: Sort each planet's neighbours by distance once for all players
+	neighbour_graph.build(*this);
+}
+
 std::vector<std::string> Galaxy::generate_planet_names(
 	uint32_t n_planets,
-	GameState* game_state)
+	DeterministicRNG& rng,
+	const TextAssets& text_assets)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
-	return generate_randomized_subset(game_state->text_assets->get_planet_name_list(), n_planets, rng);
+	return generate_randomized_subset(text_assets.get_planet_name_list(), n_planets, rng);
 }
 
 // ============================================================================
@@ -74,23 +93,23 @@ std::vector<std::string> Galaxy::generate_planet_names(
 // ============================================================================
 std::vector<PlanetCoord> Galaxy::generate_planet_coordinates(
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
 	// Dispatch to shape-specific coordinate generation
 	switch (params.shape)
 	{
 		case GALAXY_RANDOM:
-			return Galaxy::generate_coordinates_random(params, game_state);
+			return Galaxy::generate_coordinates_random(params, rng);
 		case GALAXY_SPIRAL:
-			return Galaxy::generate_coordinates_spiral(params, game_state);
+			return Galaxy::generate_coordinates_spiral(params, rng);
 		case GALAXY_CIRCLE:
-			return Galaxy::generate_coordinates_circle(params, game_state);
+			return Galaxy::generate_coordinates_circle(params, rng);
 		case GALAXY_RING:
-			return Galaxy::generate_coordinates_ring(params, game_state);
+			return Galaxy::generate_coordinates_ring(params, rng);
 		case GALAXY_CLUSTER:
-			return Galaxy::generate_coordinates_cluster(params, game_state);
+			return Galaxy::generate_coordinates_cluster(params, rng);
 		case GALAXY_GRID:
-			return Galaxy::generate_coordinates_grid(params, game_state);
+			return Galaxy::generate_coordinates_grid(params, rng);
 		default:
 			return std::vector<PlanetCoord>();
 	}
@@ -99,10 +118,8 @@ std::vector<PlanetCoord> Galaxy::generate_planet_coordinates(
 std::vector<PlanetCoord> Galaxy::select_home_planets_random(
 	const std::vector<PlanetCoord>& all_coords,
 	uint32_t n_home_planets,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	// Validate that we have enough coordinates for home planets
 	if (all_coords.size() < n_home_planets)
 	{
@@ -129,10 +146,8 @@ void Galaxy::generate_planet_parameters(
 	const std::vector<PlanetCoord>& all_coords,
 	const std::vector<PlanetCoord>& home_coords,
 	const std::vector<std::string>& planet_names,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	// Create a set of home coordinates for quick lookup
 	std::set<PlanetCoord> home_coord_set(home_coords.begin(), home_coords.end());
 	
@@ -180,9 +195,8 @@ void Galaxy::generate_planet_parameters(
 // ============================================================================
 std::vector<PlanetCoord> Galaxy::generate_coordinates_random(
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
 	std::vector<PlanetCoord> coords;
 	
 	// Calculate galaxy size using density-aware formula with reduction factor
@@ -240,10 +254,8 @@ std::vector<PlanetCoord> Galaxy::generate_coordinates_random(
 
 std::vector<PlanetCoord> Galaxy::generate_coordinates_spiral(
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	// Phase 1: Choose randomized parameters
 	double delta_theta = M_PI / 4.0 + rng.nextDouble() * (M_PI - M_PI / 4.0);
 	double a = 100.0 / std::sqrt(delta_theta);
@@ -339,10 +351,8 @@ std::vector<PlanetCoord> Galaxy::generate_coordinates_spiral(
 
 std::vector<PlanetCoord> Galaxy::generate_coordinates_circle(
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	// Calculate active area (same formula as random galaxy, but without the 0.85 reduction factor)
 	// active_area = gal_size^2 where gal_size = sqrt(n_planets) * (5.0 + 6.4/density)
 	double gal_size = std::sqrt(double(params.n_planets)) * 
@@ -359,10 +369,8 @@ std::vector<PlanetCoord> Galaxy::generate_coordinates_circle(
 
 std::vector<PlanetCoord> Galaxy::generate_coordinates_ring(
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	// Calculate active area (same formula as random galaxy, but without the 0.85 reduction factor)
 	double gal_size = std::sqrt(double(params.n_planets)) * 
 	                  (GameConstants::Galaxy_Size_Scale_Base + GameConstants::Galaxy_Size_Scale_Density / params.density);
@@ -389,9 +397,8 @@ std::vector<PlanetCoord> Galaxy::generate_coordinates_ring(
 
 std::vector<PlanetCoord> Galaxy::generate_coordinates_cluster(
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
 	std::vector<PlanetCoord> coords;
 	
 	// Phase 0: Generate random angular offset for cluster orientation
@@ -471,7 +478,7 @@ std::vector<PlanetCoord> Galaxy::generate_coordinates_cluster(
 
 std::vector<PlanetCoord> Galaxy::generate_coordinates_grid(
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& /* rng: a grid has no random layout */)
 {
 	std::vector<PlanetCoord> coords;
 	
@@ -503,12 +510,11 @@ std::vector<PlanetCoord> Galaxy::generate_coordinates_grid(
 void Galaxy::initialize_planets_random(
 	const GalaxyGenerationParams& params,
 	const std::vector<std::string>& planet_names_unused,
-	GameState* game_state)
+	DeterministicRNG& rng,
+	const TextAssets& text_assets)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	// Generate randomized planet names
-	const std::vector<std::string> planet_names = generate_planet_names(params.n_planets, game_state);
+	const std::vector<std::string> planet_names = generate_planet_names(params.n_planets, rng, text_assets);
 	
 	// Calculate galaxy size using density-aware formula with reduction factor
 	// Formula: gal_size = sqrt(n_planets) * (base + density_factor / density) * (1 - reduction_factor)
@@ -594,10 +600,8 @@ void Galaxy::initialize_planets_random(
 void Galaxy::initialize_planets_grid(
 	const GalaxyGenerationParams& params,
 	const std::vector<std::string>& planet_names,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	double planet_spacing = 4.0 + 2.0/(params.density);  // this is probably fine...
 	
 	uint32_t cols_num = static_cast<uint32_t>(std::ceil(std::sqrt(double(params.n_planets))));
@@ -659,7 +663,8 @@ void Galaxy::compute_distance_matrix()
 
 double Galaxy::get_distance(uint32_t from_id, uint32_t to_id) const
 {
-	return distance_matrix.at(from_id).at(to_id);
+	// Planet IDs are assigned sequentially from 1, so the matrix index is id - 1
+	return distance_matrix.at(from_id - 1).at(to_id - 1);
 }
 
 // ============================================================================
@@ -739,10 +744,8 @@ std::vector<PlanetCoord> Galaxy::select_home_planets_spiral(
 	uint32_t n_home_planets,
 	double a,
 	double delta_theta,
-	GameState* game_state)
+	DeterministicRNG& /* rng: homes sit at the arm ends */)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	// Validate that we have enough coordinates for home planets
 	if (all_coords.size() < n_home_planets)
 	{
@@ -785,254 +788,11 @@ std::vector<PlanetCoord> Galaxy::select_home_planets_spiral(
 	return home_coords;
 }
 
-// ============================================================================
-// Overloaded coordinate generation methods that take RNG directly
-// These are wrappers for the Python bindings to avoid needing GameState
-// ============================================================================
-
-std::vector<PlanetCoord> Galaxy::generate_coordinates_random(
-	const GalaxyGenerationParams& params,
-	DeterministicRNG& rng)
-{
-	std::vector<PlanetCoord> coords;
-	
-	// Calculate galaxy size using density-aware formula with reduction factor
-	GalaxyCoord gal_size = std::sqrt(double(params.n_planets)) * 
-	           (GameConstants::Galaxy_Size_Scale_Base + GameConstants::Galaxy_Size_Scale_Density / params.density) *
-	           (1.0 - GameConstants::Galaxy_Size_Reduction_Factor);
-	
-	// Initialize spatial grid for distance checking
-	CheckDistanceSpatialGrid grid(GameConstants::min_planet_distance, gal_size * 2.0);
-	
-	// Galaxy is centered at (0, 0)
-	GalaxyCoord half_size = gal_size / 2.0;
-	GalaxyCoord min_x = -half_size;
-	GalaxyCoord max_x = half_size;
-	GalaxyCoord min_y = -half_size;
-	GalaxyCoord max_y = half_size;
-	
-	uint32_t attempts_per_expansion = static_cast<uint32_t>(std::floor(std::sqrt(double(params.n_planets)) / 2.0));
-	uint32_t max_attempts_per_planet = params.n_planets;
-	
-	for (uint32_t i = 0; i < params.n_planets; ++i)
-	{
-		uint32_t attempt = 0;
-		bool placed = false;
-		
-		while (attempt < max_attempts_per_planet && !placed)
-		{
-			// Check if we need to expand the galaxy boundaries
-			if (attempt > 0 && attempt % attempts_per_expansion == 0)
-			{
-				// Expand boundaries by 5% around center (0, 0)
-				GalaxyCoord expansion_factor = 1.0 + GameConstants::Galaxy_Expansion_Factor;
-				min_x *= expansion_factor;
-				max_x *= expansion_factor;
-				min_y *= expansion_factor;
-				max_y *= expansion_factor;
-			}
-			// Generate random position within current galaxy bounds
-			GalaxyCoord x_coord = min_x + rng.nextDouble() * (max_x - min_x);
-			GalaxyCoord y_coord = min_y + rng.nextDouble() * (max_y - min_y);
-			
-			// Check if position is valid (far enough from other planets)
-			if (grid.is_position_valid(x_coord, y_coord, GameConstants::min_planet_distance))
-			{
-				coords.push_back({x_coord, y_coord});
-				grid.add_planet(x_coord, y_coord, i + 1);
-				placed = true;
-			}
-			attempt++;
-		}
-	}
-	
-	return coords;
-}
-
-std::vector<PlanetCoord> Galaxy::generate_coordinates_spiral(
-	const GalaxyGenerationParams& params,
-	DeterministicRNG& rng)
-{
-	// Phase 1: Choose randomized parameters
-	double delta_theta = M_PI / 4.0 + rng.nextDouble() * (M_PI - M_PI / 4.0);
-	double a = 100.0 / std::sqrt(delta_theta);
-	double ratio = 2.0 + rng.nextDouble() * (6.0 - 2.0);
-	
-	// Phase 2: Calculate overall size
-	double gal_size = std::sqrt(double(params.n_planets)) * 
-	                  (GameConstants::Galaxy_Size_Scale_Base + GameConstants::Galaxy_Size_Scale_Density / params.density);
-	double active_area = gal_size * gal_size;
-	double core_radius = std::sqrt(active_area / M_PI);
-	
-	// Refine core_radius iteratively
-	for (int iter = 0; iter < 10; ++iter) {
-		double overlap = std::max(6.0, 0.15 * core_radius);
-		double theta_core = (core_radius / a) * (core_radius / a);
-		double theta_outer = delta_theta;
-		double arc_length = fermat_spiral_arc_length(a, theta_core, theta_outer);
-		double core_planets = (core_radius / GameConstants::min_planet_distance) * 
-		                      (core_radius / GameConstants::min_planet_distance);
-		double planets_per_arm = arc_length / GameConstants::min_planet_distance;
-		double total_planets = core_planets + (params.n_players * planets_per_arm);
-		
-		if (total_planets < params.n_planets * 0.95) {
-			core_radius *= 1.05;
-		} else if (total_planets > params.n_planets * 1.05) {
-			core_radius *= 0.95;
-		} else {
-			break;
-		}
-	}
-	
-	// Calculate final dimensions
-	double overlap = std::max(6.0, 0.15 * core_radius);
-	double inner_arm_radius = core_radius - overlap;
-	double outer_arm_radius = core_radius * ratio;
-	double theta_core = (core_radius / a) * (core_radius / a);
-	double theta_outer = delta_theta;
-	
-	// Phase 3: Generate spiral arms
-	std::vector<PlanetCoord> all_coords;
-	double arm_angle_step = 2.0 * M_PI / params.n_players;
-	
-	for (uint32_t arm_idx = 0; arm_idx < params.n_players; ++arm_idx) {
-		double arm_angle = arm_idx * arm_angle_step;
-		std::vector<PlanetCoord> arm_candidates;
-		double angular_step = 0.1;
-		
-		for (double theta = theta_core; theta <= theta_outer; theta += angular_step) {
-			PlanetCoord center = fermat_spiral_point(a, theta, arm_angle);
-			double band_thickness = 4.0;
-			for (double offset = -band_thickness / 2.0; offset <= band_thickness / 2.0; offset += 1.0) {
-				double angle_perp = arm_angle + theta + M_PI / 2.0;
-				PlanetCoord offset_point = {
-					center.first + offset * std::cos(angle_perp),
-					center.second + offset * std::sin(angle_perp)
-				};
-				arm_candidates.push_back(offset_point);
-			}
-		}
-		
-		for (const auto& candidate : arm_candidates) {
-			bool valid = true;
-			for (const auto& existing : all_coords) {
-				double dx = candidate.first - existing.first;
-				double dy = candidate.second - existing.second;
-				double dist = std::sqrt(dx * dx + dy * dy);
-				if (dist < GameConstants::min_planet_distance) {
-					valid = false;
-					break;
-				}
-			}
-			if (valid) {
-				all_coords.push_back(candidate);
-			}
-		}
-	}
-	
-	// Phase 4: Generate central core
-	double seed_radius = inner_arm_radius - GameConstants::min_planet_distance;
-	if (seed_radius > 0) {
-		CircleRegion core_region(core_radius);
-		std::vector<PlanetCoord> core_coords = poisson_disk_sampling(
-			core_region,
-			GameConstants::min_planet_distance,
-			params.n_planets,
-			rng,
-			all_coords);
-		all_coords.insert(all_coords.end(), core_coords.begin(), core_coords.end());
-	}
-	
-	return all_coords;
-}
-
-std::vector<PlanetCoord> Galaxy::generate_coordinates_circle(
-	const GalaxyGenerationParams& params,
-	DeterministicRNG& rng)
-{
-	// Calculate galaxy radius based on planet count, density, and Poisson disk packing
-	// Poisson disk sampling with min_distance d has packing efficiency ~0.65-0.7
-	// Each point occupies approximately π * d² area
-	// density parameter: 1.0 = tight packing, lower values = more spread out
-	double min_distance = GameConstants::min_planet_distance;
-	// Poisson disk sampling fills the region with min_distance spacing
-	// Factor of 1.5 empirically accounts for packing efficiency
-	// Note: density parameter doesn't apply to Poisson disk sampling (it always fills completely)
-	double base_area_per_planet = 1.5 * min_distance * min_distance;
-	double total_area = params.n_planets * base_area_per_planet;
-	double base_radius = std::sqrt(total_area / M_PI);
-	
-	// Use Poisson disk sampling to generate evenly distributed coordinates
-	CircleRegion region(base_radius);
-	std::vector<PlanetCoord> coords = poisson_disk_sampling(region, min_distance, params.n_planets, rng);
-	
-	return coords;
-}
-
-std::vector<PlanetCoord> Galaxy::generate_coordinates_ring(
-	const GalaxyGenerationParams& params,
-	DeterministicRNG& rng)
-{
-	// Calculate galaxy radius based on planet count, density, and Poisson disk packing
-	// Poisson disk sampling with min_distance d has packing efficiency ~0.65-0.7
-	// Each point occupies approximately π * d² area
-	// density parameter: 1.0 = tight packing, lower values = more spread out
-	double min_distance = GameConstants::min_planet_distance;
-	// Poisson disk sampling fills the region with min_distance spacing
-	// Factor of 1.5 empirically accounts for packing efficiency
-	// Note: density parameter doesn't apply to Poisson disk sampling (it always fills completely)
-	double base_area_per_planet = 1.5 * min_distance * min_distance;
-	double total_area = params.n_planets * base_area_per_planet;
-	double base_radius = std::sqrt(total_area / M_PI);
-	
-	// Use Poisson disk sampling to generate evenly distributed coordinates in a ring
-	// Ring area = π(R_outer² - R_inner²). With R_inner = 0.6*R_outer, ring area = 0.64*π*R_outer²
-	// To achieve target area, scale up: R_outer = base_radius / sqrt(0.64) = base_radius * 1.25
-	double outer_radius = base_radius * 1.25;
-	double inner_radius = outer_radius * 0.6;
-	RingRegion region(inner_radius, outer_radius);
-	std::vector<PlanetCoord> coords = poisson_disk_sampling(region, min_distance, params.n_planets, rng);
-	
-	return coords;
-}
-
-std::vector<PlanetCoord> Galaxy::generate_coordinates_grid(
-	const GalaxyGenerationParams& params,
-	DeterministicRNG& rng)
-{
-	(void)rng;  // Not used for grid generation
-	
-	std::vector<PlanetCoord> coords;
-	
-	// Calculate grid dimensions
-	uint32_t grid_size = static_cast<uint32_t>(std::ceil(std::sqrt(double(params.n_planets))));
-	double spacing = GameConstants::min_planet_distance * 1.5;  // Slightly more than minimum
-	
-	// Center the grid at (0, 0)
-	double offset_x = -(grid_size - 1) * spacing / 2.0;
-	double offset_y = -(grid_size - 1) * spacing / 2.0;
-	
-	// Generate grid coordinates
-	for (uint32_t i = 0; i < params.n_planets; ++i)
-	{
-		uint32_t row = i / grid_size;
-		uint32_t col = i % grid_size;
-		
-		double x = offset_x + col * spacing;
-		double y = offset_y + row * spacing;
-		
-		coords.push_back({x, y});
-	}
-	
-	return coords;
-}
-
 std::vector<PlanetCoord> Galaxy::select_home_planets_cluster(
 	const std::vector<PlanetCoord>& all_coords,
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
 	uint32_t n_home_planets = params.n_players;
 	double angular_offset = params.cluster_angular_offset;
 	
@@ -1097,81 +857,3 @@ std::vector<PlanetCoord> Galaxy::select_home_planets_cluster(
 	
 	return home_coords;
 }
-
-
-// ============================================================================
-// RNG Overload Implementations (for Python wrapper and standalone use)
-// ============================================================================
-
-std::vector<PlanetCoord> Galaxy::generate_coordinates_cluster(
-	const GalaxyGenerationParams& params,
-	DeterministicRNG& rng)
-{
-	std::vector<PlanetCoord> coords;
-	
-	// Phase 0: Generate random angular offset for cluster orientation
-	const_cast<GalaxyGenerationParams&>(params).cluster_angular_offset = rng.nextDouble() * 360.0;
-	
-	// Phase 1: Calculate cluster parameters
-	uint32_t n_clusters = params.n_players;
-	if (n_clusters < 1) n_clusters = 1;
-	
-	// Calculate overall galaxy size
-	double gal_size = std::sqrt(double(params.n_planets)) * 
-	                  (GameConstants::Galaxy_Size_Scale_Base + GameConstants::Galaxy_Size_Scale_Density / params.density);
-	
-	// Calculate cluster radius and ring radius based on density
-	double cluster_radius = gal_size / (2.0 * std::sqrt(double(n_clusters)));
-	double spacing_factor = 1.1 + (1.0 - params.density) * 0.9;
-	double desired_spacing = 2.0 * cluster_radius * spacing_factor;
-	double ring_radius = desired_spacing * n_clusters / (2.0 * M_PI);
-	
-	// Planets per cluster (roughly equal distribution)
-	uint32_t planets_per_cluster = params.n_planets / n_clusters;
-	uint32_t remaining_planets = params.n_planets % n_clusters;
-	
-	// Phase 2: Generate clusters
-	CheckDistanceSpatialGrid grid(GameConstants::min_planet_distance, gal_size * 2.0);
-	
-	for (uint32_t cluster_idx = 0; cluster_idx < n_clusters; ++cluster_idx)
-	{
-		// Calculate cluster center position on ring
-		double angle = (2.0 * M_PI * cluster_idx) / n_clusters;
-		double cluster_center_x = ring_radius * std::cos(angle);
-		double cluster_center_y = ring_radius * std::sin(angle);
-		
-		// Determine how many planets in this cluster
-		uint32_t planets_in_this_cluster = planets_per_cluster;
-		if (cluster_idx < remaining_planets)
-		{
-			planets_in_this_cluster++;
-		}
-		
-		// Phase 3: Generate planets within this cluster
-		uint32_t planets_placed = 0;
-		uint32_t max_attempts = planets_in_this_cluster * 10;
-		uint32_t attempts = 0;
-		
-		while (planets_placed < planets_in_this_cluster && attempts < max_attempts)
-		{
-			// Generate random position within cluster circle
-			double angle_offset = rng.nextDouble() * 2.0 * M_PI;
-			double radius_offset = rng.nextDouble() * cluster_radius;
-			
-			double x_coord = cluster_center_x + radius_offset * std::cos(angle_offset);
-			double y_coord = cluster_center_y + radius_offset * std::sin(angle_offset);
-			
-			// Check if position is valid
-			if (grid.is_position_valid(x_coord, y_coord, GameConstants::min_planet_distance))
-			{
-				coords.push_back({x_coord, y_coord});
-				grid.add_planet(x_coord, y_coord, static_cast<uint32_t>(coords.size()));
-				planets_placed++;
-			}
-			attempts++;
-		}
-	}
-	
-	return coords;
-}
-
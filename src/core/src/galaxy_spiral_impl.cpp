@@ -3,10 +3,8 @@
 
 std::vector<PlanetCoord> Galaxy::generate_coordinates_spiral(
 	const GalaxyGenerationParams& params,
-	GameState* game_state)
+	DeterministicRNG& rng)
 {
-	DeterministicRNG& rng = game_state->get_rng();
-	
 	// Phase 1: Choose randomized parameters
 	// Angular span: randomly select from [pi/4, pi]
 	double delta_theta = M_PI / 4.0 + rng.nextDouble() * (M_PI - M_PI / 4.0);
@@ -3,6 +3,8 @@
 #include "game_constants.h"
 #include "game_formulas.h"
 #include "text_assets.h"
+#include "command_journal.h"
+#include "autosave.h"
 #include <algorithm>
 #include <cmath>
 #include <cstring>
@@ -20,10 +22,14 @@ GameState::GameState(const class GameSetup& setup)
 {
 	// Setup data has been copied and stored as members in initializer list
 	
-	// Initialize RNG with random seeds from std::random_device
-	// This ensures each game has different random behavior
-	std::random_device rd;
-	uint64_t det_seed = rd();
+	// Seed the RNGs from the galaxy seed, so the same setup always creates the same game
+	// A zero seed asks for a random one, which is stored so the game can still be recreated
+	if (galaxy_params.seed == 0)
+	{
+		std::random_device rd;
+		galaxy_params.seed = (static_cast<uint64_t>(rd()) << 32 | rd()) | 1;  // Never zero
+	}
+	uint64_t det_seed = galaxy_params.seed;
 	uint64_t ai_seed = det_seed + 1;  // Use seed + 1 for AI RNG
 	rng = std::make_unique<DeterministicRNG>(det_seed, ai_seed);
 	
@@ -38,16 +44,31 @@ GameState::GameState(const class GameSetup& setup)
 	// This also assigns planets to players internally
 	galaxy = initialize_galaxy(galaxy_params);
 	
+	// Build entity ID maps for quick lookup (requires galaxy to be assigned)
+	build_entity_maps();
+	
 	// Initialize KnowledgeGalaxy for each player
 	initialize_player_knowledge();
 	
 	// Initialize research cost caches
 	initialize_research_cost_caches();
 	
+	// Size the public history store (one set of columns per player, in player index order)
+	std::vector<uint32_t> player_ids;
+	for (const Player& player : players)
+		{ player_ids.push_back(player.id); }
+	player_history.reset(player_ids);
+	
 	// Initialize the first turn
 	start_first_turn();
 }
 
+GameState::GameState()
+{
+	text_assets = std::make_unique<TextAssets>();
+	text_assets->load_assets("TextAssets");
+}
+
 // ============================================================================
 // GameState Destructor
 // ============================================================================
@@ -160,15 +181,6 @@ const Planet* GameState::get_planet(const std::string& planet_name) const
 // ============================================================================
 // Money Allocation
 // ============================================================================
-void GameState::set_money_allocation(uint32_t player_id, const Player::MoneyAllocation& money_alloc)
-{
-	Player* player = get_player(player_id);
-	if (!player) 
-		{ throw std::runtime_error("Player not found"); }
-	
-	player->allocation = money_alloc;
-}
-
 const Player::MoneyAllocation& GameState::get_money_allocation(uint32_t player_id) const
 {
 	const Player* player = get_player(player_id);
@@ -185,6 +197,7 @@ void GameState::start_first_turn()
 {
 	// Initialize the first turn with initial game state
 	// This is called during game initialization before any process_turn() calls
+	process_visibility();
 	capture_and_distribute_player_public_info();
 }
 
@@ -200,7 +213,9 @@ void GameState::process_turn()
 	// 6. Process terraforming
 	// 7. Process mining
 	// 8. Process ships
-	// 9. Process novae
+	// 9. Resolve combat at contested planets
+	// 10. Update player knowledge of planets and fleets within sensor range
+	// 11. Process novae
 	
 	capture_and_distribute_player_public_info();
 	
@@ -211,28 +226,17 @@ void GameState::process_turn()
 	process_research();
 	process_planets();
 	process_ships();
+	process_combat();
+	process_visibility();
 	process_novae();
 	
 	increment_turn();
 	increment_year();
-}
-
-// ============================================================================
-// Serialization
-// ============================================================================
-std::vector<uint8_t> GameState::serialize_state() const
-{
-	// Placeholder for serialization
-	// This will be implemented in serialization.cpp
-	std::vector<uint8_t> buffer;
-	return buffer;
-}
-
-bool GameState::deserialize_state(const std::vector<uint8_t>& data)
-{
-	// Placeholder for deserialization
-	// This will be implemented in serialization.cpp
-	return true;
+	
+	if (command_journal)
+		{ command_journal->record_turn(*this, current_turn - 1); }
+	if (autosave)
+		{ autosave->on_turn_processed(*this); }
 }
 
 // ============================================================================
@@ -417,7 +421,7 @@ std::unique_ptr<Galaxy> GameState::initialize_galaxy(const GalaxyGenerationParam
 	// Failures are caught immediately during coordinate generation
 	
 	std::vector<Planet*> home_planets;
-	std::unique_ptr<Galaxy> new_galaxy = std::make_unique<Galaxy>(params, this);
+	std::unique_ptr<Galaxy> new_galaxy = generate_galaxy(params);
 	
 	// Convert home planet indices to Planet* pointers for assignment
 	for (size_t index : new_galaxy->home_planet_indices)
@@ -435,12 +439,25 @@ std::unique_ptr<Galaxy> GameState::initialize_galaxy(const GalaxyGenerationParam
 	// Assign home planets to players
 	assign_planets_random(home_planets);
 	
-	// Build entity ID maps for quick lookup
-	build_entity_maps();
-	
 	return new_galaxy;
 }
 
+std::unique_ptr<Galaxy> GameState::generate_galaxy(const GalaxyGenerationParams& params) const
+{
+	// Generation draws from its own RNG: its stream depends on the seed alone (not on
+	// what players have drawn), and is kept apart from the game RNG the same seed starts
+	const uint64_t generation_seed = params.seed ^ 0x9E3779B97F4A7C15ULL;
+	DeterministicRNG generation_rng(generation_seed, generation_seed);
+	return std::make_unique<Galaxy>(params, generation_rng, *text_assets);
+}
+
+std::vector<Planet> GameState::generate_map(const GalaxyGenerationParams& params) const
+{
+	// Generation records layout choices (cluster angular offset) in its params
+	GalaxyGenerationParams generation_params = params;
+	return std::move(generate_galaxy(generation_params)->planets);
+}
+
 void GameState::build_entity_maps()
 {
 	// Build planet ID to index map and planet name to index map
@@ -457,16 +474,16 @@ void GameState::build_entity_maps()
 		player_name_to_index[players[i].name] = i;
 	}
 	
-	// Build per-player fleet mapping
-	for (size_t player_idx = 0; player_idx < players.size(); ++player_idx)
-	{
-		const auto& player = players[player_idx];
-		const auto& fleets = player.get_fleets();
-		for (size_t fleet_idx = 0; fleet_idx < fleets.size(); ++fleet_idx)
-		{
-			player_fleets[player.id].push_back(fleet_idx);
-		}
-	}
+	// Size the fleet occupancy index for all planet IDs
+	uint32_t max_planet_id = 0;
+	for (const Planet& planet : galaxy->planets)
+		{ max_planet_id = std::max(max_planet_id, planet.id); }
+	fleet_occupancy.reset(max_planet_id);
+	
+	// Planets never move, so the sensor spatial index is built once
+	visibility.build(*galaxy);
+	visible_planets.assign(players.size(), PlanetBitset(max_planet_id + 1));
+	player_alliances.assign(players.size(), NO_ALLIANCE);
 }
 
 void GameState::calculate_player_incomes()
@@ -573,17 +590,11 @@ void GameState::process_ships()
 		for (auto& fleet : player.fleets)
 		{
 			// Check if fleet is in transit and has arrived
-			if (fleet.transit && fleet.transit->arrival_turn <= current_turn)
+			if (fleet.is_in_transit() && fleet.transit->arrival_turn <= current_turn)
 			{
 				// Fleet has arrived at destination
 				uint32_t dest_id = fleet.transit->destination_planet_id;
-				Planet* destination = nullptr;
-				
-				// Find the destination planet
-				if (dest_id < galaxy->planets.size())
-				{
-					destination = &galaxy->planets[dest_id];
-				}
+				Planet* destination = get_planet(dest_id);
 				
 				if (destination)
 				{
@@ -593,18 +604,177 @@ void GameState::process_ships()
 					// Clear transit info
 					fleet.transit.reset();
 					
-					// Update old transit fields for compatibility
-					fleet.in_transit = false;
-					fleet.origin_planet = destination;
-					fleet.destination_planet = nullptr;
-					fleet.distance_to_destination = 0;
-					fleet.turns_to_destination = 0;
+					// Fleets refuel when they arrive at one of their owner's planets
+					if (destination->owner == static_cast<PlayerID>(player.id))
+						{ fleet.refuel(); }
+					
+					// Fleet is now stationed at the destination
+					fleet_occupancy.add_fleet(dest_id, player.id, fleet.id);
 				}
 			}
 		}
 	}
 }
 
+void GameState::process_combat()
+{
+	// Copy the contested list: destroyed fleets are removed from the occupancy index
+	// (and may uncontest planets) while we iterate.  Each engagement draws from its
+	// own stream keyed by planet, so its outcome does not depend on this order.
+	// The index counts owners, so planets held only by allies are skipped below.
+	std::vector<uint32_t> contested = fleet_occupancy.get_contested_planets();
+	std::sort(contested.begin(), contested.end());
+	
+	std::vector<CombatParticipant> participants;
+	for (uint32_t planet_id : contested)
+	{
+		// Gather every fleet stationed at the planet
+		participants.clear();
+		for (const FleetHandle& handle : fleet_occupancy.get_fleets_at(planet_id))
+		{
+			const Fleet* fleet = get_fleet(handle.owner, handle.fleet_id);
+			if (!fleet || !fleet->ship_design)
+				{ continue; }
+			participants.push_back(CombatParticipant{
+				handle.owner,
+				handle.fleet_id,
+				fleet->ship_design->get_weapons(),
+				fleet->ship_design->get_shields(),
+				fleet->ship_count,
+				get_player_alliance(handle.owner) });
+		}
+		
+		// Allied owners share a planet in peace
+		bool hostile = false;
+		for (size_t k = 1; k < participants.size() && !hostile; ++k)
+		{
+			hostile = participants[k].owner != participants[0].owner
+				&& !are_allied(participants[k].owner, participants[0].owner);
+		}
+		if (!hostile)
+			{ continue; }
+		
+		RNGStream combat_rng = rng->stream(current_turn, RNG_PHASE_COMBAT, planet_id);
+		combat_engine.resolve(participants, combat_rng);
+		
+		// Apply casualties; fleets with no survivors are removed
+		for (const CombatParticipant& participant : participants)
+		{
+			Player* player = get_player(participant.owner);
+			if (!player)
+				{ continue; }
+			
+			if (participant.ship_count == 0)
+			{
+				(void)player->delete_fleet(participant.fleet_id);
+			}
+			else
+			{
+				Fleet* fleet = player->get_fleet(participant.fleet_id);
+				if (fleet)
+					{ player->set_fleet_ship_count(*fleet, participant.ship_count); }
+			}
+		}
+	}
+}
+
+void GameState::process_visibility()
+{
+	for (size_t i = 0; i < players.size(); ++i)
+	{
+		Player& player = players[i];
+		KnowledgeGalaxy* knowledge = player.knowledge_galaxy;
+		if (!knowledge)
+			{ continue; }
+		
+		knowledge->begin_turn(current_turn);
+		
+		const uint32_t alliance = player_alliances[i];
+		PlanetBitset& visible = visible_planets[i];
+		visibility.compute_visible_planets(player, visible);
+		
+		// Enemy fleet sightings only last for the turn they are made
+		knowledge->clear_enemy_fleets();
+		
+		// Batched observation of every visible planet (ascending ID keeps the fleet table sorted)
+		visible.for_each_set([&](uint32_t planet_id)
+		{
+			const Planet* planet = get_planet(planet_id);
+			if (!planet)
+				{ return; }
+			
+			knowledge->observe_planet(planet_id, *planet, &player, current_year);
+			
+			// Enemy fleets at the planet (not the player's own or its allies'), from the
+			// occupancy index kept by movement and combat
+			for (const FleetHandle& handle : fleet_occupancy.get_fleets_at(planet_id))
+			{
+				if (handle.owner == static_cast<PlayerID>(player.id)
+					|| (alliance != NO_ALLIANCE && get_player_alliance(handle.owner) == alliance))
+					{ continue; }
+				const Fleet* fleet = get_fleet(handle.owner, handle.fleet_id);
+				if (fleet)
+					{ knowledge->add_visible_enemy_fleet(planet_id, FleetVisibleInfo{ fleet->id, fleet->owner, fleet->ship_count }); }
+			}
+		});
+	}
+	
+	share_alliance_knowledge();
+	
+	// Freeze this turn's knowledge (copies only the pages that changed) and drop
+	// snapshots that have fallen out of the retained history
+	for (Player& player : players)
+	{
+		if (!player.knowledge_galaxy)
+			{ continue; }
+		player.knowledge_galaxy->commit_snapshot(current_turn);
+		if (current_turn >= GameConstants::Knowledge_History_Turns)
+			{ player.knowledge_galaxy->discard_snapshots_before(current_turn - GameConstants::Knowledge_History_Turns + 1); }
+	}
+}
+
+void GameState::share_alliance_knowledge()
+{
+	// Every member adopts the newer observations of every other member
+	for (size_t i = 0; i < players.size(); ++i)
+	{
+		if (player_alliances[i] == NO_ALLIANCE || !players[i].knowledge_galaxy)
+			{ continue; }
+		
+		for (size_t j = 0; j < players.size(); ++j)
+		{
+			if (j == i || player_alliances[j] != player_alliances[i] || !players[j].knowledge_galaxy)
+				{ continue; }
+			players[i].knowledge_galaxy->merge_from(*players[j].knowledge_galaxy, &players[i]);
+		}
+	}
+}
+
+uint32_t GameState::get_player_alliance(uint32_t player_id) const
+{
+	auto it = player_id_to_index.find(player_id);
+	if (it == player_id_to_index.end())
+		{ return NO_ALLIANCE; }
+	return player_alliances[it->second];
+}
+
+bool GameState::are_allied(uint32_t player_a, uint32_t player_b) const
+{
+	if (player_a == player_b)
+		{ return false; }
+	uint32_t alliance = get_player_alliance(player_a);
+	return alliance != NO_ALLIANCE && alliance == get_player_alliance(player_b);
+}
+
+const PlanetBitset& GameState::get_visible_planets(uint32_t player_id) const
+{
+	static const PlanetBitset empty_set;
+	auto it = player_id_to_index.find(player_id);
+	if (it == player_id_to_index.end() || it->second >= visible_planets.size())
+		{ return empty_set; }
+	return visible_planets[it->second];
+}
+
 void GameState::process_novae()
 {
 	// TODO: Process nova events (rare event - low priority)
@@ -622,36 +792,63 @@ void GameState::process_novae()
 
 void GameState::capture_and_distribute_player_public_info()
 {
-	// Capture public information for all players at the current turn
-	for (const auto& player : players)
+	// Capture public information for all players at the current turn into the shared store;
+	// every player reads the same columns through Player::get_public_history()
+	if (!player_history.begin_turn(current_turn, current_year))
+	{
+		std::cerr << "ERROR: player history ends at turn " << player_history.get_last_turn()
+		          << ", cannot capture turn " << current_turn << std::endl;
+		return;
+	}
+	
+	for (size_t i = 0; i < players.size(); ++i)
 	{
-		PlayerPublicInfo info;
-		info.player_id = player.id;
-		info.year = current_year;
-		info.turn = current_turn;
+		const Player& player = players[i];
 		
 		// Technology levels (subset - no Radical)
-		info.tech_range = player.tech.range;
-		info.tech_speed = player.tech.speed;
-		info.tech_weapons = player.tech.weapons;
-		info.tech_shields = player.tech.shields;
-		info.tech_mini = player.tech.mini;
+		player_history.set(i, METRIC_TECH_RANGE, player.tech.range);
+		player_history.set(i, METRIC_TECH_SPEED, player.tech.speed);
+		player_history.set(i, METRIC_TECH_WEAPONS, player.tech.weapons);
+		player_history.set(i, METRIC_TECH_SHIELDS, player.tech.shields);
+		player_history.set(i, METRIC_TECH_MINI, player.tech.mini);
 		
 		// Resources
-		info.money_income = player.money_income;
-		info.money_savings = player.money_savings;
-		info.metal_savings = player.metal_reserve;
+		player_history.set(i, METRIC_MONEY_INCOME, player.money_income);
+		player_history.set(i, METRIC_MONEY_SAVINGS, player.money_savings);
+		player_history.set(i, METRIC_METAL_SAVINGS, player.metal_reserve);
 		
 		// Territory
-		info.planets_owned = static_cast<uint32_t>(player.colonized_planets.size());
+		player_history.set(i, METRIC_PLANETS_OWNED, static_cast<int64_t>(player.colonized_planets.size()));
 		
-		// Calculated metrics
-		info.ship_power = GameFormulas::calculate_player_fleet_power(player.id, this);
-		info.victory_points = GameFormulas::calculate_player_victory_points(player.id, this);
-		
-		// Store in history
-		player_info_history[player.id].push_back(info);
+		// Calculated metrics (maintained incrementally by Player)
+		player_history.set(i, METRIC_SHIP_POWER, player.get_fleet_power());
+		player_history.set(i, METRIC_VICTORY_POINTS, player.get_victory_points());
+	}
+	
+#ifdef OPENHO_VERIFY_METRICS
+	if (!verify_player_metrics())
+		{ std::cerr << "ERROR: incremental player metrics diverged from full recompute (turn " << current_turn << ")" << std::endl; }
+#endif
+}
+
+bool GameState::verify_player_metrics()
+{
+	bool consistent = true;
+	for (const Player& player : players)
+	{
+		if (player.get_fleet_power() != GameFormulas::calculate_player_fleet_power(player.id, this)
+		 || player.get_victory_points() != GameFormulas::calculate_player_victory_points(player.id, this))
+			{ consistent = false; }
 	}
+	return consistent;
+}
+
+bool GameState::get_player_public_info(uint32_t player_id, uint32_t turn, PlayerPublicInfo& out) const
+{
+	auto it = player_id_to_index.find(player_id);
+	if (it == player_id_to_index.end())
+		{ return false; }
+	return player_history.get_row(it->second, turn, out);
 }
 
 
@@ -728,6 +925,7 @@ void GameState::process_research_stream(Player& player, TechStream stream, int64
 	
 	// Ensure we have cached costs up to the player's current tech level
 	ensure_research_costs_available(*tech_level);
+	int32_t starting_level = *tech_level;
 	
 	// Check if we can advance the technology level
 	while (true)
@@ -784,6 +982,10 @@ void GameState::process_research_stream(Player& player, TechStream stream, int64
 			break;
 		}
 	}
+	
+	// Range advances widen the player's reachable set incrementally
+	if (stream == TECH_RANGE && *tech_level != starting_level)
+		{ player.on_range_advanced(*tech_level); }
 }
 
 
@@ -955,36 +1157,6 @@ const std::vector<Fleet>& GameState::get_player_fleets(uint32_t player_id) const
 	return player->fleets;
 }
 
-bool GameState::delete_fleet(uint32_t player_id, uint32_t fleet_id)
-{
-	Player* player = get_player(player_id);
-	if (!player)
-		{ return false; }
-	
-	// Delegate to Player
-	return player->delete_fleet(fleet_id);
-}
-
-void GameState::move_fleet(uint32_t player_id, uint32_t fleet_id, uint32_t destination_planet_id)
-{
-	// Delegate to Player to handle validation and initiate movement
-	Player* player = get_player(player_id);
-	if (!player)
-		return;  // Player not found
-	
-	// Player::move_fleet handles all validation and calls Fleet::move_to()
-	player->move_fleet(fleet_id, destination_planet_id);
-}
-
-void GameState::refuel_fleet(uint32_t player_id, uint32_t fleet_id)
-{
-	Fleet* fleet = get_fleet(player_id, fleet_id);
-	if (!fleet)
-		{ return; }
-	
-	fleet->refuel();
-}
-
 void GameState::assign_planets_random(const std::vector<Planet*>& suitable_planets)
 {
 	// Create a mutable copy of suitable_planets for shuffling
@@ -1049,6 +1221,7 @@ void GameState::assign_planets_random(const std::vector<Planet*>& suitable_plane
 		
 		// Add to player's colonized planets
 		player.colonized_planets.push_back(colonized_planet);
+		player.on_colony_gained(planet->id);
 		
 		
 		// Log assignment
@@ -1182,9 +1355,17 @@ ErrorCode GameState::check_player_move_fleet(uint32_t player_id, uint32_t fleet_
 		return ErrorCode::INVALID_PLANET_ID;
 	
 	// Check fleet is not already in transit
-	if (fleet->in_transit)
+	if (fleet->is_in_transit())
 		return ErrorCode::FLEET_IN_TRANSIT;
 	
+	// Check fleet has enough fuel for the hop
+	if (fleet->current_planet && fleet->current_planet->id != destination_planet_id)
+	{
+		double distance = galaxy->get_distance(fleet->current_planet->id, destination_planet_id);
+		if (!fleet->can_reach(distance))
+			return ErrorCode::DESTINATION_OUT_OF_RANGE;
+	}
+	
 	return ErrorCode::SUCCESS;
 }
 
@@ -1248,24 +1429,23 @@ void GameState::initialize_player_knowledge()
 			// This updates all observable fields in the KnowledgePlanet
 			player.knowledge_galaxy->observe_planet(homeworld->id, *homeworld, &player, current_year);
 			
-			// Get the KnowledgePlanet for the homeworld
+			// Record the homeworld in the knowledge colonization side table
 			if (homeworld)
 			{
-				KnowledgePlanet* homeworld_knowledge = player.knowledge_galaxy->get_planet(homeworld->id);
-				if (homeworld_knowledge)
-				{
-					// Create a ColonizedPlanet in the KnowledgePlanet
-					// This represents the player's knowledge of their own colonized homeworld
-					homeworld_knowledge->colonization = std::make_unique<ColonizedPlanet>(
-						homeworld,
-						&player,
-						homeworld_colonized.get_population(),
-						homeworld_colonized.get_income()
-					);
-				}
+				// This represents the player's knowledge of their own colonized homeworld
+				player.knowledge_galaxy->set_colonization(homeworld->id, ColonizedPlanet(
+					homeworld,
+					&player,
+					homeworld_colonized.get_population(),
+					homeworld_colonized.get_income()
+				));
 			}
 		}
 	}
 	
+	// Build refuel and reachability sets now that neighbour graphs exist
+	for (Player& player : players)
+		{ player.rebuild_reachability(); }
+	
 	std::cout << "Successfully initialized KnowledgeGalaxy for all " << players.size() << " players.\n";
 }
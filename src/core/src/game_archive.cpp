@@ -0,0 +1,408 @@
+#include "game_archive.h"
+#include "game_snapshot.h"
+#include "game.h"
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// Archive Writing
+// ============================================================================
+
+namespace
+{
+	size_t align_up(size_t offset)
+		{ return (offset + ArchiveFormat::ALIGNMENT - 1) & ~(ArchiveFormat::ALIGNMENT - 1); }
+
+	/// Collects tables, then lays them out behind the header and section table
+	class ArchiveBuilder
+	{
+	public:
+		template <typename T>
+		void add(uint32_t tag, const std::vector<T>& table)
+			{ tables.push_back(Table{ tag, table.data(), table.size() * sizeof(T) }); }
+
+		void add(uint32_t tag, const std::string& blob)
+			{ tables.push_back(Table{ tag, blob.data(), blob.size() }); }
+
+		void write(std::vector<uint8_t>& out) const
+		{
+			std::vector<ArchiveSection> sections(tables.size());
+			size_t offset = align_up(sizeof(ArchiveHeader) + sections.size() * sizeof(ArchiveSection));
+			for (size_t i = 0; i < tables.size(); ++i)
+			{
+				sections[i].tag = tables[i].tag;
+				sections[i].reserved = 0;
+				sections[i].offset = offset;
+				sections[i].size = tables[i].size;
+				offset = align_up(offset + tables[i].size);
+			}
+
+			ArchiveHeader header{};
+			header.magic = ArchiveFormat::MAGIC;
+			header.version = ArchiveFormat::VERSION;
+			header.flags = 0;
+			header.byte_order = ArchiveFormat::BYTE_ORDER_MARK;
+			header.section_count = static_cast<uint32_t>(sections.size());
+			header.file_size = offset;
+
+			out.assign(offset, 0);
+			std::memcpy(out.data(), &header, sizeof(header));
+			if (!sections.empty())
+				{ std::memcpy(out.data() + sizeof(header), sections.data(), sections.size() * sizeof(ArchiveSection)); }
+			for (size_t i = 0; i < tables.size(); ++i)
+			{
+				if (tables[i].size > 0)
+					{ std::memcpy(out.data() + sections[i].offset, tables[i].data, tables[i].size); }
+			}
+		}
+
+	private:
+		struct Table
+		{
+			uint32_t tag;
+			const void* data;
+			size_t size;
+		};
+		std::vector<Table> tables;
+	};
+
+	ArchiveString add_string(std::string& blob, const std::string& value)
+	{
+		ArchiveString reference{ static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(value.size()) };
+		blob += value;
+		return reference;
+	}
+
+	ArchiveRange range_from(size_t first, size_t end)
+		{ return ArchiveRange{ static_cast<uint32_t>(first), static_cast<uint32_t>(end - first) }; }
+}
+
+void write_game_archive(const GameSnapshot& s, std::vector<uint8_t>& out)
+{
+	std::string strings;
+
+	std::vector<ArchiveMeta> meta(1);
+	meta[0].current_turn = s.current_turn;
+	meta[0].current_year = s.current_year;
+	meta[0].next_fleet_id = s.next_fleet_id;
+	meta[0].n_planets = s.galaxy_params.n_planets;
+	meta[0].n_players = s.galaxy_params.n_players;
+	meta[0].shape = static_cast<uint32_t>(s.galaxy_params.shape);
+	meta[0].seed = s.galaxy_params.seed;
+	meta[0].density = s.galaxy_params.density;
+	meta[0].cluster_angular_offset = s.galaxy_params.cluster_angular_offset;
+	meta[0].galaxy_size = s.galaxy_size;
+
+	std::vector<uint32_t> homes(s.home_planet_indices.begin(), s.home_planet_indices.end());
+
+	std::vector<ArchivePlanet> planets;
+	planets.reserve(s.planets.size());
+	for (const Planet& planet : s.planets)
+	{
+		ArchivePlanet record{};
+		record.id = planet.id;
+		record.owner = planet.owner;
+		record.x = planet.x;
+		record.y = planet.y;
+		record.true_gravity = planet.true_gravity;
+		record.true_temperature = planet.true_temperature;
+		record.metal = planet.metal;
+		record.population = planet.population;
+		record.name = add_string(strings, planet.name);
+		record.nova_state = static_cast<uint32_t>(planet.nova_state);
+		planets.push_back(record);
+	}
+
+	std::vector<ArchivePlayer> players;
+	std::vector<ArchiveColony> colonies;
+	std::vector<ArchiveKnownPlanet> known_planets;
+	std::vector<uint64_t> visible_words;
+	players.reserve(s.players.size());
+	for (const PlayerRecord& p : s.players)
+	{
+		ArchivePlayer record{};
+		record.id = p.id;
+		record.alliance_id = p.alliance_id;
+		record.name = add_string(strings, p.name);
+		record.gender = static_cast<uint32_t>(p.gender);
+		record.type = static_cast<uint32_t>(p.type);
+		record.iq = p.iq;
+		record.starting_colony_quality = static_cast<uint32_t>(p.starting_colony_quality);
+		record.money_savings = p.money_savings;
+		record.metal_reserve = p.metal_reserve;
+		record.money_income = p.money_income;
+		record.metal_income = p.metal_income;
+		record.ideal_temperature = p.ideal_temperature;
+		record.ideal_gravity = p.ideal_gravity;
+		record.tech_range = p.tech.range;
+		record.tech_speed = p.tech.speed;
+		record.tech_weapons = p.tech.weapons;
+		record.tech_shields = p.tech.shields;
+		record.tech_mini = p.tech.mini;
+		record.tech_radical = p.tech.radical;
+
+		size_t first = colonies.size();
+		for (const ColonyRecord& colony : p.colonies)
+		{
+			ArchiveColony entry{};
+			entry.planet_id = colony.planet_id;
+			entry.population = colony.population;
+			entry.income = colony.income;
+			entry.desirability = colony.desirability;
+			entry.funding_fraction = colony.funding_fraction;
+			entry.mining_fraction = colony.mining_fraction;
+			entry.terraforming_fraction = colony.terraforming_fraction;
+			entry.apparent_gravity = colony.apparent_gravity;
+			entry.apparent_temperature = colony.apparent_temperature;
+			colonies.push_back(entry);
+		}
+		record.colonies = range_from(first, colonies.size());
+
+		first = known_planets.size();
+		for (const KnowledgePlanet& known : p.known_planets)
+		{
+			ArchiveKnownPlanet entry{};
+			entry.id = known.id;
+			entry.metal = known.metal;
+			entry.apparent_temperature = known.apparent_temperature;
+			entry.apparent_gravity = known.apparent_gravity;
+			entry.apparent_owner = known.apparent_owner;
+			entry.apparent_population = known.apparent_population;
+			entry.observation_year = known.observation_year;
+			entry.can_be_profitable = known.can_be_profitable;
+			entry.perceived_value = known.perceived_value;
+			entry.nova_state = static_cast<uint32_t>(known.nova_state);
+			known_planets.push_back(entry);
+		}
+		record.known_planets = range_from(first, known_planets.size());
+
+		first = visible_words.size();
+		visible_words.insert(visible_words.end(), p.visible_planet_words.begin(), p.visible_planet_words.end());
+		record.visible_words = range_from(first, visible_words.size());
+
+		record.fleet_count = static_cast<uint32_t>(p.fleets.size());
+		for (const FleetRecord& fleet : p.fleets)
+			{ record.ship_count += fleet.ship_count; }
+		players.push_back(record);
+	}
+
+	// History columns are copied as they are stored
+	const PlayerHistoryStore& history = s.history;
+	std::vector<ArchiveHistoryInfo> history_info(1);
+	history_info[0].player_count = static_cast<uint32_t>(history.get_player_count());
+	history_info[0].metric_count = METRIC_COUNT;
+	history_info[0].row_count = static_cast<uint32_t>(history.get_row_count());
+	history_info[0].first_turn = history.get_first_turn();
+	history_info[0].retained_turns = history.get_retained_turns();
+
+	std::vector<int64_t> history_columns;
+	history_columns.reserve(history.get_player_count() * METRIC_COUNT * history.get_row_count());
+	for (size_t player = 0; player < history.get_player_count(); ++player)
+	{
+		for (uint32_t metric = 0; metric < METRIC_COUNT; ++metric)
+		{
+			MetricSpan column = history.get_metric(player, static_cast<PlayerMetric>(metric));
+			history_columns.insert(history_columns.end(), column.begin(), column.end());
+		}
+	}
+
+	ArchiveBuilder builder;
+	builder.add(ArchiveFormat::SECTION_META, meta);
+	builder.add(ArchiveFormat::SECTION_STRINGS, strings);
+	builder.add(ArchiveFormat::SECTION_HOMES, homes);
+	builder.add(ArchiveFormat::SECTION_PLANETS, planets);
+	builder.add(ArchiveFormat::SECTION_PLAYERS, players);
+	builder.add(ArchiveFormat::SECTION_COLONIES, colonies);
+	builder.add(ArchiveFormat::SECTION_KNOWLEDGE, known_planets);
+	builder.add(ArchiveFormat::SECTION_VISIBILITY, visible_words);
+	builder.add(ArchiveFormat::SECTION_HISTORY, history_info);
+	builder.add(ArchiveFormat::SECTION_HISTORY_IDS, history.get_player_ids());
+	builder.add(ArchiveFormat::SECTION_HISTORY_YEARS, history.get_years());
+	builder.add(ArchiveFormat::SECTION_HISTORY_COLUMNS, history_columns);
+	builder.write(out);
+}
+
+bool save_game_archive(const GameState& game, const std::string& path)
+{
+	GameSnapshot snapshot;
+	game.capture_snapshot(snapshot);
+	std::vector<uint8_t> archive;
+	write_game_archive(snapshot, archive);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(archive.data()), static_cast<std::streamsize>(archive.size()));
+	return static_cast<bool>(file);
+}
+
+// ============================================================================
+// GameArchiveView Class
+// ============================================================================
+
+namespace
+{
+	/// Locate a table: 8-byte aligned, inside the archive, a whole number of records
+	template <typename T>
+	bool find_table(const uint8_t* data, size_t size, const ArchiveSection* sections, uint32_t section_count,
+	                uint32_t tag, ArchiveSpan<T>& table)
+	{
+		for (uint32_t i = 0; i < section_count; ++i)
+		{
+			const ArchiveSection& section = sections[i];
+			if (section.tag != tag)
+				{ continue; }
+			if (section.offset % ArchiveFormat::ALIGNMENT != 0 || section.offset > size
+			    || section.size > size - section.offset || section.size % sizeof(T) != 0)
+				{ return false; }
+			table = ArchiveSpan<T>{ reinterpret_cast<const T*>(data + section.offset),
+			                        static_cast<size_t>(section.size / sizeof(T)) };
+			return true;
+		}
+		return false;
+	}
+
+	bool range_fits(ArchiveRange range, size_t table_size)
+		{ return range.first <= table_size && range.count <= table_size - range.first; }
+}
+
+bool GameArchiveView::open(const uint8_t* data, size_t size)
+{
+	close();
+	if (!data || reinterpret_cast<uintptr_t>(data) % ArchiveFormat::ALIGNMENT != 0 || size < sizeof(ArchiveHeader))
+		{ return false; }
+
+	const ArchiveHeader& header = *reinterpret_cast<const ArchiveHeader*>(data);
+	if (header.magic != ArchiveFormat::MAGIC || header.byte_order != ArchiveFormat::BYTE_ORDER_MARK
+	    || header.version == 0 || header.version > ArchiveFormat::VERSION || header.file_size != size
+	    || header.section_count > (size - sizeof(ArchiveHeader)) / sizeof(ArchiveSection))
+		{ return false; }
+
+	const ArchiveSection* sections = reinterpret_cast<const ArchiveSection*>(data + sizeof(ArchiveHeader));
+	const uint32_t count = header.section_count;
+
+	GameArchiveView view;
+	ArchiveSpan<ArchiveMeta> meta_table;
+	ArchiveSpan<ArchiveHistoryInfo> history_table;
+	if (!find_table(data, size, sections, count, ArchiveFormat::SECTION_META, meta_table)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_STRINGS, view.strings)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_HOMES, view.homes)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_PLANETS, view.planets)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_PLAYERS, view.players)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_COLONIES, view.colonies)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_KNOWLEDGE, view.known_planets)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_VISIBILITY, view.visible_words)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_HISTORY, history_table)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_HISTORY_IDS, view.history_ids)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_HISTORY_YEARS, view.history_years)
+	    || !find_table(data, size, sections, count, ArchiveFormat::SECTION_HISTORY_COLUMNS, view.history_columns)
+	    || meta_table.size() != 1 || history_table.size() != 1)
+		{ return false; }
+
+	// Per-player ranges and history shape, so accessors need no checks
+	for (const ArchivePlayer& player : view.players)
+	{
+		if (!range_fits(player.colonies, view.colonies.size())
+		    || !range_fits(player.known_planets, view.known_planets.size())
+		    || !range_fits(player.visible_words, view.visible_words.size()))
+			{ return false; }
+	}
+	const ArchiveHistoryInfo& info = history_table[0];
+	if (info.metric_count != METRIC_COUNT || view.history_ids.size() != info.player_count
+	    || view.history_years.size() != info.row_count
+	    || view.history_columns.size() != static_cast<uint64_t>(info.player_count) * METRIC_COUNT * info.row_count)
+		{ return false; }
+
+	view.meta = &meta_table[0];
+	view.history = &info;
+	*this = view;
+	return true;
+}
+
+std::string_view GameArchiveView::get_string(ArchiveString reference) const
+{
+	if (reference.offset > strings.size() || reference.length > strings.size() - reference.offset)
+		{ return std::string_view(); }
+	return std::string_view(strings.first + reference.offset, reference.length);
+}
+
+// ============================================================================
+// MappedGameArchive Class
+// ============================================================================
+
+bool MappedGameArchive::open(const std::string& path)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		{ return false; }
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE file_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!file_mapping)
+		{ return false; }
+	void* address = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(file_mapping);
+	if (!address)
+		{ return false; }
+	mapping_size = static_cast<size_t>(file_size.QuadPart);
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		{ return false; }
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size <= 0)
+	{
+		::close(file);
+		return false;
+	}
+	void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+	::close(file);
+	if (address == MAP_FAILED)
+		{ return false; }
+	mapping_size = static_cast<size_t>(info.st_size);
+#endif
+
+	mapping = static_cast<const uint8_t*>(address);
+	if (!view.open(mapping, mapping_size))
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+void MappedGameArchive::close()
+{
+	view.close();
+	if (!mapping)
+		{ return; }
+#ifdef _WIN32
+	UnmapViewOfFile(mapping);
+#else
+	munmap(const_cast<uint8_t*>(mapping), mapping_size);
+#endif
+	mapping = nullptr;
+	mapping_size = 0;
+}
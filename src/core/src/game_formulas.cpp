@@ -1,5 +1,6 @@
 #include "game_formulas.h"
 #include "game_constants.h"
+#include "game.h"
 #include "utility.h"
 #include <cmath>
 
@@ -35,21 +36,85 @@ namespace GameFormulas
 		return 1;
 	}
 	
+	// ============================================================================
+	// Fleet Movement Calculations
+	// ============================================================================
+	uint32_t calculate_travel_turns(double distance, int32_t ship_range)
+	{
+		uint32_t turns = 0;
+		if (ship_range > 0)
+			{ turns = static_cast<uint32_t>(std::ceil(distance / ship_range)); }
+		if (turns == 0)
+			{ turns = 1; }  // At least 1 turn to travel
+		return turns;
+	}
+	
+	int32_t calculate_fuel_cost(double distance)
+	{
+		// One fuel unit per light-year, rounded up
+		return static_cast<int32_t>(std::ceil(distance));
+	}
+	
+	// ============================================================================
+	// Combat Calculations
+	// ============================================================================
+	double calculate_ship_attack_strength(int32_t tech_weapons)
+	{
+		// Linear in weapons tech; negative tech levels are treated as 0
+		int32_t level = tech_weapons > 0 ? tech_weapons : 0;
+		return GameConstants::Combat_Base_Attack + GameConstants::Combat_Attack_Per_Weapons_Level * level;
+	}
+	
+	double calculate_ship_defense_strength(int32_t tech_shields)
+	{
+		// Linear in shields tech; negative tech levels are treated as 0
+		int32_t level = tech_shields > 0 ? tech_shields : 0;
+		return GameConstants::Combat_Base_Defense + GameConstants::Combat_Defense_Per_Shields_Level * level;
+	}
+	
 	// ============================================================================
 	// Player Metrics Calculations
 	// ============================================================================
+	int64_t calculate_ship_power(int32_t tech_weapons, int32_t tech_shields)
+	{
+		double strength = calculate_ship_attack_strength(tech_weapons) * calculate_ship_defense_strength(tech_shields);
+		return static_cast<int64_t>(std::llround(strength * GameConstants::Fleet_Power_Scale));
+	}
+	
+	int32_t calculate_colony_victory_points(int32_t population)
+	{
+		int32_t inhabitants = population > 0 ? population : 0;
+		return GameConstants::Victory_Points_Per_Colony + inhabitants / GameConstants::Population_Per_Victory_Point;
+	}
+	
 	int64_t calculate_player_fleet_power(uint32_t player_id, GameState* game_state)
 	{
-		// Placeholder: return 1
-		// Real formula will be implemented later
-		return 1;
+		const Player* player = game_state ? game_state->get_player(player_id) : nullptr;
+		if (!player)
+			{ return 0; }
+		
+		int64_t power = 0;
+		for (const Fleet& fleet : player->get_fleets())
+		{
+			if (fleet.ship_design)
+			{
+				power += static_cast<int64_t>(fleet.ship_count)
+				       * calculate_ship_power(fleet.ship_design->get_weapons(), fleet.ship_design->get_shields());
+			}
+		}
+		return power;
 	}
 	
 	int32_t calculate_player_victory_points(uint32_t player_id, GameState* game_state)
 	{
-		// Placeholder: return 1
-		// Real formula will be implemented later
-		return 1;
+		const Player* player = game_state ? game_state->get_player(player_id) : nullptr;
+		if (!player)
+			{ return 0; }
+		
+		int32_t points = 0;
+		for (const ColonizedPlanet& colony : player->get_colonized_planets())
+			{ points += calculate_colony_victory_points(colony.get_population()); }
+		return points;
 	}
 	
 	// ============================================================================
@@ -247,7 +312,7 @@ namespace GameFormulas
 // ============================================================================
 // Planetary Perception Calculations
 // ============================================================================
-double calculate_apparent_gravity(double ideal_gravity, double true_gravity)
+double GameFormulas::calculate_apparent_gravity(double ideal_gravity, double true_gravity)
 {
 	// Linear gravity perception formula
 	// Line passes through (0, 0) and (ideal_gravity, best_perceived_gravity)
@@ -260,7 +325,7 @@ double calculate_apparent_gravity(double ideal_gravity, double true_gravity)
 	return perceived_grav;
 }
 
-double calculate_apparent_temperature(double ideal_temperature, double true_temperature)
+double GameFormulas::calculate_apparent_temperature(double ideal_temperature, double true_temperature)
 {
 	// Calculate perceived temperature based on ideal and true temperature
 	// All temperatures are in Kelvin
@@ -0,0 +1,235 @@
+#include "game_pool.h"
+#include "game.h"
+#include "game_setup.h"
+#include "player.h"
+#include "player_history.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+// ============================================================================
+// GameState Hibernation Support
+// ============================================================================
+
+GameSetup GameState::get_setup() const
+{
+	return GameSetup(galaxy_params, player_setups);
+}
+
+size_t GameState::estimate_memory_usage() const
+{
+	// The large structures only: galaxy with its derived data, per-player
+	// knowledge and entities, history, and the lookup indices
+	const size_t hash_node = 2 * sizeof(void*);
+	size_t bytes = sizeof(GameState);
+
+	const size_t planet_count = galaxy->planets.size();
+	bytes += galaxy->planets.capacity() * sizeof(Planet);
+	for (const std::vector<double>& row : galaxy->distance_matrix)
+		{ bytes += sizeof(row) + row.capacity() * sizeof(double); }
+	bytes += galaxy->neighbour_graph.get_edge_count() * (sizeof(uint32_t) + sizeof(double));
+	bytes += planet_count * (sizeof(PlanetIdentity) + sizeof(std::string));
+
+	for (const Player& player : players)
+	{
+		if (player.knowledge_galaxy)
+			{ bytes += player.knowledge_galaxy->estimate_memory_usage(); }
+		bytes += player.get_colonized_planets().capacity() * sizeof(ColonizedPlanet);
+		bytes += player.get_fleets().capacity() * sizeof(Fleet);
+		bytes += player.get_fleets().size() * (sizeof(std::pair<uint32_t, size_t>) + hash_node);
+		bytes += player.get_ship_designs().capacity() * sizeof(ShipDesign);
+	}
+	bytes += players.size() * (planet_count / 8 + sizeof(PlanetBitset));
+
+	bytes += player_history.get_row_count() * player_history.get_player_count() * METRIC_COUNT * sizeof(int64_t);
+
+	bytes += (planet_id_to_index.size() + planet_name_to_index.size()) * (sizeof(std::pair<std::string, size_t>) + hash_node);
+	return bytes;
+}
+
+// ============================================================================
+// GamePool Class
+// ============================================================================
+
+GamePool::GamePool(size_t memory_budget)
+	: memory_budget(memory_budget)
+{
+}
+
+GamePool::~GamePool() = default;
+
+GamePool::GameId GamePool::add(std::unique_ptr<GameState> game)
+{
+	GameId id = next_id++;
+	Entry& entry = games[id];
+	entry.game = std::move(game);
+	lru.push_front(id);
+	entry.lru = lru.begin();
+	enforce_budget();
+	return id;
+}
+
+GamePool::Lease GamePool::acquire(GameId id)
+{
+	auto it = games.find(id);
+	if (it == games.end())
+		{ return Lease(); }
+	Entry& entry = it->second;
+	if (!entry.game && !resume(id))
+		{ return Lease(); }
+	touch(entry);
+	entry.leases++;
+	enforce_budget();
+	return Lease(*this, id, entry.game.get());
+}
+
+bool GamePool::hibernate(GameId id)
+{
+	auto it = games.find(id);
+	if (it == games.end() || !it->second.game)
+		{ return false; }
+	Entry& entry = it->second;
+	if (entry.leases > 0 || entry.game->get_command_journal() || entry.game->get_autosave())
+		{ return false; }
+
+	entry.save = entry.game->serialize_state();
+	entry.save.shrink_to_fit();
+	entry.game.reset();
+	totals.hibernations++;
+	return true;
+}
+
+bool GamePool::resume(GameId id)
+{
+	auto it = games.find(id);
+	if (it == games.end() || it->second.game)
+		{ return false; }
+	Entry& entry = it->second;
+
+	auto start = std::chrono::steady_clock::now();
+	std::unique_ptr<GameState> game = GameState::from_save(entry.save);
+	if (!game)
+		{ return false; }
+	double resume_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	entry.game = std::move(game);
+	std::vector<uint8_t>().swap(entry.save);
+	totals.resumes++;
+	totals.last_resume_ms = resume_ms;
+	totals.max_resume_ms = std::max(totals.max_resume_ms, resume_ms);
+	return true;
+}
+
+bool GamePool::remove(GameId id)
+{
+	auto it = games.find(id);
+	if (it == games.end() || it->second.leases > 0)
+		{ return false; }
+	lru.erase(it->second.lru);
+	games.erase(it);
+	return true;
+}
+
+bool GamePool::is_hibernated(GameId id) const
+{
+	auto it = games.find(id);
+	return it != games.end() && !it->second.game;
+}
+
+void GamePool::set_memory_budget(size_t bytes)
+{
+	memory_budget = bytes;
+	enforce_budget();
+}
+
+size_t GamePool::enforce_budget()
+{
+	if (memory_budget == 0 || lru.empty())
+		{ return 0; }
+
+	size_t resident_bytes = 0;
+	for (const auto& game : games)
+	{
+		if (game.second.game)
+			{ resident_bytes += game.second.game->estimate_memory_usage(); }
+	}
+
+	// Oldest first, sparing the most recent game (hibernate() also skips leased ones)
+	size_t hibernated = 0;
+	for (auto it = std::prev(lru.end()); resident_bytes > memory_budget && it != lru.begin(); )
+	{
+		GameId id = *it--;
+		Entry& entry = games[id];
+		if (!entry.game)
+			{ continue; }
+		size_t game_bytes = entry.game->estimate_memory_usage();
+		if (hibernate(id))
+		{
+			resident_bytes -= game_bytes;
+			hibernated++;
+		}
+	}
+	return hibernated;
+}
+
+GamePool::Stats GamePool::get_stats() const
+{
+	Stats stats = totals;
+	for (const auto& game : games)
+	{
+		const Entry& entry = game.second;
+		if (entry.game)
+		{
+			stats.resident_games++;
+			stats.resident_bytes += entry.game->estimate_memory_usage();
+		}
+		else
+		{
+			stats.hibernated_games++;
+			stats.hibernated_bytes += entry.save.size();
+		}
+	}
+	return stats;
+}
+
+void GamePool::touch(Entry& entry)
+{
+	lru.splice(lru.begin(), lru, entry.lru);
+}
+
+// ============================================================================
+// GamePool::Lease Class
+// ============================================================================
+
+GamePool::Lease::Lease(Lease&& other) noexcept
+	: pool(other.pool), id(other.id), game(other.game)
+{
+	other.pool = nullptr;
+	other.game = nullptr;
+}
+
+GamePool::Lease& GamePool::Lease::operator=(Lease&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		pool = other.pool;
+		id = other.id;
+		game = other.game;
+		other.pool = nullptr;
+		other.game = nullptr;
+	}
+	return *this;
+}
+
+void GamePool::Lease::release()
+{
+	if (pool)
+	{
+		auto it = pool->games.find(id);
+		if (it != pool->games.end() && it->second.leases > 0)
+			{ it->second.leases--; }
+	}
+	pool = nullptr;
+	game = nullptr;
+}
@@ -11,6 +11,14 @@ GameSetup::GameSetup()
 	: galaxy_params(100, 1, 0.5, GALAXY_RANDOM, 0)
 { }
 
+GameSetup::GameSetup(const GalaxyGenerationParams& params, const std::vector<PlayerSetup>& players)
+	: galaxy_params(params),
+	  player_setups(players)
+{
+	// Keep galaxy params consistent with the actual number of players
+	galaxy_params.n_players = static_cast<uint32_t>(player_setups.size());
+}
+
 GameSetup::~GameSetup()
 { }
 
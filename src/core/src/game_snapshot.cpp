@@ -0,0 +1,411 @@
+#include "game_snapshot.h"
+#include "game.h"
+#include "game_formulas.h"
+#include <algorithm>
+#include <unordered_set>
+
+// ============================================================================
+// Snapshot Records
+// ============================================================================
+
+ColonyRecord ColonyRecord::from(const ColonizedPlanet& colony)
+{
+	ColonyRecord record;
+	record.planet_id = colony.get_id();
+	record.funding_fraction = colony.get_funding_fraction();
+	record.population = colony.get_population();
+	record.income = colony.get_income();
+	record.mining_fraction = colony.get_mining_fraction();
+	record.terraforming_fraction = colony.get_terraforming_fraction();
+	record.apparent_gravity = colony.get_apparent_gravity();
+	record.apparent_temperature = colony.get_apparent_temperature();
+	record.desirability = colony.get_desirability();
+	return record;
+}
+
+namespace
+{
+	/// Rebuild a colony from its record without re-deriving anything
+	ColonizedPlanet make_colony(const ColonyRecord& record, Planet* planet, Player* owner)
+	{
+		// Assign the split directly: the PlanetaryBudgetSplit constructor would re-normalize it
+		ColonizedPlanet::PlanetaryBudgetSplit split;
+		split.mining_fraction = record.mining_fraction;
+		split.terraforming_fraction = record.terraforming_fraction;
+
+		ColonizedPlanet colony(planet, owner, record.population, record.income,
+		                       record.funding_fraction, split, record.desirability);
+		colony.set_apparent_gravity(record.apparent_gravity);
+		colony.set_apparent_temperature(record.apparent_temperature);
+		return colony;
+	}
+
+	/// Check every cross-reference in a snapshot before any live state is touched
+	bool validate_snapshot(const GameSnapshot& s)
+	{
+		const uint32_t planet_count = static_cast<uint32_t>(s.planets.size());
+		auto valid_planet = [planet_count](uint32_t planet_id) { return planet_id >= 1 && planet_id <= planet_count; };
+
+		if (planet_count == 0 || s.players.empty() || s.galaxy_params.shape > GALAXY_GRID)
+			{ return false; }
+
+		// Planet IDs are sequential from 1 (get_planet() relies on it)
+		for (uint32_t i = 0; i < planet_count; ++i)
+		{
+			const Planet& planet = s.planets[i];
+			if (planet.id != i + 1 || planet.nova_state > PLANET_DESTROYED)
+				{ return false; }
+			if (planet.owner != NOT_OWNED && (planet.owner < 1 || static_cast<size_t>(planet.owner) > s.players.size()))
+				{ return false; }
+		}
+		for (size_t index : s.home_planet_indices)
+		{
+			if (index >= planet_count)
+				{ return false; }
+		}
+
+		const size_t visible_words = (static_cast<size_t>(planet_count) + 1 + 63) / 64;
+		std::unordered_set<uint64_t> stationed;   // (owner << 32) | fleet_id of every docked fleet
+
+		for (size_t i = 0; i < s.players.size(); ++i)
+		{
+			const PlayerRecord& p = s.players[i];
+
+			// Player IDs are 1..N in player order
+			if (p.id != i + 1 || p.gender > GENDER_M || p.type > PLAYER_COMPUTER || p.starting_colony_quality > START_ABUNDANT)
+				{ return false; }
+
+			for (const ColonyRecord& colony : p.colonies)
+			{
+				if (!valid_planet(colony.planet_id))
+					{ return false; }
+			}
+			for (const ColonyRecord& colony : p.known_colonizations)
+			{
+				if (!valid_planet(colony.planet_id))
+					{ return false; }
+			}
+
+			for (const ShipDesign& design : p.designs)
+			{
+				if (design.type > SHIP_BIOLOGICAL)
+					{ return false; }
+			}
+
+			for (const FleetRecord& fleet : p.fleets)
+			{
+				auto design = std::find_if(p.designs.begin(), p.designs.end(),
+					[&fleet](const ShipDesign& d) { return d.id == fleet.design_id; });
+				if (design == p.designs.end())
+					{ return false; }
+
+				if (fleet.transit)
+				{
+					if (fleet.planet_id != 0 || !valid_planet(fleet.transit->origin_planet_id) ||
+					    !valid_planet(fleet.transit->destination_planet_id))
+						{ return false; }
+				}
+				else
+				{
+					if (!valid_planet(fleet.planet_id))
+						{ return false; }
+					stationed.insert(static_cast<uint64_t>(p.id) << 32 | fleet.id);
+				}
+			}
+
+			for (const KnowledgePlanet& known : p.known_planets)
+			{
+				if (!valid_planet(known.id) || known.nova_state > PLANET_DESTROYED)
+					{ return false; }
+			}
+			for (const EnemyFleetRecord& enemy : p.enemy_fleets)
+			{
+				if (!valid_planet(enemy.planet_id))
+					{ return false; }
+			}
+			if (p.visible_planet_words.size() != visible_words)
+				{ return false; }
+		}
+
+		// Every stationed fleet appears exactly once in the occupancy order, at its own planet
+		if (s.occupancy.size() != stationed.size())
+			{ return false; }
+		for (const OccupancyRecord& record : s.occupancy)
+		{
+			if (!valid_planet(record.planet_id) || record.owner < 1 || static_cast<size_t>(record.owner) > s.players.size())
+				{ return false; }
+			const std::vector<FleetRecord>& fleets = s.players[record.owner - 1].fleets;
+			auto fleet = std::find_if(fleets.begin(), fleets.end(),
+				[&record](const FleetRecord& f) { return f.id == record.fleet_id; });
+			if (fleet == fleets.end() || fleet->transit || fleet->planet_id != record.planet_id)
+				{ return false; }
+			if (stationed.erase(static_cast<uint64_t>(record.owner) << 32 | record.fleet_id) == 0)
+				{ return false; }
+		}
+
+		// History columns belong to the same players, in the same order
+		const std::vector<uint32_t>& history_ids = s.history.get_player_ids();
+		if (history_ids.size() != s.players.size() || !s.history.validate())
+			{ return false; }
+		for (size_t i = 0; i < history_ids.size(); ++i)
+		{
+			if (history_ids[i] != s.players[i].id)
+				{ return false; }
+		}
+		return true;
+	}
+}
+
+// ============================================================================
+// GameState Snapshot Capture
+// ============================================================================
+
+void GameState::capture_snapshot(GameSnapshot& s) const
+{
+	capture_frozen_snapshot(s);
+	expand_frozen_knowledge(s);
+}
+
+void GameState::capture_frozen_snapshot(GameSnapshot& s) const
+{
+	s.current_turn = current_turn;
+	s.current_year = current_year;
+	s.next_fleet_id = next_fleet_id;
+
+	s.galaxy_params = galaxy_params;
+	s.galaxy_size = galaxy->gal_size;
+	s.home_planet_indices = galaxy->home_planet_indices;
+	s.planets = galaxy->planets;
+
+	// A recycled snapshot keeps its records, so their lists reuse their memory
+	s.players.resize(players.size());
+	for (size_t i = 0; i < players.size(); ++i)
+	{
+		const Player& player = players[i];
+		PlayerRecord& record = s.players[i];
+
+		record.id = player.id;
+		record.name = player.name;
+		record.gender = player.gender;
+		record.type = player.type;
+		record.iq = player.iq;
+		record.starting_colony_quality = i < player_setups.size() ? player_setups[i].starting_colony_quality : START_NORMAL;
+
+		record.money_savings = player.money_savings;
+		record.metal_reserve = player.metal_reserve;
+		record.money_income = player.money_income;
+		record.metal_income = player.metal_income;
+		record.ideal_temperature = player.ideal_temperature;
+		record.ideal_gravity = player.ideal_gravity;
+
+		record.tech = player.tech;
+		record.income = player.current_turn_income;
+		record.allocation = player.allocation;
+		record.research = player.partial_research;
+
+		record.next_ship_design_id = player.next_ship_design_id;
+		record.alliance_id = player_alliances[i];
+
+		record.colonies.clear();
+		for (const ColonizedPlanet& colony : player.colonized_planets)
+			{ record.colonies.push_back(ColonyRecord::from(colony)); }
+
+		record.designs = player.ship_designs;
+
+		record.fleets.clear();
+		for (const Fleet& fleet : player.fleets)
+		{
+			FleetRecord fleet_record;
+			fleet_record.id = fleet.id;
+			fleet_record.design_id = fleet.ship_design ? fleet.ship_design->id : 0;
+			fleet_record.ship_count = fleet.ship_count;
+			fleet_record.fuel = fleet.fuel;
+			fleet_record.descriptor = fleet.descriptor;
+			fleet_record.planet_id = (fleet.is_in_transit() || !fleet.current_planet) ? 0 : fleet.current_planet->id;
+			fleet_record.transit = fleet.transit;
+			record.fleets.push_back(std::move(fleet_record));
+		}
+
+		record.known_planets.clear();
+		record.frozen_knowledge.clear();
+		record.known_colonizations.clear();
+		record.enemy_fleets.clear();
+		if (const KnowledgeGalaxy* knowledge = player.knowledge_galaxy)
+		{
+			// Pages the player learned nothing on are shared, not copied
+			knowledge->freeze(record.frozen_knowledge);
+
+			// Side table is a hash map: sort so equal games produce equal snapshots
+			knowledge->for_each_colonization([&record](uint32_t, const ColonizedPlanet& colony)
+				{ record.known_colonizations.push_back(ColonyRecord::from(colony)); });
+			std::sort(record.known_colonizations.begin(), record.known_colonizations.end(),
+				[](const ColonyRecord& a, const ColonyRecord& b) { return a.planet_id < b.planet_id; });
+
+			knowledge->for_each_enemy_fleet([&record](uint32_t planet_id, const FleetVisibleInfo& info)
+				{ record.enemy_fleets.push_back(EnemyFleetRecord{ planet_id, info }); });
+		}
+
+		const PlanetBitset& visible = visible_planets[i];
+		record.visible_planet_words.assign(visible.words(), visible.words() + visible.word_count());
+	}
+
+	// Stationed fleets in index order, which decides the order of combat draws
+	s.occupancy.clear();
+	for (const Planet& planet : galaxy->planets)
+	{
+		for (const FleetHandle& handle : fleet_occupancy.get_fleets_at(planet.id))
+			{ s.occupancy.push_back(OccupancyRecord{ planet.id, handle.owner, handle.fleet_id }); }
+	}
+
+	s.history = player_history;
+
+	s.deterministic_seed = rng->getDeterministicSeed();
+	s.ai_seed = rng->getAISeed();
+	s.deterministic_rng_state = rng->serialize_deterministic_rng_state();
+	s.ai_rng_state = rng->serialize_ai_rng_state();
+}
+
+void expand_frozen_knowledge(GameSnapshot& s)
+{
+	for (PlayerRecord& record : s.players)
+	{
+		record.frozen_knowledge.expand(record.known_planets);
+		record.frozen_knowledge.clear();
+	}
+}
+
+// ============================================================================
+// GameState Snapshot Restore
+// ============================================================================
+
+bool GameState::restore_snapshot(const GameSnapshot& s)
+{
+	if (!validate_snapshot(s))
+		{ return false; }
+
+	std::unique_ptr<DeterministicRNG> restored_rng = std::make_unique<DeterministicRNG>(s.deterministic_seed, s.ai_seed);
+	if (!restored_rng->deserialize_deterministic_rng_state(s.deterministic_rng_state)
+	    || !restored_rng->deserialize_ai_rng_state(s.ai_rng_state))
+		{ return false; }
+
+	// Drop the current game (players do not delete their knowledge themselves)
+	for (Player& player : players)
+	{
+		delete player.knowledge_galaxy;
+		player.knowledge_galaxy = nullptr;
+	}
+	players.clear();
+	planet_id_to_index.clear();
+	planet_name_to_index.clear();
+	player_id_to_index.clear();
+	player_name_to_index.clear();
+
+	current_turn = s.current_turn;
+	current_year = s.current_year;
+	next_fleet_id = s.next_fleet_id;
+	galaxy_params = s.galaxy_params;
+
+	// Planets as saved; distances, identities and neighbour lists are rebuilt
+	galaxy = std::make_unique<Galaxy>(s.planets, s.galaxy_size, s.home_planet_indices);
+
+	// Players (reserved up front: colonies keep Player pointers)
+	players.reserve(s.players.size());
+	player_setups.clear();
+	for (const PlayerRecord& record : s.players)
+	{
+		Player player(this);
+		player.id = record.id;
+		player.name = record.name;
+		player.gender = record.gender;
+		player.type = record.type;
+		player.iq = record.iq;
+
+		player.money_savings = record.money_savings;
+		player.metal_reserve = record.metal_reserve;
+		player.money_income = record.money_income;
+		player.metal_income = record.metal_income;
+		player.ideal_temperature = record.ideal_temperature;
+		player.ideal_gravity = record.ideal_gravity;
+
+		player.tech = record.tech;
+		player.current_turn_income = record.income;
+		player.allocation = record.allocation;
+		player.partial_research = record.research;
+
+		player.ship_designs = record.designs;
+		player.next_ship_design_id = record.next_ship_design_id;
+		players.push_back(std::move(player));
+
+		player_setups.push_back(PlayerSetup{ record.name, record.gender, record.type, record.iq, record.starting_colony_quality });
+	}
+
+	// Lookup maps, occupancy sizing, sensor index, visible sets and alliances
+	build_entity_maps();
+
+	for (size_t i = 0; i < players.size(); ++i)
+	{
+		Player& player = players[i];
+		const PlayerRecord& record = s.players[i];
+
+		player.knowledge_galaxy = new KnowledgeGalaxy(*galaxy, player.id);
+		for (const KnowledgePlanet& known : record.known_planets)
+			{ player.knowledge_galaxy->restore_planet(known); }
+		for (const ColonyRecord& colony : record.known_colonizations)
+		{
+			player.knowledge_galaxy->set_colonization(colony.planet_id,
+				make_colony(colony, get_planet(colony.planet_id), &player));
+		}
+		for (const EnemyFleetRecord& enemy : record.enemy_fleets)
+			{ player.knowledge_galaxy->add_visible_enemy_fleet(enemy.planet_id, enemy.info); }
+
+		player.colonized_planets.reserve(record.colonies.size());
+		for (const ColonyRecord& colony : record.colonies)
+			{ player.colonized_planets.push_back(make_colony(colony, get_planet(colony.planet_id), &player)); }
+
+		// Fleets in transit are built at their origin, then moved into this player's space planet
+		for (const FleetRecord& fleet_record : record.fleets)
+		{
+			uint32_t planet_id = fleet_record.transit ? fleet_record.transit->origin_planet_id : fleet_record.planet_id;
+			(void)player.build_fleet(fleet_record.id, fleet_record.design_id, fleet_record.ship_count, planet_id);
+
+			Fleet& fleet = player.fleets.back();
+			fleet.fuel = fleet_record.fuel;
+			fleet.descriptor = fleet_record.descriptor;
+			fleet.transit = fleet_record.transit;
+			if (fleet.transit)
+				{ fleet.current_planet = player.knowledge_galaxy->get_space_real_planet(); }
+		}
+
+		player_alliances[i] = record.alliance_id;
+		std::copy(record.visible_planet_words.begin(), record.visible_planet_words.end(), visible_planets[i].words());
+	}
+
+	// Colony constructors claim their planets; the saved owners are authoritative
+	for (size_t i = 0; i < s.planets.size(); ++i)
+		{ galaxy->planets[i].owner = s.planets[i].owner; }
+
+	// build_fleet() filled the index in fleet order; replay the saved per-planet order instead
+	fleet_occupancy.reset(static_cast<uint32_t>(galaxy->planets.size()));
+	for (const OccupancyRecord& record : s.occupancy)
+		{ fleet_occupancy.add_fleet(record.planet_id, record.owner, record.fleet_id); }
+
+	// Derived data
+	for (Player& player : players)
+	{
+		player.fleet_power = GameFormulas::calculate_player_fleet_power(player.id, this);
+		player.victory_points = GameFormulas::calculate_player_victory_points(player.id, this);
+		player.rebuild_reachability();
+	}
+	initialize_research_cost_caches();
+
+	player_history = s.history;
+
+	rng = std::move(restored_rng);
+
+	// Knowledge history restarts at the saved turn (earlier turns are not stored)
+	uint32_t last_committed_turn = current_turn > 0 ? current_turn - 1 : 0;
+	for (Player& player : players)
+		{ player.knowledge_galaxy->commit_snapshot(last_committed_turn); }
+
+	return true;
+}
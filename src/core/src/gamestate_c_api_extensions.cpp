@@ -1,6 +1,9 @@
 #include "gamestate_c_api_extensions.h"
 #include "game.h"
 #include "player.h"
+#include "command_journal.h"
+#include <algorithm>
+#include <cstring>
 
 // ============================================================================
 // Turn Management & Status
@@ -72,17 +75,10 @@ uint32_t game_player_build_fleet(
 	if (!game_state)
 		return 0;
 	
-	// Validate first
-	if (game_state->check_player_build_fleet(player_id, design_id, ship_count, planet_id) != ErrorCode::SUCCESS)
-		return 0;
-	
-	// Get player and delegate to Player::create_fleet
-	GameState* mutable_game_state = const_cast<GameState*>(game_state);
-	Player* player = mutable_game_state->get_player(player_id);
-	if (!player)
-		return 0;
-	
-	return player->create_fleet(design_id, ship_count, planet_id);
+	// execute_command() validates with check_player_build_fleet()
+	uint32_t fleet_id = 0;
+	(void)game_state->execute_command(GameCommand::build_fleet(player_id, design_id, ship_count, planet_id), &fleet_id);
+	return fleet_id;
 }
 
 // ============================================================================
@@ -120,16 +116,11 @@ uint32_t game_player_design_ship(
 	if (!game_state || !name)
 		return 0;
 	
-	// Validate first
-	if (game_state->check_player_design_ship(player_id, std::string(name), static_cast<ShipType>(ship_type), tech_range, tech_speed, tech_weapons, tech_shields, tech_miniaturization) != ErrorCode::SUCCESS)
-		return 0;
-	
-	// Delegate to Player
-	Player* player = game_state->get_player(player_id);
-	if (!player)
-		return 0;
-	
-	return player->create_ship_design(std::string(name), static_cast<ShipType>(ship_type), tech_range, tech_speed, tech_weapons, tech_shields, tech_miniaturization);
+	// execute_command() validates with check_player_design_ship()
+	uint32_t design_id = 0;
+	(void)game_state->execute_command(GameCommand::create_ship_design(player_id, std::string(name), static_cast<ShipType>(ship_type),
+	                                                                 tech_range, tech_speed, tech_weapons, tech_shields, tech_miniaturization), &design_id);
+	return design_id;
 }
 
 // ============================================================================
@@ -159,17 +150,17 @@ ErrorCode game_player_set_spending_allocation(
 	if (!game_state)
 		return ErrorCode::INVALID_PARAMETER;
 	
-	// Validate first
-	if (game_state->check_player_set_spending_allocation(player_id, savings_fraction, research_fraction, planets_fraction) != ErrorCode::SUCCESS)
-		return ErrorCode::INVALID_ALLOCATION;
+	const Player* player = game_state->get_player(player_id);
+	if (!player)
+		return ErrorCode::INVALID_PLAYER_ID;
 	
-	// Delegate to GameState - note: research allocation struct needs to be populated
-	Player::MoneyAllocation alloc;
+	// Keep the player's research split; only the top-level fractions change
+	// (execute_command() validates with check_player_set_spending_allocation())
+	Player::MoneyAllocation alloc = player->get_spending_allocation();
 	alloc.savings_fraction = savings_fraction;
 	alloc.research_fraction = research_fraction;
 	alloc.planets_fraction = planets_fraction;
-	game_state->set_money_allocation(player_id, alloc);
-	return ErrorCode::SUCCESS;
+	return game_state->execute_command(GameCommand::set_money_allocation(player_id, alloc));
 }
 
 // ============================================================================
@@ -197,13 +188,30 @@ ErrorCode game_player_move_fleet(
 	if (!game_state)
 		return ErrorCode::INVALID_PARAMETER;
 	
-	// Validate first
-	if (game_state->check_player_move_fleet(player_id, fleet_id, destination_planet_id) != ErrorCode::SUCCESS)
-		return ErrorCode::VALIDATION_FAILED;
+	// execute_command() validates with check_player_move_fleet()
+	return game_state->execute_command(GameCommand::move_fleet(player_id, fleet_id, destination_planet_id));
+}
+
+ErrorCode game_player_delete_fleet(
+	GameState* game_state,
+	uint32_t player_id,
+	uint32_t fleet_id)
+{
+	if (!game_state)
+		return ErrorCode::INVALID_PARAMETER;
+	
+	return game_state->execute_command(GameCommand::delete_fleet(player_id, fleet_id));
+}
+
+ErrorCode game_player_refuel_fleet(
+	GameState* game_state,
+	uint32_t player_id,
+	uint32_t fleet_id)
+{
+	if (!game_state)
+		return ErrorCode::INVALID_PARAMETER;
 	
-	// Delegate to GameState
-	game_state->move_fleet(player_id, fleet_id, destination_planet_id);
-	return ErrorCode::SUCCESS;
+	return game_state->execute_command(GameCommand::refuel_fleet(player_id, fleet_id));
 }
 
 // ============================================================================
@@ -233,10 +241,107 @@ ErrorCode game_player_set_planet_allocation(
 	if (!game_state)
 		return ErrorCode::INVALID_PARAMETER;
 	
-	// Validate first
-	if (game_state->check_player_set_planet_allocation(player_id, planet_id, mining_fraction, terraforming_fraction) != ErrorCode::SUCCESS)
-		return ErrorCode::INVALID_ALLOCATION;
+	// execute_command() validates with check_player_set_planet_allocation()
+	return game_state->execute_command(GameCommand::set_planet_allocation(player_id, planet_id, mining_fraction, terraforming_fraction));
+}
+
+// ============================================================================
+// Player History Export
+// ============================================================================
+
+uint32_t game_get_player_metric_count(void)
+{
+	return METRIC_COUNT;
+}
+
+ErrorCode game_get_player_history_turns(
+	const GameState* game_state,
+	uint32_t* out_first_turn,
+	uint32_t* out_last_turn)
+{
+	if (!game_state || !out_first_turn || !out_last_turn)
+		return ErrorCode::INVALID_PARAMETER;
+	
+	const PlayerHistoryStore& history = game_state->get_player_history();
+	if (history.empty())
+		return ErrorCode::INVALID_PARAMETER;
+	
+	*out_first_turn = history.get_first_turn();
+	*out_last_turn = history.get_last_turn();
+	return ErrorCode::SUCCESS;
+}
+
+ErrorCode game_get_player_metric_view(
+	const GameState* game_state,
+	uint32_t player_id,
+	uint32_t metric,
+	uint32_t first_turn,
+	uint32_t last_turn,
+	PlayerHistoryView* out)
+{
+	if (!game_state || !out || metric >= METRIC_COUNT)
+		return ErrorCode::INVALID_PARAMETER;
+	
+	const PlayerHistoryStore& history = game_state->get_player_history();
+	size_t player_index = history.find_player(player_id);
+	if (player_index == SIZE_MAX)
+		return ErrorCode::INVALID_PLAYER_ID;
+	
+	MetricSpan span = history.get_metric_range(player_index, static_cast<PlayerMetric>(metric), first_turn, last_turn);
+	out->values = span.empty() ? nullptr : span.first;
+	out->count = static_cast<uint32_t>(span.count);
+	out->stride = sizeof(int64_t);
+	out->first_turn = span.first_turn;
+	out->reserved = 0;
+	return ErrorCode::SUCCESS;
+}
+
+ErrorCode game_get_player_metric_since(
+	const GameState* game_state,
+	uint32_t player_id,
+	uint32_t metric,
+	uint32_t since_turn,
+	PlayerHistoryView* out)
+{
+	return game_get_player_metric_view(game_state, player_id, metric, since_turn, UINT32_MAX, out);
+}
+
+ErrorCode game_copy_player_history(
+	const GameState* game_state,
+	uint32_t player_id,
+	uint32_t since_turn,
+	int64_t* out_values,
+	uint32_t max_rows,
+	uint32_t* out_rows,
+	uint32_t* out_first_turn)
+{
+	if (!game_state || !out_values || !out_rows || !out_first_turn)
+		return ErrorCode::INVALID_PARAMETER;
+	
+	const PlayerHistoryStore& history = game_state->get_player_history();
+	size_t player_index = history.find_player(player_id);
+	if (player_index == SIZE_MAX)
+		return ErrorCode::INVALID_PLAYER_ID;
+	
+	*out_rows = 0;
+	*out_first_turn = since_turn;
+	if (max_rows == 0 || history.empty())
+		return ErrorCode::SUCCESS;
+	
+	// All metrics share the same rows, so clip once and copy each column in one block
+	uint32_t first_turn = std::max(since_turn, history.get_first_turn());
+	if (first_turn > history.get_last_turn())
+		return ErrorCode::SUCCESS;
+	uint32_t last_turn = static_cast<uint32_t>(std::min<uint64_t>(history.get_last_turn(), static_cast<uint64_t>(first_turn) + max_rows - 1));
+	uint32_t rows = last_turn - first_turn + 1;
+	
+	for (uint32_t metric = 0; metric < METRIC_COUNT; ++metric)
+	{
+		MetricSpan span = history.get_metric_range(player_index, static_cast<PlayerMetric>(metric), first_turn, last_turn);
+		std::memcpy(out_values + static_cast<size_t>(metric) * rows, span.first, rows * sizeof(int64_t));
+	}
 	
-	// TODO: Implement actual allocation setting in GameState
+	*out_rows = rows;
+	*out_first_turn = first_turn;
 	return ErrorCode::SUCCESS;
 }
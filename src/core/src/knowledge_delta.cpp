@@ -0,0 +1,166 @@
+#include "knowledge_delta.h"
+#include "knowledge_planet.h"
+#include "game_constants.h"
+#include "serialization.h"
+
+// ============================================================================
+// KnowledgeDelta Implementation
+// ============================================================================
+
+KnowledgeDelta KnowledgeDelta::capture(const KnowledgePlanet& planet, uint32_t changed_fields)
+{
+	KnowledgeDelta delta;
+	delta.planet_id = planet.id;
+	delta.changed_fields = changed_fields;
+	delta.apparent_temperature = planet.apparent_temperature;
+	delta.apparent_gravity = planet.apparent_gravity;
+	delta.metal = planet.metal;
+	delta.apparent_owner = planet.apparent_owner;
+	delta.apparent_population = planet.apparent_population;
+	delta.observation_year = planet.observation_year;
+	delta.can_be_profitable = planet.can_be_profitable;
+	delta.perceived_value = planet.perceived_value;
+	return delta;
+}
+
+void KnowledgeDelta::apply_to(KnowledgePlanet& planet) const
+{
+	if (changed_fields & KNOWLEDGE_TEMPERATURE)
+		{ planet.apparent_temperature = apparent_temperature; }
+	if (changed_fields & KNOWLEDGE_GRAVITY)
+		{ planet.apparent_gravity = apparent_gravity; }
+	if (changed_fields & KNOWLEDGE_METAL)
+		{ planet.metal = metal; }
+	if (changed_fields & KNOWLEDGE_OWNER)
+		{ planet.apparent_owner = apparent_owner; }
+	if (changed_fields & KNOWLEDGE_POPULATION)
+		{ planet.apparent_population = apparent_population; }
+	if (changed_fields & KNOWLEDGE_OBSERVATION_YEAR)
+		{ planet.observation_year = observation_year; }
+	if (changed_fields & KNOWLEDGE_PROFITABILITY)
+		{ planet.can_be_profitable = can_be_profitable; }
+	if (changed_fields & KNOWLEDGE_PERCEIVED_VALUE)
+		{ planet.perceived_value = perceived_value; }
+}
+
+void KnowledgeDelta::encode(ByteWriter& w) const
+{
+	w.put_varuint(planet_id);
+	w.put_u8(static_cast<uint8_t>(changed_fields));
+	if (changed_fields & KNOWLEDGE_TEMPERATURE)
+		{ w.put_f64(apparent_temperature); }
+	if (changed_fields & KNOWLEDGE_GRAVITY)
+		{ w.put_f64(apparent_gravity); }
+	if (changed_fields & KNOWLEDGE_METAL)
+		{ w.put_varint(metal); }
+	if (changed_fields & KNOWLEDGE_OWNER)
+		{ w.put_varint(apparent_owner); }
+	if (changed_fields & KNOWLEDGE_POPULATION)
+		{ w.put_varint(apparent_population); }
+	if (changed_fields & KNOWLEDGE_OBSERVATION_YEAR)
+		{ w.put_varint(observation_year); }
+	if (changed_fields & KNOWLEDGE_PROFITABILITY)
+		{ w.put_varint(can_be_profitable); }
+	if (changed_fields & KNOWLEDGE_PERCEIVED_VALUE)
+		{ w.put_varint(perceived_value); }
+}
+
+bool KnowledgeDelta::decode(ByteReader& r)
+{
+	*this = KnowledgeDelta();
+	planet_id = r.get_varuint32();
+	changed_fields = r.get_u8();
+	if (changed_fields & KNOWLEDGE_TEMPERATURE)
+		{ apparent_temperature = r.get_f64(); }
+	if (changed_fields & KNOWLEDGE_GRAVITY)
+		{ apparent_gravity = r.get_f64(); }
+	if (changed_fields & KNOWLEDGE_METAL)
+		{ metal = r.get_varint32(); }
+	if (changed_fields & KNOWLEDGE_OWNER)
+		{ apparent_owner = r.get_varint32(); }
+	if (changed_fields & KNOWLEDGE_POPULATION)
+		{ apparent_population = r.get_varint32(); }
+	if (changed_fields & KNOWLEDGE_OBSERVATION_YEAR)
+		{ observation_year = r.get_varint32(); }
+	if (changed_fields & KNOWLEDGE_PROFITABILITY)
+		{ can_be_profitable = r.get_varint32(); }
+	if (changed_fields & KNOWLEDGE_PERCEIVED_VALUE)
+		{ perceived_value = r.get_varint32(); }
+	return r.ok();
+}
+
+// ============================================================================
+// KnowledgeChangeLog Implementation
+// ============================================================================
+
+void KnowledgeChangeLog::begin_turn(uint32_t turn)
+{
+	if (!turns.empty() && turns.back().turn == turn)
+		{ return; }
+	
+	turns.push_back(TurnSegment{ turn, bytes.size(), 0 });
+	while (turns.size() > GameConstants::Knowledge_Change_Log_Turns)
+		{ discard_oldest_turn(); }
+}
+
+void KnowledgeChangeLog::append(const KnowledgeDelta& delta)
+{
+	if (turns.empty())
+		{ begin_turn(0); }
+	ByteWriter w(bytes);
+	delta.encode(w);
+	turns.back().count++;
+	delta_count++;
+}
+
+size_t KnowledgeChangeLog::get_turn_deltas(uint32_t turn, std::vector<KnowledgeDelta>& out) const
+{
+	const uint8_t* first = nullptr;
+	size_t size = get_turn_bytes(turn, first);
+	if (!decode_deltas(first, size, out))
+		{ out.clear(); }
+	return out.size();
+}
+
+size_t KnowledgeChangeLog::get_turn_bytes(uint32_t turn, const uint8_t*& first) const
+{
+	first = nullptr;
+	for (size_t i = 0; i < turns.size(); ++i)
+	{
+		if (turns[i].turn != turn)
+			{ continue; }
+		
+		size_t end = (i + 1 < turns.size()) ? turns[i + 1].first : bytes.size();
+		first = bytes.data() + turns[i].first;
+		return end - turns[i].first;
+	}
+	return 0;
+}
+
+bool KnowledgeChangeLog::decode_deltas(const uint8_t* data, size_t size, std::vector<KnowledgeDelta>& out)
+{
+	out.clear();
+	ByteReader r(data, size);
+	while (!r.at_end())
+	{
+		KnowledgeDelta delta;
+		if (!delta.decode(r))
+			{ return false; }
+		out.push_back(delta);
+	}
+	return true;
+}
+
+void KnowledgeChangeLog::discard_oldest_turn()
+{
+	if (turns.size() < 2)
+		{ return; }
+	
+	// Shift the remaining deltas down and rebase the segment offsets
+	size_t removed = turns[1].first;
+	bytes.erase(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(removed));
+	delta_count -= turns.front().count;
+	turns.erase(turns.begin());
+	for (TurnSegment& segment : turns)
+		{ segment.first -= removed; }
+}
@@ -3,6 +3,7 @@
 #include "planet.h"
 #include "player.h"
 #include "game_constants.h"
+#include <algorithm>
 
 // ============================================================================
 // KnowledgeGalaxy Implementation
@@ -11,15 +12,8 @@ KnowledgeGalaxy::KnowledgeGalaxy(const Galaxy& galaxy, PlayerID player_id)
 	: real_galaxy(&galaxy),
 	  player_id(player_id)
 {
-	// Initialize KnowledgePlanets for all planets in the galaxy
-	// Start with partial info (id, name, coordinates only)
-	knowledge_planets.reserve(galaxy.planets.size());
-	for (const auto& planet : galaxy.planets) 
-		{ knowledge_planets.emplace_back(planet, player_id); }
-	
-	// Copy distance matrix from Galaxy for O(1) local access
-	// No network latency for distance queries
-	distance_matrix = galaxy.distance_matrix;
+	// No planet records yet: they are created on first observation.
+	// Identity, distances and neighbour lists are read from the shared Galaxy.
 	
 	// Create virtual space planet for holding in-transit fleets
 	// Each player gets their own space planet to prevent cross-player conflicts
@@ -36,7 +30,7 @@ KnowledgeGalaxy::KnowledgeGalaxy(const Galaxy& galaxy, PlayerID player_id)
 	
 	// Create knowledge planet for the space planet
 	// This represents the player's knowledge view of the space planet
-	space_knowledge_planet = new KnowledgePlanet(*space_real_planet, player_id);
+	space_knowledge_planet = new KnowledgePlanet(space_real_planet->id);
 }
 
 KnowledgeGalaxy::~KnowledgeGalaxy()
@@ -51,40 +45,365 @@ KnowledgeGalaxy::~KnowledgeGalaxy()
 
 KnowledgePlanet* KnowledgeGalaxy::get_planet(uint32_t planet_id)
 {
-	if (planet_id < knowledge_planets.size()) 
+	auto it = record_slots.find(planet_id);
+	if (it == record_slots.end())
+		{ return nullptr; }
+	KnowledgePage& page = get_writable_page(it->second / KnowledgePage::CAPACITY);
+	return &page.records[it->second % KnowledgePage::CAPACITY];
+}
+
+const KnowledgePlanet* KnowledgeGalaxy::get_planet(uint32_t planet_id) const
+{
+	auto it = record_slots.find(planet_id);
+	if (it == record_slots.end())
+		{ return nullptr; }
+	return &pages[it->second / KnowledgePage::CAPACITY]->records[it->second % KnowledgePage::CAPACITY];
+}
+
+KnowledgePlanet* KnowledgeGalaxy::get_or_create_planet(uint32_t planet_id)
+{
+	KnowledgePlanet* existing = get_planet(planet_id);
+	if (existing)
+		{ return existing; }
+	
+	// Planet IDs are assigned sequentially from 1
+	if (planet_id < 1 || planet_id > get_planet_count())
+		{ return nullptr; }
+	
+	if (pages.empty() || pages.back()->records.size() == KnowledgePage::CAPACITY)
 	{
-		return &knowledge_planets[planet_id];
+		pages.push_back(std::make_unique<KnowledgePage>());
+		pages.back()->records.reserve(KnowledgePage::CAPACITY);
+		page_history.emplace_back();
+		page_dirty.push_back(0);
 	}
-	return nullptr;
+	
+	uint32_t page_index = static_cast<uint32_t>(pages.size() - 1);
+	KnowledgePage& page = get_writable_page(page_index);
+	uint32_t slot = page_index * KnowledgePage::CAPACITY + static_cast<uint32_t>(page.records.size());
+	page.records.emplace_back(planet_id);
+	record_slots.emplace(planet_id, slot);
+	return &page.records.back();
 }
 
-const KnowledgePlanet* KnowledgeGalaxy::get_planet(uint32_t planet_id) const
+KnowledgePlanet KnowledgeGalaxy::get_planet_or_unknown(uint32_t planet_id) const
 {
-	if (planet_id < knowledge_planets.size()) 
+	const KnowledgePlanet* known = get_planet(planet_id);
+	return known ? *known : KnowledgePlanet(planet_id);
+}
+
+KnowledgeGalaxy::KnowledgePage& KnowledgeGalaxy::get_writable_page(uint32_t page_index)
+{
+	if (!page_dirty[page_index])
 	{
-		return &knowledge_planets[planet_id];
+		page_dirty[page_index] = 1;
+		dirty_pages.push_back(page_index);
 	}
-	return nullptr;
+	return *pages[page_index];
+}
+
+size_t KnowledgeGalaxy::get_planet_count() const
+{
+	return real_galaxy ? real_galaxy->planets.size() : 0;
+}
+
+size_t KnowledgeGalaxy::estimate_memory_usage() const
+{
+	// Every committed version is a frozen copy of its page
+	const size_t page_bytes = sizeof(KnowledgePage) + KnowledgePage::CAPACITY * sizeof(KnowledgePlanet);
+	size_t versions = 0;
+	for (const std::vector<PageVersion>& history : page_history)
+		{ versions += history.size(); }
+	const size_t hash_node = 2 * sizeof(void*);
+
+	size_t bytes = (pages.size() + versions) * page_bytes;
+	bytes += versions * sizeof(PageVersion);
+	bytes += record_slots.size() * (sizeof(std::pair<uint32_t, uint32_t>) + hash_node);
+	bytes += colonizations.size() * (sizeof(std::pair<uint32_t, ColonizedPlanet>) + hash_node);
+	bytes += enemy_fleets.capacity() * (sizeof(FleetVisibleInfo) + sizeof(uint32_t));
+	bytes += change_log.get_byte_count();
+	bytes += (observation_age.size() + enemy_colony_age.size()) * (2 * sizeof(uint32_t) + 2 * hash_node);
+	return bytes;
 }
 
-void KnowledgeGalaxy::observe_planet(uint32_t planet_id, const Planet& real_planet, const Player* observer, int32_t current_year)
+uint32_t KnowledgeGalaxy::observe_planet(uint32_t planet_id, const Planet& real_planet, const Player* observer, int32_t current_year)
 {
-	if (planet_id < knowledge_planets.size()) 
+	// The record is updated in place; only real changes mark its page for the next snapshot
+	auto it = record_slots.find(planet_id);
+	if (it == record_slots.end())
+	{
+		if (!get_or_create_planet(planet_id))
+			{ return 0; }
+		it = record_slots.find(planet_id);
+	}
+	uint32_t slot = it->second;
+	KnowledgePlanet* known = &get_record(slot);
+	
+	uint32_t changed = known->observe_planet(real_planet, observer, current_year);
+	if (changed & ~static_cast<uint32_t>(KNOWLEDGE_OBSERVATION_YEAR))
+		{ (void)get_writable_page(slot / KnowledgePage::CAPACITY); }
+	if (changed)
+	{
+		if (changed_this_turn.size() == 0)
+			{ changed_this_turn.resize(static_cast<uint32_t>(get_planet_count()) + 1); }
+		changed_this_turn.set(planet_id);
+	}
+	
+	// Keep the staleness indexes in step with the record
+	if (changed & KNOWLEDGE_OBSERVATION_YEAR)
+		{ observation_age.update(planet_id, known->observation_year); }
+	if (changed & (KNOWLEDGE_OBSERVATION_YEAR | KNOWLEDGE_OWNER))
 	{
-		knowledge_planets[planet_id].observe_planet(real_planet, observer, current_year);
+		bool enemy_owned = known->apparent_owner != NOT_OWNED &&
+		                   known->apparent_owner != OWNER_UNKNOWN &&
+		                   known->apparent_owner != player_id;
+		if (enemy_owned)
+			{ enemy_colony_age.update(planet_id, known->observation_year); }
+		else
+			{ enemy_colony_age.remove(planet_id); }
 	}
+	
+	// Year-only refreshes are logged too (a few bytes each) so mirrors age the same way
+	if (changed)
+		{ change_log.append(KnowledgeDelta::capture(*known, changed)); }
+	return changed;
+}
+
+bool KnowledgeGalaxy::restore_planet(const KnowledgePlanet& record)
+{
+	KnowledgePlanet* known = get_or_create_planet(record.id);
+	if (!known)
+		{ return false; }
+	*known = record;
+	
+	// Same index rules as observe_planet(), applied to the saved record
+	if (known->observation_year != OBSERVATION_YEAR_UNKNOWN)
+		{ observation_age.update(known->id, known->observation_year); }
+	bool enemy_owned = known->apparent_owner != NOT_OWNED &&
+	                   known->apparent_owner != OWNER_UNKNOWN &&
+	                   known->apparent_owner != player_id;
+	if (enemy_owned)
+		{ enemy_colony_age.update(known->id, known->observation_year); }
+	return true;
 }
 
 const Planet* KnowledgeGalaxy::get_real_planet(uint32_t planet_id) const
 {
-	if (real_galaxy && planet_id < real_galaxy->planets.size()) 
+	if (real_galaxy && planet_id >= 1 && planet_id <= real_galaxy->planets.size()) 
 	{
-		return &real_galaxy->planets[planet_id];
+		return &real_galaxy->planets[planet_id - 1];
 	}
 	return nullptr;
 }
 
 double KnowledgeGalaxy::get_distance(uint32_t from_id, uint32_t to_id) const
 {
-	return distance_matrix.at(from_id).at(to_id);
+	return real_galaxy->get_distance(from_id, to_id);
+}
+
+const PlanetNeighbourGraph& KnowledgeGalaxy::get_neighbour_graph() const
+{
+	return real_galaxy->neighbour_graph;
+}
+
+const PlanetIdentity* KnowledgeGalaxy::get_planet_identity(uint32_t planet_id) const
+{
+	return real_galaxy ? real_galaxy->planet_identities.get(planet_id) : nullptr;
+}
+
+const std::string& KnowledgeGalaxy::get_planet_name(uint32_t planet_id) const
+{
+	static const std::string empty_name;
+	return real_galaxy ? real_galaxy->planet_identities.get_name(planet_id) : empty_name;
+}
+
+// ============================================================================
+// Turn Tracking and Alliance Sharing
+// ============================================================================
+
+void KnowledgeGalaxy::begin_turn(uint32_t turn)
+{
+	change_log.begin_turn(turn);
+	changed_this_turn.clear();
+}
+
+uint32_t KnowledgeGalaxy::merge_from(const KnowledgeGalaxy& ally, const Player* observer)
+{
+	if (!real_galaxy || ally.changed_this_turn.size() == 0)
+		{ return 0; }
+	if (changed_this_turn.size() == 0)
+		{ changed_this_turn.resize(static_cast<uint32_t>(get_planet_count()) + 1); }
+	
+	const KnowledgeGalaxy& self = *this;
+	const uint64_t* theirs = ally.changed_this_turn.words();
+	const uint64_t* mine = changed_this_turn.words();
+	size_t word_count = std::min(ally.changed_this_turn.word_count(), changed_this_turn.word_count());
+	uint32_t merged = 0;
+	
+	for (size_t w = 0; w < word_count; ++w)
+	{
+		// Anything we changed this turn is already as fresh as the ally's copy
+		uint64_t candidates = theirs[w] & ~mine[w];
+		while (candidates)
+		{
+			uint32_t planet_id = static_cast<uint32_t>(w * 64 + PlanetBits::lowest_bit(candidates));
+			candidates &= candidates - 1;
+			
+			const KnowledgePlanet* their_record = ally.get_planet(planet_id);
+			const KnowledgePlanet* our_record = self.get_planet(planet_id);
+			if (!their_record || (our_record && our_record->observation_year >= their_record->observation_year))
+				{ continue; }
+			
+			// The ally saw the planet this turn, so the real planet still matches what it saw;
+			// observing by proxy keeps apparent values relative to our own ideals
+			observe_planet(planet_id, real_galaxy->planets[planet_id - 1], observer, their_record->observation_year);
+			merged++;
+		}
+	}
+	return merged;
+}
+
+// ============================================================================
+// Knowledge History
+// ============================================================================
+
+void KnowledgeGalaxy::commit_snapshot(uint32_t turn)
+{
+	for (uint32_t page_index : dirty_pages)
+	{
+		std::vector<PageVersion>& history = page_history[page_index];
+		
+		// Committing the same turn again replaces that turn's version
+		auto frozen = std::make_shared<const KnowledgePage>(*pages[page_index]);
+		if (!history.empty() && history.back().turn == turn)
+			{ history.back().page = std::move(frozen); }
+		else
+			{ history.push_back(PageVersion{ turn, std::move(frozen) }); }
+		page_dirty[page_index] = 0;
+	}
+	dirty_pages.clear();
+}
+
+const KnowledgePlanet* KnowledgeGalaxy::get_planet(uint32_t planet_id, uint32_t turn) const
+{
+	auto it = record_slots.find(planet_id);
+	if (it == record_slots.end())
+		{ return nullptr; }
+	
+	uint32_t page_index = it->second / KnowledgePage::CAPACITY;
+	uint32_t record_index = it->second % KnowledgePage::CAPACITY;
+	const std::vector<PageVersion>& history = page_history[page_index];
+	
+	// Latest version committed at or before the requested turn
+	auto version = std::upper_bound(history.begin(), history.end(), turn,
+		[](uint32_t t, const PageVersion& v) { return t < v.turn; });
+	if (version == history.begin())
+		{ return nullptr; }
+	--version;
+	
+	// Records created after that version was committed were unknown at the time
+	if (record_index >= version->page->records.size())
+		{ return nullptr; }
+	return &version->page->records[record_index];
+}
+
+void KnowledgeGalaxy::discard_snapshots_before(uint32_t turn)
+{
+	for (std::vector<PageVersion>& history : page_history)
+	{
+		// Keep the version in force at 'turn' and everything after it
+		auto version = std::upper_bound(history.begin(), history.end(), turn,
+			[](uint32_t t, const PageVersion& v) { return t < v.turn; });
+		if (version != history.begin())
+			{ history.erase(history.begin(), version - 1); }
+	}
+}
+
+void KnowledgeGalaxy::freeze(FrozenKnowledge& out) const
+{
+	out.clear();
+	out.pages.reserve(pages.size());
+	out.observation_years.reserve(record_slots.size());
+	for (size_t i = 0; i < pages.size(); ++i)
+	{
+		const KnowledgePage& page = *pages[i];
+		const std::vector<PageVersion>& history = page_history[i];
+		if (!page_dirty[i] && !history.empty())
+			{ out.pages.push_back(history.back().page); }
+		else
+			{ out.pages.push_back(std::make_shared<const KnowledgePage>(page)); }
+		
+		for (const KnowledgePlanet& record : page.records)
+			{ out.observation_years.push_back(record.observation_year); }
+	}
+}
+
+void KnowledgeGalaxy::FrozenKnowledge::expand(std::vector<KnowledgePlanet>& out) const
+{
+	out.reserve(out.size() + observation_years.size());
+	for_each_record([&out](const KnowledgePlanet& record, int32_t observation_year)
+	{
+		out.push_back(record);
+		out.back().observation_year = observation_year;
+	});
+}
+
+// ============================================================================
+// Colonization Side Table
+// ============================================================================
+
+ColonizedPlanet* KnowledgeGalaxy::get_colonization(uint32_t planet_id)
+{
+	auto it = colonizations.find(planet_id);
+	return it != colonizations.end() ? &it->second : nullptr;
+}
+
+const ColonizedPlanet* KnowledgeGalaxy::get_colonization(uint32_t planet_id) const
+{
+	auto it = colonizations.find(planet_id);
+	return it != colonizations.end() ? &it->second : nullptr;
+}
+
+void KnowledgeGalaxy::set_colonization(uint32_t planet_id, const ColonizedPlanet& colonization)
+{
+	colonizations.insert_or_assign(planet_id, colonization);
+}
+
+void KnowledgeGalaxy::clear_colonization(uint32_t planet_id)
+{
+	colonizations.erase(planet_id);
+}
+
+// ============================================================================
+// Visible Enemy Fleets Side Table
+// ============================================================================
+
+FleetVisibleRange KnowledgeGalaxy::get_enemy_fleets(uint32_t planet_id) const
+{
+	auto range = std::equal_range(enemy_fleet_planet_ids.begin(), enemy_fleet_planet_ids.end(), planet_id);
+	size_t first = static_cast<size_t>(range.first - enemy_fleet_planet_ids.begin());
+	size_t count = static_cast<size_t>(range.second - range.first);
+	return FleetVisibleRange{ enemy_fleets.data() + first, count };
+}
+
+void KnowledgeGalaxy::clear_enemy_fleets()
+{
+	enemy_fleet_planet_ids.clear();
+	enemy_fleets.clear();
+}
+
+void KnowledgeGalaxy::add_visible_enemy_fleet(uint32_t planet_id, const FleetVisibleInfo& fleet_info)
+{
+	// The visibility phase adds planets in ascending order, so this is normally an append
+	if (enemy_fleet_planet_ids.empty() || enemy_fleet_planet_ids.back() <= planet_id)
+	{
+		enemy_fleet_planet_ids.push_back(planet_id);
+		enemy_fleets.push_back(fleet_info);
+		return;
+	}
+	
+	auto it = std::upper_bound(enemy_fleet_planet_ids.begin(), enemy_fleet_planet_ids.end(), planet_id);
+	size_t index = static_cast<size_t>(it - enemy_fleet_planet_ids.begin());
+	enemy_fleet_planet_ids.insert(it, planet_id);
+	enemy_fleets.insert(enemy_fleets.begin() + static_cast<std::ptrdiff_t>(index), fleet_info);
 }
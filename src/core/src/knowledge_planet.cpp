@@ -2,104 +2,62 @@
 #include "planet.h"
 #include "player.h"
 #include "game_formulas.h"
-#include <algorithm>
 
 // ============================================================================
 // KnowledgePlanet Implementation
 // ============================================================================
 
-KnowledgePlanet::KnowledgePlanet(const Planet& planet, PlayerID player_id)
-	: id(planet.id),
-	  name(planet.name),
-	  x(planet.x),
-	  y(planet.y),
-	  as_seen_by(player_id),
-	  nova_state(PLANET_NORMAL)
+KnowledgePlanet::KnowledgePlanet(uint32_t planet_id)
 {
 	// Initialize observable fields with unknown values
 	apparent_temperature = UNKNOWN_DOUBLE_VALUE;
 	apparent_gravity = UNKNOWN_DOUBLE_VALUE;
+	id = planet_id;
 	metal = UNKNOWN_INT_VALUE;
 	apparent_owner = OWNER_UNKNOWN;
 	apparent_population = POPULATION_UNKNOWN;
 	observation_year = OBSERVATION_YEAR_UNKNOWN;
 	can_be_profitable = PROFITABILITY_UNKNOWN;
 	perceived_value = PERCEIVED_VALUE_UNKNOWN;
+	nova_state = PLANET_NORMAL;
 }
 
-void KnowledgePlanet::observe_planet(const Planet& planet, const Player* observer, int32_t current_year)
+namespace
+{
+	// Write value into field if it differs, recording the field's bit in changed
+	template<typename T>
+	void update_field(T& field, const T& value, uint32_t bit, uint32_t& changed)
+	{
+		if (field != value)
+		{
+			field = value;
+			changed |= bit;
+		}
+	}
+}
+
+uint32_t KnowledgePlanet::observe_planet(const Planet& planet, const Player* observer, int32_t current_year)
 {
 	// Update observable fields based on current planet state
 	// Note: nova_state is NOT updated by this method
+	uint32_t changed = 0;
 	
 	// Calculate apparent values based on the observing player's ideals
-	apparent_temperature = GameFormulas::calculate_apparent_temperature(
-		observer->get_ideal_temperature(), planet.true_temperature);
-	apparent_gravity = GameFormulas::calculate_apparent_gravity(
-		observer->get_ideal_gravity(), planet.true_gravity);
+	update_field(apparent_temperature, GameFormulas::calculate_apparent_temperature(
+		observer->get_ideal_temperature(), planet.true_temperature), KNOWLEDGE_TEMPERATURE, changed);
+	update_field(apparent_gravity, GameFormulas::calculate_apparent_gravity(
+		observer->get_ideal_gravity(), planet.true_gravity), KNOWLEDGE_GRAVITY, changed);
 	
 	// Known fields from planet
-	metal = planet.metal;
-	apparent_owner = planet.owner;
-	apparent_population = planet.population;  // Copy actual population
+	update_field(metal, planet.metal, KNOWLEDGE_METAL, changed);
+	update_field(apparent_owner, planet.owner, KNOWLEDGE_OWNER, changed);
+	update_field(apparent_population, planet.population, KNOWLEDGE_POPULATION, changed);  // Copy actual population
 	
 	// Unknown fields (not available from Planet)
-	observation_year = current_year;
-	can_be_profitable = PROFITABILITY_UNKNOWN;
-	perceived_value = PERCEIVED_VALUE_UNKNOWN;
-}
-
-
-// ============================================================================
-// Fleet Management Methods
-// ============================================================================
-
-void KnowledgePlanet::add_my_fleet(Fleet* fleet)
-{
-	if (!fleet)
-		return;
-	
-	// Check if fleet is already in the list to avoid duplicates
-	for (const auto& existing_fleet : my_fleets)
-	{
-		if (existing_fleet && existing_fleet->id == fleet->id)
-			return;  // Fleet already added
-	}
+	update_field(observation_year, current_year, KNOWLEDGE_OBSERVATION_YEAR, changed);
+	update_field(can_be_profitable, PROFITABILITY_UNKNOWN, KNOWLEDGE_PROFITABILITY, changed);
+	update_field(perceived_value, PERCEIVED_VALUE_UNKNOWN, KNOWLEDGE_PERCEIVED_VALUE, changed);
 	
-	my_fleets.push_back(fleet);
+	return changed;
 }
 
-void KnowledgePlanet::remove_my_fleet(uint32_t fleet_id)
-{
-	auto it = std::find_if(my_fleets.begin(), my_fleets.end(),
-		[fleet_id](const Fleet* fleet) { return fleet && fleet->id == fleet_id; });
-	
-	if (it != my_fleets.end())
-		my_fleets.erase(it);
-}
-
-void KnowledgePlanet::add_visible_enemy_fleet(const FleetVisibleInfo& fleet_info)
-{
-	// Check if fleet is already in the list to avoid duplicates
-	for (const auto& existing_fleet : enemy_fleets)
-	{
-		if (existing_fleet.fleet_id == fleet_info.fleet_id)
-			return;  // Fleet already added
-	}
-	
-	enemy_fleets.push_back(fleet_info);
-}
-
-void KnowledgePlanet::remove_visible_enemy_fleet(uint32_t fleet_id)
-{
-	auto it = std::find_if(enemy_fleets.begin(), enemy_fleets.end(),
-		[fleet_id](const FleetVisibleInfo& fleet) { return fleet.fleet_id == fleet_id; });
-	
-	if (it != enemy_fleets.end())
-		enemy_fleets.erase(it);
-}
-
-void KnowledgePlanet::clear_enemy_fleets()
-{
-	enemy_fleets.clear();
-}
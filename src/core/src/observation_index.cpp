@@ -0,0 +1,63 @@
+#include "observation_index.h"
+#include "enums.h"
+
+// ============================================================================
+// ObservationAgeIndex Implementation
+// ============================================================================
+
+void ObservationAgeIndex::update(uint32_t planet_id, int32_t observation_year)
+{
+	auto it = entries.find(planet_id);
+	if (it != entries.end())
+	{
+		if (it->second.year == observation_year)
+			{ return; }
+		remove(planet_id);
+	}
+
+	std::vector<uint32_t>& bucket = buckets[observation_year];
+	entries[planet_id] = Entry{ observation_year, static_cast<uint32_t>(bucket.size()) };
+	bucket.push_back(planet_id);
+}
+
+void ObservationAgeIndex::remove(uint32_t planet_id)
+{
+	auto it = entries.find(planet_id);
+	if (it == entries.end())
+		{ return; }
+
+	auto bucket_it = buckets.find(it->second.year);
+	std::vector<uint32_t>& bucket = bucket_it->second;
+	uint32_t position = it->second.position;
+
+	// Swap-remove, fixing up the moved planet's position
+	uint32_t moved = bucket.back();
+	bucket[position] = moved;
+	bucket.pop_back();
+	if (moved != planet_id)
+		{ entries[moved].position = position; }
+
+	entries.erase(it);
+	if (bucket.empty())
+		{ buckets.erase(bucket_it); }
+}
+
+void ObservationAgeIndex::collect_observed_before(int32_t year, size_t max_count, std::vector<uint32_t>& out) const
+{
+	size_t added = 0;
+	for (auto it = buckets.begin(); it != buckets.end() && it->first < year; ++it)
+	{
+		for (uint32_t planet_id : it->second)
+		{
+			if (added == max_count)
+				{ return; }
+			out.push_back(planet_id);
+			added++;
+		}
+	}
+}
+
+int32_t ObservationAgeIndex::get_oldest_year() const
+{
+	return buckets.empty() ? OBSERVATION_YEAR_UNKNOWN : buckets.begin()->first;
+}
@@ -0,0 +1,27 @@
+#include "planet_identity.h"
+
+// ============================================================================
+// PlanetIdentityTable Implementation
+// ============================================================================
+
+void PlanetIdentityTable::build(const std::vector<Planet>& planets)
+{
+	entries.clear();
+	names.clear();
+	entries.reserve(planets.size());
+	names.reserve(planets.size());
+
+	for (const Planet& planet : planets)
+	{
+		entries.push_back(PlanetIdentity{ planet.id, planet.x, planet.y });
+		names.push_back(planet.name);
+	}
+}
+
+const std::string& PlanetIdentityTable::get_name(uint32_t planet_id) const
+{
+	static const std::string empty_name;
+	if (planet_id < 1 || planet_id > names.size())
+		{ return empty_name; }
+	return names[planet_id - 1];
+}
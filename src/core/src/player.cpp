@@ -98,7 +98,10 @@ uint32_t Player::build_fleet(uint32_t fleet_id, uint32_t design_id, uint32_t shi
 	// Create fleet using private constructor (Player is a friend of Fleet)
 	Fleet new_fleet(fleet_id, id, design, ship_count, planet);
 	
+	fleet_index[fleet_id] = fleets.size();
 	fleets.push_back(std::move(new_fleet));
+	game_state->get_fleet_occupancy().add_fleet(planet_id, id, fleet_id);
+	fleet_power += get_fleet_power_of(fleets.back());
 	//
 	return fleet_id;
 }
@@ -118,34 +121,53 @@ uint32_t Player::create_fleet(uint32_t design_id, uint32_t ship_count, uint32_t
 
 Fleet* Player::get_fleet(uint32_t fleet_id)
 {
-	for (auto& fleet : fleets)
-	{
-		if (fleet.id == fleet_id)
-			{ return &fleet; }
-	}
-	return nullptr;
+	auto it = fleet_index.find(fleet_id);
+	if (it == fleet_index.end())
+		{ return nullptr; }
+	return &fleets[it->second];
 }
 const Fleet* Player::get_fleet(uint32_t fleet_id) const
 {
-	for (const auto& fleet : fleets)
-	{
-		if (fleet.id == fleet_id)
-			{ return &fleet; }
-	}
-	return nullptr;
+	auto it = fleet_index.find(fleet_id);
+	if (it == fleet_index.end())
+		{ return nullptr; }
+	return &fleets[it->second];
 }
 
 bool Player::delete_fleet(uint32_t fleet_id)
 {
-	for (size_t i = 0; i < fleets.size(); ++i)
-	{
-		if (fleets[i].id == fleet_id)
-		{
-			fleets.erase(fleets.begin() + i);
-			return true;
-		}
-	}
-	return false;
+	auto it = fleet_index.find(fleet_id);
+	if (it == fleet_index.end())
+		{ return false; }
+	
+	size_t i = it->second;
+	fleet_index.erase(it);
+	
+	// Stationed fleets leave the occupancy index; fleets in transit are not in it
+	if (game_state && !fleets[i].is_in_transit() && fleets[i].current_planet)
+		{ game_state->get_fleet_occupancy().remove_fleet(fleets[i].current_planet->id, id, fleet_id); }
+	fleet_power -= get_fleet_power_of(fleets[i]);
+	
+	// Keep the build order (it decides the order of turn processing); later fleets move down one
+	fleets.erase(fleets.begin() + i);
+	for (size_t j = i; j < fleets.size(); ++j)
+		{ fleet_index[fleets[j].id] = j; }
+	return true;
+}
+
+void Player::set_fleet_ship_count(Fleet& fleet, uint32_t ship_count)
+{
+	fleet_power -= get_fleet_power_of(fleet);
+	fleet.ship_count = ship_count;
+	fleet_power += get_fleet_power_of(fleet);
+}
+
+int64_t Player::get_fleet_power_of(const Fleet& fleet)
+{
+	if (!fleet.ship_design)
+		{ return 0; }
+	return static_cast<int64_t>(fleet.ship_count)
+	     * GameFormulas::calculate_ship_power(fleet.ship_design->get_weapons(), fleet.ship_design->get_shields());
 }
 
 void Player::move_fleet(uint32_t fleet_id, uint32_t destination_planet_id)
@@ -155,6 +177,10 @@ void Player::move_fleet(uint32_t fleet_id, uint32_t destination_planet_id)
 	if (!fleet)
 		{ return; }  // Fleet not found
 	
+	// A fleet already in transit cannot be redirected
+	if (fleet->is_in_transit())
+		{ return; }
+	
 	// Validate destination planet exists
 	if (!game_state)
 		{ return; }  // No game state reference
@@ -172,43 +198,205 @@ void Player::move_fleet(uint32_t fleet_id, uint32_t destination_planet_id)
 	
 	// Delegate to Fleet::move_to() to initiate movement
 	// This creates FleetTransit and moves fleet to space planet
+	uint32_t origin_id = fleet->current_planet ? fleet->current_planet->id : 0;
 	fleet->move_to(destination, knowledge_galaxy, current_turn);
+	
+	// Departed fleets are no longer stationed at their origin
+	if (fleet->is_in_transit())
+		{ game_state->get_fleet_occupancy().remove_fleet(origin_id, id, fleet_id); }
 }
 
 std::vector<Fleet*> Player::get_fleets_in_transit()
 {
 	std::vector<Fleet*> result;
+	for (auto& fleet : fleets)
+	{
+		if (fleet.is_in_transit())
+			{ result.push_back(&fleet); }
+	}
+	return result;
+}
+
+const std::vector<const Fleet*> Player::get_fleets_in_transit() const
+{
+	std::vector<const Fleet*> result;
+	for (const auto& fleet : fleets)
+	{
+		if (fleet.is_in_transit())
+			{ result.push_back(&fleet); }
+	}
+	return result;
+}
+
+
+// ============================================================================
+// Route Planning
+// ============================================================================
+
+bool Player::plan_fleet_route(uint32_t fleet_id, uint32_t destination_planet_id, RouteMode mode, Route& route)
+{
+	route.found = false;
+	route.waypoints.clear();
 	
-	if (!knowledge_galaxy)
-		return result;
+	const Fleet* fleet = get_fleet(fleet_id);
+	if (!fleet || fleet->is_in_transit() || !fleet->current_planet || !fleet->ship_design)
+		{ return false; }
 	
-	KnowledgePlanet* space_planet = knowledge_galaxy->get_space_knowledge_planet();
-	if (!space_planet)
-		return result;
+	RouteQuery query;
+	query.origin_planet_id = fleet->current_planet->id;
+	query.destination_planet_id = destination_planet_id;
+	query.start_fuel = fleet->get_available_fuel();
+	query.max_fuel = fleet->uses_fuel() ? fleet->ship_design->get_range() : INT32_MAX;
+	query.ship_range = fleet->ship_design->get_range();
+	query.mode = mode;
 	
-	// Get the fleet list from the space knowledge planet
-	return space_planet->my_fleets;
+	return plan_route(query, route);
 }
 
-const std::vector<const Fleet*> Player::get_fleets_in_transit() const
+bool Player::plan_route(const RouteQuery& query, Route& route)
 {
-	std::vector<const Fleet*> result;
+	if (!knowledge_galaxy)
+	{
+		route.found = false;
+		route.waypoints.clear();
+		return false;
+	}
+	
+	return route_planner.plan(*knowledge_galaxy, query, refuel_planets, route);
+}
+
+
+// ============================================================================
+// Knowledge Staleness
+// ============================================================================
+
+void Player::get_stale_planets(uint32_t min_turns_unseen, size_t max_count, std::vector<uint32_t>& out) const
+{
+	if (!knowledge_galaxy || !game_state)
+		{ return; }
 	
+	// Observed in or before this year = unseen for at least min_turns_unseen turns
+	int64_t cutoff = static_cast<int64_t>(game_state->get_current_year()) -
+	                 static_cast<int64_t>(min_turns_unseen) * GameConstants::Years_Per_Turn;
+	knowledge_galaxy->get_planets_observed_before(static_cast<int32_t>(cutoff + 1), max_count, out);
+}
+
+void Player::get_oldest_enemy_colonies(size_t max_count, std::vector<uint32_t>& out) const
+{
+	if (!knowledge_galaxy)
+		{ return; }
+	knowledge_galaxy->get_oldest_enemy_colonies(max_count, out);
+}
+
+
+// ============================================================================
+// Reachability
+// ============================================================================
+
+void Player::rebuild_reachability()
+{
 	if (!knowledge_galaxy)
-		return result;
+		{ return; }
+	
+	uint32_t bit_count = static_cast<uint32_t>(knowledge_galaxy->get_planet_count()) + 1;
+	refuel_planets.resize(bit_count);
+	refuel_planets.clear();
+	reachable_planets.resize(bit_count);
+	reachable_planets.clear();
+	reach_coverage.assign(bit_count, 0);
+	reach_range = tech.range;
+	
+	for (const auto& colony : colonized_planets)
+	{
+		refuel_planets.set(colony.get_id());
+		adjust_reach_coverage(colony.get_id(), -1.0, reach_range, +1);
+	}
+}
+
+void Player::on_colony_gained(uint32_t planet_id)
+{
+	for (auto it = colonized_planets.rbegin(); it != colonized_planets.rend(); ++it)
+	{
+		if (it->get_id() == planet_id)
+		{
+			victory_points += GameFormulas::calculate_colony_victory_points(it->get_population());
+			break;
+		}
+	}
 	
-	const KnowledgePlanet* space_planet = knowledge_galaxy->get_space_knowledge_planet();
-	if (!space_planet)
-		return result;
+	// Before the knowledge galaxy exists, rebuild_reachability() picks the colony up
+	if (!knowledge_galaxy || reach_coverage.empty())
+		{ return; }
 	
-	// Get the fleet list from the space knowledge planet
-	// Convert mutable pointers to const pointers
-	for (const auto& fleet_ptr : space_planet->my_fleets)
+	refuel_planets.set(planet_id);
+	adjust_reach_coverage(planet_id, -1.0, reach_range, +1);
+}
+
+void Player::on_colony_lost(uint32_t planet_id)
+{
+	for (const ColonizedPlanet& colony : colonized_planets)
 	{
-		result.push_back(fleet_ptr);
+		if (colony.get_id() == planet_id)
+		{
+			victory_points -= GameFormulas::calculate_colony_victory_points(colony.get_population());
+			break;
+		}
 	}
 	
-	return result;
+	if (!knowledge_galaxy || reach_coverage.empty())
+		{ return; }
+	
+	refuel_planets.reset(planet_id);
+	adjust_reach_coverage(planet_id, -1.0, reach_range, -1);
+}
+
+void Player::on_colony_population_changed(int32_t old_population, int32_t new_population)
+{
+	victory_points += GameFormulas::calculate_colony_victory_points(new_population)
+	                - GameFormulas::calculate_colony_victory_points(old_population);
+}
+
+void Player::on_range_advanced(int32_t new_range)
+{
+	if (!knowledge_galaxy || reach_coverage.empty() || new_range == reach_range)
+		{ return; }
+	
+	// Only the ring of planets between the old and new range changes
+	for (const auto& colony : colonized_planets)
+	{
+		if (new_range > reach_range)
+			{ adjust_reach_coverage(colony.get_id(), reach_range, new_range, +1); }
+		else
+			{ adjust_reach_coverage(colony.get_id(), new_range, reach_range, -1); }
+	}
+	reach_range = new_range;
+}
+
+void Player::adjust_reach_coverage(uint32_t planet_id, double min_exclusive, double max_inclusive, int32_t delta)
+{
+	// The colony itself counts as reachable
+	if (min_exclusive < 0.0)
+	{
+		reach_coverage[planet_id] += delta;
+		if (reach_coverage[planet_id] > 0)
+			{ reachable_planets.set(planet_id); }
+		else
+			{ reachable_planets.reset(planet_id); }
+	}
+	
+	// Neighbours are sorted by distance, so the ring is a contiguous slice
+	const PlanetNeighbourGraph& graph = knowledge_galaxy->get_neighbour_graph();
+	PlanetNeighbourGraph::NeighbourRange inner = graph.get_neighbours_within(planet_id, min_exclusive);
+	PlanetNeighbourGraph::NeighbourRange outer = graph.get_neighbours_within(planet_id, max_inclusive);
+	for (uint32_t i = inner.count; i < outer.count; ++i)
+	{
+		uint32_t id = outer.ids[i];
+		reach_coverage[id] += delta;
+		if (reach_coverage[id] > 0)
+			{ reachable_planets.set(id); }
+		else
+			{ reachable_planets.reset(id); }
+	}
 }
 
 
@@ -259,54 +447,12 @@ bool Player::delete_ship_design(uint32_t design_id)
 }
 
 // ============================================================================
-// Player Info History Management
+// Public Player History
 // ============================================================================
 
-void Player::receive_player_public_info(uint32_t source_player_id, const PlayerPublicInfo& info)
-{
-	// Append the new info to the history for this player
-	player_info_history[source_player_id].push_back(info);
-}
-
-const std::vector<PlayerPublicInfo>* Player::get_player_info_history(uint32_t player_id) const
-{
-	auto it = player_info_history.find(player_id);
-	if (it != player_info_history.end())
-	return &it->second;
-	
-	return nullptr;
-}
-
-bool Player::validate_player_info_history(uint32_t player_id) const
-{
-	auto it = player_info_history.find(player_id);
-	if (it == player_info_history.end())
-		{ return false; }  // No history for this player
-
-	const auto& history = it->second;
-	if (history.empty())
-		{ return false; }  // Empty history
-	
-	// Check for consistency: each entry should have sequential years
-	for (size_t i = 1; i < history.size(); ++i)
-	{
-		// Year should be sequential
-		if (history[i].year != history[i-1].year + 1)
-			{ return false; }
-		
-		// Player ID should be consistent
-		if (history[i].player_id != history[i-1].player_id)
-			{ return false; }
-	}
-	return true;
-}
-
-void Player::request_full_player_info_resync(uint32_t player_id)
+const PlayerHistoryStore& Player::get_public_history() const
 {
-	// This is a placeholder - in a real implementation, this would
-	// communicate with GameState to request a full resync
-	// For now, we just clear the history for this player
-	player_info_history[player_id].clear();
+	return game_state->get_player_history();
 }
 
 
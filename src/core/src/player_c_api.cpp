@@ -68,23 +68,6 @@ ErrorCode player_get_spending_allocation(
 	return ErrorCode::SUCCESS;
 }
 
-// ============================================================================
-// Player Spending Allocation
-// ============================================================================
-
-ErrorCode player_set_spending_allocation(
-	Player* player,
-	double savings_fraction,
-	double research_fraction,
-	double planets_fraction)
-{
-	if (!player)
-		return ErrorCode::INVALID_PARAMETER;
-	
-	// TODO: Implement validation and setting
-	return ErrorCode::SUCCESS;
-}
-
 // ============================================================================
 // Ship Design Management
 // ============================================================================
@@ -111,42 +94,6 @@ const ShipDesign* const* player_get_all_ship_designs(const Player* player)
 	return nullptr;
 }
 
-uint32_t player_design_ship(
-	Player* player,
-	const char* name,
-	uint32_t ship_type,
-	int32_t tech_range,
-	int32_t tech_speed,
-	int32_t tech_weapons,
-	int32_t tech_shields,
-	int32_t tech_miniaturization)
-{
-	if (!player || !name)
-		return 0;
-	
-	// TODO: Implement with validation
-	return player->create_ship_design(
-		std::string(name),
-		static_cast<ShipType>(ship_type),
-		tech_range,
-		tech_speed,
-		tech_weapons,
-		tech_shields,
-		tech_miniaturization
-	);
-}
-
-ErrorCode player_delete_ship_design(Player* player, uint32_t design_id)
-{
-	if (!player)
-		return ErrorCode::INVALID_PLAYER_ID;
-	
-	if (!player->delete_ship_design(design_id))
-		return ErrorCode::SHIP_DESIGN_NOT_FOUND;
-	
-	return ErrorCode::SUCCESS;
-}
-
 // ============================================================================
 // Fleet Management
 // ============================================================================
@@ -173,50 +120,6 @@ const Fleet* const* player_get_all_fleets(const Player* player)
 	return nullptr;
 }
 
-uint32_t player_build_fleet(
-	Player* player,
-	uint32_t design_id,
-	uint32_t ship_count,
-	uint32_t planet_id)
-{
-	if (!player)
-		return 0;
-	
-	// TODO: Implement with validation
-	// Note: Fleet ID allocation happens in Player::create_fleet via GameState
-	return 0;
-}
-
-ErrorCode player_delete_fleet(Player* player, uint32_t fleet_id)
-{
-	if (!player)
-		return ErrorCode::INVALID_PLAYER_ID;
-	
-	if (!player->delete_fleet(fleet_id))
-		return ErrorCode::FLEET_NOT_FOUND;
-	
-	return ErrorCode::SUCCESS;
-}
-
-ErrorCode player_move_fleet(Player* player, uint32_t fleet_id, uint32_t destination_planet_id)
-{
-	if (!player)
-		return ErrorCode::INVALID_PLAYER_ID;
-	
-	// TODO: Implement with validation
-	player->move_fleet(fleet_id, destination_planet_id);
-	return ErrorCode::SUCCESS;
-}
-
-ErrorCode player_refuel_fleet(Player* player, uint32_t fleet_id)
-{
-	if (!player)
-		return ErrorCode::INVALID_PLAYER_ID;
-	
-	// TODO: Implement with validation
-	return ErrorCode::SUCCESS;
-}
-
 // ============================================================================
 // Colonized Planet Management
 // ============================================================================
@@ -243,19 +146,6 @@ const ColonizedPlanet* const* player_get_all_colonized_planets(const Player* pla
 	return nullptr;
 }
 
-ErrorCode player_set_planet_allocation(
-	Player* player,
-	uint32_t planet_id,
-	double mining_fraction,
-	double terraforming_fraction)
-{
-	if (!player)
-		return ErrorCode::INVALID_PLAYER_ID;
-	
-	// TODO: Implement with validation
-	return ErrorCode::SUCCESS;
-}
-
 // ============================================================================
 // Technology & Research (Read-Only)
 // ============================================================================
@@ -292,3 +182,33 @@ double player_get_research_allocation(const Player* player, uint32_t tech_type)
 			return -1.0;
 	}
 }
+
+// ============================================================================
+// Reachability (Read-Only)
+// ============================================================================
+
+const uint64_t* player_get_reachable_planet_words(const Player* player, uint32_t* word_count)
+{
+	if (!player || !word_count)
+		return nullptr;
+	
+	const PlanetBitset& reachable = player->get_reachable_planets();
+	*word_count = static_cast<uint32_t>(reachable.word_count());
+	return reachable.word_count() ? reachable.words() : nullptr;
+}
+
+uint32_t player_get_reachable_planet_count(const Player* player)
+{
+	if (!player)
+		return 0;
+	
+	return player->get_reachable_planets().count();
+}
+
+int player_is_planet_reachable(const Player* player, uint32_t planet_id)
+{
+	if (!player)
+		return 0;
+	
+	return player->get_reachable_planets().test(planet_id) ? 1 : 0;
+}
@@ -0,0 +1,133 @@
+#include "player_history.h"
+#include <algorithm>
+
+// ============================================================================
+// PlayerHistoryStore Implementation
+// ============================================================================
+
+void PlayerHistoryStore::reset(const std::vector<uint32_t>& ids, size_t retained)
+{
+	player_ids = ids;
+	retained_turns = retained;
+	turns.clear();
+	years.clear();
+	columns.assign(player_ids.size() * METRIC_COUNT, std::vector<int64_t>());
+}
+
+bool PlayerHistoryStore::begin_turn(uint32_t turn, uint32_t year)
+{
+	if (!turns.empty() && turn == turns.back())
+	{
+		// Re-capture of the same turn: overwrite the last row in place
+		years.back() = year;
+		return true;
+	}
+
+	if (!turns.empty() && turn > turns.back() + 1)
+		{ return false; }
+
+	if (!turns.empty() && turn < turns.back())
+	{
+		// Going back (a restored or replayed turn): keep only the rows before it
+		size_t keep = turn < turns.front() ? 0 : row_of(turn);
+		turns.resize(keep);
+		years.resize(keep);
+		for (std::vector<int64_t>& column : columns)
+			{ column.resize(keep); }
+	}
+
+	turns.push_back(turn);
+	years.push_back(year);
+	for (std::vector<int64_t>& column : columns)
+		{ column.push_back(0); }
+
+	trim();
+	return true;
+}
+
+void PlayerHistoryStore::trim()
+{
+	if (retained_turns == 0 || turns.size() < 2 * retained_turns)
+		{ return; }
+
+	size_t drop = turns.size() - retained_turns;
+	turns.erase(turns.begin(), turns.begin() + drop);
+	years.erase(years.begin(), years.begin() + drop);
+	for (std::vector<int64_t>& column : columns)
+		{ column.erase(column.begin(), column.begin() + drop); }
+}
+
+size_t PlayerHistoryStore::find_player(uint32_t player_id) const
+{
+	auto it = std::find(player_ids.begin(), player_ids.end(), player_id);
+	return it == player_ids.end() ? SIZE_MAX : static_cast<size_t>(it - player_ids.begin());
+}
+
+MetricSpan PlayerHistoryStore::get_metric(size_t player_index, PlayerMetric metric) const
+{
+	if (player_index >= player_ids.size() || metric >= METRIC_COUNT)
+		{ return MetricSpan{ nullptr, 0, 0 }; }
+
+	const std::vector<int64_t>& column = columns[player_index * METRIC_COUNT + metric];
+	return MetricSpan{ column.data(), column.size(), get_first_turn() };
+}
+
+MetricSpan PlayerHistoryStore::get_metric_range(size_t player_index, PlayerMetric metric, uint32_t first_turn, uint32_t last_turn) const
+{
+	if (turns.empty() || first_turn > last_turn)
+		{ return MetricSpan{ nullptr, 0, first_turn }; }
+
+	first_turn = std::max(first_turn, turns.front());
+	last_turn = std::min(last_turn, turns.back());
+	if (first_turn > last_turn)
+		{ return MetricSpan{ nullptr, 0, first_turn }; }
+
+	MetricSpan all = get_metric(player_index, metric);
+	if (all.empty())
+		{ return all; }
+	return MetricSpan{ all.first + row_of(first_turn), static_cast<size_t>(last_turn - first_turn) + 1, first_turn };
+}
+
+bool PlayerHistoryStore::get_row(size_t player_index, uint32_t turn, PlayerPublicInfo& out) const
+{
+	if (player_index >= player_ids.size() || !contains_turn(turn))
+		{ return false; }
+
+	size_t row = row_of(turn);
+	const std::vector<int64_t>* player_columns = &columns[player_index * METRIC_COUNT];
+
+	out.player_id = player_ids[player_index];
+	out.year = years[row];
+	out.turn = turn;
+	out.tech_range = static_cast<int32_t>(player_columns[METRIC_TECH_RANGE][row]);
+	out.tech_speed = static_cast<int32_t>(player_columns[METRIC_TECH_SPEED][row]);
+	out.tech_weapons = static_cast<int32_t>(player_columns[METRIC_TECH_WEAPONS][row]);
+	out.tech_shields = static_cast<int32_t>(player_columns[METRIC_TECH_SHIELDS][row]);
+	out.tech_mini = static_cast<int32_t>(player_columns[METRIC_TECH_MINI][row]);
+	out.money_income = player_columns[METRIC_MONEY_INCOME][row];
+	out.money_savings = player_columns[METRIC_MONEY_SAVINGS][row];
+	out.metal_savings = player_columns[METRIC_METAL_SAVINGS][row];
+	out.planets_owned = static_cast<uint32_t>(player_columns[METRIC_PLANETS_OWNED][row]);
+	out.ship_power = player_columns[METRIC_SHIP_POWER][row];
+	out.victory_points = static_cast<int32_t>(player_columns[METRIC_VICTORY_POINTS][row]);
+	return true;
+}
+
+bool PlayerHistoryStore::validate() const
+{
+	if (years.size() != turns.size() || columns.size() != player_ids.size() * METRIC_COUNT)
+		{ return false; }
+
+	for (size_t i = 1; i < turns.size(); ++i)
+	{
+		if (turns[i] != turns[i - 1] + 1)
+			{ return false; }
+	}
+
+	for (const std::vector<int64_t>& column : columns)
+	{
+		if (column.size() != turns.size())
+			{ return false; }
+	}
+	return true;
+}
@@ -1,5 +1,210 @@
 #include "rng.h"
 #include <algorithm>
+#include <charconv>
+#include <limits>
+
+namespace
+{
+	constexpr size_t MT_N = RNGStateFormat::STATE_WORDS;
+	constexpr size_t MT_M = 156;
+	constexpr uint64_t MT_A = 0xB5026F5AA96619E9ULL;
+	constexpr uint64_t MT_F = 6364136223846793005ULL;
+	constexpr uint64_t UPPER_MASK = ~0ULL << 31;
+	constexpr uint64_t LOWER_MASK = ~UPPER_MASK;
+
+	void store_le(uint8_t* out, uint64_t value, size_t bytes)
+	{
+		for (size_t i = 0; i < bytes; ++i)
+			{ out[i] = static_cast<uint8_t>(value >> (8 * i)); }
+	}
+
+	uint64_t load_le(const uint8_t* in, size_t bytes)
+	{
+		uint64_t value = 0;
+		for (size_t i = 0; i < bytes; ++i)
+			{ value |= static_cast<uint64_t>(in[i]) << (8 * i); }
+		return value;
+	}
+
+	// Philox4x32 multipliers and Weyl key increments (Random123)
+	constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+	constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+	constexpr uint32_t PHILOX_W0 = 0x9E3779B9;
+	constexpr uint32_t PHILOX_W1 = 0xBB67AE85;
+
+	inline void philox_round(uint32_t c[4], const uint32_t k[2])
+	{
+		uint64_t product0 = static_cast<uint64_t>(PHILOX_M0) * c[0];
+		uint64_t product1 = static_cast<uint64_t>(PHILOX_M1) * c[2];
+		c[0] = static_cast<uint32_t>(product1 >> 32) ^ c[1] ^ k[0];
+		c[1] = static_cast<uint32_t>(product1);
+		c[2] = static_cast<uint32_t>(product0 >> 32) ^ c[3] ^ k[1];
+		c[3] = static_cast<uint32_t>(product0);
+	}
+}
+
+// ============================================================================
+// MersenneTwister64 Implementation
+// ============================================================================
+
+void MersenneTwister64::seed(uint64_t value)
+{
+	// Same seeding and state normalization as Boost, so sequences match
+	state[0] = value;
+	for (size_t i = 1; i < MT_N; ++i)
+		{ state[i] = MT_F * (state[i - 1] ^ (state[i - 1] >> 62)) + i; }
+	index = MT_N;
+
+	uint64_t y0 = state[MT_M - 1] ^ state[MT_N - 1];
+	y0 = (y0 >> 63) ? ((y0 ^ MT_A) << 1) | 1 : y0 << 1;
+	state[0] = (state[0] & UPPER_MASK) | (y0 & LOWER_MASK);
+
+	if (std::all_of(state, state + MT_N, [](uint64_t word) { return word == 0; }))
+		{ state[0] = 1ULL << 63; }
+}
+
+void MersenneTwister64::twist()
+{
+	for (size_t j = 0; j < MT_N - MT_M; ++j)
+	{
+		uint64_t y = (state[j] & UPPER_MASK) | (state[j + 1] & LOWER_MASK);
+		state[j] = state[j + MT_M] ^ (y >> 1) ^ ((state[j + 1] & 1) * MT_A);
+	}
+	for (size_t j = MT_N - MT_M; j < MT_N - 1; ++j)
+	{
+		uint64_t y = (state[j] & UPPER_MASK) | (state[j + 1] & LOWER_MASK);
+		state[j] = state[j - (MT_N - MT_M)] ^ (y >> 1) ^ ((state[j + 1] & 1) * MT_A);
+	}
+	uint64_t y = (state[MT_N - 1] & UPPER_MASK) | (state[0] & LOWER_MASK);
+	state[MT_N - 1] = state[MT_M - 1] ^ (y >> 1) ^ ((state[0] & 1) * MT_A);
+	index = 0;
+}
+
+void MersenneTwister64::write_state(uint8_t* out) const
+{
+	store_le(out, RNGStateFormat::MAGIC, 4);
+	store_le(out + 4, RNGStateFormat::VERSION, 2);
+	store_le(out + 6, 0, 2);
+	store_le(out + 8, index, 4);
+	store_le(out + 12, 0, 4);
+	uint8_t* words = out + RNGStateFormat::HEADER_SIZE;
+	for (size_t i = 0; i < MT_N; ++i)
+		{ store_le(words + 8 * i, state[i], 8); }
+}
+
+bool MersenneTwister64::read_state(const uint8_t* data, size_t size)
+{
+	if (size < 4 || load_le(data, 4) != RNGStateFormat::MAGIC)
+		{ return read_text_state(data, size); }
+
+	if (size != RNGStateFormat::SIZE || load_le(data + 4, 2) != RNGStateFormat::VERSION)
+		{ return false; }
+	uint32_t position = static_cast<uint32_t>(load_le(data + 8, 4));
+	if (position > MT_N)
+		{ return false; }
+
+	const uint8_t* words = data + RNGStateFormat::HEADER_SIZE;
+	for (size_t i = 0; i < MT_N; ++i)
+		{ state[i] = load_le(words + 8 * i, 8); }
+	index = position;
+	return true;
+}
+
+bool MersenneTwister64::read_text_state(const uint8_t* data, size_t size)
+{
+	// Boost's stream form: the state words in decimal, read back as a fresh twist
+	uint64_t words[MT_N];
+	const char* cursor = reinterpret_cast<const char*>(data);
+	const char* end = cursor + size;
+	for (size_t i = 0; i < MT_N; ++i)
+	{
+		while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\t' || *cursor == '\r'))
+			{ ++cursor; }
+		std::from_chars_result result = std::from_chars(cursor, end, words[i]);
+		if (result.ec != std::errc())
+			{ return false; }
+		cursor = result.ptr;
+	}
+
+	std::copy(words, words + MT_N, state);
+	index = MT_N;
+	return true;
+}
+
+bool MersenneTwister64::operator==(const MersenneTwister64& other) const
+{
+	return index == other.index && std::equal(state, state + MT_N, other.state);
+}
+
+// ============================================================================
+// RNGStream Implementation
+// ============================================================================
+
+void RNGStream::philox_block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4])
+{
+	uint32_t c[4] = { counter[0], counter[1], counter[2], counter[3] };
+	uint32_t k[2] = { key[0], key[1] };
+	philox_round(c, k);
+	for (int round = 1; round < 10; ++round)
+	{
+		k[0] += PHILOX_W0;
+		k[1] += PHILOX_W1;
+		philox_round(c, k);
+	}
+	std::copy(c, c + 4, out);
+}
+
+void RNGStream::refill()
+{
+	uint32_t words[4];
+	philox_block(counter, key, words);
+	counter[0]++;  // 2^32 blocks per stream
+	buffer[0] = static_cast<uint64_t>(words[1]) << 32 | words[0];
+	buffer[1] = static_cast<uint64_t>(words[3]) << 32 | words[2];
+	used = 0;
+}
+
+double RNGStream::nextDouble()
+{
+	// Top 53 bits, so every value is exact and below 1.0
+	return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int32_t RNGStream::nextInt32Range(int32_t min, int32_t max)
+{
+	if (min > max)
+	{
+		std::swap(min, max);
+	}
+	boost::random::uniform_int_distribution<int32_t> dist(min, max);
+	return dist(*this);
+}
+
+uint32_t RNGStream::nextUInt32Range(uint32_t min, uint32_t max)
+{
+	if (min > max)
+	{
+		std::swap(min, max);
+	}
+	boost::random::uniform_int_distribution<uint32_t> dist(min, max);
+	return dist(*this);
+}
+
+double RNGStream::nextDoubleRange(double min, double max)
+{
+	if (min > max)
+	{
+		std::swap(min, max);
+	}
+	boost::random::uniform_real_distribution<double> dist(min, max);
+	return dist(*this);
+}
+
+double RNGStream::nextNormal(double mean, double sigma)
+{
+	boost::random::normal_distribution<double> normalDist(mean, sigma);
+	return normalDist(*this);
+}
 
 // ============================================================================
 // DeterministicRNG Implementation
@@ -177,43 +382,37 @@ double DeterministicRNG::nextAIDoubleRange(double min, double max)
 // ============================================================================
 std::vector<uint8_t> DeterministicRNG::serialize_ai_rng_state() const
 {
-	std::ostringstream oss;
-	oss << aiEngine;
-	const std::string& str = oss.str();
-	return std::vector<uint8_t>(str.begin(), str.end());
+	std::vector<uint8_t> data(RNGStateFormat::SIZE);
+	aiEngine.write_state(data.data());
+	return data;
 }
 
-void DeterministicRNG::deserialize_ai_rng_state(const std::vector<uint8_t>& data)
+bool DeterministicRNG::deserialize_ai_rng_state(const std::vector<uint8_t>& data)
 {
-	std::string str(data.begin(), data.end());
-	std::istringstream iss(str);
-	iss >> aiEngine;
+	return aiEngine.read_state(data.data(), data.size());
 }
 
-size_t DeterministicRNG::get_serialized_ai_rng_state_size()
+bool DeterministicRNG::deserialize_ai_rng_state(const uint8_t* data, size_t size)
 {
-	// MT19937-64 has 312 uint64_t values + 1 position index
-	// Text serialization is roughly 20-30 bytes per uint64_t
-	// Approximate size: ~10-15 KB for text serialization
-	// This is a rough estimate; actual size depends on the serialization format
-	return 15000;  // Conservative estimate
+	return aiEngine.read_state(data, size);
 }
 
 std::vector<uint8_t> DeterministicRNG::serialize_deterministic_rng_state() const
 {
-	std::ostringstream oss;
-	oss << deterministicEngine;
-	const std::string& str = oss.str();
-	return std::vector<uint8_t>(str.begin(), str.end());
+	std::vector<uint8_t> data(RNGStateFormat::SIZE);
+	deterministicEngine.write_state(data.data());
+	return data;
 }
 
-void DeterministicRNG::deserialize_deterministic_rng_state(const std::vector<uint8_t>& data)
+bool DeterministicRNG::deserialize_deterministic_rng_state(const std::vector<uint8_t>& data)
 {
-	std::string str(data.begin(), data.end());
-	std::istringstream iss(str);
-	iss >> deterministicEngine;
+	return deterministicEngine.read_state(data.data(), data.size());
 }
 
+bool DeterministicRNG::deserialize_deterministic_rng_state(const uint8_t* data, size_t size)
+{
+	return deterministicEngine.read_state(data, size);
+}
 
 // ============================================================================
 // Normal Distribution Methods
@@ -0,0 +1,531 @@
+#include "route_planner.h"
+#include "knowledge_galaxy.h"
+#include "galaxy.h"
+#include "game_formulas.h"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// PlanetNeighbourGraph Implementation
+// ============================================================================
+
+void PlanetNeighbourGraph::build(const Galaxy& galaxy)
+{
+	max_planet_id = static_cast<uint32_t>(galaxy.planets.size());
+
+	size_t n = max_planet_id;
+	size_t per_planet = n > 0 ? n - 1 : 0;
+	offsets.assign(n + 1, 0);
+	neighbour_ids.resize(n * per_planet);
+	neighbour_distances.resize(n * per_planet);
+
+	// Distances are whole numbers (compute_distance_matrix rounds them), so a row is
+	// ordered by a counting sort over distance: scanning IDs in ascending order keeps
+	// ties by ID, and the cost is O(n + largest distance) instead of O(n log n).
+	// Rows spanning a very wide distance range fall back to sorting packed keys.
+	std::vector<uint32_t> bucket_starts;
+	std::vector<uint64_t> keys(per_planet);
+
+	for (uint32_t from_id = 1; from_id <= max_planet_id; ++from_id)
+	{
+		const std::vector<double>& row = galaxy.distance_matrix[from_id - 1];
+		size_t base = offsets[from_id - 1];
+		size_t count = 0;
+
+		uint32_t max_distance = 0;
+		for (uint32_t to_id = 1; to_id <= max_planet_id; ++to_id)
+			{ max_distance = std::max(max_distance, static_cast<uint32_t>(row[to_id - 1])); }
+
+		if (max_distance <= 8 * n)
+		{
+			bucket_starts.assign(static_cast<size_t>(max_distance) + 2, 0);
+			for (uint32_t to_id = 1; to_id <= max_planet_id; ++to_id)
+			{
+				if (to_id != from_id)
+					{ bucket_starts[static_cast<uint32_t>(row[to_id - 1]) + 1]++; }
+			}
+			for (size_t d = 1; d < bucket_starts.size(); ++d)
+				{ bucket_starts[d] += bucket_starts[d - 1]; }
+			for (uint32_t to_id = 1; to_id <= max_planet_id; ++to_id)
+			{
+				if (to_id == from_id)
+					{ continue; }
+				uint32_t distance = static_cast<uint32_t>(row[to_id - 1]);
+				size_t slot = base + bucket_starts[distance]++;
+				neighbour_ids[slot] = to_id;
+				neighbour_distances[slot] = row[to_id - 1];
+				count++;
+			}
+		}
+		else
+		{
+			for (uint32_t to_id = 1; to_id <= max_planet_id; ++to_id)
+			{
+				if (to_id != from_id)
+					{ keys[count++] = static_cast<uint64_t>(row[to_id - 1]) << 32 | to_id; }
+			}
+			std::sort(keys.begin(), keys.begin() + count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				neighbour_ids[base + i] = static_cast<uint32_t>(keys[i]);
+				neighbour_distances[base + i] = static_cast<double>(keys[i] >> 32);
+			}
+		}
+		offsets[from_id] = static_cast<uint32_t>(base + count);
+	}
+}
+
+PlanetNeighbourGraph::NeighbourRange PlanetNeighbourGraph::get_neighbours(uint32_t planet_id) const
+{
+	if (planet_id == 0 || planet_id > max_planet_id)
+		{ return NeighbourRange{ nullptr, nullptr, 0 }; }
+
+	uint32_t begin = offsets[planet_id - 1];
+	uint32_t end = offsets[planet_id];
+	return NeighbourRange{ neighbour_ids.data() + begin, neighbour_distances.data() + begin, end - begin };
+}
+
+PlanetNeighbourGraph::NeighbourRange PlanetNeighbourGraph::get_neighbours_within(uint32_t planet_id, double range) const
+{
+	NeighbourRange all = get_neighbours(planet_id);
+	const double* last = std::upper_bound(all.distances, all.distances + all.count, range);
+	all.count = static_cast<uint32_t>(last - all.distances);
+	return all;
+}
+
+// ============================================================================
+// RoutePlanner Implementation
+// ============================================================================
+
+// A fleet may only take a hop whose fuel cost does not exceed its remaining fuel,
+// and arriving at a refuel planet restores max_fuel.  Matrix distances are rounded,
+// so a detour through a planet where the fleet cannot refuel can cost a little less
+// fuel, or fewer turns, than the direct hop.  Every planet is therefore a possible
+// stop, and searches run over labels (planet, fuel left).  Labels at a planet are
+// settled in order of cost, so a later label is only kept if it arrives with more
+// fuel than every earlier one.  Neighbours within the fuel left are the prefix of
+// each planet's sorted neighbour list.
+//
+// The tank is full again at every refuel planet, so a route splits into legs that
+// end at refuel planets.  For each tank capacity, ship range and mode the planner
+// keeps a hub network, built on first use:
+//   - the leg from each planet: every planet reachable on one tank without
+//     refuelling on the way, with its labels in order of cost
+//   - the route tree of each refuel planet: the best cost to every planet when
+//     setting out from it with a full tank (Dijkstra over the refuel planets' legs)
+// A fleet docked at a refuel planet is answered from that planet's route tree.
+// Any other fleet is part-way through the leg of the planet it is at: setting out
+// with start_fuel instead of a full tank keeps exactly the labels that still have
+// (max_fuel - start_fuel) fuel left, because dropping the same amount of fuel from
+// every label does not change which labels dominate which.  Legs do not refill the
+// tank at refuel planets for the same reason.  The route is then the cheaper of the
+// destination's first label with enough fuel, and each refuel planet's first such
+// label plus that planet's route tree; refuel labels are visited cheapest first and
+// the scan stops at the first one that costs as much as the best route so far.
+// Searches that can ignore refuelling (unlimited fuel, or more than a tank) use A*,
+// bounded by the minimum number of full-tank hops still needed to cover the
+// straight-line distance to the destination (every hop costs at least one hop and
+// one turn, so it is admissible for both modes).  Per-planet search state is reset
+// with a generation counter, so repeated queries do not allocate.
+
+namespace
+{
+	// Lexicographic "worse than": higher primary cost, then higher secondary cost
+	bool queue_after(uint32_t a_primary, uint32_t a_secondary, uint32_t b_primary, uint32_t b_secondary)
+	{
+		if (a_primary != b_primary)
+			{ return a_primary > b_primary; }
+		return a_secondary > b_secondary;
+	}
+
+	// Number of hub networks (tank capacity, ship range and mode) kept per planner
+	constexpr size_t MAX_CACHED_HUB_NETWORKS = 4;
+}
+
+uint32_t RoutePlanner::remaining_hops_bound(double distance_to_destination, int32_t max_fuel)
+{
+	// Matrix distances are rounded, so a detour can be up to 1.5 shorter than the
+	// straight line suggests; dividing by (max_fuel + 2) keeps the bound consistent
+	return static_cast<uint32_t>(std::floor(distance_to_destination / (static_cast<double>(max_fuel) + 2.0)));
+}
+
+void RoutePlanner::clear_cache()
+{
+	hub_networks.clear();
+	cached_refuel_planets = PlanetBitset();
+}
+
+void RoutePlanner::prepare(uint32_t max_planet_id)
+{
+	size_t n = static_cast<size_t>(max_planet_id) + 1;
+	if (planet_generation.size() < n)
+	{
+		settled_fuel.resize(n);
+		pending_primary.resize(n);
+		pending_secondary.resize(n);
+		pending_fuel.resize(n);
+		planet_generation.resize(n, 0);
+	}
+
+	queue.clear();
+
+	// Bump the generation so stale per-planet state is ignored without clearing it
+	generation++;
+	if (generation == 0)
+	{
+		std::fill(planet_generation.begin(), planet_generation.end(), 0);
+		generation = 1;
+	}
+}
+
+void RoutePlanner::touch(uint32_t planet_id)
+{
+	if (planet_generation[planet_id] != generation)
+	{
+		planet_generation[planet_id] = generation;
+		settled_fuel[planet_id] = -1;
+		pending_primary[planet_id] = UINT32_MAX;
+		pending_secondary[planet_id] = UINT32_MAX;
+		pending_fuel[planet_id] = -1;
+	}
+}
+
+uint32_t RoutePlanner::search(const KnowledgeGalaxy& knowledge_galaxy, const RouteQuery& query,
+                              const PlanetBitset& refuel_planets, uint32_t origin_planet_id, int32_t start_fuel,
+                              uint32_t destination_planet_id, std::vector<Label>& out)
+{
+	const PlanetNeighbourGraph& graph = knowledge_galaxy.get_neighbour_graph();
+	prepare(graph.get_max_planet_id());
+	out.clear();
+
+	auto heap_order = [](const QueueEntry& a, const QueueEntry& b)
+	{
+		if (a.estimate != b.estimate || a.secondary != b.secondary)
+			{ return queue_after(a.estimate, a.secondary, b.estimate, b.secondary); }
+		return a.fuel < b.fuel;    // More fuel first among equals
+	};
+
+	bool by_turns = (query.mode == ROUTE_FEWEST_TURNS);
+	bool is_leg = (destination_planet_id == 0);
+	int32_t bound_fuel = std::max(query.max_fuel, start_fuel);
+
+	if (refuel_planets.test(origin_planet_id))
+		{ start_fuel = std::max(start_fuel, query.max_fuel); }
+	queue.push_back(QueueEntry{ 0, 0, 0, origin_planet_id, start_fuel, NO_LABEL });
+
+	while (!queue.empty())
+	{
+		std::pop_heap(queue.begin(), queue.end(), heap_order);
+		QueueEntry entry = queue.back();
+		queue.pop_back();
+
+		// Labels at a planet settle in order of cost: keep this one only if it has more fuel
+		uint32_t id = entry.planet_id;
+		touch(id);
+		if (entry.fuel <= settled_fuel[id])
+			{ continue; }
+		settled_fuel[id] = entry.fuel;
+
+		uint32_t label_index = static_cast<uint32_t>(out.size());
+		out.push_back(Label{ id, entry.parent, entry.fuel, entry.primary, entry.secondary });
+		if (id == destination_planet_id)
+			{ return label_index; }
+		if (is_leg && entry.parent != NO_LABEL && refuel_planets.test(id))
+			{ continue; }
+
+		PlanetNeighbourGraph::NeighbourRange in_range = graph.get_neighbours_within(id, entry.fuel);
+		for (uint32_t i = 0; i < in_range.count; ++i)
+		{
+			uint32_t next_id = in_range.ids[i];
+			double distance = in_range.distances[i];
+			int32_t fuel_cost = GameFormulas::calculate_fuel_cost(distance);
+			if (fuel_cost > entry.fuel)
+				{ continue; }
+
+			// Unlimited fuel (INT32_MAX) is never used up
+			int32_t fuel = (entry.fuel == INT32_MAX) ? entry.fuel : entry.fuel - fuel_cost;
+			if (!is_leg && refuel_planets.test(next_id))
+				{ fuel = std::max(fuel, query.max_fuel); }
+			touch(next_id);
+			if (fuel <= settled_fuel[next_id])
+				{ continue; }
+
+			uint32_t turns = GameFormulas::calculate_travel_turns(distance, query.ship_range);
+			uint32_t primary = entry.primary + (by_turns ? turns : 1);
+			uint32_t secondary = entry.secondary + (by_turns ? 1 : turns);
+
+			// Skip a label no cheaper than one already queued with at least as much fuel
+			bool cheaper = queue_after(pending_primary[next_id], pending_secondary[next_id], primary, secondary);
+			if (!cheaper && fuel <= pending_fuel[next_id])
+				{ continue; }
+			if (cheaper || fuel > pending_fuel[next_id])
+			{
+				pending_primary[next_id] = primary;
+				pending_secondary[next_id] = secondary;
+				pending_fuel[next_id] = fuel;
+			}
+
+			uint32_t estimate = primary;
+			if (!is_leg && next_id != destination_planet_id)
+			{
+				estimate += remaining_hops_bound(knowledge_galaxy.get_distance(next_id, destination_planet_id),
+				                                 bound_fuel);
+			}
+
+			queue.push_back(QueueEntry{ estimate, secondary, primary, next_id, fuel, label_index });
+			std::push_heap(queue.begin(), queue.end(), heap_order);
+		}
+	}
+	return NO_LABEL;
+}
+
+RoutePlanner::HubNetwork& RoutePlanner::get_hub_network(const KnowledgeGalaxy& knowledge_galaxy, const RouteQuery& query)
+{
+	for (HubNetwork& network : hub_networks)
+	{
+		if (network.max_fuel == query.max_fuel && network.ship_range == query.ship_range && network.mode == query.mode)
+			{ return network; }
+	}
+
+	if (hub_networks.size() >= MAX_CACHED_HUB_NETWORKS)
+		{ hub_networks.erase(hub_networks.begin()); }
+
+	size_t n = static_cast<size_t>(knowledge_galaxy.get_neighbour_graph().get_max_planet_id()) + 1;
+	HubNetwork network;
+	network.max_fuel = query.max_fuel;
+	network.ship_range = query.ship_range;
+	network.mode = query.mode;
+	network.legs.resize(n);
+	network.trees.resize(n);
+	hub_networks.push_back(std::move(network));
+	return hub_networks.back();
+}
+
+const RoutePlanner::Leg& RoutePlanner::get_leg(HubNetwork& network, const KnowledgeGalaxy& knowledge_galaxy,
+                                               const RouteQuery& query, const PlanetBitset& refuel_planets,
+                                               uint32_t planet_id)
+{
+	// A built leg always holds at least its start label
+	Leg& leg = network.legs[planet_id];
+	if (!leg.labels.empty())
+		{ return leg; }
+
+	(void)search(knowledge_galaxy, query, refuel_planets, planet_id, query.max_fuel, 0, leg.labels);
+
+	// Chain each planet's labels in settled order, so best_label ends on the cheapest
+	uint32_t label_count = static_cast<uint32_t>(leg.labels.size());
+	leg.best_label.assign(static_cast<size_t>(knowledge_galaxy.get_neighbour_graph().get_max_planet_id()) + 1, NO_LABEL);
+	leg.next_label.resize(label_count);
+	for (uint32_t i = label_count; i-- > 0;)
+	{
+		uint32_t id = leg.labels[i].planet_id;
+		leg.next_label[i] = leg.best_label[id];
+		leg.best_label[id] = i;
+	}
+	for (uint32_t i = 1; i < label_count; ++i)
+	{
+		if (refuel_planets.test(leg.labels[i].planet_id))
+			{ leg.refuel_labels.push_back(i); }
+	}
+	return leg;
+}
+
+const std::vector<RoutePlanner::Reach>& RoutePlanner::get_route_tree(HubNetwork& network,
+                                                                     const KnowledgeGalaxy& knowledge_galaxy,
+                                                                     const RouteQuery& query,
+                                                                     const PlanetBitset& refuel_planets,
+                                                                     uint32_t planet_id)
+{
+	std::vector<Reach>& out = network.trees[planet_id];
+	if (!out.empty())
+		{ return out; }
+
+	size_t n = static_cast<size_t>(knowledge_galaxy.get_neighbour_graph().get_max_planet_id()) + 1;
+	out.assign(n, Reach{ UINT32_MAX, UINT32_MAX, NO_LABEL });
+	hub_settled.assign(n, 0);
+	hub_queue.clear();
+
+	auto heap_order = [](const HubEntry& a, const HubEntry& b)
+		{ return queue_after(a.primary, a.secondary, b.primary, b.secondary); };
+
+	// Dijkstra over refuel planets: each settled one offers its leg.  Refuel planets in
+	// reach join the queue; other planets are leaves, reached from their cheapest leg
+	out[planet_id] = Reach{ 0, 0, NO_LABEL };
+	hub_queue.push_back(HubEntry{ 0, 0, planet_id });
+
+	while (!hub_queue.empty())
+	{
+		std::pop_heap(hub_queue.begin(), hub_queue.end(), heap_order);
+		HubEntry entry = hub_queue.back();
+		hub_queue.pop_back();
+
+		uint32_t hub_id = entry.planet_id;
+		if (hub_settled[hub_id] || entry.primary != out[hub_id].primary || entry.secondary != out[hub_id].secondary)
+			{ continue; }
+		hub_settled[hub_id] = 1;
+
+		const Leg& leg = get_leg(network, knowledge_galaxy, query, refuel_planets, hub_id);
+		for (uint32_t i = 1; i < leg.labels.size(); ++i)
+		{
+			const Label& label = leg.labels[i];
+			uint32_t id = label.planet_id;
+			if (leg.best_label[id] != i || hub_settled[id])
+				{ continue; }
+
+			uint32_t primary = entry.primary + label.primary;
+			uint32_t secondary = entry.secondary + label.secondary;
+			if (!queue_after(out[id].primary, out[id].secondary, primary, secondary))
+				{ continue; }
+			out[id] = Reach{ primary, secondary, hub_id };
+			if (refuel_planets.test(id))
+			{
+				hub_queue.push_back(HubEntry{ primary, secondary, id });
+				std::push_heap(hub_queue.begin(), hub_queue.end(), heap_order);
+			}
+		}
+	}
+	return out;
+}
+
+bool RoutePlanner::plan(const KnowledgeGalaxy& knowledge_galaxy, const RouteQuery& query,
+                        const PlanetBitset& refuel_planets, Route& route)
+{
+	route.found = false;
+	route.waypoints.clear();
+	route.total_turns = 0;
+	route.hops = 0;
+	route.fuel_on_arrival = 0;
+
+	uint32_t max_id = knowledge_galaxy.get_neighbour_graph().get_max_planet_id();
+	uint32_t origin = query.origin_planet_id;
+	uint32_t destination = query.destination_planet_id;
+	if (origin == 0 || origin > max_id || destination == 0 || destination > max_id)
+		{ return false; }
+
+	// Any change to the refuel set invalidates every cached hub network
+	if (cached_refuel_planets != refuel_planets)
+	{
+		hub_networks.clear();
+		cached_refuel_planets = refuel_planets;
+	}
+
+	// Unlimited fuel, or more than a tank: refuel planets are not special, search directly
+	if (query.start_fuel > query.max_fuel || query.start_fuel == INT32_MAX)
+	{
+		uint32_t label_index = search(knowledge_galaxy, query, refuel_planets, origin, query.start_fuel,
+		                              destination, query_labels);
+		if (label_index == NO_LABEL)
+			{ return false; }
+		append_label_path(query_labels, label_index, route.waypoints);
+		route.waypoints.push_back(origin);
+		std::reverse(route.waypoints.begin(), route.waypoints.end());
+		route.fuel_on_arrival = query_labels[label_index].fuel;
+		set_route_totals(query_labels[label_index].primary, query_labels[label_index].secondary, query.mode, route);
+		return true;
+	}
+
+	HubNetwork& network = get_hub_network(knowledge_galaxy, query);
+
+	// A fleet docked at a refuel planet sets out with a full tank: answer from its route tree
+	if (refuel_planets.test(origin))
+	{
+		const Reach& arrival = get_route_tree(network, knowledge_galaxy, query, refuel_planets, origin)[destination];
+		if (arrival.primary == UINT32_MAX)
+			{ return false; }
+		route.fuel_on_arrival = append_tree_path(network, origin, destination, route.waypoints);
+		if (refuel_planets.test(destination))
+			{ route.fuel_on_arrival = query.max_fuel; }
+		route.waypoints.push_back(origin);
+		std::reverse(route.waypoints.begin(), route.waypoints.end());
+		set_route_totals(arrival.primary, arrival.secondary, query.mode, route);
+		return true;
+	}
+
+	// Otherwise the fleet is part-way through its planet's leg, with labels that keep at
+	// least fuel_spent fuel.  The route either stays on that leg to the destination or
+	// ends it at a refuel planet, from where the rest of the way is that planet's route tree
+	const Leg& leg = get_leg(network, knowledge_galaxy, query, refuel_planets, origin);
+	int32_t fuel_spent = query.max_fuel - query.start_fuel;
+
+	uint32_t best_primary = UINT32_MAX;
+	uint32_t best_secondary = UINT32_MAX;
+	uint32_t best_index = NO_LABEL;
+	uint32_t best_tree = NO_LABEL;
+	for (uint32_t i = leg.best_label[destination]; i != NO_LABEL; i = leg.next_label[i])
+	{
+		if (leg.labels[i].fuel >= fuel_spent)
+		{
+			best_primary = leg.labels[i].primary;
+			best_secondary = leg.labels[i].secondary;
+			best_index = i;
+			break;
+		}
+	}
+	for (uint32_t i : leg.refuel_labels)
+	{
+		// A route tree never costs less than nothing, so no later refuel label can do better
+		const Label& label = leg.labels[i];
+		if (!queue_after(best_primary, best_secondary, label.primary, label.secondary))
+			{ break; }
+		if (label.fuel < fuel_spent)
+			{ continue; }
+
+		const Reach& rest = get_route_tree(network, knowledge_galaxy, query, refuel_planets, label.planet_id)[destination];
+		if (rest.primary == UINT32_MAX)
+			{ continue; }
+		uint32_t primary = label.primary + rest.primary;
+		uint32_t secondary = label.secondary + rest.secondary;
+		if (queue_after(best_primary, best_secondary, primary, secondary))
+		{
+			best_primary = primary;
+			best_secondary = secondary;
+			best_index = i;
+			best_tree = label.planet_id;
+		}
+	}
+	if (best_index == NO_LABEL)
+		{ return false; }
+
+	route.fuel_on_arrival = leg.labels[best_index].fuel - fuel_spent;
+	if (best_tree != NO_LABEL)
+		{ route.fuel_on_arrival = append_tree_path(network, best_tree, destination, route.waypoints); }
+	if (refuel_planets.test(destination))
+		{ route.fuel_on_arrival = query.max_fuel; }
+	append_label_path(leg.labels, best_index, route.waypoints);
+	route.waypoints.push_back(origin);
+	std::reverse(route.waypoints.begin(), route.waypoints.end());
+	set_route_totals(best_primary, best_secondary, query.mode, route);
+	return true;
+}
+
+void RoutePlanner::set_route_totals(uint32_t primary, uint32_t secondary, RouteMode mode, Route& route)
+{
+	bool by_turns = (mode == ROUTE_FEWEST_TURNS);
+	route.found = true;
+	route.total_turns = by_turns ? primary : secondary;
+	route.hops = by_turns ? secondary : primary;
+}
+
+void RoutePlanner::append_label_path(const std::vector<Label>& labels, uint32_t label_index,
+                                     std::vector<uint32_t>& reversed_waypoints)
+{
+	for (; labels[label_index].parent != NO_LABEL; label_index = labels[label_index].parent)
+		{ reversed_waypoints.push_back(labels[label_index].planet_id); }
+}
+
+int32_t RoutePlanner::append_tree_path(const HubNetwork& network, uint32_t tree_planet_id,
+                                       uint32_t destination_planet_id, std::vector<uint32_t>& reversed_waypoints)
+{
+	// Walk back leg by leg; within a leg, follow the label parents
+	const std::vector<Reach>& tree = network.trees[tree_planet_id];
+	int32_t fuel_on_arrival = network.legs[tree_planet_id].labels[0].fuel;
+	for (uint32_t id = destination_planet_id; id != tree_planet_id; id = tree[id].via)
+	{
+		const Leg& leg = network.legs[tree[id].via];
+		uint32_t index = leg.best_label[id];
+		if (id == destination_planet_id)
+			{ fuel_on_arrival = leg.labels[index].fuel; }
+		append_label_path(leg.labels, index, reversed_waypoints);
+	}
+	return fuel_on_arrival;
+}
@@ -0,0 +1,884 @@
+#include "save_chain.h"
+#include "game.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace SaveRecords;
+
+// ============================================================================
+// Delta Encoding Helpers
+// ============================================================================
+
+namespace
+{
+	// How a per-player list is stored in a delta
+	constexpr uint8_t LIST_UNCHANGED = 0;
+	constexpr uint8_t LIST_FULL = 1;        // Count and every record
+	constexpr uint8_t LIST_PATCH = 2;       // Removed keys, then changed and new records
+
+	// How the history section is stored in a delta
+	constexpr uint8_t HISTORY_FULL = 0;
+	constexpr uint8_t HISTORY_APPEND = 1;   // Rows from the base's last turn on
+
+	/// Compares records by their encoding, so every saved field counts and nothing else does
+	/// Both sides share one string table, so equal names get equal indices
+	class RecordComparer
+	{
+	public:
+		template <typename Record, typename WriteFn>
+		bool same(const Record& a, const Record& b, WriteFn write)
+		{
+			a_bytes.clear();
+			b_bytes.clear();
+			ByteWriter a_writer(a_bytes);
+			ByteWriter b_writer(b_bytes);
+			write(a_writer, a, strings);
+			write(b_writer, b, strings);
+			return a_bytes == b_bytes;
+		}
+
+	private:
+		StringTable strings;
+		std::vector<uint8_t> a_bytes;
+		std::vector<uint8_t> b_bytes;
+	};
+
+	// ------------------------------------------------------------------------
+	// Keyed Record Codecs
+	// ------------------------------------------------------------------------
+
+	struct ColonyCodec
+	{
+		typedef ColonyRecord Record;
+		static uint32_t key(const ColonyRecord& colony) { return colony.planet_id; }
+		static void write(ByteWriter& w, const ColonyRecord& colony, uint32_t& previous_id, StringTable&)
+			{ write_colony(w, colony, previous_id); }
+		static bool read(ByteReader& r, const std::vector<std::string>&, uint32_t& previous_id, std::vector<ColonyRecord>& out)
+		{
+			out.push_back(read_colony(r, previous_id));
+			return r.ok();
+		}
+	};
+
+	struct FleetCodec
+	{
+		typedef FleetRecord Record;
+		static uint32_t key(const FleetRecord& fleet) { return fleet.id; }
+		static void write(ByteWriter& w, const FleetRecord& fleet, uint32_t& previous_id, StringTable& strings)
+			{ write_fleet(w, fleet, previous_id, strings); }
+		static bool read(ByteReader& r, const std::vector<std::string>& strings, uint32_t& previous_id, std::vector<FleetRecord>& out)
+		{
+			FleetRecord fleet;
+			if (!read_fleet(r, strings, previous_id, fleet))
+				{ return false; }
+			out.push_back(std::move(fleet));
+			return true;
+		}
+	};
+
+	struct KnownPlanetCodec
+	{
+		typedef KnowledgePlanet Record;
+		static uint32_t key(const KnowledgePlanet& known) { return known.id; }
+		static void write(ByteWriter& w, const KnowledgePlanet& known, uint32_t& previous_id, StringTable&)
+			{ write_known_planet(w, known, previous_id); }
+		static bool read(ByteReader& r, const std::vector<std::string>&, uint32_t& previous_id, std::vector<KnowledgePlanet>& out)
+		{
+			out.push_back(read_known_planet(r, previous_id));
+			return r.ok();
+		}
+	};
+
+	// ------------------------------------------------------------------------
+	// Keyed Lists
+	// ------------------------------------------------------------------------
+
+	/// Write the change from base to next; returns false if the list is unchanged
+	/// A patch keeps surviving records in place and appends new ones, so it is only
+	/// used when that reproduces next's order (otherwise the whole list is written)
+	template <typename Codec>
+	bool write_list(ByteWriter& w, const std::vector<typename Codec::Record>& base,
+	                const std::vector<typename Codec::Record>& next, StringTable& strings, RecordComparer& compare)
+	{
+		typedef typename Codec::Record Record;
+		auto write_record = [](ByteWriter& out, const Record& record, StringTable& table)
+		{
+			uint32_t previous_id = 0;
+			Codec::write(out, record, previous_id, table);
+		};
+
+		std::unordered_map<uint32_t, size_t> base_index;
+		base_index.reserve(base.size());
+		for (size_t i = 0; i < base.size(); ++i)
+			{ base_index.emplace(Codec::key(base[i]), i); }
+
+		std::vector<const Record*> upserts;
+		std::vector<bool> kept(base.size(), false);
+		bool patch_order = base_index.size() == base.size();
+		bool seen_new = false;
+		size_t kept_end = 0;
+		for (const Record& record : next)
+		{
+			auto found = base_index.find(Codec::key(record));
+			if (found == base_index.end())
+			{
+				seen_new = true;
+				upserts.push_back(&record);
+				continue;
+			}
+			if (seen_new || found->second < kept_end)
+				{ patch_order = false; }
+			kept_end = found->second + 1;
+			kept[found->second] = true;
+			if (!compare.same(base[found->second], record, write_record))
+				{ upserts.push_back(&record); }
+		}
+		size_t removed = static_cast<size_t>(std::count(kept.begin(), kept.end(), false));
+
+		if (patch_order && removed == 0 && upserts.empty())
+		{
+			w.put_u8(LIST_UNCHANGED);
+			return false;
+		}
+
+		uint32_t previous_id = 0;
+		if (!patch_order || upserts.size() + removed >= next.size())
+		{
+			w.put_u8(LIST_FULL);
+			w.put_varuint(next.size());
+			for (const Record& record : next)
+				{ Codec::write(w, record, previous_id, strings); }
+			return true;
+		}
+
+		w.put_u8(LIST_PATCH);
+		w.put_varuint(removed);
+		for (size_t i = 0; i < base.size(); ++i)
+		{
+			if (kept[i])
+				{ continue; }
+			uint32_t key = Codec::key(base[i]);
+			w.put_varint(static_cast<int64_t>(key) - previous_id);
+			previous_id = key;
+		}
+		w.put_varuint(upserts.size());
+		previous_id = 0;
+		for (const Record* record : upserts)
+			{ Codec::write(w, *record, previous_id, strings); }
+		return true;
+	}
+
+	template <typename Codec>
+	bool read_list(ByteReader& r, const std::vector<std::string>& strings, std::vector<typename Codec::Record>& list)
+	{
+		typedef typename Codec::Record Record;
+		uint8_t mode = r.get_u8();
+		if (mode == LIST_UNCHANGED)
+			{ return r.ok(); }
+
+		uint32_t previous_id = 0;
+		if (mode == LIST_FULL)
+		{
+			uint32_t count = r.get_count();
+			list.clear();
+			list.reserve(count);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (!Codec::read(r, strings, previous_id, list))
+					{ return false; }
+			}
+			return r.ok();
+		}
+		if (mode != LIST_PATCH)
+			{ return false; }
+
+		uint32_t removed_count = r.get_count();
+		std::unordered_set<uint32_t> removed;
+		for (uint32_t i = 0; i < removed_count && r.ok(); ++i)
+		{
+			previous_id = static_cast<uint32_t>(previous_id + r.get_varint());
+			removed.insert(previous_id);
+		}
+		if (!removed.empty())
+		{
+			list.erase(std::remove_if(list.begin(), list.end(),
+			                          [&removed](const Record& record) { return removed.count(Codec::key(record)) != 0; }),
+			           list.end());
+		}
+
+		uint32_t upsert_count = r.get_count();
+		std::vector<Record> upserts;
+		upserts.reserve(upsert_count);
+		previous_id = 0;
+		for (uint32_t i = 0; i < upsert_count; ++i)
+		{
+			if (!Codec::read(r, strings, previous_id, upserts))
+				{ return false; }
+		}
+
+		std::unordered_map<uint32_t, size_t> index;
+		index.reserve(list.size() + upserts.size());
+		for (size_t i = 0; i < list.size(); ++i)
+			{ index.emplace(Codec::key(list[i]), i); }
+		for (Record& record : upserts)
+		{
+			auto found = index.find(Codec::key(record));
+			if (found != index.end())
+				{ list[found->second] = std::move(record); }
+			else
+			{
+				index.emplace(Codec::key(record), list.size());
+				list.push_back(std::move(record));
+			}
+		}
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Indexed Sections
+	// ------------------------------------------------------------------------
+
+	/// Advance index by the next gap in an increasing index list (false if it leaves [0, count))
+	bool read_next_index(ByteReader& r, size_t& index, size_t count)
+	{
+		uint64_t gap = r.get_varuint();
+		if (!r.ok() || gap > count || index + gap >= count)
+			{ return false; }
+		index += static_cast<size_t>(gap);
+		return true;
+	}
+
+	/// Section of per-player blocks; write_block returns false if the player has nothing to store
+	template <typename WriteBlock>
+	void write_player_blocks(ByteWriter& w, uint32_t tag, size_t player_count, uint32_t& section_count, WriteBlock write_block)
+	{
+		std::vector<uint8_t> blocks;
+		std::vector<uint8_t> block;
+		ByteWriter blocks_writer(blocks);
+		size_t changed = 0;
+		size_t previous = 0;
+		for (size_t i = 0; i < player_count; ++i)
+		{
+			block.clear();
+			ByteWriter block_writer(block);
+			if (!write_block(block_writer, i))
+				{ continue; }
+			blocks_writer.put_varuint(i - previous);
+			blocks_writer.put_bytes(block.data(), block.size());
+			previous = i;
+			changed++;
+		}
+		if (changed == 0)
+			{ return; }
+
+		size_t section = w.begin_section(tag);
+		w.put_varuint(changed);
+		w.put_bytes(blocks.data(), blocks.size());
+		w.end_section(section);
+		section_count++;
+	}
+
+	template <typename ReadBlock>
+	bool read_player_blocks(ByteReader r, size_t player_count, ReadBlock read_block)
+	{
+		uint32_t count = r.get_count();
+		size_t index = 0;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (!read_next_index(r, index, player_count) || !read_block(r, index))
+				{ return false; }
+		}
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Knowledge
+	// ------------------------------------------------------------------------
+
+	bool write_knowledge_change(ByteWriter& w, const PlayerRecord& base, const PlayerRecord& next,
+	                            StringTable& strings, RecordComparer& compare)
+	{
+		bool changed = write_list<KnownPlanetCodec>(w, base.known_planets, next.known_planets, strings, compare);
+		changed |= write_list<ColonyCodec>(w, base.known_colonizations, next.known_colonizations, strings, compare);
+
+		// Enemy sightings are few and short-lived: store the whole list when it changes
+		auto write_enemies = [](ByteWriter& out, const std::vector<EnemyFleetRecord>& enemies, StringTable&)
+			{ write_enemy_fleets(out, enemies); };
+		if (compare.same(base.enemy_fleets, next.enemy_fleets, write_enemies))
+			{ w.put_u8(LIST_UNCHANGED); }
+		else
+		{
+			w.put_u8(LIST_FULL);
+			write_enemy_fleets(w, next.enemy_fleets);
+			changed = true;
+		}
+
+		// Visible planets: changed words only (words past the end of the base count as zero)
+		const std::vector<uint64_t>& before = base.visible_planet_words;
+		const std::vector<uint64_t>& after = next.visible_planet_words;
+		std::vector<size_t> changed_words;
+		for (size_t i = 0; i < after.size(); ++i)
+		{
+			if (after[i] != (i < before.size() ? before[i] : 0))
+				{ changed_words.push_back(i); }
+		}
+		w.put_varuint(after.size());
+		w.put_varuint(changed_words.size());
+		size_t previous = 0;
+		for (size_t index : changed_words)
+		{
+			w.put_varuint(index - previous);
+			w.put_u64(after[index]);
+			previous = index;
+		}
+		return changed || !changed_words.empty() || before.size() != after.size();
+	}
+
+	bool read_knowledge_change(ByteReader& r, size_t planet_count, PlayerRecord& player)
+	{
+		if (!read_list<KnownPlanetCodec>(r, {}, player.known_planets)
+		    || !read_list<ColonyCodec>(r, {}, player.known_colonizations))
+			{ return false; }
+
+		uint8_t enemy_mode = r.get_u8();
+		if (enemy_mode == LIST_FULL)
+		{
+			if (!read_enemy_fleets(r, player.enemy_fleets))
+				{ return false; }
+		}
+		else if (enemy_mode != LIST_UNCHANGED)
+			{ return false; }
+
+		uint64_t word_count = r.get_varuint();
+		if (!r.ok() || word_count > planet_count / 64 + 1)
+			{ return false; }
+		player.visible_planet_words.resize(static_cast<size_t>(word_count), 0);
+		uint32_t changed_count = r.get_count();
+		size_t index = 0;
+		for (uint32_t i = 0; i < changed_count; ++i)
+		{
+			if (!read_next_index(r, index, player.visible_planet_words.size()))
+				{ return false; }
+			player.visible_planet_words[index] = r.get_u64();
+		}
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// History
+	// ------------------------------------------------------------------------
+
+	bool same_history(const PlayerHistoryStore& a, const PlayerHistoryStore& b)
+	{
+		if (a.get_player_ids() != b.get_player_ids() || a.get_retained_turns() != b.get_retained_turns()
+		    || a.get_turns() != b.get_turns() || a.get_years() != b.get_years())
+			{ return false; }
+		for (size_t player = 0; player < a.get_player_count(); ++player)
+		{
+			for (uint32_t metric = 0; metric < METRIC_COUNT; ++metric)
+			{
+				MetricSpan x = a.get_metric(player, static_cast<PlayerMetric>(metric));
+				MetricSpan y = b.get_metric(player, static_cast<PlayerMetric>(metric));
+				if (x.size() != y.size() || !std::equal(x.begin(), x.end(), y.begin()))
+					{ return false; }
+			}
+		}
+		return true;
+	}
+
+	/// Rows captured since the base (its last row included, since a turn can be captured again),
+	/// provided replaying them onto the base reproduces next exactly
+	bool write_history_append(ByteWriter& w, const PlayerHistoryStore& base, const PlayerHistoryStore& next)
+	{
+		if (base.empty() || base.get_player_ids() != next.get_player_ids()
+		    || base.get_retained_turns() != next.get_retained_turns() || !next.contains_turn(base.get_last_turn()))
+			{ return false; }
+
+		std::vector<uint8_t> rows;
+		ByteWriter rows_writer(rows);
+		write_history_rows(rows_writer, next, base.get_last_turn() - next.get_first_turn());
+
+		PlayerHistoryStore replayed = base;
+		ByteReader rows_reader(rows.data(), rows.size());
+		if (!read_history_rows(rows_reader, replayed) || !same_history(replayed, next))
+			{ return false; }
+
+		w.put_u8(HISTORY_APPEND);
+		w.put_bytes(rows.data(), rows.size());
+		return true;
+	}
+
+	// ------------------------------------------------------------------------
+	// Compatibility
+	// ------------------------------------------------------------------------
+
+	/// Galaxy layout and players must match for a delta to make sense
+	bool same_layout(const GameSnapshot& base, const GameSnapshot& next)
+	{
+		const GalaxyGenerationParams& a = base.galaxy_params;
+		const GalaxyGenerationParams& b = next.galaxy_params;
+		if (a.n_planets != b.n_planets || a.n_players != b.n_players || a.density != b.density || a.shape != b.shape
+		    || a.seed != b.seed || a.cluster_angular_offset != b.cluster_angular_offset
+		    || base.galaxy_size != next.galaxy_size || base.home_planet_indices != next.home_planet_indices
+		    || base.planets.size() != next.planets.size() || base.players.size() != next.players.size())
+			{ return false; }
+
+		for (size_t i = 0; i < base.planets.size(); ++i)
+		{
+			const Planet& p = base.planets[i];
+			const Planet& q = next.planets[i];
+			if (p.id != q.id || p.name != q.name || p.x != q.x || p.y != q.y)
+				{ return false; }
+		}
+		for (size_t i = 0; i < base.players.size(); ++i)
+		{
+			if (base.players[i].id != next.players[i].id)
+				{ return false; }
+		}
+		return true;
+	}
+
+	void patch_u32(std::vector<uint8_t>& out, size_t position, uint32_t value)
+	{
+		for (size_t i = 0; i < 4; ++i)
+			{ out[position + i] = static_cast<uint8_t>(value >> (8 * i)); }
+	}
+
+	// ========================================================================
+	// Delta Decoding
+	// ========================================================================
+
+	/// Apply a delta in place (snapshot is unspecified on failure)
+	bool apply_delta(const uint8_t* data, size_t size, GameSnapshot& s)
+	{
+		if (!data || size < DeltaFormat::HEADER_SIZE)
+			{ return false; }
+
+		ByteReader header(data, size);
+		if (header.get_u32() != DeltaFormat::MAGIC)
+			{ return false; }
+		uint16_t version = header.get_u16();
+		header.get_u16();  // Flags (none defined yet)
+		uint32_t base_turn = header.get_u32();
+		uint32_t turn = header.get_u32();
+		uint32_t section_count = header.get_u32();
+		if (version == 0 || version > DeltaFormat::VERSION || base_turn != s.current_turn)
+			{ return false; }
+
+		SectionIndex sections;
+		if (!sections.parse(header, section_count))
+			{ return false; }
+
+		ByteReader r(nullptr, 0);
+		std::vector<std::string> strings;
+		if (sections.find(SaveFormat::SECTION_STRINGS, r) && !read_strings(r, strings))
+			{ return false; }
+
+		if (!sections.find(SaveFormat::SECTION_META, r))
+			{ return false; }
+		s.current_turn = turn;
+		s.current_year = r.get_varuint32();
+		s.next_fleet_id = r.get_varuint32();
+		if (!r.ok())
+			{ return false; }
+
+		if (sections.find(SaveFormat::SECTION_PLANETS, r))
+		{
+			uint32_t count = r.get_count();
+			size_t index = 0;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (!read_next_index(r, index, s.planets.size()) || !read_planet_state(r, s.planets[index]))
+					{ return false; }
+			}
+		}
+
+		if (sections.find(SaveFormat::SECTION_PLAYERS, r))
+		{
+			uint32_t count = r.get_count();
+			size_t index = 0;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (!read_next_index(r, index, s.players.size()) || !read_player(r, strings, s.players[index]))
+					{ return false; }
+			}
+		}
+
+		const size_t player_count = s.players.size();
+		if (sections.find(SaveFormat::SECTION_COLONIES, r)
+		    && !read_player_blocks(r, player_count, [&](ByteReader& block, size_t i)
+		           { return read_list<ColonyCodec>(block, strings, s.players[i].colonies); }))
+			{ return false; }
+
+		if (sections.find(SaveFormat::SECTION_DESIGNS, r)
+		    && !read_player_blocks(r, player_count, [&](ByteReader& block, size_t i)
+		           { return read_designs(block, strings, s.players[i].designs); }))
+			{ return false; }
+
+		if (sections.find(SaveFormat::SECTION_FLEETS, r)
+		    && !read_player_blocks(r, player_count, [&](ByteReader& block, size_t i)
+		           { return read_list<FleetCodec>(block, strings, s.players[i].fleets); }))
+			{ return false; }
+
+		if (sections.find(SaveFormat::SECTION_OCCUPANCY, r) && !read_occupancy(r, s.occupancy))
+			{ return false; }
+
+		if (sections.find(SaveFormat::SECTION_KNOWLEDGE, r)
+		    && !read_player_blocks(r, player_count, [&](ByteReader& block, size_t i)
+		           { return read_knowledge_change(block, s.planets.size(), s.players[i]); }))
+			{ return false; }
+
+		if (sections.find(SaveFormat::SECTION_HISTORY, r))
+		{
+			uint8_t mode = r.get_u8();
+			bool read = mode == HISTORY_APPEND ? read_history_rows(r, s.history)
+			          : mode == HISTORY_FULL ? read_history(r, s.history) : false;
+			if (!read)
+				{ return false; }
+		}
+
+		if (sections.find(SaveFormat::SECTION_RNG, r) && !read_rng(r, s))
+			{ return false; }
+		return true;
+	}
+}
+
+// ============================================================================
+// Delta Encoding
+// ============================================================================
+
+bool encode_game_delta(const GameSnapshot& base, const GameSnapshot& next, std::vector<uint8_t>& out)
+{
+	if (!same_layout(base, next))
+		{ return false; }
+
+	const size_t start = out.size();
+	ByteWriter w(out);
+	StringTable strings;
+	RecordComparer compare;
+	uint32_t section_count = 0;
+
+	w.put_u32(DeltaFormat::MAGIC);
+	w.put_u16(DeltaFormat::VERSION);
+	w.put_u16(0);
+	w.put_u32(base.current_turn);
+	w.put_u32(next.current_turn);
+	w.put_u32(0);  // Section count, patched at the end
+
+	size_t section = w.begin_section(SaveFormat::SECTION_META);
+	w.put_varuint(next.current_year);
+	w.put_varuint(next.next_fleet_id);
+	w.end_section(section);
+	section_count++;
+
+	// Planets and players: changed entries by index
+	auto write_planet = [](ByteWriter& out_writer, const Planet& planet, StringTable&)
+		{ write_planet_state(out_writer, planet); };
+	std::vector<size_t> changed;
+	for (size_t i = 0; i < next.planets.size(); ++i)
+	{
+		if (!compare.same(base.planets[i], next.planets[i], write_planet))
+			{ changed.push_back(i); }
+	}
+	if (!changed.empty())
+	{
+		section = w.begin_section(SaveFormat::SECTION_PLANETS);
+		w.put_varuint(changed.size());
+		size_t previous = 0;
+		for (size_t index : changed)
+		{
+			w.put_varuint(index - previous);
+			write_planet_state(w, next.planets[index]);
+			previous = index;
+		}
+		w.end_section(section);
+		section_count++;
+	}
+
+	changed.clear();
+	for (size_t i = 0; i < next.players.size(); ++i)
+	{
+		if (!compare.same(base.players[i], next.players[i], write_player))
+			{ changed.push_back(i); }
+	}
+	if (!changed.empty())
+	{
+		section = w.begin_section(SaveFormat::SECTION_PLAYERS);
+		w.put_varuint(changed.size());
+		size_t previous = 0;
+		for (size_t index : changed)
+		{
+			w.put_varuint(index - previous);
+			write_player(w, next.players[index], strings);
+			previous = index;
+		}
+		w.end_section(section);
+		section_count++;
+	}
+
+	// Per-player lists
+	const size_t player_count = next.players.size();
+	write_player_blocks(w, SaveFormat::SECTION_COLONIES, player_count, section_count, [&](ByteWriter& block, size_t i)
+		{ return write_list<ColonyCodec>(block, base.players[i].colonies, next.players[i].colonies, strings, compare); });
+
+	auto write_design_list = [](ByteWriter& out_writer, const std::vector<ShipDesign>& designs, StringTable& table)
+		{ write_designs(out_writer, designs, table); };
+	write_player_blocks(w, SaveFormat::SECTION_DESIGNS, player_count, section_count, [&](ByteWriter& block, size_t i)
+	{
+		if (compare.same(base.players[i].designs, next.players[i].designs, write_design_list))
+			{ return false; }
+		write_designs(block, next.players[i].designs, strings);
+		return true;
+	});
+
+	write_player_blocks(w, SaveFormat::SECTION_FLEETS, player_count, section_count, [&](ByteWriter& block, size_t i)
+		{ return write_list<FleetCodec>(block, base.players[i].fleets, next.players[i].fleets, strings, compare); });
+
+	auto write_occupancy_list = [](ByteWriter& out_writer, const std::vector<OccupancyRecord>& occupancy, StringTable&)
+		{ write_occupancy(out_writer, occupancy); };
+	if (!compare.same(base.occupancy, next.occupancy, write_occupancy_list))
+	{
+		section = w.begin_section(SaveFormat::SECTION_OCCUPANCY);
+		write_occupancy(w, next.occupancy);
+		w.end_section(section);
+		section_count++;
+	}
+
+	write_player_blocks(w, SaveFormat::SECTION_KNOWLEDGE, player_count, section_count, [&](ByteWriter& block, size_t i)
+		{ return write_knowledge_change(block, base.players[i], next.players[i], strings, compare); });
+
+	if (!same_history(base.history, next.history))
+	{
+		section = w.begin_section(SaveFormat::SECTION_HISTORY);
+		if (!write_history_append(w, base.history, next.history))
+		{
+			w.put_u8(HISTORY_FULL);
+			write_history(w, next.history);
+		}
+		w.end_section(section);
+		section_count++;
+	}
+
+	if (base.deterministic_seed != next.deterministic_seed || base.ai_seed != next.ai_seed
+	    || base.deterministic_rng_state != next.deterministic_rng_state || base.ai_rng_state != next.ai_rng_state)
+	{
+		section = w.begin_section(SaveFormat::SECTION_RNG);
+		write_rng(w, next);
+		w.end_section(section);
+		section_count++;
+	}
+
+	if (!strings.get_strings().empty())
+	{
+		section = w.begin_section(SaveFormat::SECTION_STRINGS);
+		write_strings(w, strings);
+		w.end_section(section);
+		section_count++;
+	}
+
+	patch_u32(out, start + DeltaFormat::HEADER_SIZE - 4, section_count);
+	return true;
+}
+
+bool apply_game_delta(const uint8_t* data, size_t size, GameSnapshot& snapshot)
+{
+	GameSnapshot next = snapshot;
+	if (!apply_delta(data, size, next))
+		{ return false; }
+	snapshot = std::move(next);
+	return true;
+}
+
+// ============================================================================
+// SaveChain Class
+// ============================================================================
+
+SaveChain::SaveChain(uint32_t keyframe_interval)
+	: keyframe_interval(keyframe_interval)
+{ }
+
+size_t SaveChain::checkpoint(const GameState& game)
+{
+	GameSnapshot snapshot;
+	game.capture_snapshot(snapshot);
+
+	// Checkpointing an earlier turn (e.g. after loading one) starts a new branch
+	while (!entries.empty() && entries.back().turn >= snapshot.current_turn)
+	{
+		entries.pop_back();
+		has_last = false;
+	}
+
+	Entry entry;
+	entry.turn = snapshot.current_turn;
+	entry.keyframe = !has_last || deltas_since_keyframe >= keyframe_interval
+	              || !encode_game_delta(last, snapshot, entry.data);
+	if (entry.keyframe)
+	{
+		entry.data.clear();
+		encode_game_snapshot(snapshot, entry.data);
+		deltas_since_keyframe = 0;
+	}
+	else
+		{ deltas_since_keyframe++; }
+
+	entries.push_back(std::move(entry));
+	last = std::move(snapshot);
+	has_last = true;
+	return entries.back().data.size();
+}
+
+bool SaveChain::reconstruct(uint32_t turn, GameSnapshot& snapshot) const
+{
+	size_t index = find_entry(turn);
+	return index != SIZE_MAX && reconstruct_entry(entries, index, snapshot);
+}
+
+bool SaveChain::load(uint32_t turn, GameState& game) const
+{
+	GameSnapshot snapshot;
+	return reconstruct(turn, snapshot) && game.restore_snapshot(snapshot);
+}
+
+bool SaveChain::compact(uint32_t turn)
+{
+	size_t index = find_entry(turn);
+	GameSnapshot snapshot;
+	if (index == SIZE_MAX || !reconstruct_entry(entries, index, snapshot))
+		{ return false; }
+
+	Entry keyframe;
+	keyframe.turn = turn;
+	keyframe.keyframe = true;
+	encode_game_snapshot(snapshot, keyframe.data);
+
+	entries.erase(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+	entries.insert(entries.begin(), std::move(keyframe));
+	deltas_since_keyframe = count_trailing_deltas(entries);
+	return true;
+}
+
+void SaveChain::clear()
+{
+	entries.clear();
+	last = GameSnapshot();
+	has_last = false;
+	deltas_since_keyframe = 0;
+}
+
+size_t SaveChain::get_total_bytes() const
+{
+	size_t total = 0;
+	for (const Entry& entry : entries)
+		{ total += entry.data.size(); }
+	return total;
+}
+
+void SaveChain::write(std::vector<uint8_t>& out) const
+{
+	write_header(out);
+	for (size_t i = 0; i < entries.size(); ++i)
+		{ write_entry(i, out); }
+}
+
+void SaveChain::write_header(std::vector<uint8_t>& out)
+{
+	ByteWriter w(out);
+	w.put_u32(DeltaFormat::CHAIN_MAGIC);
+	w.put_u16(DeltaFormat::CHAIN_VERSION);
+	w.put_u16(0);
+}
+
+void SaveChain::write_entry(size_t index, std::vector<uint8_t>& out) const
+{
+	const Entry& entry = entries[index];
+	ByteWriter w(out);
+	w.put_u8(entry.keyframe ? DeltaFormat::ENTRY_KEYFRAME : DeltaFormat::ENTRY_DELTA);
+	w.put_u32(entry.turn);
+	w.put_u32(static_cast<uint32_t>(entry.data.size()));
+	w.put_bytes(entry.data.data(), entry.data.size());
+}
+
+bool SaveChain::read(const uint8_t* data, size_t size)
+{
+	if (!data || size < DeltaFormat::CHAIN_HEADER_SIZE)
+		{ return false; }
+
+	ByteReader r(data, size);
+	if (r.get_u32() != DeltaFormat::CHAIN_MAGIC)
+		{ return false; }
+	uint16_t version = r.get_u16();
+	r.get_u16();  // Flags (none defined yet)
+	if (version == 0 || version > DeltaFormat::CHAIN_VERSION)
+		{ return false; }
+
+	std::vector<Entry> loaded;
+	while (r.ok() && !r.at_end())
+	{
+		uint8_t kind = r.get_u8();
+		uint32_t turn = r.get_u32();
+		uint32_t length = r.get_u32();
+		const uint8_t* payload = r.get_bytes(length);
+		if (!payload || (kind != DeltaFormat::ENTRY_KEYFRAME && kind != DeltaFormat::ENTRY_DELTA)
+		    || (!loaded.empty() && turn <= loaded.back().turn))
+			{ return false; }
+
+		Entry entry;
+		entry.turn = turn;
+		entry.keyframe = kind == DeltaFormat::ENTRY_KEYFRAME;
+		entry.data.assign(payload, payload + length);
+		loaded.push_back(std::move(entry));
+	}
+	if (!r.ok())
+		{ return false; }
+
+	// Rebuilding the newest state checks the tail of the chain and gives the base for the next delta
+	GameSnapshot newest;
+	if (!loaded.empty() && !reconstruct_entry(loaded, loaded.size() - 1, newest))
+		{ return false; }
+
+	entries = std::move(loaded);
+	has_last = !entries.empty();
+	last = std::move(newest);
+	deltas_since_keyframe = count_trailing_deltas(entries);
+	return true;
+}
+
+size_t SaveChain::find_entry(uint32_t turn) const
+{
+	auto found = std::lower_bound(entries.begin(), entries.end(), turn,
+	                              [](const Entry& entry, uint32_t value) { return entry.turn < value; });
+	if (found == entries.end() || found->turn != turn)
+		{ return SIZE_MAX; }
+	return static_cast<size_t>(found - entries.begin());
+}
+
+bool SaveChain::reconstruct_entry(const std::vector<Entry>& chain, size_t index, GameSnapshot& snapshot)
+{
+	size_t keyframe = index;
+	while (!chain[keyframe].keyframe)
+	{
+		if (keyframe == 0)
+			{ return false; }
+		keyframe--;
+	}
+
+	const Entry& base = chain[keyframe];
+	if (!decode_game_snapshot(base.data.data(), base.data.size(), snapshot) || snapshot.current_turn != base.turn)
+		{ return false; }
+	for (size_t i = keyframe + 1; i <= index; ++i)
+	{
+		if (!apply_delta(chain[i].data.data(), chain[i].data.size(), snapshot) || snapshot.current_turn != chain[i].turn)
+			{ return false; }
+	}
+	return true;
+}
+
+uint32_t SaveChain::count_trailing_deltas(const std::vector<Entry>& chain)
+{
+	uint32_t count = 0;
+	for (size_t i = chain.size(); i > 0 && !chain[i - 1].keyframe; --i)
+		{ count++; }
+	return count;
+}
@@ -0,0 +1,1280 @@
+#include "serialization.h"
+#include "game_snapshot.h"
+#include "game.h"
+
+// ============================================================================
+// Record Encoding
+// ============================================================================
+
+namespace
+{
+	bool read_string(ByteReader& r, const std::vector<std::string>& strings, std::string& out)
+	{
+		uint32_t index = r.get_varuint32();
+		if (!r.ok() || index >= strings.size())
+			{ return false; }
+		out = strings[index];
+		return true;
+	}
+
+	bool same_bits(double a, double b)
+		{ return std::memcmp(&a, &b, sizeof(a)) == 0; }
+
+	// FNV-1a, fed one little-endian value at a time
+	void hash_value(uint64_t& hash, uint64_t value, size_t bytes)
+	{
+		for (size_t i = 0; i < bytes; ++i)
+		{
+			hash ^= static_cast<uint8_t>(value >> (8 * i));
+			hash *= 0x100000001B3ULL;
+		}
+	}
+
+	void hash_double(uint64_t& hash, double value)
+	{
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		hash_value(hash, bits, 8);
+	}
+}
+
+namespace SaveRecords
+{
+	// ------------------------------------------------------------------------
+	// Strings
+	// ------------------------------------------------------------------------
+
+	void write_strings(ByteWriter& w, const StringTable& strings)
+	{
+		w.put_varuint(strings.get_strings().size());
+		for (const std::string& value : strings.get_strings())
+		{
+			w.put_varuint(value.size());
+			w.put_bytes(value.data(), value.size());
+			w.flush_point();
+		}
+	}
+
+	bool read_strings(ByteReader& r, std::vector<std::string>& strings)
+	{
+		uint32_t count = r.get_count();
+		strings.clear();
+		strings.reserve(count);
+		for (uint32_t i = 0; i < count && r.ok(); ++i)
+		{
+			uint32_t length = r.get_varuint32();
+			const uint8_t* bytes = r.get_bytes(length);
+			if (bytes)
+				{ strings.emplace_back(reinterpret_cast<const char*>(bytes), length); }
+		}
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Planets
+	// ------------------------------------------------------------------------
+
+	void write_planet_state(ByteWriter& w, const Planet& planet)
+	{
+		w.put_f64(planet.true_gravity);
+		w.put_f64(planet.true_temperature);
+		w.put_varint(planet.metal);
+		w.put_varint(planet.population);
+		w.put_varint(planet.owner);
+		w.put_u8(static_cast<uint8_t>(planet.nova_state));
+	}
+
+	bool read_planet_state(ByteReader& r, Planet& planet)
+	{
+		planet.true_gravity = r.get_f64();
+		planet.true_temperature = r.get_f64();
+		planet.metal = r.get_varint32();
+		planet.population = r.get_varint32();
+		planet.owner = r.get_varint32();
+		uint8_t nova = r.get_u8();
+		if (!r.ok() || nova > PLANET_DESTROYED)
+			{ return false; }
+		planet.nova_state = static_cast<PlanetNovaState>(nova);
+		return true;
+	}
+
+	// ------------------------------------------------------------------------
+	// Players
+	// ------------------------------------------------------------------------
+
+	void write_player(ByteWriter& w, const PlayerRecord& p, StringTable& strings)
+	{
+		w.put_varuint(strings.intern(p.name));
+		w.put_u8(static_cast<uint8_t>(p.gender));
+		w.put_u8(static_cast<uint8_t>(p.type));
+		w.put_varint(p.iq);
+		w.put_u8(static_cast<uint8_t>(p.starting_colony_quality));
+
+		w.put_varint(p.money_savings);
+		w.put_varint(p.metal_reserve);
+		w.put_varint(p.money_income);
+		w.put_varint(p.metal_income);
+		w.put_f64(p.ideal_temperature);
+		w.put_f64(p.ideal_gravity);
+
+		w.put_varint(p.tech.range);
+		w.put_varint(p.tech.speed);
+		w.put_varint(p.tech.weapons);
+		w.put_varint(p.tech.shields);
+		w.put_varint(p.tech.mini);
+		w.put_varint(p.tech.radical);
+
+		w.put_varint(p.income.planetary_income);
+		w.put_varint(p.income.interest_income);
+		w.put_varint(p.income.windfall_income);
+		w.put_varint(p.income.total_income);
+
+		w.put_f64(p.allocation.savings_fraction);
+		w.put_f64(p.allocation.research_fraction);
+		w.put_f64(p.allocation.planets_fraction);
+		w.put_f64(p.allocation.research.research_range_fraction);
+		w.put_f64(p.allocation.research.research_speed_fraction);
+		w.put_f64(p.allocation.research.research_weapons_fraction);
+		w.put_f64(p.allocation.research.research_shields_fraction);
+		w.put_f64(p.allocation.research.research_mini_fraction);
+		w.put_f64(p.allocation.research.research_radical_fraction);
+
+		w.put_varint(p.research.research_points_range);
+		w.put_varint(p.research.research_points_speed);
+		w.put_varint(p.research.research_points_weapons);
+		w.put_varint(p.research.research_points_shields);
+		w.put_varint(p.research.research_points_mini);
+		w.put_varint(p.research.research_points_radical);
+
+		w.put_varuint(p.next_ship_design_id);
+		w.put_varuint(p.alliance_id);
+	}
+
+	bool read_player(ByteReader& r, const std::vector<std::string>& strings, PlayerRecord& p)
+	{
+		if (!read_string(r, strings, p.name))
+			{ return false; }
+		p.gender = static_cast<Gender>(r.get_u8());
+		p.type = static_cast<PlayerType>(r.get_u8());
+		p.iq = r.get_varint32();
+		p.starting_colony_quality = static_cast<StartingColonyQuality>(r.get_u8());
+
+		p.money_savings = r.get_varint();
+		p.metal_reserve = r.get_varint();
+		p.money_income = r.get_varint();
+		p.metal_income = r.get_varint();
+		p.ideal_temperature = r.get_f64();
+		p.ideal_gravity = r.get_f64();
+
+		p.tech.range = r.get_varint32();
+		p.tech.speed = r.get_varint32();
+		p.tech.weapons = r.get_varint32();
+		p.tech.shields = r.get_varint32();
+		p.tech.mini = r.get_varint32();
+		p.tech.radical = r.get_varint32();
+
+		p.income.planetary_income = r.get_varint();
+		p.income.interest_income = r.get_varint();
+		p.income.windfall_income = r.get_varint();
+		p.income.total_income = r.get_varint();
+
+		p.allocation.savings_fraction = r.get_f64();
+		p.allocation.research_fraction = r.get_f64();
+		p.allocation.planets_fraction = r.get_f64();
+		p.allocation.research.research_range_fraction = r.get_f64();
+		p.allocation.research.research_speed_fraction = r.get_f64();
+		p.allocation.research.research_weapons_fraction = r.get_f64();
+		p.allocation.research.research_shields_fraction = r.get_f64();
+		p.allocation.research.research_mini_fraction = r.get_f64();
+		p.allocation.research.research_radical_fraction = r.get_f64();
+
+		p.research.research_points_range = r.get_varint();
+		p.research.research_points_speed = r.get_varint();
+		p.research.research_points_weapons = r.get_varint();
+		p.research.research_points_shields = r.get_varint();
+		p.research.research_points_mini = r.get_varint();
+		p.research.research_points_radical = r.get_varint();
+
+		p.next_ship_design_id = r.get_varuint32();
+		p.alliance_id = r.get_varuint32();
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Colonies
+	// ------------------------------------------------------------------------
+
+	void write_colony(ByteWriter& w, const ColonyRecord& colony, uint32_t& previous_id)
+	{
+		w.put_varint(static_cast<int64_t>(colony.planet_id) - previous_id);
+		previous_id = colony.planet_id;
+		w.put_f64(colony.funding_fraction);
+		w.put_varint(colony.population);
+		w.put_varint(colony.income);
+		w.put_f64(colony.mining_fraction);
+		w.put_f64(colony.terraforming_fraction);
+		w.put_f64(colony.apparent_gravity);
+		w.put_f64(colony.apparent_temperature);
+		w.put_varint(colony.desirability);
+	}
+
+	ColonyRecord read_colony(ByteReader& r, uint32_t& previous_id)
+	{
+		ColonyRecord colony;
+		colony.planet_id = static_cast<uint32_t>(previous_id + r.get_varint());
+		previous_id = colony.planet_id;
+		colony.funding_fraction = r.get_f64();
+		colony.population = r.get_varint32();
+		colony.income = r.get_varint32();
+		colony.mining_fraction = r.get_f64();
+		colony.terraforming_fraction = r.get_f64();
+		colony.apparent_gravity = r.get_f64();
+		colony.apparent_temperature = r.get_f64();
+		colony.desirability = r.get_varint32();
+		return colony;
+	}
+
+	void write_colonies(ByteWriter& w, const std::vector<ColonyRecord>& colonies)
+	{
+		w.put_varuint(colonies.size());
+		uint32_t previous_id = 0;
+		for (const ColonyRecord& colony : colonies)
+			{ write_colony(w, colony, previous_id); }
+	}
+
+	bool read_colonies(ByteReader& r, std::vector<ColonyRecord>& colonies)
+	{
+		uint32_t count = r.get_count();
+		colonies.clear();
+		colonies.reserve(count);
+		uint32_t previous_id = 0;
+		for (uint32_t i = 0; i < count && r.ok(); ++i)
+			{ colonies.push_back(read_colony(r, previous_id)); }
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Ship Designs
+	// ------------------------------------------------------------------------
+
+	void write_designs(ByteWriter& w, const std::vector<ShipDesign>& designs, StringTable& strings)
+	{
+		w.put_varuint(designs.size());
+		uint32_t previous_id = 0;
+		for (const ShipDesign& design : designs)
+		{
+			w.put_varint(static_cast<int64_t>(design.id) - previous_id);
+			previous_id = design.id;
+			w.put_varuint(strings.intern(design.name));
+			w.put_u8(static_cast<uint8_t>(design.type));
+			w.put_varint(design.build_cost);
+			w.put_varint(design.prototype_cost);
+			w.put_varint(design.metal_cost);
+			w.put_varint(design.get_range());
+			w.put_varint(design.get_speed());
+			w.put_varint(design.get_weapons());
+			w.put_varint(design.get_shields());
+			w.put_varint(design.get_mini());
+		}
+	}
+
+	bool read_designs(ByteReader& r, const std::vector<std::string>& strings, std::vector<ShipDesign>& designs)
+	{
+		uint32_t count = r.get_count();
+		designs.clear();
+		designs.reserve(count);
+		uint32_t previous_id = 0;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			ShipDesign design;
+			design.id = static_cast<uint32_t>(previous_id + r.get_varint());
+			previous_id = design.id;
+			if (!read_string(r, strings, design.name))
+				{ return false; }
+			design.type = static_cast<ShipType>(r.get_u8());
+			design.build_cost = r.get_varint();
+			design.prototype_cost = r.get_varint();
+			design.metal_cost = r.get_varint();
+			int32_t range = r.get_varint32();
+			int32_t speed = r.get_varint32();
+			int32_t weapons = r.get_varint32();
+			int32_t shields = r.get_varint32();
+			int32_t mini = r.get_varint32();
+			set_ship_design_tech(design, range, speed, weapons, shields, mini);
+			if (!r.ok())
+				{ return false; }
+			designs.push_back(design);
+		}
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Fleets
+	// ------------------------------------------------------------------------
+
+	void write_fleet(ByteWriter& w, const FleetRecord& fleet, uint32_t& previous_id, StringTable& strings)
+	{
+		w.put_varint(static_cast<int64_t>(fleet.id) - previous_id);
+		previous_id = fleet.id;
+		w.put_varuint(fleet.design_id);
+		w.put_varuint(fleet.ship_count);
+		w.put_varint(fleet.fuel);
+		w.put_varuint(strings.intern(fleet.descriptor));
+		w.put_varuint(fleet.planet_id);
+		w.put_u8(fleet.transit ? 1 : 0);
+		if (fleet.transit)
+		{
+			w.put_varuint(fleet.transit->origin_planet_id);
+			w.put_varuint(fleet.transit->destination_planet_id);
+			w.put_varuint(fleet.transit->departure_turn);
+			w.put_varuint(fleet.transit->arrival_turn);
+			w.put_f64(fleet.transit->distance);
+			w.put_varuint(fleet.transit->turns_to_travel);
+		}
+	}
+
+	bool read_fleet(ByteReader& r, const std::vector<std::string>& strings, uint32_t& previous_id, FleetRecord& fleet)
+	{
+		fleet.id = static_cast<uint32_t>(previous_id + r.get_varint());
+		previous_id = fleet.id;
+		fleet.design_id = r.get_varuint32();
+		fleet.ship_count = r.get_varuint32();
+		fleet.fuel = r.get_varint32();
+		if (!read_string(r, strings, fleet.descriptor))
+			{ return false; }
+		fleet.planet_id = r.get_varuint32();
+		fleet.transit.reset();
+		if (r.get_u8())
+		{
+			uint32_t origin = r.get_varuint32();
+			uint32_t destination = r.get_varuint32();
+			uint32_t departure = r.get_varuint32();
+			uint32_t arrival = r.get_varuint32();
+			double distance = r.get_f64();
+			uint32_t turns = r.get_varuint32();
+			fleet.transit.emplace(origin, destination, departure, arrival, distance, turns);
+		}
+		return r.ok();
+	}
+
+	void write_fleets(ByteWriter& w, const std::vector<FleetRecord>& fleets, StringTable& strings)
+	{
+		w.put_varuint(fleets.size());
+		uint32_t previous_id = 0;
+		for (const FleetRecord& fleet : fleets)
+			{ write_fleet(w, fleet, previous_id, strings); }
+	}
+
+	bool read_fleets(ByteReader& r, const std::vector<std::string>& strings, std::vector<FleetRecord>& fleets)
+	{
+		uint32_t count = r.get_count();
+		fleets.assign(count, FleetRecord());
+		uint32_t previous_id = 0;
+		for (FleetRecord& fleet : fleets)
+		{
+			if (!read_fleet(r, strings, previous_id, fleet))
+				{ return false; }
+		}
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Knowledge
+	// ------------------------------------------------------------------------
+
+	/// A record with the given observation year (pinned pages hold their years apart)
+	void write_known_planet(ByteWriter& w, const KnowledgePlanet& known, int32_t observation_year, uint32_t& previous_id)
+	{
+		w.put_varint(static_cast<int64_t>(known.id) - previous_id);
+		previous_id = known.id;
+		w.put_f64(known.apparent_temperature);
+		w.put_f64(known.apparent_gravity);
+		w.put_varint(known.metal);
+		w.put_varint(known.apparent_owner);
+		w.put_varint(known.apparent_population);
+		w.put_varint(observation_year);
+		w.put_varint(known.can_be_profitable);
+		w.put_varint(known.perceived_value);
+		w.put_u8(static_cast<uint8_t>(known.nova_state));
+	}
+
+	void write_known_planet(ByteWriter& w, const KnowledgePlanet& known, uint32_t& previous_id)
+		{ write_known_planet(w, known, known.observation_year, previous_id); }
+
+	KnowledgePlanet read_known_planet(ByteReader& r, uint32_t& previous_id)
+	{
+		KnowledgePlanet known(static_cast<uint32_t>(previous_id + r.get_varint()));
+		previous_id = known.id;
+		known.apparent_temperature = r.get_f64();
+		known.apparent_gravity = r.get_f64();
+		known.metal = r.get_varint32();
+		known.apparent_owner = r.get_varint32();
+		known.apparent_population = r.get_varint32();
+		known.observation_year = r.get_varint32();
+		known.can_be_profitable = r.get_varint32();
+		known.perceived_value = r.get_varint32();
+		known.nova_state = static_cast<PlanetNovaState>(r.get_u8());
+		return known;
+	}
+
+	void write_enemy_fleets(ByteWriter& w, const std::vector<EnemyFleetRecord>& enemy_fleets)
+	{
+		w.put_varuint(enemy_fleets.size());
+		uint32_t previous_planet = 0;
+		for (const EnemyFleetRecord& enemy : enemy_fleets)
+		{
+			w.put_varint(static_cast<int64_t>(enemy.planet_id) - previous_planet);
+			previous_planet = enemy.planet_id;
+			w.put_varuint(enemy.info.fleet_id);
+			w.put_varint(enemy.info.owner);
+			w.put_varuint(enemy.info.ship_count);
+		}
+	}
+
+	bool read_enemy_fleets(ByteReader& r, std::vector<EnemyFleetRecord>& enemy_fleets)
+	{
+		uint32_t count = r.get_count();
+		enemy_fleets.clear();
+		enemy_fleets.reserve(count);
+		uint32_t previous_planet = 0;
+		for (uint32_t i = 0; i < count && r.ok(); ++i)
+		{
+			EnemyFleetRecord enemy;
+			enemy.planet_id = static_cast<uint32_t>(previous_planet + r.get_varint());
+			previous_planet = enemy.planet_id;
+			enemy.info.fleet_id = r.get_varuint32();
+			enemy.info.owner = r.get_varint32();
+			enemy.info.ship_count = r.get_varuint32();
+			enemy_fleets.push_back(enemy);
+		}
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Fleet Occupancy
+	// ------------------------------------------------------------------------
+
+	void write_occupancy(ByteWriter& w, const std::vector<OccupancyRecord>& occupancy)
+	{
+		w.put_varuint(occupancy.size());
+		uint32_t previous_planet = 0;
+		for (const OccupancyRecord& record : occupancy)
+		{
+			w.put_varint(static_cast<int64_t>(record.planet_id) - previous_planet);
+			previous_planet = record.planet_id;
+			w.put_varint(record.owner);
+			w.put_varuint(record.fleet_id);
+		}
+	}
+
+	bool read_occupancy(ByteReader& r, std::vector<OccupancyRecord>& occupancy)
+	{
+		uint32_t count = r.get_count();
+		occupancy.clear();
+		occupancy.reserve(count);
+		uint32_t previous_planet = 0;
+		for (uint32_t i = 0; i < count && r.ok(); ++i)
+		{
+			OccupancyRecord record;
+			record.planet_id = static_cast<uint32_t>(previous_planet + r.get_varint());
+			previous_planet = record.planet_id;
+			record.owner = r.get_varint32();
+			record.fleet_id = r.get_varuint32();
+			occupancy.push_back(record);
+		}
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Public Player History
+	// ------------------------------------------------------------------------
+
+	void write_history_rows(ByteWriter& w, const PlayerHistoryStore& history, size_t first_row)
+	{
+		const size_t rows = first_row < history.get_row_count() ? history.get_row_count() - first_row : 0;
+		w.put_varuint(rows);
+		w.put_varuint(rows ? history.get_turns()[first_row] : 0);
+
+		// Rows are consecutive turns; years and metrics change slowly, so store deltas
+		uint32_t previous_year = 0;
+		for (size_t row = first_row; row < history.get_row_count(); ++row)
+		{
+			w.put_varint(static_cast<int64_t>(history.get_years()[row]) - previous_year);
+			previous_year = history.get_years()[row];
+		}
+
+		for (size_t player = 0; player < history.get_player_count(); ++player)
+		{
+			for (uint32_t metric = 0; metric < METRIC_COUNT; ++metric)
+			{
+				MetricSpan column = history.get_metric(player, static_cast<PlayerMetric>(metric));
+				uint64_t previous = 0;
+				for (size_t row = first_row; row < column.size(); ++row)
+				{
+					w.put_varint(static_cast<int64_t>(static_cast<uint64_t>(column[row]) - previous));
+					previous = static_cast<uint64_t>(column[row]);
+				}
+				w.flush_point();
+			}
+		}
+	}
+
+	bool read_history_rows(ByteReader& r, PlayerHistoryStore& history)
+	{
+		uint32_t rows = r.get_count();
+		uint32_t first_turn = r.get_varuint32();
+		if (!r.ok())
+			{ return false; }
+
+		std::vector<uint32_t> years(rows);
+		uint32_t previous_year = 0;
+		for (uint32_t& year : years)
+		{
+			previous_year = static_cast<uint32_t>(previous_year + r.get_varint());
+			year = previous_year;
+		}
+
+		// Decode the columns, then replay them row by row (begin_turn keeps the store's own rules)
+		const size_t column_count = history.get_player_count() * METRIC_COUNT;
+		std::vector<int64_t> values(column_count * rows);
+		for (size_t column = 0; column < column_count; ++column)
+		{
+			uint64_t previous = 0;
+			for (uint32_t row = 0; row < rows; ++row)
+			{
+				previous += static_cast<uint64_t>(r.get_varint());
+				values[column * rows + row] = static_cast<int64_t>(previous);
+			}
+		}
+		if (!r.ok())
+			{ return false; }
+
+		for (uint32_t row = 0; row < rows; ++row)
+		{
+			if (!history.begin_turn(first_turn + row, years[row]))
+				{ return false; }
+			for (size_t column = 0; column < column_count; ++column)
+			{
+				history.set(column / METRIC_COUNT, static_cast<PlayerMetric>(column % METRIC_COUNT),
+				            values[column * rows + row]);
+			}
+		}
+		return true;
+	}
+
+	void write_history(ByteWriter& w, const PlayerHistoryStore& history)
+	{
+		const std::vector<uint32_t>& ids = history.get_player_ids();
+		w.put_varuint(ids.size());
+		uint32_t previous_id = 0;
+		for (uint32_t id : ids)
+		{
+			w.put_varint(static_cast<int64_t>(id) - previous_id);
+			previous_id = id;
+		}
+		w.put_varuint(history.get_retained_turns());
+		write_history_rows(w, history, 0);
+	}
+
+	bool read_history(ByteReader& r, PlayerHistoryStore& history)
+	{
+		uint32_t player_count = r.get_count();
+		std::vector<uint32_t> ids;
+		ids.reserve(player_count);
+		uint32_t previous_id = 0;
+		for (uint32_t i = 0; i < player_count && r.ok(); ++i)
+		{
+			previous_id = static_cast<uint32_t>(previous_id + r.get_varint());
+			ids.push_back(previous_id);
+		}
+		uint64_t retained_turns = r.get_varuint();
+		if (!r.ok())
+			{ return false; }
+
+		history.reset(ids, static_cast<size_t>(retained_turns));
+		return read_history_rows(r, history);
+	}
+
+	// ------------------------------------------------------------------------
+	// RNG
+	// ------------------------------------------------------------------------
+
+	void write_rng(ByteWriter& w, const GameSnapshot& s)
+	{
+		w.put_u64(s.deterministic_seed);
+		w.put_u64(s.ai_seed);
+		w.put_varuint(s.deterministic_rng_state.size());
+		w.put_bytes(s.deterministic_rng_state.data(), s.deterministic_rng_state.size());
+		w.put_varuint(s.ai_rng_state.size());
+		w.put_bytes(s.ai_rng_state.data(), s.ai_rng_state.size());
+	}
+
+	bool read_rng(ByteReader& r, GameSnapshot& s)
+	{
+		s.deterministic_seed = r.get_u64();
+		s.ai_seed = r.get_u64();
+		uint32_t det_size = r.get_count();
+		const uint8_t* det_bytes = r.get_bytes(det_size);
+		if (det_bytes)
+			{ s.deterministic_rng_state.assign(det_bytes, det_bytes + det_size); }
+		uint32_t ai_size = r.get_count();
+		const uint8_t* ai_bytes = r.get_bytes(ai_size);
+		if (ai_bytes)
+			{ s.ai_rng_state.assign(ai_bytes, ai_bytes + ai_size); }
+		return r.ok();
+	}
+
+	// ------------------------------------------------------------------------
+	// Seed-only Map
+	// ------------------------------------------------------------------------
+
+	bool map_matches_planets(const std::vector<Planet>& generated, const std::vector<Planet>& planets)
+	{
+		if (generated.size() != planets.size())
+			{ return false; }
+		for (size_t i = 0; i < planets.size(); ++i)
+		{
+			if (generated[i].id != planets[i].id || generated[i].name != planets[i].name
+			    || !same_bits(generated[i].x, planets[i].x) || !same_bits(generated[i].y, planets[i].y))
+				{ return false; }
+		}
+		return true;
+	}
+
+	void write_map(ByteWriter& w, const std::vector<Planet>& generated, const std::vector<Planet>& planets)
+	{
+		w.put_varuint(GALAXY_GENERATOR_VERSION);
+		w.put_u64(hash_planets(generated));
+		w.put_varuint(planets.size());
+
+		std::vector<uint8_t> masks(planets.size(), 0);
+		size_t changed = 0;
+		for (size_t i = 0; i < planets.size(); ++i)
+		{
+			const Planet& before = generated[i];
+			const Planet& after = planets[i];
+			uint8_t mask = 0;
+			if (!same_bits(before.true_gravity, after.true_gravity))
+				{ mask |= MapDelta::FIELD_GRAVITY; }
+			if (!same_bits(before.true_temperature, after.true_temperature))
+				{ mask |= MapDelta::FIELD_TEMPERATURE; }
+			if (before.metal != after.metal)
+				{ mask |= MapDelta::FIELD_METAL; }
+			if (before.population != after.population)
+				{ mask |= MapDelta::FIELD_POPULATION; }
+			if (before.owner != after.owner)
+				{ mask |= MapDelta::FIELD_OWNER; }
+			if (before.nova_state != after.nova_state)
+				{ mask |= MapDelta::FIELD_NOVA; }
+			masks[i] = mask;
+			changed += mask != 0;
+		}
+
+		w.put_varuint(changed);
+		size_t previous_index = 0;
+		for (size_t i = 0; i < planets.size(); ++i)
+		{
+			uint8_t mask = masks[i];
+			if (!mask)
+				{ continue; }
+			const Planet& planet = planets[i];
+			w.put_varuint(i - previous_index);
+			previous_index = i;
+			w.put_u8(mask);
+			if (mask & MapDelta::FIELD_GRAVITY)
+				{ w.put_f64(planet.true_gravity); }
+			if (mask & MapDelta::FIELD_TEMPERATURE)
+				{ w.put_f64(planet.true_temperature); }
+			if (mask & MapDelta::FIELD_METAL)
+				{ w.put_varint(planet.metal); }
+			if (mask & MapDelta::FIELD_POPULATION)
+				{ w.put_varint(planet.population); }
+			if (mask & MapDelta::FIELD_OWNER)
+				{ w.put_varint(planet.owner); }
+			if (mask & MapDelta::FIELD_NOVA)
+				{ w.put_u8(static_cast<uint8_t>(planet.nova_state)); }
+			w.flush_point();
+		}
+	}
+
+	bool read_map(ByteReader& r, const std::vector<Planet>& generated, std::vector<Planet>& planets)
+	{
+		uint32_t version = r.get_varuint32();
+		uint64_t hash = r.get_u64();
+		uint32_t count = r.get_varuint32();
+		if (!r.ok() || version != GALAXY_GENERATOR_VERSION || count != generated.size() || hash != hash_planets(generated))
+			{ return false; }
+
+		planets = generated;
+		uint32_t changed = r.get_count();
+		uint64_t index = 0;
+		for (uint32_t i = 0; i < changed && r.ok(); ++i)
+		{
+			index += r.get_varuint32();
+			uint8_t mask = r.get_u8();
+			if (index >= count || mask >= MapDelta::FIELD_NOVA << 1)
+				{ return false; }
+			Planet& planet = planets[index];
+			if (mask & MapDelta::FIELD_GRAVITY)
+				{ planet.true_gravity = r.get_f64(); }
+			if (mask & MapDelta::FIELD_TEMPERATURE)
+				{ planet.true_temperature = r.get_f64(); }
+			if (mask & MapDelta::FIELD_METAL)
+				{ planet.metal = r.get_varint32(); }
+			if (mask & MapDelta::FIELD_POPULATION)
+				{ planet.population = r.get_varint32(); }
+			if (mask & MapDelta::FIELD_OWNER)
+				{ planet.owner = r.get_varint32(); }
+			if (mask & MapDelta::FIELD_NOVA)
+			{
+				uint8_t nova = r.get_u8();
+				if (nova > PLANET_DESTROYED)
+					{ return false; }
+				planet.nova_state = static_cast<PlanetNovaState>(nova);
+			}
+		}
+		return r.ok();
+	}
+}
+
+// ============================================================================
+// Seed-only Maps
+// ============================================================================
+
+uint64_t hash_planets(const std::vector<Planet>& planets)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	hash_value(hash, planets.size(), 4);
+	for (const Planet& planet : planets)
+	{
+		hash_value(hash, planet.id, 4);
+		hash_value(hash, planet.name.size(), 4);
+		for (char c : planet.name)
+			{ hash_value(hash, static_cast<uint8_t>(c), 1); }
+		hash_double(hash, planet.x);
+		hash_double(hash, planet.y);
+		hash_double(hash, planet.true_gravity);
+		hash_double(hash, planet.true_temperature);
+		hash_value(hash, static_cast<uint32_t>(planet.metal), 4);
+		hash_value(hash, static_cast<uint32_t>(planet.population), 4);
+		hash_value(hash, static_cast<uint32_t>(planet.owner), 4);
+		hash_value(hash, static_cast<uint8_t>(planet.nova_state), 1);
+	}
+	return hash;
+}
+
+// ============================================================================
+// Section Index
+// ============================================================================
+
+bool SectionIndex::parse(ByteReader& reader, uint32_t section_count)
+{
+	sections.clear();
+	for (uint32_t i = 0; i < section_count && reader.ok(); ++i)
+	{
+		uint32_t tag = reader.get_u32();
+		uint32_t length = reader.get_u32();
+		const uint8_t* payload = reader.get_bytes(length);
+		if (payload)
+			{ sections.push_back(Section{ tag, payload, length }); }
+	}
+	return reader.ok();
+}
+
+bool SectionIndex::find(uint32_t tag, ByteReader& reader) const
+{
+	for (const Section& section : sections)
+	{
+		if (section.tag == tag)
+		{
+			reader = ByteReader(section.payload, section.length);
+			return true;
+		}
+	}
+	return false;
+}
+
+// ============================================================================
+// Snapshot Encoding
+// ============================================================================
+
+using namespace SaveRecords;
+
+namespace
+{
+	void write_meta(ByteWriter& w, const GameSnapshot& s)
+	{
+		w.put_varuint(s.current_turn);
+		w.put_varuint(s.current_year);
+		w.put_varuint(s.next_fleet_id);
+		w.put_varuint(s.galaxy_params.n_planets);
+		w.put_varuint(s.galaxy_params.n_players);
+		w.put_f64(s.galaxy_params.density);
+		w.put_varuint(static_cast<uint32_t>(s.galaxy_params.shape));
+		w.put_u64(s.galaxy_params.seed);
+		w.put_f64(s.galaxy_params.cluster_angular_offset);
+		w.put_f64(s.galaxy_size);
+		w.put_varuint(s.home_planet_indices.size());
+		for (size_t index : s.home_planet_indices)
+			{ w.put_varuint(index); }
+	}
+
+	bool read_meta(ByteReader r, GameSnapshot& s)
+	{
+		s.current_turn = r.get_varuint32();
+		s.current_year = r.get_varuint32();
+		s.next_fleet_id = r.get_varuint32();
+		s.galaxy_params.n_planets = r.get_varuint32();
+		s.galaxy_params.n_players = r.get_varuint32();
+		s.galaxy_params.density = r.get_f64();
+		s.galaxy_params.shape = static_cast<GalaxyShape>(r.get_varuint32());
+		s.galaxy_params.seed = r.get_u64();
+		s.galaxy_params.cluster_angular_offset = r.get_f64();
+		s.galaxy_size = r.get_f64();
+		uint32_t home_count = r.get_count();
+		s.home_planet_indices.clear();
+		for (uint32_t i = 0; i < home_count && r.ok(); ++i)
+			{ s.home_planet_indices.push_back(r.get_varuint32()); }
+		return r.ok();
+	}
+
+	void write_planets(ByteWriter& w, const GameSnapshot& s, StringTable& strings)
+	{
+		w.put_varuint(s.planets.size());
+		uint32_t previous_id = 0;
+		for (const Planet& planet : s.planets)
+		{
+			w.put_varint(static_cast<int64_t>(planet.id) - previous_id);
+			previous_id = planet.id;
+			w.put_varuint(strings.intern(planet.name));
+			w.put_f64(planet.x);
+			w.put_f64(planet.y);
+			write_planet_state(w, planet);
+			w.flush_point();
+		}
+	}
+
+	bool read_planets(ByteReader r, const std::vector<std::string>& strings, GameSnapshot& s)
+	{
+		uint32_t count = r.get_count();
+		s.planets.clear();
+		s.planets.reserve(count);
+		uint32_t previous_id = 0;
+		std::string name;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			uint32_t id = static_cast<uint32_t>(previous_id + r.get_varint());
+			previous_id = id;
+			if (!read_string(r, strings, name))
+				{ return false; }
+			double x = r.get_f64();
+			double y = r.get_f64();
+			s.planets.emplace_back(id, name, x, y, 0.0, 0.0, 0);
+			if (!read_planet_state(r, s.planets.back()))
+				{ return false; }
+		}
+		return r.ok();
+	}
+
+	void write_players(ByteWriter& w, const GameSnapshot& s, StringTable& strings)
+	{
+		w.put_varuint(s.players.size());
+		uint32_t previous_id = 0;
+		for (const PlayerRecord& p : s.players)
+		{
+			w.put_varint(static_cast<int64_t>(p.id) - previous_id);
+			previous_id = p.id;
+			write_player(w, p, strings);
+			w.flush_point();
+		}
+	}
+
+	bool read_players(ByteReader r, const std::vector<std::string>& strings, GameSnapshot& s)
+	{
+		uint32_t count = r.get_count();
+		s.players.assign(count, PlayerRecord());
+		uint32_t previous_id = 0;
+		for (PlayerRecord& p : s.players)
+		{
+			p.id = static_cast<uint32_t>(previous_id + r.get_varint());
+			previous_id = p.id;
+			if (!read_player(r, strings, p))
+				{ return false; }
+		}
+		return r.ok();
+	}
+
+	bool read_player_count(ByteReader& r, const GameSnapshot& s)
+		{ return r.get_varuint() == s.players.size() && r.ok(); }
+
+	void write_knowledge(ByteWriter& w, const PlayerRecord& p)
+	{
+		// Expanded records, or the pages of a frozen capture read in place
+		w.put_varuint(p.known_planets.size() + p.frozen_knowledge.size());
+		uint32_t previous_id = 0;
+		for (const KnowledgePlanet& known : p.known_planets)
+		{
+			write_known_planet(w, known, previous_id);
+			w.flush_point();
+		}
+		p.frozen_knowledge.for_each_record([&](const KnowledgePlanet& known, int32_t observation_year)
+		{
+			write_known_planet(w, known, observation_year, previous_id);
+			w.flush_point();
+		});
+
+		write_colonies(w, p.known_colonizations);
+		write_enemy_fleets(w, p.enemy_fleets);
+
+		w.put_varuint(p.visible_planet_words.size());
+		for (uint64_t word : p.visible_planet_words)
+			{ w.put_u64(word); }
+	}
+
+	bool read_knowledge(ByteReader& r, PlayerRecord& p)
+	{
+		uint32_t count = r.get_count();
+		p.known_planets.clear();
+		p.known_planets.reserve(count);
+		uint32_t previous_id = 0;
+		for (uint32_t i = 0; i < count && r.ok(); ++i)
+			{ p.known_planets.push_back(read_known_planet(r, previous_id)); }
+
+		if (!read_colonies(r, p.known_colonizations) || !read_enemy_fleets(r, p.enemy_fleets))
+			{ return false; }
+
+		uint32_t word_count = r.get_count();
+		p.visible_planet_words.assign(word_count, 0);
+		for (uint64_t& word : p.visible_planet_words)
+			{ word = r.get_u64(); }
+		return r.ok();
+	}
+
+	/// Sections in file order; STRS is last so the others can intern names as they go
+	constexpr uint32_t SAVE_SECTIONS[] = {
+		SaveFormat::SECTION_META, SaveFormat::SECTION_PLANETS, SaveFormat::SECTION_PLAYERS,
+		SaveFormat::SECTION_COLONIES, SaveFormat::SECTION_DESIGNS, SaveFormat::SECTION_FLEETS,
+		SaveFormat::SECTION_OCCUPANCY, SaveFormat::SECTION_KNOWLEDGE, SaveFormat::SECTION_HISTORY,
+		SaveFormat::SECTION_RNG, SaveFormat::SECTION_STRINGS
+	};
+	constexpr uint32_t SAVE_SECTION_COUNT = sizeof(SAVE_SECTIONS) / sizeof(SAVE_SECTIONS[0]);
+
+	void write_save_header(ByteWriter& w)
+	{
+		w.put_u32(SaveFormat::MAGIC);
+		w.put_u16(SaveFormat::VERSION);
+		w.put_u16(0);
+		w.put_u32(SAVE_SECTION_COUNT);
+	}
+
+	/// Payload of a section from SAVE_SECTIONS (or SECTION_MAP, given the generated planets)
+	void write_save_section(ByteWriter& w, uint32_t tag, const GameSnapshot& snapshot, StringTable& strings,
+		const std::vector<Planet>* generated = nullptr)
+	{
+		switch (tag)
+		{
+			case SaveFormat::SECTION_META:
+				write_meta(w, snapshot);
+				break;
+			case SaveFormat::SECTION_PLANETS:
+				write_planets(w, snapshot, strings);
+				break;
+			case SaveFormat::SECTION_MAP:
+				write_map(w, *generated, snapshot.planets);
+				break;
+			case SaveFormat::SECTION_PLAYERS:
+				write_players(w, snapshot, strings);
+				break;
+			case SaveFormat::SECTION_COLONIES:
+				w.put_varuint(snapshot.players.size());
+				for (const PlayerRecord& p : snapshot.players)
+				{
+					write_colonies(w, p.colonies);
+					w.flush_point();
+				}
+				break;
+			case SaveFormat::SECTION_DESIGNS:
+				w.put_varuint(snapshot.players.size());
+				for (const PlayerRecord& p : snapshot.players)
+				{
+					write_designs(w, p.designs, strings);
+					w.flush_point();
+				}
+				break;
+			case SaveFormat::SECTION_FLEETS:
+				w.put_varuint(snapshot.players.size());
+				for (const PlayerRecord& p : snapshot.players)
+				{
+					write_fleets(w, p.fleets, strings);
+					w.flush_point();
+				}
+				break;
+			case SaveFormat::SECTION_OCCUPANCY:
+				write_occupancy(w, snapshot.occupancy);
+				break;
+			case SaveFormat::SECTION_KNOWLEDGE:
+				w.put_varuint(snapshot.players.size());
+				for (const PlayerRecord& p : snapshot.players)
+				{
+					write_knowledge(w, p);
+					w.flush_point();
+				}
+				break;
+			case SaveFormat::SECTION_HISTORY:
+				write_history(w, snapshot.history);
+				break;
+			case SaveFormat::SECTION_RNG:
+				write_rng(w, snapshot);
+				break;
+			case SaveFormat::SECTION_STRINGS:
+				write_strings(w, strings);
+				break;
+		}
+	}
+
+	/// Payload length of every section, in SAVE_SECTIONS order, from a counting pass
+	/// (interning the strings in the order the encoder will)
+	void measure_sections(const GameSnapshot& snapshot, uint32_t (&lengths)[SAVE_SECTION_COUNT])
+	{
+		ByteWriter w{ ByteWriter::CountOnly() };
+		StringTable strings;
+		for (uint32_t i = 0; i < SAVE_SECTION_COUNT; ++i)
+		{
+			size_t start = w.size();
+			write_save_section(w, SAVE_SECTIONS[i], snapshot, strings);
+			lengths[i] = static_cast<uint32_t>(w.size() - start);
+		}
+	}
+
+	/// Encode to a vector; with generated planets, MAPD takes the place of PLNT
+	void encode_sections(const GameSnapshot& snapshot, const std::vector<Planet>* generated, std::vector<uint8_t>& out)
+	{
+		ByteWriter w(out);
+		StringTable strings;
+
+		write_save_header(w);
+		for (uint32_t tag : SAVE_SECTIONS)
+		{
+			if (tag == SaveFormat::SECTION_PLANETS && generated)
+				{ tag = SaveFormat::SECTION_MAP; }
+			size_t section = w.begin_section(tag);
+			write_save_section(w, tag, snapshot, strings, generated);
+			w.end_section(section);
+		}
+	}
+}
+
+void encode_game_snapshot(const GameSnapshot& snapshot, std::vector<uint8_t>& out)
+{
+	encode_sections(snapshot, nullptr, out);
+}
+
+void encode_game_snapshot(const GameSnapshot& snapshot, const std::vector<Planet>& generated, std::vector<uint8_t>& out)
+{
+	bool map = map_matches_planets(generated, snapshot.planets);
+	encode_sections(snapshot, map ? &generated : nullptr, out);
+}
+
+size_t measure_game_snapshot(const GameSnapshot& snapshot)
+{
+	uint32_t lengths[SAVE_SECTION_COUNT];
+	measure_sections(snapshot, lengths);
+
+	size_t size = SaveFormat::HEADER_SIZE;
+	for (uint32_t length : lengths)
+		{ size += SaveFormat::SECTION_HEADER_SIZE + length; }
+	return size;
+}
+
+bool stream_game_snapshot(const GameSnapshot& snapshot, ByteSink& sink)
+{
+	// A streamed length cannot be patched, so a counting pass measures the sections first
+	uint32_t lengths[SAVE_SECTION_COUNT];
+	measure_sections(snapshot, lengths);
+
+	std::vector<uint8_t> chunk;
+	ByteWriter w(chunk, sink);
+	StringTable strings;
+
+	write_save_header(w);
+	for (uint32_t i = 0; i < SAVE_SECTION_COUNT; ++i)
+	{
+		w.put_u32(SAVE_SECTIONS[i]);
+		w.put_u32(lengths[i]);
+		size_t start = w.size();
+		write_save_section(w, SAVE_SECTIONS[i], snapshot, strings);
+		if (w.size() - start != lengths[i])
+			{ return false; }  // Both passes run the same encoder, so this means a bug
+	}
+	return w.flush();
+}
+
+bool decode_game_snapshot(const uint8_t* data, size_t size, GameSnapshot& snapshot, MapGenerator* maps)
+{
+	if (!data || size < SaveFormat::HEADER_SIZE)
+		{ return false; }
+
+	ByteReader header(data, size);
+	if (header.get_u32() != SaveFormat::MAGIC)
+		{ return false; }
+	uint16_t version = header.get_u16();
+	header.get_u16();  // Flags (none defined yet)
+	uint32_t section_count = header.get_u32();
+	if (version == 0 || version > SaveFormat::VERSION)
+		{ return false; }
+
+	SectionIndex sections;
+	if (!sections.parse(header, section_count))
+		{ return false; }
+
+	ByteReader r(nullptr, 0);
+	std::vector<std::string> strings;
+	if (!sections.find(SaveFormat::SECTION_STRINGS, r) || !read_strings(r, strings))
+		{ return false; }
+	if (!sections.find(SaveFormat::SECTION_META, r) || !read_meta(r, snapshot))
+		{ return false; }
+	if (sections.find(SaveFormat::SECTION_PLANETS, r))
+	{
+		if (!read_planets(r, strings, snapshot))
+			{ return false; }
+	}
+	else
+	{
+		// Seed-only map: check the generator version before paying for generation
+		if (!maps || !sections.find(SaveFormat::SECTION_MAP, r))
+			{ return false; }
+		ByteReader version = r;
+		std::vector<Planet> generated;
+		if (version.get_varuint32() != GALAXY_GENERATOR_VERSION || !version.ok()
+		    || !maps->generate_planets(snapshot.galaxy_params, generated) || !read_map(r, generated, snapshot.planets))
+			{ return false; }
+	}
+	if (!sections.find(SaveFormat::SECTION_PLAYERS, r) || !read_players(r, strings, snapshot))
+		{ return false; }
+
+	if (!sections.find(SaveFormat::SECTION_COLONIES, r) || !read_player_count(r, snapshot))
+		{ return false; }
+	for (PlayerRecord& p : snapshot.players)
+	{
+		if (!read_colonies(r, p.colonies))
+			{ return false; }
+	}
+
+	if (!sections.find(SaveFormat::SECTION_DESIGNS, r) || !read_player_count(r, snapshot))
+		{ return false; }
+	for (PlayerRecord& p : snapshot.players)
+	{
+		if (!read_designs(r, strings, p.designs))
+			{ return false; }
+	}
+
+	if (!sections.find(SaveFormat::SECTION_FLEETS, r) || !read_player_count(r, snapshot))
+		{ return false; }
+	for (PlayerRecord& p : snapshot.players)
+	{
+		if (!read_fleets(r, strings, p.fleets))
+			{ return false; }
+	}
+
+	if (!sections.find(SaveFormat::SECTION_OCCUPANCY, r) || !read_occupancy(r, snapshot.occupancy))
+		{ return false; }
+
+	if (!sections.find(SaveFormat::SECTION_KNOWLEDGE, r) || !read_player_count(r, snapshot))
+		{ return false; }
+	for (PlayerRecord& p : snapshot.players)
+	{
+		if (!read_knowledge(r, p))
+			{ return false; }
+	}
+
+	if (!sections.find(SaveFormat::SECTION_HISTORY, r) || !read_history(r, snapshot.history))
+		{ return false; }
+	if (!sections.find(SaveFormat::SECTION_RNG, r) || !read_rng(r, snapshot))
+		{ return false; }
+	return true;
+}
+
+// ============================================================================
+// GameState Serialization
+// ============================================================================
+
+std::vector<uint8_t> GameState::serialize_state() const
+{
+	// Knowledge is encoded straight from the pinned pages, never expanded
+	GameSnapshot snapshot;
+	capture_frozen_snapshot(snapshot);
+
+	std::vector<uint8_t> buffer;
+	encode_game_snapshot(snapshot, buffer);
+	return buffer;
+}
+
+bool GameState::serialize_state(ByteSink& sink) const
+{
+	GameSnapshot snapshot;
+	capture_frozen_snapshot(snapshot);
+	return stream_game_snapshot(snapshot, sink);
+}
+
+size_t GameState::get_serialized_size() const
+{
+	GameSnapshot snapshot;
+	capture_frozen_snapshot(snapshot);
+	return measure_game_snapshot(snapshot);
+}
+
+namespace
+{
+	/// Regenerates seed-only maps with a game's generation code
+	class GameMapGenerator : public MapGenerator
+	{
+	public:
+		explicit GameMapGenerator(const GameState& game) : game(game) {}
+
+		bool generate_planets(const GalaxyGenerationParams& params, std::vector<Planet>& planets) override
+		{
+			if (params.shape > GALAXY_GRID || params.n_planets < params.n_players)
+				{ return false; }
+			try
+			{
+				planets = game.generate_map(params);
+			}
+			catch (const std::exception&)
+			{
+				return false;
+			}
+			return true;
+		}
+
+	private:
+		const GameState& game;
+	};
+}
+
+bool GameState::deserialize_state(const std::vector<uint8_t>& data)
+{
+	GameSnapshot snapshot;
+	GameMapGenerator maps(*this);
+	if (!decode_game_snapshot(data.data(), data.size(), snapshot, &maps))
+		{ return false; }
+	return restore_snapshot(snapshot);
+}
+
+std::unique_ptr<GameState> GameState::from_save(const std::vector<uint8_t>& data)
+{
+	std::unique_ptr<GameState> game(new GameState());
+	if (!game->deserialize_state(data))
+		{ return nullptr; }
+	return game;
+}
+
+std::vector<uint8_t> GameState::serialize_state_seed_map() const
+{
+	GameSnapshot snapshot;
+	capture_frozen_snapshot(snapshot);
+	std::vector<Planet> generated = generate_map(galaxy_params);
+
+	std::vector<uint8_t> buffer;
+	encode_game_snapshot(snapshot, generated, buffer);
+	return buffer;
+}
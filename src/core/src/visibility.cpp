@@ -0,0 +1,134 @@
+#include "visibility.h"
+#include "galaxy.h"
+#include "planet.h"
+#include "player.h"
+#include "fleet.h"
+#include "game_constants.h"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// PlanetGrid Implementation
+// ============================================================================
+
+void PlanetGrid::build(const Galaxy& galaxy, double cell_size)
+{
+	cell_offsets.clear();
+	cell_planet_ids.clear();
+	cell_planet_x.clear();
+	cell_planet_y.clear();
+	if (galaxy.planets.empty() || cell_size <= 0.0)
+		{ return; }
+
+	double max_x = galaxy.planets.front().x;
+	double max_y = galaxy.planets.front().y;
+	min_x = max_x;
+	min_y = max_y;
+	for (const Planet& planet : galaxy.planets)
+	{
+		min_x = std::min(min_x, planet.x);
+		min_y = std::min(min_y, planet.y);
+		max_x = std::max(max_x, planet.x);
+		max_y = std::max(max_y, planet.y);
+	}
+
+	inv_cell_size = 1.0 / cell_size;
+	columns = static_cast<uint32_t>((max_x - min_x) * inv_cell_size) + 1;
+	rows = static_cast<uint32_t>((max_y - min_y) * inv_cell_size) + 1;
+
+	// Counting sort of planets into cells
+	size_t n_cells = static_cast<size_t>(columns) * rows;
+	cell_offsets.assign(n_cells + 1, 0);
+	std::vector<uint32_t> planet_cell(galaxy.planets.size());
+	for (size_t i = 0; i < galaxy.planets.size(); ++i)
+	{
+		const Planet& planet = galaxy.planets[i];
+		planet_cell[i] = cell_y(planet.y) * columns + cell_x(planet.x);
+		cell_offsets[planet_cell[i] + 1]++;
+	}
+	for (size_t c = 0; c < n_cells; ++c)
+		{ cell_offsets[c + 1] += cell_offsets[c]; }
+
+	cell_planet_ids.resize(galaxy.planets.size());
+	cell_planet_x.resize(galaxy.planets.size());
+	cell_planet_y.resize(galaxy.planets.size());
+	std::vector<uint32_t> fill(cell_offsets.begin(), cell_offsets.end() - 1);
+	for (size_t i = 0; i < galaxy.planets.size(); ++i)
+	{
+		const Planet& planet = galaxy.planets[i];
+		uint32_t slot = fill[planet_cell[i]]++;
+		cell_planet_ids[slot] = planet.id;
+		cell_planet_x[slot] = planet.x;
+		cell_planet_y[slot] = planet.y;
+	}
+}
+
+uint32_t PlanetGrid::clamp_cell(double offset, uint32_t count) const
+{
+	if (offset <= 0.0)
+		{ return 0; }
+	uint32_t cell = static_cast<uint32_t>(offset);
+	return std::min(cell, count - 1);
+}
+
+// ============================================================================
+// VisibilitySystem Implementation
+// ============================================================================
+
+void VisibilitySystem::build(const Galaxy& galaxy)
+{
+	// Size the cells to the longest sensor range so most queries touch at most 3x3 cells
+	double cell_size = std::max(GameConstants::Sensor_Range_Colony, GameConstants::Sensor_Range_Fleet);
+	grid.build(galaxy, cell_size);
+
+	max_planet_id = 0;
+	for (const Planet& planet : galaxy.planets)
+		{ max_planet_id = std::max(max_planet_id, planet.id); }
+
+	planet_x.assign(static_cast<size_t>(max_planet_id) + 1, 0.0);
+	planet_y.assign(static_cast<size_t>(max_planet_id) + 1, 0.0);
+	for (const Planet& planet : galaxy.planets)
+	{
+		planet_x[planet.id] = planet.x;
+		planet_y[planet.id] = planet.y;
+	}
+
+	sensor_planets.resize(max_planet_id + 1);
+	sensor_range.assign(static_cast<size_t>(max_planet_id) + 1, 0.0);
+}
+
+void VisibilitySystem::add_sensor(uint32_t planet_id, double range)
+{
+	if (planet_id == 0 || planet_id > max_planet_id)
+		{ return; }
+
+	if (!sensor_planets.test(planet_id))
+	{
+		sensor_planets.set(planet_id);
+		sensor_range[planet_id] = range;
+	}
+	else
+		{ sensor_range[planet_id] = std::max(sensor_range[planet_id], range); }
+}
+
+void VisibilitySystem::compute_visible_planets(const Player& player, PlanetBitset& visible)
+{
+	visible.resize(max_planet_id + 1);
+	visible.clear();
+	sensor_planets.clear();
+
+	for (const auto& colony : player.get_colonized_planets())
+		{ add_sensor(colony.get_id(), GameConstants::Sensor_Range_Colony); }
+
+	for (const Fleet& fleet : player.get_fleets())
+	{
+		if (!fleet.is_in_transit() && fleet.current_planet)
+			{ add_sensor(fleet.current_planet->id, GameConstants::Sensor_Range_Fleet); }
+	}
+
+	sensor_planets.for_each_set([&](uint32_t planet_id)
+	{
+		grid.for_each_within(planet_x[planet_id], planet_y[planet_id], sensor_range[planet_id],
+			[&visible](uint32_t seen_id) { visible.set(seen_id); });
+	});
+}